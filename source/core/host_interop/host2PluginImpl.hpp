@@ -40,6 +40,12 @@ public:
 
 public: // Plugin framework interface
     ErrorCode LE_FASTCALL setParameter( ParameterID, Plugins::AutomatedParameterValue );
+    /// Sample accurate variants for hosts that timestamp (or ramp) parameter
+    /// changes: module parameter changes are queued for the STFT hop
+    /// containing the given offset (into the next process() call), everything
+    /// else (and anything that cannot be queued) is applied immediately.
+    ErrorCode LE_FASTCALL setParameter( ParameterID, Plugins::AutomatedParameterValue, std::uint32_t sampleOffset );
+    ErrorCode LE_FASTCALL setParameter( ParameterID, Plugins::AutomatedParameterValue startValue, Plugins::AutomatedParameterValue endValue, std::uint32_t sampleOffset, std::uint32_t duration );
 
 private: //...mrmlj...spectrumWorxSharedImpl.hpp...
 public:
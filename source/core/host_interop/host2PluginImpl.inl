@@ -23,7 +23,7 @@
 #include "le/parameters/parametersUtilities.hpp"
 #include "le/plugins/plugin.hpp"
 #include "le/utility/platformSpecifics.hpp"
-#include "le/utility/trace.hpp"
+#include "le/utility/binaryTrace.hpp"
 #include "le/utility/cstdint.hpp"
 
 #include "boost/assert.hpp"
@@ -177,7 +177,7 @@ public:
         }
         else
         {
-            LE_TRACE( "SW: attempt to change a 'non-tail' module (index %d).\n", parameterID.moduleIndex );
+            LE_TRACE_RT( Host, "attempt to change a 'non-tail' module (index %d).", parameterID.moduleIndex );
             return Plugins::ErrorCode<Protocol>::OutOfRange;
         }
     }
@@ -249,7 +249,7 @@ Host2PluginInteropImpl<Impl, Protocol>::setParameter
     // http://forum.cockos.com/showthread.php?t=60633
     if ( impl().blockAutomation() )
     {
-        LE_TRACE( "\t SW: blocked automation of parameter %u.", parameterIndexFromBinaryID( parameterID.binaryValue ) );
+        LE_TRACE_RT( Host, "blocked automation of parameter %u.", parameterIndexFromBinaryID( parameterID.binaryValue ) );
         return Plugins::ErrorCode<Protocol>::CannotDoInCurrentContext;
     }
 
@@ -268,6 +268,76 @@ Host2PluginInteropImpl<Impl, Protocol>::setParameter
     return invokeFunctorOnIdentifiedParameter( parameterID, std::forward<ParameterSetter const>( setter ), &impl() );
 }
 
+
+template <class Impl, class Protocol>
+typename Plugins::ErrorCode<Protocol>::value_type LE_NOTHROW
+Host2PluginInteropImpl<Impl, Protocol>::setParameter
+(
+             ParameterID             const parameterID,
+    Plugins::AutomatedParameterValue const value,
+             std::uint32_t           const sampleOffset
+)
+{
+    return setParameter( parameterID, value, value, sampleOffset, 0 );
+}
+
+
+template <class Impl, class Protocol>
+typename Plugins::ErrorCode<Protocol>::value_type LE_NOTHROW
+Host2PluginInteropImpl<Impl, Protocol>::setParameter
+(
+             ParameterID             const parameterID,
+    Plugins::AutomatedParameterValue const startValue,
+    Plugins::AutomatedParameterValue const endValue,
+             std::uint32_t           const sampleOffset,
+             std::uint32_t           const duration
+)
+{
+    bool const ramp( duration != 0 );
+    if
+    (
+        (  parameterID.type() != ParameterID::ModuleParameter       ) ||
+        ( !sampleOffset && !ramp                                  ) ||
+        (  impl().blockAutomation()                               )
+    )
+        return setParameter( parameterID, endValue );
+
+    auto const & id     ( parameterID.value._.module                                                      );
+    auto const   pModule( impl().moduleChain(). template moduleAs<typename Impl::Module>( id.moduleIndex ) );
+    if
+    (
+        ( !pModule                                                      ) ||
+        (  id.moduleParameterIndex >= pModule->numberOfParameters()     ) ||
+        (  pModule->automationOverridden( id.moduleParameterIndex )     )
+    )
+        return setParameter( parameterID, endValue );
+
+    bool const normalised( AutomatedParameter::normalised );
+    float const internalEndValue( pModule->automatedToInternalValue( id.moduleParameterIndex, endValue, normalised ) );
+    bool const continuous( pModule->parameterInfo( id.moduleParameterIndex ).type == ParameterInfo::FloatingPoint );
+    bool const scheduled
+    (
+        ( ramp && continuous )
+            ? impl().scheduleModuleParameterRamp
+              (
+                  id.moduleIndex, id.moduleParameterIndex,
+                  pModule->automatedToInternalValue( id.moduleParameterIndex, startValue, normalised ), internalEndValue,
+                  sampleOffset, duration
+              )
+            : impl().scheduleModuleParameter
+              (
+                  id.moduleIndex, id.moduleParameterIndex,
+                  internalEndValue, continuous,
+                  sampleOffset + duration
+              )
+    );
+    if ( !scheduled )
+        return setParameter( parameterID, endValue );
+
+    impl().markCurrentProgramAsModified();
+    return Plugins::ErrorCode<Protocol>::Success;
+}
+
 //------------------------------------------------------------------------------
 } // namespace SW
 //------------------------------------------------------------------------------
@@ -32,6 +32,13 @@ public: // Parameters
 
     void                                        LE_FASTCALL setAutomatedParameter              ( std::uint8_t parameterIndex, Plugins::AutomatedParameterValue, bool normalised );
 
+    /// Internal value of the given parameter for the given automation value
+    /// (what setAutomatedParameter() would set).
+    float                            LE_NOALIAS LE_FASTCALL automatedToInternalValue           ( std::uint8_t parameterIndex, Plugins::AutomatedParameterValue, bool normalised ) const;
+
+    /// Automation is ignored for parameters driven by their LFOs.
+    bool                             LE_NOALIAS LE_FASTCALL automationOverridden               ( std::uint8_t parameterIndex ) const;
+
     LE_NOTHROWNOALIAS char const * getParameterValueString( std::uint8_t parameterIndex, LE::Parameters::AutomatedParameterPrinter const & ) const;
 
 private:
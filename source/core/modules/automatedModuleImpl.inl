@@ -61,29 +61,37 @@ AutomatedModuleImpl<Impl>::setAutomatedParameter( std::uint8_t const parameterIn
     if ( parameterIndex >= impl().numberOfParameters() )
         return; // index out of range
 
-    if ( parameterIndex != 0 && impl().lfo( parameterIndex - 1 ).enabled() ) //...mrmlj...skip bypass
+    if ( automationOverridden( parameterIndex ) )
         return; // skip automation if the parameter's LFO is enabled
 
+    float const internalValue( automatedToInternalValue( parameterIndex, value, normalised ) );
     if ( parameterIndex < impl().numberOfBaseParameters )
-    {
-        impl().setBaseParameter
-        (
-            parameterIndex,
-            Automation::sharedAutomated2InternalValue( parameterIndex, value, normalised )
-        );
-        return;
-    }
+        impl().setBaseParameter  (                                      parameterIndex  , internalValue );
+    else
+        impl().setEffectParameter( impl().effectSpecificParameterIndex( parameterIndex ), internalValue );
+} // AutomatedModuleImpl<Impl>::setAutomatedParameter()
+
+
+template <class Impl>
+float LE_NOTHROWNOALIAS
+AutomatedModuleImpl<Impl>::automatedToInternalValue( std::uint8_t const parameterIndex, Plugins::AutomatedParameterValue const value, bool const normalised ) const
+{
+    if ( parameterIndex < impl().numberOfBaseParameters )
+        return Automation::sharedAutomated2InternalValue( parameterIndex, value, normalised );
 
 #ifdef LE_SW_FMOD //...mrmlj...FMOD has "full range" but completely static parameters...
     const_cast<bool &>( normalised ) = true;
 #endif // LE_SW_FMOD
-    std::uint8_t const effectSpecificParameterIndex( impl().effectSpecificParameterIndex( parameterIndex ) );
-    impl().setEffectParameter
-    (
-        effectSpecificParameterIndex,
-        Automation::effectAutomated2InternalValue( effectSpecificParameterIndex, value, normalised, impl() )
-    );
-} // AutomatedModuleImpl<Impl>::setAutomatedParameter()
+    return Automation::effectAutomated2InternalValue( impl().effectSpecificParameterIndex( parameterIndex ), value, normalised, impl() );
+}
+
+
+template <class Impl>
+bool LE_NOTHROWNOALIAS
+AutomatedModuleImpl<Impl>::automationOverridden( std::uint8_t const parameterIndex ) const
+{
+    return parameterIndex != 0 && impl().lfo( parameterIndex - 1 ).enabled(); //...mrmlj...skip bypass
+}
 
 
 template <class Impl> LE_NOTHROWNOALIAS
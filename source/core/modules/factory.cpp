@@ -20,10 +20,13 @@
     #endif
 #endif
 #include "core/modules/finalImplementations.hpp"
+#include "core/modules/modulePool.hpp"
 
 #include "le/spectrumworx/effects/configuration/effectNames.hpp"
 #include "le/spectrumworx/effects/configuration/indexToEffectImplMapping.hpp"
 #include "le/spectrumworx/effects/configuration/includedEffects.hpp"
+#include "le/spectrumworx/engine/buffers.hpp"
+#include "le/spectrumworx/engine/effectTraits.hpp"
 #include "le/spectrumworx/engine/moduleParameters.hpp"
 #include "le/utility/rvalueReferences.hpp"
 #include "le/utility/switch.hpp"
@@ -38,6 +41,10 @@
 #endif // LE_SW_GUI
 
 #include "boost/assert.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <type_traits>
 //------------------------------------------------------------------------------
 namespace LE
 {
@@ -89,6 +96,26 @@ struct ModuleSizeGetter
 }; // struct ModuleSizeGetter
 
 
+////////////////////////////////////////////////////////////////////////////
+/// \internal
+/// \struct ScratchStorageGetter
+////////////////////////////////////////////////////////////////////////////
+
+struct ScratchStorageGetter
+{
+    using result_type = std::uint32_t;
+
+    template <class EffectIndex>
+    result_type operator()( EffectIndex ) const
+    {
+        using EffectImplementation = typename Effects::ImplForIndex<EffectIndex::value>::type;
+        return Engine::Detail::effectScratchStorage<EffectImplementation>( factors );
+    }
+
+    Engine::StorageFactors const & factors;
+}; // struct ScratchStorageGetter
+
+
 ////////////////////////////////////////////////////////////////////////////
 /// \internal
 /// \struct ModuleConstructor
@@ -139,6 +166,73 @@ struct ModuleConstructor
 }; // struct ModuleConstructor
 
 #pragma warning( pop )
+
+
+////////////////////////////////////////////////////////////////////////////
+/// \internal
+/// Module memory
+///
+///   Modules with DSP (and thus channel state storage) come from a process
+/// wide ModulePool (the factory and the deleters have no notion of a plugin
+/// instance), GUI-only modules (of separated DSP/GUI builds) are allocated
+/// directly from the heap.
+////////////////////////////////////////////////////////////////////////////
+
+template <class ModuleInterface>
+using PooledModule = std::is_base_of<Engine::ModuleDSP, ModuleInterface>;
+
+template <class ModuleInterface>
+LE_COLD
+ModulePool & modulePool()
+{
+    struct Sizes : ModulePool::ModuleSizes
+    {
+        Sizes()
+        {
+            using SizeGetter = ModuleSizeGetter<ModuleInterface>;
+            for ( std::uint8_t effectIndex( 0 ); effectIndex < this->size(); ++effectIndex )
+            {
+                (*this)[ effectIndex ] = Effects::includedEffects[ effectIndex ]
+                    ? boost::switch_<Effects::ValidIndices>( effectIndex, SizeGetter(), boost::assert_no_default_case<typename SizeGetter::result_type>() )
+                    : 0;
+            }
+        }
+    }; // struct Sizes
+    static ModulePool pool( ( Sizes() ) );
+    return pool;
+}
+
+template <class ModuleInterface>
+void * allocate( std::int8_t const effectIndex, std::true_type /*pooled*/ )
+{
+    return modulePool<ModuleInterface>().allocate( effectIndex );
+}
+
+template <class ModuleInterface>
+void * allocate( std::int8_t const effectIndex, std::false_type /*pooled*/ )
+{
+    using SizeGetter = ModuleSizeGetter<ModuleInterface>;
+    auto const storageSize
+    (
+        boost::switch_<Effects::ValidIndices>
+        (
+            effectIndex,
+            SizeGetter(),
+            boost::assert_no_default_case<typename SizeGetter::result_type>()
+        )
+    );
+    return std::malloc( storageSize );
+}
+
+template <class ModuleInterface>
+void adoptSpareStorage( ModuleInterface & module, std::true_type  /*pooled*/ ) { ModulePool::adoptSpareStorage( module ); }
+template <class ModuleInterface>
+void adoptSpareStorage( ModuleInterface &       , std::false_type /*pooled*/ ) {}
+
+template <class ModuleInterface>
+void trimPool( std::true_type  /*pooled*/ ) { modulePool<ModuleInterface>().trim(); }
+template <class ModuleInterface>
+void trimPool( std::false_type /*pooled*/ ) {}
 } // anonymous namespace
 
 
@@ -172,33 +266,77 @@ boost::intrusive_ptr<ModuleInterface> ModuleFactory::create( std::int8_t const e
 
     using namespace boost;
 
-    using SizeGetter = ModuleSizeGetter<ModuleInterface>;
-    auto const storageSize
-    (
-        switch_<Effects::ValidIndices>
-        (
-            effectIndex,
-            SizeGetter(),
-            assert_no_default_case<typename SizeGetter::result_type>()
-        )
-    );
-    void * const pStorage( std::malloc( storageSize ) );
+    using Pooled = PooledModule<ModuleInterface>;
+    void * const pStorage( allocate<ModuleInterface>( effectIndex, Pooled() ) );
 
     if ( BOOST_UNLIKELY( !pStorage ) )
         return nullptr;
 
     using Constructor = ModuleConstructor<ModuleInterface>;
     Constructor & moduleConstructor( *static_cast<Constructor *>( pStorage ) );
-    return
+    ModuleInterface * const pModule
+    (
         switch_<Effects::ValidIndices>
         (
             effectIndex,
             std::forward<Constructor>( moduleConstructor ),
             assert_no_default_case<typename Constructor::result_type>()
-        );
+        )
+    );
+    adoptSpareStorage( *pModule, Pooled() );
+    return pModule;
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+//
+// ModuleFactory::maximumScratchStorage()
+// --------------------------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+
+LE_COLD
+std::uint32_t ModuleFactory::maximumScratchStorage( Engine::StorageFactors const & factors )
+{
+    ScratchStorageGetter const getter = { factors };
+    std::uint32_t maximum( 0 );
+    for ( std::uint8_t effectIndex( 0 ); effectIndex < Effects::Constants::numberOfEffects; ++effectIndex )
+    {
+        if ( Effects::includedEffects[ effectIndex ] )
+            maximum = std::max( maximum, boost::switch_<Effects::ValidIndices>( effectIndex, getter, boost::assert_no_default_case<ScratchStorageGetter::result_type>() ) );
+    }
+    return maximum;
+}
+
+
+LE_NOTHROW LE_COLD
+void ModuleFactory::trimPools()
+{
+#if LE_SW_GUI && !LE_SW_SEPARATED_DSP_GUI
+    trimPool<SW::Module   >( PooledModule<SW::Module   >() );
+#else
+    trimPool<SW::ModuleDSP>( PooledModule<SW::ModuleDSP>() );
+#endif
+}
+
+
+//...mrmlj...for TalkBox4Unity and the headless tools
+#if !LE_SW_GUI
+namespace Engine
+{
+    // Implementation note:
+    //   Defined here rather than in moduleDSP.hpp (which is included by more
+    // than one translation unit) so that non-unity builds link.
+    LE_NOTHROWNOALIAS
+    void LE_FASTCALL intrusive_ptr_release_deleter( ModuleNode const * LE_RESTRICT const pModuleNode )
+    {
+        auto const & module( actualModule<SW::ModuleDSP>( *pModuleNode ) );
+        ModulePool::destroy( module );
+    }
+} // namespace Engine
+#endif // !LE_SW_GUI
+
+
 #if LE_SW_GUI && !LE_SW_SEPARATED_DSP_GUI
     template LE_NOTHROW boost::intrusive_ptr<SW::Module   > LE_FASTCALL ModuleFactory::create( std::int8_t effectIndex );
 #else
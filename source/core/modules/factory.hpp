@@ -22,11 +22,19 @@ namespace LE
 namespace SW
 {
 //------------------------------------------------------------------------------
+namespace Engine { struct StorageFactors; }
 
 struct ModuleFactory
 {
     template <class ModuleInterface>
     static LE_NOTHROW boost::intrusive_ptr<ModuleInterface> LE_FASTCALL create( std::int8_t effectIndex );
+
+    /// The largest scratch storage requirement of the included effects (see
+    /// Engine::ScratchArena).
+    static std::uint32_t LE_FASTCALL maximumScratchStorage( Engine::StorageFactors const & );
+    /// Returns the unused memory of the (process wide) module pool to the heap
+    /// (see ModulePool::trim()).
+    static LE_NOTHROW void LE_FASTCALL trimPools();
 }; // struct ModuleFactory
 
 //------------------------------------------------------------------------------
@@ -13,6 +13,7 @@
 #pragma once
 //------------------------------------------------------------------------------
 #include "automatedModuleImpl.hpp"
+#include "modulePool.hpp"
 
 #include "le/spectrumworx/engine/module.hpp"
 #include "le/utility/platformSpecifics.hpp"
@@ -47,19 +48,6 @@ protected:
 #endif // _MSC_ver
 }; // class _MSC_VER
 
-//...mrmlj...for TalkBox4Unity
-#if !LE_SW_GUI
-namespace Engine
-{
-    LE_NOTHROWNOALIAS
-    void LE_FASTCALL intrusive_ptr_release_deleter( ModuleNode const * LE_RESTRICT const pModuleNode )
-    {
-        auto const & module( actualModule<SW::ModuleDSP>( *pModuleNode ) );
-        delete &module;
-    }
-} // namespace Engine
-#endif // !LE_SW_GUI
-
 //------------------------------------------------------------------------------
 } // namespace SW
 //------------------------------------------------------------------------------
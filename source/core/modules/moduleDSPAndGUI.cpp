@@ -10,6 +10,7 @@
 #include "moduleDSPAndGUI.hpp"
 
 #include "automatedModuleImpl.inl"
+#include "modulePool.hpp"
 
 #include "le/utility/parentFromMember.hpp"
 #include "le/spectrumworx/engine/moduleNode.hpp" // for intrusive_ptr_release_deleter
@@ -232,7 +233,7 @@ namespace Engine
         )
         {
             LE_ASSUME( module.referenceCount_ == 0 );
-            delete &module;
+            ModulePool::destroy( module );
         }
         else
         {
@@ -0,0 +1,220 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// modulePool.cpp
+/// --------------
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#include "modulePool.hpp"
+
+#include "le/utility/buffers.hpp"
+
+#include "boost/assert.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+
+/// \note The header precedes the module in the same block, padded so that the
+/// module keeps the alignment of the (malloc allocated) slab.
+struct ModulePool::Block
+{
+    Block( ModulePool & pool, Slab & slab, std::uint8_t const sizeClass ) : pPool( &pool ), pSlab( &slab ), pNextFree( nullptr ), sizeClass( sizeClass ) {}
+
+    ModulePool                * const pPool       ;
+    Slab                      * const pSlab       ;
+    Block                     *       pNextFree   ;
+    std::uint8_t                const sizeClass   ;
+    Engine::HeapSharedStorage         spareStorage;
+}; // struct ModulePool::Block
+
+struct ModulePool::Slab
+{
+    Slab         * pNext     ;
+    std::uint8_t   freeBlocks;
+}; // struct ModulePool::Slab
+
+std::uint16_t const ModulePool::blockHeaderSize( static_cast<std::uint16_t>( Utility::align( sizeof( ModulePool::Block ) ) ) );
+std::uint16_t const ModulePool::slabHeaderSize ( static_cast<std::uint16_t>( Utility::align( sizeof( ModulePool::Slab  ) ) ) );
+
+
+LE_NOTHROW LE_COLD
+ModulePool::ModulePool( ModuleSizes const & moduleSizes )
+    :
+    pSlabs_    ( nullptr ),
+#ifndef NDEBUG
+    liveBlocks_( 0       ),
+#endif // NDEBUG
+    criticalSection_()
+{
+    freeLists_.fill( nullptr );
+
+    std::uint8_t numberOfSizeClasses( 0 );
+    for ( std::uint8_t effectIndex( 0 ); effectIndex < moduleSizes.size(); ++effectIndex )
+    {
+        std::uint16_t const size( ( moduleSizes[ effectIndex ] + sizeGranularity - 1 ) / sizeGranularity * sizeGranularity );
+        auto const pSizeClassesEnd( &classSizes_[ 0 ] + numberOfSizeClasses          );
+        auto const pSizeClass     ( std::find( &classSizes_[ 0 ], pSizeClassesEnd, size ) );
+        if ( pSizeClass == pSizeClassesEnd )
+        {
+            *pSizeClass = size;
+            ++numberOfSizeClasses;
+        }
+        sizeClasses_[ effectIndex ] = static_cast<std::uint8_t>( pSizeClass - &classSizes_[ 0 ] );
+    }
+}
+
+
+LE_NOTHROW LE_COLD
+ModulePool::~ModulePool()
+{
+    BOOST_ASSERT_MSG( liveBlocks_ == 0, "Module pool destroyed before all of its modules." );
+    for ( Block * pBlock : freeLists_ )
+    {
+        while ( pBlock )
+        {
+            Block * const pNextFree( pBlock->pNextFree );
+            pBlock->~Block();
+            pBlock = pNextFree;
+        }
+    }
+    while ( pSlabs_ )
+    {
+        Slab * const pNext( pSlabs_->pNext );
+        std::free( pSlabs_ );
+        pSlabs_ = pNext;
+    }
+}
+
+
+LE_NOTHROWNOALIAS
+void * ModulePool::allocate( std::uint8_t const effectIndex )
+{
+    std::uint8_t const sizeClass( sizeClasses_[ effectIndex ] );
+    BOOST_ASSERT( classSizes_[ sizeClass ] != 0 );
+
+    Utility::CriticalSectionLock const lock( criticalSection_ );
+
+    if ( BOOST_UNLIKELY( !freeLists_[ sizeClass ] ) && !addSlab( sizeClass ) )
+        return nullptr;
+
+    Block & block( *freeLists_[ sizeClass ] );
+    freeLists_[ sizeClass ] = block.pNextFree;
+    block.pNextFree         = nullptr;
+    BOOST_ASSERT( block.pSlab->freeBlocks );
+    --block.pSlab->freeBlocks;
+#ifndef NDEBUG
+    ++liveBlocks_;
+#endif // NDEBUG
+    return reinterpret_cast<char *>( &block ) + blockHeaderSize;
+}
+
+
+LE_NOTHROW
+void ModulePool::deallocate( void * const pModule, Engine::HeapSharedStorage && storage )
+{
+    Block & block( ModulePool::block( pModule ) );
+    // The previous spare storage (if it was not adopted) gets freed along with
+    // the (then swapped) source storage.
+    block.spareStorage = std::move( storage );
+
+    ModulePool & pool( *block.pPool );
+    Utility::CriticalSectionLock const lock( pool.criticalSection_ );
+    block.pNextFree = pool.freeLists_[ block.sizeClass ];
+    pool.freeLists_[ block.sizeClass ] = &block;
+    ++block.pSlab->freeBlocks;
+#ifndef NDEBUG
+    BOOST_ASSERT( pool.liveBlocks_ );
+    --pool.liveBlocks_;
+#endif // NDEBUG
+}
+
+
+LE_NOTHROW LE_COLD
+void ModulePool::trim()
+{
+    Utility::CriticalSectionLock const lock( criticalSection_ );
+
+    // Unlink (and destroy) the blocks of unused slabs from the free lists and
+    // drop the spare storage of the remaining free blocks.
+    for ( Block * & pFreeList : freeLists_ )
+    {
+        Block * * ppBlock( &pFreeList );
+        while ( Block * const pBlock = *ppBlock )
+        {
+            if ( pBlock->pSlab->freeBlocks == blocksPerSlab )
+            {
+                *ppBlock = pBlock->pNextFree;
+                pBlock->~Block();
+            }
+            else
+            {
+                pBlock->spareStorage = Engine::HeapSharedStorage();
+                ppBlock = &pBlock->pNextFree;
+            }
+        }
+    }
+
+    Slab * * ppSlab( &pSlabs_ );
+    while ( Slab * const pSlab = *ppSlab )
+    {
+        if ( pSlab->freeBlocks == blocksPerSlab )
+        {
+            *ppSlab = pSlab->pNext;
+            std::free( pSlab );
+        }
+        else
+        {
+            ppSlab = &pSlab->pNext;
+        }
+    }
+}
+
+
+Engine::HeapSharedStorage & ModulePool::spareStorage( void * const pModule ) { return block( pModule ).spareStorage; }
+
+
+ModulePool::Block & ModulePool::block( void * const pModule )
+{
+    return *reinterpret_cast<Block *>( static_cast<char *>( pModule ) - blockHeaderSize );
+}
+
+
+LE_NOTHROW LE_COLD
+bool ModulePool::addSlab( std::uint8_t const sizeClass )
+{
+    BOOST_ASSERT( !freeLists_[ sizeClass ] );
+
+    std::uint32_t const blockSize( blockHeaderSize + classSizes_[ sizeClass ] );
+    char * const pSlabStorage( static_cast<char *>( std::malloc( slabHeaderSize + blocksPerSlab * blockSize ) ) );
+    if ( BOOST_UNLIKELY( !pSlabStorage ) )
+        return false;
+
+    Slab & slab( *new ( pSlabStorage ) Slab );
+    slab.pNext      = pSlabs_;
+    slab.freeBlocks = blocksPerSlab;
+    pSlabs_         = &slab;
+
+    for ( std::uint8_t blockIndex( 0 ); blockIndex < blocksPerSlab; ++blockIndex )
+    {
+        Block * const pBlock( new ( pSlabStorage + slabHeaderSize + blockIndex * blockSize ) Block( *this, slab, sizeClass ) );
+        pBlock->pNextFree = freeLists_[ sizeClass ];
+        freeLists_[ sizeClass ] = pBlock;
+    }
+    return true;
+}
+
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file modulePool.hpp
+/// --------------------
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef modulePool_hpp__3D5B8E41_9C72_4A0F_B6E8_52F1A7C09D63
+#define modulePool_hpp__3D5B8E41_9C72_4A0F_B6E8_52F1A7C09D63
+#pragma once
+//------------------------------------------------------------------------------
+#include "le/spectrumworx/effects/configuration/constants.hpp"
+#include "le/spectrumworx/engine/buffers.hpp"
+#include "le/utility/criticalSection.hpp"
+#include "le/utility/platformSpecifics.hpp"
+
+#include <array>
+#include <cstdint>
+#include <utility>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class ModulePool
+///
+/// \brief Recycles module memory so that chain edits do not hit the heap once
+/// the pool has warmed up.
+///
+///   Effect modules are grouped into size classes (the distinct sizes of the
+/// module implementations of all the effects, rounded up to a cache line).
+/// Each size class keeps a free list of blocks carved out of slabs that are
+/// allocated on demand and returned to the heap by trim() (once all of their
+/// blocks are free) or when the pool itself is destroyed. A released block also keeps the channel state storage of its
+/// last occupant which is handed over to the next module constructed in it
+/// (modules sharing a size class mostly have similarly sized states) so that
+/// the following Engine::ModuleDSP::resize() normally does not reallocate.
+///
+///   Block allocation and release take a (short, uncontended in practice)
+/// lock as modules may get released from the audio thread.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class ModulePool
+{
+public:
+    using ModuleSizes = std::array<std::uint16_t, Effects::Constants::numberOfEffects>;
+
+    LE_NOTHROW  ModulePool( ModuleSizes const & );
+    LE_NOTHROW ~ModulePool();
+
+    /// Memory for a module of the given effect (or nullptr on failure).
+    LE_NOTHROWNOALIAS void * LE_FASTCALL allocate( std::uint8_t effectIndex );
+
+    /// Returns the completely unused slabs and the spare storage kept in free
+    /// blocks to the heap (e.g. when a plugin instance is destroyed, as the
+    /// pool is shared by all the instances in the process).
+    LE_NOTHROW void LE_FASTCALL trim();
+
+    /// Lends the channel state storage left behind in the block by a previous
+    /// module to the module just constructed in it.
+    template <class Module>
+    static void adoptSpareStorage( Module & module ) { module.adoptStorage( std::move( spareStorage( &module ) ) ); }
+
+    /// Destroys a module created in memory obtained from allocate() and
+    /// returns the memory (and the module's storage) to its pool.
+    template <class Module>
+    static LE_NOTHROW void destroy( Module const & module )
+    {
+        auto & mutableModule( const_cast<Module &>( module ) );
+        Engine::HeapSharedStorage storage( mutableModule.releaseStorage() );
+        mutableModule.~Module();
+        deallocate( &mutableModule, std::move( storage ) );
+    }
+
+    ModulePool( ModulePool const & ) = delete;
+
+private:
+    struct Block;
+    struct Slab ;
+
+    static LE_NOTHROW void LE_FASTCALL deallocate( void * pModule, Engine::HeapSharedStorage && );
+
+    static Engine::HeapSharedStorage & LE_FASTCALL spareStorage( void * pModule );
+    static Block                     & LE_FASTCALL block       ( void * pModule );
+
+    LE_NOTHROW bool LE_FASTCALL addSlab( std::uint8_t sizeClass );
+
+private:
+    static std::uint16_t BOOST_CONSTEXPR_OR_CONST sizeGranularity = 64;
+    static std::uint8_t  BOOST_CONSTEXPR_OR_CONST blocksPerSlab   = 4;
+
+    static std::uint16_t const blockHeaderSize;
+    static std::uint16_t const slabHeaderSize ;
+
+    std::array<Block *      , Effects::Constants::numberOfEffects> freeLists_  ;
+    std::array<std::uint16_t, Effects::Constants::numberOfEffects> classSizes_ ;
+    std::array<std::uint8_t , Effects::Constants::numberOfEffects> sizeClasses_; // per effect
+
+    Slab * pSlabs_;
+
+#ifndef NDEBUG
+    std::uint16_t liveBlocks_;
+#endif // NDEBUG
+
+    Utility::CriticalSection criticalSection_;
+}; // class ModulePool
+
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // modulePool_hpp
@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// qualityOfService.cpp
+/// --------------------
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#include "qualityOfService.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <limits>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+
+namespace
+{
+    float        const overloadThreshold   = 0.85f; // of the real-time budget
+    float        const headroomThreshold   = 0.45f;
+    std::uint8_t const overloadedCallbacks = 3    ; // consecutive
+    float        const settleSeconds       = 0.5f ; // minimum time between two step downs
+    float        const recoverySeconds     = 2    ; // minimum time (with headroom) before a step up
+    std::uint8_t const maximumBackoff      = 4    ; // recovery period up to 2 * 2^4 = 32 seconds
+} // anonymous namespace
+
+
+LE_NOTHROWNOALIAS LE_COLD
+char const * QualityOfService::levelName( Level const level )
+{
+    switch ( level )
+    {
+        case Level::Full                   : return "full quality"        ;
+        case Level::ReducedOverlap         : return "reduced overlap"     ;
+        case Level::OptionalModulesBypassed: return "optional modules off";
+        case Level::ExpensiveModesCapped   : return "expensive modes off" ;
+        LE_DEFAULT_CASE_UNREACHABLE();
+    }
+}
+
+
+LE_NOTHROW LE_COLD
+QualityOfService::QualityOfService()
+    :
+    enabled_            ( false ),
+    targetLevel_        ( static_cast<std::uint8_t>( Level::Full ) ),
+    load_               ( 0     ),
+    overloadedCallbacks_( 0     ),
+    headroomSamples_    ( 0     ),
+    samplesSinceChange_ ( 0     ),
+    recoveryBackoff_    ( 0     ),
+    recovered_          ( false ),
+    reduceOverlap_      ( false ),
+    overlapReduced_     ( false ),
+    userOverlapFactor_  ( 0     )
+{}
+
+
+LE_COLD
+void QualityOfService::enable( bool const enable )
+{
+    // Implementation note:
+    //   Only the atomic state is touched here, the audio thread counters are
+    // left for update() to reset with the next level change.
+    if ( !enable )
+        targetLevel_.store( static_cast<std::uint8_t>( Level::Full ), std::memory_order_release );
+    enabled_.store( enable, std::memory_order_relaxed );
+}
+
+
+LE_NOTHROWNOALIAS LE_HOT
+bool QualityOfService::update( Clock::duration const processingTime, std::uint32_t const samples, float const sampleRate )
+{
+    BOOST_ASSERT( enabled() );
+    if ( BOOST_UNLIKELY( !samples ) )
+        return false;
+
+    using seconds = std::chrono::duration<float>;
+    float const budget( samples / sampleRate                                              );
+    float const load  ( std::chrono::duration_cast<seconds>( processingTime ).count() / budget );
+    load_.store( load, std::memory_order_relaxed );
+
+    std::uint32_t const settleSamples  ( static_cast<std::uint32_t>( settleSeconds   * sampleRate )                    );
+    std::uint32_t const recoverySamples( static_cast<std::uint32_t>( recoverySeconds * sampleRate ) << recoveryBackoff_ );
+
+    samplesSinceChange_ = std::min( samplesSinceChange_ + samples, std::numeric_limits<std::uint32_t>::max() - samples );
+
+    auto const level( static_cast<std::uint8_t>( targetLevel() ) );
+
+    if ( load > overloadThreshold )
+    {
+        headroomSamples_ = 0;
+        if ( ++overloadedCallbacks_ < overloadedCallbacks || samplesSinceChange_ < settleSamples )
+            return false;
+        if ( level == static_cast<std::uint8_t>( Level::Lowest ) )
+            return false;
+        // Falling right back after a step up: the restored level cannot be
+        // sustained so wait longer before trying it again.
+        if ( recovered_ && ( samplesSinceChange_ < recoverySamples ) && ( recoveryBackoff_ < maximumBackoff ) )
+            ++recoveryBackoff_;
+        setTargetLevel( static_cast<Level>( level + 1 ) );
+        return true;
+    }
+
+    overloadedCallbacks_ = 0;
+    if ( load < headroomThreshold )
+    {
+        headroomSamples_ += samples;
+        if ( headroomSamples_ >= recoverySamples )
+        {
+            if ( level == static_cast<std::uint8_t>( Level::Full ) )
+            {
+                // Full quality has been sustained long enough to forget past
+                // failed recoveries.
+                recoveryBackoff_ = 0;
+                headroomSamples_ = 0;
+                return false;
+            }
+            setTargetLevel( static_cast<Level>( level - 1 ) );
+            return true;
+        }
+    }
+    else
+    {
+        headroomSamples_ = 0;
+    }
+    return false;
+}
+
+
+void QualityOfService::setTargetLevel( Level const level )
+{
+    recovered_ = level < targetLevel();
+    targetLevel_.store( static_cast<std::uint8_t>( level ), std::memory_order_release );
+    overloadedCallbacks_ = 0;
+    headroomSamples_     = 0;
+    samplesSinceChange_  = 0;
+}
+
+
+std::uint8_t QualityOfService::effectiveOverlapFactor( std::uint8_t const userOverlapFactor ) const
+{
+    if ( !reduceOverlap_ )
+        return userOverlapFactor;
+    // Overlap factors below 2 (no overlap) break the WOLA reconstruction.
+    return std::max<std::uint8_t>( userOverlapFactor / 2, std::min<std::uint8_t>( userOverlapFactor, 2 ) );
+}
+
+
+void QualityOfService::commitOverlapFactor( std::uint8_t const userOverlapFactor )
+{
+    overlapReduced_    = reduceOverlap_;
+    userOverlapFactor_ = userOverlapFactor;
+}
+
+
+std::uint8_t QualityOfService::rollbackOverlapFactor( std::uint8_t const setupOverlapFactor )
+{
+    reduceOverlap_ = overlapReduced_;
+    return overlapReduced_ ? userOverlapFactor_ : setupOverlapFactor;
+}
+
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file qualityOfService.hpp
+/// --------------------------
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef qualityOfService_hpp__3B0E5C2A_7D14_4F6B_9A1E_C8F2D5A06B73
+#define qualityOfService_hpp__3B0E5C2A_7D14_4F6B_9A1E_C8F2D5A06B73
+#pragma once
+//------------------------------------------------------------------------------
+#include "le/utility/platformSpecifics.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class QualityOfService
+///
+/// \brief Opt-in adaptive load shedding controller.
+///
+///   Compares the time spent in each process() call against the real-time
+/// budget of the processed block (its duration at the current sample rate,
+/// measured with the same std::chrono::steady_clock time base used by the
+/// DSPProfiler) and, while the engine is overloaded, lowers the quality level
+/// one step at a time in the order given by the Level enum. Once the load
+/// drops well below the budget and stays there for the recovery period the
+/// levels are restored one by one (the recovery period doubles each time a
+/// restored level immediately overloads the engine again).
+///
+///   update() is the only member function called from the audio thread and
+/// it is wait-free. It only publishes the target level, the levels that need
+/// memory reallocation (the overlap factor reduction) are applied by the
+/// owner from a non real-time thread.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class QualityOfService
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum struct Level : std::uint8_t
+    {
+        Full                   , ///< no degradation
+        ReducedOverlap         , ///< overlap factor halved (down to 2)
+        OptionalModulesBypassed, ///< + modules flagged as optional bypassed
+        ExpensiveModesCapped   , ///< + Engine::Setup::reducedQuality() set (conversions capped to Math::FineConversion)
+
+        Lowest = ExpensiveModesCapped
+    };
+
+    static LE_NOTHROWNOALIAS char const * LE_FASTCALL levelName( Level );
+
+public:
+    LE_NOTHROW QualityOfService();
+
+    void enable ( bool enable );
+    bool enabled() const { return enabled_.load( std::memory_order_relaxed ); }
+
+    /// Returns true if the target level changed.
+    LE_NOTHROWNOALIAS bool LE_FASTCALL update( Clock::duration processingTime, std::uint32_t samples, float sampleRate );
+
+    Level targetLevel() const { return static_cast<Level>( targetLevel_.load( std::memory_order_acquire ) ); }
+
+    /// Load (processing time to real-time budget ratio) of the most recent
+    /// process() call.
+    float load() const { return load_.load( std::memory_order_relaxed ); }
+
+    static bool shedOptionalModules( Level const level ) { return level >= Level::OptionalModulesBypassed; }
+    static bool capExpensiveModes  ( Level const level ) { return level >= Level::ExpensiveModesCapped   ; }
+
+public: // Overlap factor reduction (process lock protected).
+    std::uint8_t effectiveOverlapFactor( std::uint8_t userOverlapFactor ) const;
+
+    bool overlapReductionPending( Level const level ) const { return reduceOverlap( level ) != overlapReduced_; }
+    void requestOverlapReduction( Level const level )       { reduceOverlap_ = reduceOverlap( level ); }
+
+    void         commitOverlapFactor  ( std::uint8_t userOverlapFactor );
+    std::uint8_t rollbackOverlapFactor( std::uint8_t setupOverlapFactor );
+
+private:
+    static bool reduceOverlap( Level const level ) { return level >= Level::ReducedOverlap; }
+
+    void setTargetLevel( Level );
+
+private:
+    std::atomic<bool         > enabled_    ;
+    std::atomic<std::uint8_t > targetLevel_;
+    std::atomic<float        > load_       ;
+
+    // Audio thread only state:
+    std::uint8_t  overloadedCallbacks_;
+    std::uint32_t headroomSamples_    ;
+    std::uint32_t samplesSinceChange_ ;
+    std::uint8_t  recoveryBackoff_    ;
+    bool          recovered_          ; // the last level change was a step up
+
+    // Process lock protected state:
+    bool         reduceOverlap_    ;
+    bool         overlapReduced_   ;
+    std::uint8_t userOverlapFactor_;
+}; // class QualityOfService
+
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // qualityOfService_hpp
@@ -12,6 +12,8 @@ set( SOURCES_Core
     core/automatedModuleChain.cpp
     core/automatedModuleChain.hpp
     core/parameterID.hpp
+    core/qualityOfService.cpp
+    core/qualityOfService.hpp
     core/spectrumWorxSharedImpl.hpp
     core/spectrumWorxSharedImpl.inl
     core/spectrumWorxCore.cpp
@@ -43,6 +45,8 @@ set( SOURCES_Core_Modules
     core/modules/finalImplementations.hpp
     core/modules/factory.cpp
     core/modules/factory.hpp
+    core/modules/modulePool.cpp
+    core/modules/modulePool.hpp
 )
 source_group( "Core\\Modules" FILES ${SOURCES_Core_Modules} core/modules/moduleGUI.cpp core/modules/moduleGUI.hpp core/modules/moduleDSPAndGUI.cpp core/modules/moduleDSPAndGUI.hpp )
 set( SOURCES_Core
@@ -92,6 +96,8 @@ set(SOURCES_Externals__Effects
 #...mrmlj...clean this up...use Utility as a separate library
 set(SOURCES_Externals__Utility
     ${leExternals}/utility/assertionHandler.cpp
+    ${leExternals}/utility/binaryTrace.cpp
+    ${leExternals}/utility/binaryTrace.hpp
     ${leExternals}/utility/buffers.hpp
     ${leExternals}/utility/clear.hpp
     ${leExternals}/utility/countof.hpp
@@ -130,6 +136,7 @@ source_group("Externals\\Utility" FILES ${SOURCES_Externals__Utility})
 set(SOURCES_Externals__Engine
     ${leExternals}/spectrumworx/engine/automatableParameters.hpp
     ${leExternals}/spectrumworx/engine/automatableParameters.cpp
+    ${leExternals}/spectrumworx/engine/binKernels.hpp
     ${leExternals}/spectrumworx/engine/buffers.hpp
     ${leExternals}/spectrumworx/engine/channelBuffers.hpp
     ${leExternals}/spectrumworx/engine/channelBuffers.cpp
@@ -140,6 +147,7 @@ set(SOURCES_Externals__Engine
     ${leExternals}/spectrumworx/engine/channelDataReIm.hpp
     ${leExternals}/spectrumworx/engine/channelDataReIm.cpp
     ${leExternals}/spectrumworx/engine/channelData_fwd.hpp
+    ${leExternals}/spectrumworx/engine/effectTraits.hpp
     ${leExternals}/spectrumworx/engine/module.hpp
     ${leExternals}/spectrumworx/engine/module.cpp
     ${leExternals}/spectrumworx/engine/moduleBase.hpp
@@ -149,12 +157,22 @@ set(SOURCES_Externals__Engine
     ${leExternals}/spectrumworx/engine/moduleChainImpl.hpp
     ${leExternals}/spectrumworx/engine/moduleChainImpl.cpp
     ${leExternals}/spectrumworx/engine/moduleNode.hpp
+    ${leExternals}/spectrumworx/engine/parameterEvents.hpp
+    ${leExternals}/spectrumworx/engine/parameterEvents.cpp
     ${leExternals}/spectrumworx/engine/parameters.hpp
     ${leExternals}/spectrumworx/engine/parameters.cpp
     ${leExternals}/spectrumworx/engine/processor.hpp
     ${leExternals}/spectrumworx/engine/processor.cpp
+    ${leExternals}/spectrumworx/engine/resolutionLayers.hpp
+    ${leExternals}/spectrumworx/engine/resolutionLayers.cpp
+    ${leExternals}/spectrumworx/engine/scratchArena.hpp
     ${leExternals}/spectrumworx/engine/setup.hpp
     ${leExternals}/spectrumworx/engine/setup.cpp
+    ${leExternals}/spectrumworx/engine/spectralEnvelope.hpp
+    ${leExternals}/spectrumworx/engine/spectralEnvelope.cpp
+    ${leExternals}/spectrumworx/engine/spectralFeatures.hpp
+    ${leExternals}/spectrumworx/engine/spectralFeatures.cpp
+    ${leExternals}/spectrumworx/engine/staticChain.hpp
 )
 source_group("Externals\\Engine" FILES ${SOURCES_Externals__Engine})
 
@@ -169,6 +187,7 @@ set(SOURCES_Externals__Math
     ${leExternals}/math/conversion.hpp
     ${leExternals}/math/math.cpp
     ${leExternals}/math/math.hpp
+    ${leExternals}/math/pcmConversion.hpp
     ${leExternals}/math/vector.cpp
     ${leExternals}/math/vector.hpp
     ${leExternals}/math/windows.cpp
@@ -308,6 +327,8 @@ set(SOURCES_Externals__Analysis
     ${leExternals}/analysis/musical_scales/musicalScales.hpp
     ${leExternals}/analysis/peak_detector/peakDetector.cpp
     ${leExternals}/analysis/peak_detector/peakDetector.hpp
+    ${leExternals}/analysis/pitch_detector/pitchCurve.cpp
+    ${leExternals}/analysis/pitch_detector/pitchCurve.hpp
     ${leExternals}/analysis/pitch_detector/pitchDetector.cpp
     ${leExternals}/analysis/pitch_detector/pitchDetector.hpp
 )
@@ -14,6 +14,7 @@
 #else
     #include "modules/moduleDSP.hpp"
 #endif // LE_SW_SEPARATED_DSP_GUI
+#include "modules/factory.hpp"
 
 #include "le/math/conversion.hpp"
 #include "le/math/math.hpp"
@@ -33,6 +34,7 @@
     #include <windows.h> // CRITICAL_SECTION
 #endif
 
+#include <algorithm>
 #include <cstdlib>
 #include <ctime>
 //------------------------------------------------------------------------------
@@ -53,6 +55,7 @@ namespace GUI
 namespace Engine
 {
     ModuleChainImpl & Processor::modules() { return SpectrumWorxCore::modules( *this ); }
+    std::uint32_t Processor::effectsScratchStorage( StorageFactors const & factors ) { return ModuleFactory::maximumScratchStorage( factors ); }
 } // namespace Engine
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -74,6 +77,8 @@ char const SpectrumWorxCore::productString[] = "SpectrumWorx (Little Endian Ltd.
 
 LE_NOTHROW
 SpectrumWorxCore::SpectrumWorxCore()
+    :
+    reportedQualityLevel_( QualityOfService::Level::Full )
 {
 #ifndef NDEBUG
     Utility::Tracer::pTagString = "SW";
@@ -110,6 +115,15 @@ void SpectrumWorxCore::process /// \throws nothing
         return;
     ProcessLockUnlocker const processingLockUnlocker( *this );
 
+    QualityOfService::Clock::time_point processingStart;
+    bool const measureLoad( qualityOfService_.enabled() );
+    if ( measureLoad )
+        processingStart = QualityOfService::Clock::now();
+    {
+        auto const qualityLevel( qualityOfService_.targetLevel() );
+        Engine::Processor::setLoadShedding( QualityOfService::shedOptionalModules( qualityLevel ), QualityOfService::capExpensiveModes( qualityLevel ) );
+    }
+
 #ifdef _DEBUG
     // Implementation note:
     //   To aid in algorithm debugging we locally enable FPU exceptions.
@@ -149,6 +163,9 @@ void SpectrumWorxCore::process /// \throws nothing
         parameters().get<MixPercentage>()
     );
 
+    if ( measureLoad )
+        qualityOfService_.update( QualityOfService::Clock::now() - processingStart, samples, engineSetup().sampleRate<float>() );
+
 #ifdef _DEBUG
     }
     catch ( ... )
@@ -332,6 +349,17 @@ bool SpectrumWorxCore::setNumberOfChannelsImpl( std::uint8_t const numberOfMainC
     return true;
 }
 
+LE_NOTHROW
+bool SpectrumWorxCore::setResolutionLayers( std::uint8_t const numberOfLayers )
+{
+    BOOST_ASSERT( currentThreadOwnsTheProcessLock() );
+    BOOST_ASSERT( numberOfLayers >= 1 && numberOfLayers <= Engine::Constants::maximumResolutionLayers );
+
+    Engine::StorageFactors newStorageFactors( currentStorageFactors() );
+    newStorageFactors.resolutionLayers = numberOfLayers;
+    return resize( newStorageFactors );
+}
+
 LE_NOTHROW
 bool SpectrumWorxCore::checkChannelConfiguration( std::uint8_t const numberOfInputChannels, std::uint8_t const numberOfOutputChannels )
 {
@@ -411,7 +439,7 @@ bool SpectrumWorxCore::isEngineSetupUpToDate() const
     return
     (
         ( uncheckedEngineSetup().fftSize                <unsigned int>() == parameters.get<FFTSize         >() ) &&
-        ( uncheckedEngineSetup().windowOverlappingFactor<unsigned int>() == parameters.get<OverlapFactor   >() )
+        ( uncheckedEngineSetup().windowOverlappingFactor<unsigned int>() == qualityOfService_.effectiveOverlapFactor( parameters.get<OverlapFactor>() ) )
     #if LE_SW_ENGINE_WINDOW_PRESUM
      && ( uncheckedEngineSetup().windowSizeFactor                     () == parameters.get<WindowSizeFactor>() )
     #endif // LE_SW_ENGINE_WINDOW_PRESUM
@@ -493,18 +521,22 @@ bool SpectrumWorxCore::updateEngineSetup()
         #if LE_SW_ENGINE_WINDOW_PRESUM
             parameters.get<WindowSizeFactor>(),
         #endif // LE_SW_ENGINE_WINDOW_PRESUM
-            parameters.get<OverlapFactor   >(),
+            qualityOfService_.effectiveOverlapFactor( parameters.get<OverlapFactor>() ),
             setup.numberOfChannels          (),
+            std::max<std::uint8_t>( currentStorageFactors().resolutionLayers, 1 ),
             setup.sampleRate<std::uint32_t> ()
         )
     );
 
     if ( resize( storageFactors ) )
+    {
+        qualityOfService_.commitOverlapFactor( parameters.get<OverlapFactor>() );
         return true;
+    }
 
     // Restore previous settings on failure:
     parameters.set<FFTSize         >( setup.fftSize                <FFTSize      ::value_type>() );
-    parameters.set<OverlapFactor   >( setup.windowOverlappingFactor<OverlapFactor::value_type>() );
+    parameters.set<OverlapFactor   >( qualityOfService_.rollbackOverlapFactor( setup.windowOverlappingFactor<OverlapFactor::value_type>() ) );
 #if LE_SW_ENGINE_WINDOW_PRESUM
     parameters.set<WindowSizeFactor>( setup.windowSizeFactor                                  () );
 #endif // LE_SW_ENGINE_WINDOW_PRESUM
@@ -636,6 +668,64 @@ void SpectrumWorxCore::moveModule( std::uint8_t const sourceIndex, std::uint8_t
 }
 
 
+bool SpectrumWorxCore::updateQualityOfService()
+{
+    auto const level( qualityOfService_.targetLevel() );
+    if ( level == reportedQualityLevel_ )
+        return false;
+    reportedQualityLevel_ = level;
+
+    // Implementation note:
+    //   Only the overlap factor change requires taking the process lock (and
+    // thus possibly skipping an audio block) and reallocation. The remaining
+    // levels are applied by process() itself.
+    if ( qualityOfService_.overlapReductionPending( level ) && currentStorageFactors().complete() )
+    {
+        Utility::CriticalSectionLock const processLock( this->getProcessingLock() );
+        qualityOfService_.requestOverlapReduction( level );
+        bool const succeeded( updateEngineSetup() );
+        LE_TRACE_IF( !succeeded, "\tSW: failed to change the overlap factor for quality of service level %u.", unsigned( level ) );
+        boost::ignore_unused( succeeded );
+    }
+    return true;
+}
+
+
+LE_NOTHROW
+bool SpectrumWorxCore::scheduleModuleParameter
+(
+    std::uint8_t  const moduleIndex,
+    std::uint8_t  const parameterIndex,
+    float         const value,
+    bool          const continuous,
+    std::uint32_t const sampleOffset
+)
+{
+    if ( !processCriticalSection_.try_lock() )
+        return false;
+    ProcessLockUnlocker const processingLockUnlocker( *this );
+    return parameterEvents().schedule( moduleChain(), moduleIndex, parameterIndex, value, continuous, sampleOffset );
+}
+
+
+LE_NOTHROW
+bool SpectrumWorxCore::scheduleModuleParameterRamp
+(
+    std::uint8_t  const moduleIndex,
+    std::uint8_t  const parameterIndex,
+    float         const startValue,
+    float         const endValue,
+    std::uint32_t const sampleOffset,
+    std::uint32_t const duration
+)
+{
+    if ( !processCriticalSection_.try_lock() )
+        return false;
+    ProcessLockUnlocker const processingLockUnlocker( *this );
+    return parameterEvents().scheduleRamp( moduleChain(), moduleIndex, parameterIndex, startValue, endValue, sampleOffset, duration );
+}
+
+
 Utility::CriticalSectionLock LE_NOTHROW SpectrumWorxCore::getProcessingLock() const { return Utility::CriticalSectionLock( processCriticalSection_ ); }
 
 
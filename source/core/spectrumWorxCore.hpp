@@ -12,6 +12,7 @@
 #pragma once
 //------------------------------------------------------------------------------
 #include "automatedModuleChain.hpp"
+#include "qualityOfService.hpp"
 #include "configuration/versionConfiguration.hpp"
 #include "host_interop/host2Plugin.hpp"
 #include "host_interop/parameters.hpp"
@@ -135,6 +136,31 @@ public:
 
     static SpectrumWorxCore const & fromEngineSetup( Engine::Setup const & );
 
+public: // Multi-resolution mode (see Engine::ResolutionLayers, opt-in).
+    /// \note Has to be called with the process lock held.
+    bool LE_NOTHROW setResolutionLayers( std::uint8_t numberOfLayers );
+
+public: // Quality of service (adaptive load shedding, opt-in).
+    QualityOfService       & qualityOfService()       { return qualityOfService_; }
+    QualityOfService const & qualityOfService() const { return qualityOfService_; }
+
+    /// Applies the quality level changes published by the audio thread that
+    /// require reallocation and returns true if the level changed since the
+    /// previous call (so that the change can be reported to the GUI/client).
+    /// Must be called periodically from a non real-time thread while the
+    /// controller is enabled.
+    bool updateQualityOfService();
+
+public: // Sample accurate automation
+    /// Queues a change of a module parameter (indexed as in
+    /// ModuleBase::setParameter(), internal value) for the STFT hop that
+    /// contains the given sample offset of the next process() call. Returns
+    /// false if the change could not be queued (the process lock is held by
+    /// another thread or the queue is full) in which case the caller should
+    /// apply it immediately.
+    bool LE_NOTHROW scheduleModuleParameter    ( std::uint8_t moduleIndex, std::uint8_t parameterIndex, float value, bool continuous, std::uint32_t sampleOffset );
+    bool LE_NOTHROW scheduleModuleParameterRamp( std::uint8_t moduleIndex, std::uint8_t parameterIndex, float startValue, float endValue, std::uint32_t sampleOffset, std::uint32_t duration );
+
 protected:
     LE_NOTHROW  SpectrumWorxCore();
 #ifndef NDEBUG
@@ -341,6 +367,9 @@ private:
 
     Engine::StorageFactors    currentStorageFactors_;
     Engine::HeapSharedStorage sharedStorage_        ;
+
+    QualityOfService          qualityOfService_     ;
+    QualityOfService::Level   reportedQualityLevel_ ;
 }; // class SpectrumWorxCore
 
 
@@ -9,106 +9,252 @@
 //------------------------------------------------------------------------------
 #include "sample.hpp"
 
-#ifndef NDEBUG
-    #include "le/math/vector.hpp"
-#endif // NDEBUG
-#include "le/utility/criticalSection.hpp"
+#include "le/math/vector.hpp"
+
+#include "boost/simd/preprocessor/stack_buffer.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <new>
 //------------------------------------------------------------------------------
 namespace LE
 {
 //------------------------------------------------------------------------------
 
-char const * Sample::load( juce::File const & sampleFile, unsigned int const desiredSampleRate, Utility::CriticalSection & criticalSection )
+namespace
 {
-    DataHolder newData;
-    char const * const pErrorString( doLoad( sampleFile.getFullPathName(), desiredSampleRate, newData ) );
-    if ( !pErrorString )
+    /// \note The amount of (already converted and resampled) data kept ahead
+    /// of the audio thread and the period in which the prefetch thread tops it
+    /// up. The ratio leaves plenty of headroom for a descheduled prefetch
+    /// thread while still costing only a fraction of a fully decoded sample.
+    unsigned int const ringBufferMilliseconds    = 500;
+    unsigned int const prefetchPeriodMilliseconds =  20;
+
+    /// Maximum number of output frames produced in one prefetch step.
+    std::uint16_t const prefetchBlockFrames = 512;
+    /// Maximum supported downsampling ratio (source rate / target rate).
+    std::uint8_t  const maximumResamplingRatio = 8;
+    std::uint32_t const sourceBlockFrames      = prefetchBlockFrames * maximumResamplingRatio + 2;
+
+    std::uint64_t const fixedPointOne = std::uint64_t( 1 ) << 32;
+} // anonymous namespace
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Sample::PrefetchThread
+//
+////////////////////////////////////////////////////////////////////////////////
+
+class Sample::PrefetchThread : public juce::Thread
+{
+public:
+    PrefetchThread( Sample & sample ) : juce::Thread( "Sample prefetch thread" ), sample_( sample ) {}
+
+private:
+    void run() override
+    {
+        while ( !threadShouldExit() )
+        {
+            sample_.prefetch();
+            wait( prefetchPeriodMilliseconds );
+        }
+    }
+
+private:
+    Sample & sample_;
+}; // class Sample::PrefetchThread
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Sample
+//
+////////////////////////////////////////////////////////////////////////////////
+
+Sample::Sample()
+    :
+    pPublishedStream_( nullptr ),
+    pStreamInUse_    ( nullptr ),
+    underruns_       ( 0       )
+{}
+
+
+Sample::~Sample()
+{
+    // Implementation note:
+    //   A negative timeout makes JUCE signal the thread and wait for it to
+    // exit instead of force-killing it (possibly while it holds the stream
+    // ownership lock or is in the middle of a file read).
+    if ( pPrefetchThread_ )
+        pPrefetchThread_->stopThread( -1 );
+    publish( nullptr );
+}
+
+
+char const * Sample::load( juce::File const & sampleFile, unsigned int const desiredSampleRate )
+{
+    std::unique_ptr<Stream> pNewStream( new ( std::nothrow ) Stream( desiredSampleRate * ringBufferMilliseconds / 1000 ) );
+    if ( !pNewStream )
+        return "Out of memory";
+
+    juce::String const fileName( sampleFile.getFullPathName() );
+
+    // Implementation note:
+    //   WAVE files are streamed straight from the memory mapped file while
+    // other formats (and WAVE variants unsupported by AudioIO::InputWaveFile)
+    // fall back to the platform specific decoders that decode the whole file
+    // up front.
+    if ( pNewStream->openWAVE( fileName, desiredSampleRate ) )
     {
-        Utility::CriticalSectionLock const lock( criticalSection );
-        this->sampleFile_ = sampleFile;
-        this->data_.takeDataFrom( newData );
         // Implementation note:
-        //   The sample position has to be cleared while we still hold the lock
-        // otherwise race conditions (and thus crashes) occur.
-        //                                    (18.06.2010.) (Domagoj Saric)
-        /// \todo Think of a cleaner solution where the Sample class knows
-        /// nothing about critical sections and threading issues.
-        ///                                   (22.09.2010.) (Domagoj Saric)
-        samplePosition_ = 0;
-
-        // Assert something was actually read.
-        BOOST_ASSERT( !channel1().empty() );
-
-        // Assert all channels are of equal size.
-        BOOST_ASSERT( channel1().size() == channel2().size() );
-
-        /// \todo The Mac loader seems to return out-of-dynamic-range samples
-        /// when loading MP3 files. Investigate.
-        ///                                   (29.09.2010.) (Domagoj Saric)
-        float const maximumAbsoluteValue
-        (
-            #ifdef __APPLE__
-                1.15f
-            #else
-                1.00f
-            #endif // __APPLE__
-        );
-
-        // Assert data was correctly read (all values are in the normalised range).
-        BOOST_ASSERT( Math::max( channel1() ) <= +maximumAbsoluteValue );
-        BOOST_ASSERT( Math::max( channel2() ) <= +maximumAbsoluteValue );
-        BOOST_ASSERT( Math::min( channel1() ) >= -maximumAbsoluteValue );
-        BOOST_ASSERT( Math::min( channel2() ) >= -maximumAbsoluteValue );
-
-        boost::ignore_unused_variable_warning( maximumAbsoluteValue );
+        //   Fully decoded samples are shared (through the SampleCache) by all
+        // the instances that use the same file at the same sample rate.
+        SampleCache::Key      const cacheKey    ( SampleCache::Key::create( sampleFile, desiredSampleRate ) );
+        SampleCache::EntryPtr       pDecodedData( SampleCache::find( cacheKey )                             );
+        if ( !pDecodedData )
+        {
+            DataHolder decodedData;
+            char const * const pErrorString( doLoad( fileName, desiredSampleRate, decodedData ) );
+            if ( pErrorString )
+                return pErrorString;
+
+            // Assert something was actually read.
+            BOOST_ASSERT( !decodedData.channel( 0 ).empty() );
+
+            // Assert all channels are of equal size.
+            BOOST_ASSERT( decodedData.channel( 0 ).size() == decodedData.channel( 1 ).size() );
+
+            /// \todo The Mac loader seems to return out-of-dynamic-range samples
+            /// when loading MP3 files. Investigate.
+            ///                                   (29.09.2010.) (Domagoj Saric)
+            float const maximumAbsoluteValue
+            (
+                #ifdef __APPLE__
+                    1.15f
+                #else
+                    1.00f
+                #endif // __APPLE__
+            );
+
+            // Assert data was correctly read (all values are in the normalised range).
+            BOOST_ASSERT( Math::max( decodedData.channel( 0 ) ) <= +maximumAbsoluteValue );
+            BOOST_ASSERT( Math::max( decodedData.channel( 1 ) ) <= +maximumAbsoluteValue );
+            BOOST_ASSERT( Math::min( decodedData.channel( 0 ) ) >= -maximumAbsoluteValue );
+            BOOST_ASSERT( Math::min( decodedData.channel( 1 ) ) >= -maximumAbsoluteValue );
+
+            boost::ignore_unused_variable_warning( maximumAbsoluteValue );
+
+            pDecodedData = SampleCache::insert( cacheKey, decodedData.channel( 0 ), decodedData.channel( 1 ) );
+            if ( !pDecodedData )
+                return "Out of memory";
+        }
+        pNewStream->useCached( std::move( pDecodedData ) );
+    }
+
+    // Prime the ring buffer before the stream becomes visible to the audio
+    // thread.
+    while ( pNewStream->prefetch() ) {}
+
+    if ( !pPrefetchThread_ )
+    {
+        pPrefetchThread_ = new ( std::nothrow ) PrefetchThread( *this );
+        if ( !pPrefetchThread_ )
+            return "Out of memory";
+        pPrefetchThread_->startThread( 2 );
     }
-    return pErrorString;
+
+    publish( pNewStream.release() );
+    sampleFile_ = sampleFile;
+    return nullptr;
 }
 
 
 void Sample::clear()
 {
-    data_.pBuffer.reset();
-    //samplePosition_ = 0;
+    publish( nullptr );
     sampleFile_ = juce::File::nonexistent;
 }
 
 
-Sample::ChannelData Sample::channel( unsigned int const index ) const
-{ //...mrmlj...think of a smarter solution (to provide true indexed channel access)...
-    switch ( index )
+void Sample::publish( Stream * const pNewStream )
+{
+    Utility::CriticalSectionLock const lock( streamOwnershipLock_ );
+    Stream * const pPreviousStream( pPublishedStream_.exchange( pNewStream ) );
+    if ( !pPreviousStream )
+        return;
+    // Wait for the audio thread to let go of the previous stream (it can
+    // hold it for at most one process() call).
+    while ( pStreamInUse_.load() == pPreviousStream )
+        juce::Thread::yield();
+    delete pPreviousStream;
+}
+
+
+Sample::Stream * Sample::acquireStream()
+{
+    Stream * pStream( pPublishedStream_.load() );
+    for ( ; ; )
     {
-        case 0: return channel1();
-        case 1: return channel2();
-        LE_DEFAULT_CASE_UNREACHABLE();
+        pStreamInUse_.store( pStream );
+        Stream * const pCurrentStream( pPublishedStream_.load() );
+        if ( BOOST_LIKELY( pCurrentStream == pStream ) )
+            return pStream;
+        pStream = pCurrentStream;
     }
 }
 
 
-Sample::ChannelData Sample::channel1() const
+void Sample::releaseStream()
 {
-    return ChannelData( data_.pBuffer.get(), data_.pChannel1End );
+    pStreamInUse_.store( nullptr, std::memory_order_release );
 }
 
 
-Sample::ChannelData Sample::channel2() const
+void Sample::prefetch()
 {
-    return ChannelData( data_.pChannel2Beginning, data_.pChannel2End );
+    Utility::CriticalSectionLock const lock( streamOwnershipLock_ );
+    if ( Stream * const pStream = pPublishedStream_.load( std::memory_order_relaxed ) )
+        while ( pStream->prefetch() ) {}
 }
 
 
-unsigned int & Sample::samplePosition()
+LE_NOTHROWNOALIAS
+bool Sample::read( float * LE_RESTRICT const * const pOutputs, std::uint8_t const numberOfChannels, std::uint16_t const sampleFrames )
 {
-    BOOST_ASSERT( *this ); return samplePosition_;
+    Stream * const pStream( acquireStream() );
+    std::uint16_t const framesRead
+    (
+        pStream
+            ? pStream->read( pOutputs, numberOfChannels, sampleFrames )
+            : 0
+    );
+    releaseStream();
+
+    if ( BOOST_UNLIKELY( framesRead != sampleFrames ) )
+    {
+        if ( pStream )
+            underruns_.fetch_add( 1, std::memory_order_relaxed );
+        for ( std::uint8_t channel( 0 ); channel < numberOfChannels; ++channel )
+            Math::clear( &pOutputs[ channel ][ framesRead ], sampleFrames - framesRead );
+    }
+    return pStream != nullptr;
 }
 
 
 void Sample::restart()
 {
-    samplePosition_ = 0;
+    Utility::CriticalSectionLock const lock( streamOwnershipLock_ );
+    if ( Stream * const pStream = pPublishedStream_.load( std::memory_order_relaxed ) )
+        pStream->rewind();
 }
 
 
+Sample::operator bool() const { return pPublishedStream_.load( std::memory_order_relaxed ) != nullptr; }
+
+
 bool Sample::DataHolder::recreate( std::size_t const newSizeInSamplesPerChannel )
 {
     pBuffer.reset( new (std::nothrow) float[ newSizeInSamplesPerChannel * fixedNumberOfChannels ] );
@@ -120,24 +266,190 @@ bool Sample::DataHolder::recreate( std::size_t const newSizeInSamplesPerChannel
 }
 
 
-void Sample::DataHolder::takeDataFrom( DataHolder & other )
+Sample::ChannelData Sample::DataHolder::channel( std::uint8_t const index ) const
+{
+    switch ( index )
+    {
+        case 0: return ChannelData( pBuffer.get()     , pChannel1End );
+        case 1: return ChannelData( pChannel2Beginning, pChannel2End );
+        LE_DEFAULT_CASE_UNREACHABLE();
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Sample::Stream
+//
+////////////////////////////////////////////////////////////////////////////////
+
+Sample::Stream::Stream( std::uint32_t const ringCapacityInFrames )
+    :
+    sourceFrames_  ( 0            ),
+    sourceChannels_( 0            ),
+    position_      ( 0            ),
+    step_          ( fixedPointOne ),
+    ring_          ( ringCapacityInFrames * fixedNumberOfChannels )
+{}
+
+
+char const * Sample::Stream::openWAVE( juce::String const & fileName, unsigned int const desiredSampleRate )
+{
+    char const * const pErrorString( wave_.open<Utility::AbsolutePath>( fileName.toUTF8() ) );
+    if ( pErrorString )
+        return pErrorString;
+
+    if ( wave_.sampleRate() > desiredSampleRate * maximumResamplingRatio )
+    {
+        wave_.close();
+        return "Unsupported sample rate";
+    }
+
+    sourceFrames_   = wave_.lengthInSampleFrames();
+    sourceChannels_ = wave_.numberOfChannels    ();
+    step_           = ( std::uint64_t( wave_.sampleRate() ) << 32 ) / desiredSampleRate;
+    return sourceFrames_ ? nullptr : "Empty file";
+}
+
+
+void Sample::Stream::useCached( SampleCache::EntryPtr pDecodedData )
+{
+    pDecoded_.swap( pDecodedData );
+
+    sourceFrames_   = pDecoded_->lengthInFrames();
+    sourceChannels_ = fixedNumberOfChannels;
+    // Platform decoders already resample to the target rate.
+    step_           = fixedPointOne;
+}
+
+
+/// \note Decodes <VAR>frames</VAR> consecutive (looped) source frames into
+/// interleaved stereo, expanding mono and dropping channels above stereo.
+std::uint32_t Sample::Stream::decodeSourceBlock( std::uint32_t firstFrame, float * LE_RESTRICT pInterleavedStereo, std::uint32_t frames )
 {
-    pBuffer.swap( other.pBuffer );
-    pChannel1End       = other.pChannel1End      ;
-    pChannel2Beginning = other.pChannel2Beginning;
-    pChannel2End       = other.pChannel2End      ;
+    BOOST_ASSERT( frames     <= sourceBlockFrames );
+    BOOST_ASSERT( firstFrame <  sourceFrames_     );
+    std::uint32_t const decodedFrames( frames );
+    while ( frames )
+    {
+        std::uint32_t const chunk( std::min( frames, sourceFrames_ - firstFrame ) );
+        if ( pDecoded_ )
+        {
+            float const * LE_RESTRICT const pLeft ( pDecoded_->channel( 0 ).begin() + firstFrame );
+            float const * LE_RESTRICT const pRight( pDecoded_->channel( 1 ).begin() + firstFrame );
+            for ( std::uint32_t frame( 0 ); frame < chunk; ++frame )
+            {
+                *pInterleavedStereo++ = pLeft [ frame ];
+                *pInterleavedStereo++ = pRight[ frame ];
+            }
+        }
+        else
+        {
+            BOOST_SIMD_ALIGNED_SCOPED_STACK_BUFFER( rawFrames, float, chunk * sourceChannels_ );
+            // (sequential blocks continue from the file's read cursor, seek
+            // only when the loop wraps or playback jumped)
+            if ( wave_.getSamplePosition() != firstFrame )
+                wave_.setSamplePosition( firstFrame );
+            BOOST_VERIFY( wave_.read( rawFrames.begin(), chunk ) == chunk );
+            std::uint8_t const rightChannelOffset( sourceChannels_ > 1 ? 1 : 0 );
+            float const * LE_RESTRICT pRaw( rawFrames.begin() );
+            for ( std::uint32_t frame( 0 ); frame < chunk; ++frame )
+            {
+                *pInterleavedStereo++ = pRaw[ 0                  ];
+                *pInterleavedStereo++ = pRaw[ rightChannelOffset ];
+                pRaw += sourceChannels_;
+            }
+        }
+        frames     -= chunk;
+        firstFrame  = 0;
+    }
+    return decodedFrames;
+}
+
 
-    // Catch (incorrect) subsequent usage of 'other' (now in undefined state).
-    #ifndef NDEBUG
-        other.pBuffer.reset();
-        other.pChannel1End       = 0;
-        other.pChannel2Beginning = 0;
-        other.pChannel2End       = 0;
-    #endif // NDEBUG
+bool Sample::Stream::prefetch()
+{
+    std::uint32_t frames( static_cast<std::uint32_t>( ring_.write_available() / fixedNumberOfChannels ) );
+    if ( frames < prefetchBlockFrames / 4 )
+        return false;
+    frames = std::min<std::uint32_t>( frames, prefetchBlockFrames );
+
+    // Source frames required to linearly interpolate 'frames' output frames.
+    std::uint32_t const firstSourceFrame( static_cast<std::uint32_t>( position_ >> 32 ) );
+    std::uint32_t const lastSourceFrame ( static_cast<std::uint32_t>( ( position_ + ( frames - 1 ) * step_ ) >> 32 ) + 1 );
+    std::uint32_t const sourceFrames    ( lastSourceFrame - firstSourceFrame + 1 );
+
+    LE_ALIGN( 16 ) float source[ sourceBlockFrames   * fixedNumberOfChannels ];
+    LE_ALIGN( 16 ) float output[ prefetchBlockFrames * fixedNumberOfChannels ];
+
+    decodeSourceBlock( firstSourceFrame, source, sourceFrames );
+
+    std::uint64_t       relativePosition( position_ - ( std::uint64_t( firstSourceFrame ) << 32 ) );
+    std::uint64_t const loopLength      ( std::uint64_t( sourceFrames_ ) << 32 );
+    float * LE_RESTRICT pOutput( output );
+    for ( std::uint32_t frame( 0 ); frame < frames; ++frame )
+    {
+        std::uint32_t const index   ( static_cast<std::uint32_t>( relativePosition >> 32 ) );
+        float         const fraction( static_cast<float>( relativePosition & ( fixedPointOne - 1 ) ) * ( 1.0f / fixedPointOne ) );
+        float const * LE_RESTRICT const pCurrent( &source[ index * fixedNumberOfChannels ] );
+        float const * LE_RESTRICT const pNext   ( pCurrent + fixedNumberOfChannels        );
+        *pOutput++ = pCurrent[ 0 ] + fraction * ( pNext[ 0 ] - pCurrent[ 0 ] );
+        *pOutput++ = pCurrent[ 1 ] + fraction * ( pNext[ 1 ] - pCurrent[ 1 ] );
+        relativePosition += step_;
+    }
+
+    // (a sample shorter than a prefetch block wraps more than once)
+    position_ += frames * step_;
+    position_ %= loopLength;
+
+    BOOST_VERIFY( ring_.push( output, frames * fixedNumberOfChannels ) == frames * fixedNumberOfChannels );
+    return true;
+}
+
+
+LE_NOTHROWNOALIAS
+std::uint16_t Sample::Stream::read( float * LE_RESTRICT const * const pOutputs, std::uint8_t const numberOfChannels, std::uint16_t const sampleFrames )
+{
+    BOOST_ASSERT( numberOfChannels <= fixedNumberOfChannels );
+
+    std::uint16_t const chunkFrames( 256 );
+    LE_ALIGN( 16 ) float interleaved[ chunkFrames * fixedNumberOfChannels ];
+
+    std::uint16_t framesRead( 0 );
+    while ( framesRead < sampleFrames )
+    {
+        std::uint16_t const framesToRead( std::min<std::uint16_t>( sampleFrames - framesRead, chunkFrames ) );
+        // The producer always pushes whole (stereo) frames in a single push()
+        // call so the available amount is always a multiple of the number of
+        // channels.
+        auto const samplesPopped( ring_.pop( interleaved, framesToRead * fixedNumberOfChannels ) );
+        BOOST_ASSERT( samplesPopped % fixedNumberOfChannels == 0 );
+        auto const framesPopped( static_cast<std::uint16_t>( samplesPopped / fixedNumberOfChannels ) );
+        if ( numberOfChannels == fixedNumberOfChannels )
+        {
+            float * LE_RESTRICT const outputs[ fixedNumberOfChannels ] = { pOutputs[ 0 ] + framesRead, pOutputs[ 1 ] + framesRead };
+            Math::deinterleave( interleaved, outputs, framesPopped, fixedNumberOfChannels );
+        }
+        else
+        {
+            BOOST_ASSERT( numberOfChannels == 1 );
+            for ( std::uint16_t frame( 0 ); frame < framesPopped; ++frame )
+                pOutputs[ 0 ][ framesRead + frame ] = interleaved[ frame * fixedNumberOfChannels ];
+        }
+        framesRead += framesPopped;
+        if ( framesPopped != framesToRead )
+            break;
+    }
+    return framesRead;
 }
 
 
-Sample::operator bool() const { return data_.pBuffer.get() != nullptr; }
+void Sample::Stream::rewind()
+{
+    ring_.reset();
+    position_ = 0;
+    while ( prefetch() ) {}
+}
 
 //------------------------------------------------------------------------------
 } // namespace LE
@@ -11,18 +11,21 @@
 #define sample_hpp__A94590F9_6645_4380_8512_060CF57872FA
 #pragma once
 //------------------------------------------------------------------------------
+#include "sampleCache.hpp"
+
+#include "le/audioio/file/inputWaveFile.hpp"
+#include "le/utility/criticalSection.hpp"
 #include "le/utility/platformSpecifics.hpp"
 
 #include <juce/juce_core/juce_core.h>
 
+#include <boost/lockfree/spsc_queue.hpp>
 #include <boost/range/iterator_range_core.hpp>
 #include <boost/smart_ptr/scoped_array.hpp>
-//------------------------------------------------------------------------------
-
-#ifdef _WIN32
-namespace boost { namespace signals2 { class mutex; } }
-#endif // _WIN32
 
+#include <atomic>
+#include <cstdint>
+//------------------------------------------------------------------------------
 namespace LE
 {
 //------------------------------------------------------------------------------
@@ -31,37 +34,44 @@ namespace LE
 ///
 /// \class Sample
 ///
-/// \brief Loads and streams a sample from memory, looped, always stereo.
+/// \brief Streams a sample, looped, always stereo.
+///
+/// \details WAVE files are memory mapped (through AudioIO::InputWaveFile) and
+/// converted and resampled incrementally by a background prefetch thread into
+/// a lock-free ring buffer which is then read by the audio thread. Other
+/// formats are decoded up front by the platform specific doLoad()
+/// implementation, stored in the (shared) SampleCache and then streamed
+/// through the same ring buffer.
+/// The audio thread never takes a lock: a newly loaded stream is published
+/// with an atomic pointer exchange and the previous one is destroyed only after
+/// the audio thread has released it (a single hazard pointer).
 ///
 ////////////////////////////////////////////////////////////////////////////////
 
-namespace Utility
-{
-#ifdef _WIN32
-    using CriticalSection = boost::signals2::mutex;
-#else
-    class CriticalSection;
-#endif // _WIN32
-} // namespace Utility
-
 class Sample
 {
 public:
     using ChannelData = boost::iterator_range<float const * LE_RESTRICT>;
 
 public:
-    char const * load( juce::File const & sampleFile, unsigned int desiredSampleRate, Utility::CriticalSection & );
+     Sample();
+    ~Sample();
 
-    void clear();
+    char const * load( juce::File const & sampleFile, unsigned int desiredSampleRate );
 
-    ChannelData channel( unsigned int index ) const;
+    void clear();
 
-    ChannelData channel1() const;
-    ChannelData channel2() const;
+    /// \note Audio thread only. Fills <VAR>numberOfChannels</VAR> buffers with
+    /// the next <VAR>sampleFrames</VAR> (looped) sample frames. Returns false
+    /// (and outputs silence) if no sample is loaded.
+    LE_NOTHROWNOALIAS
+    bool read( float * LE_RESTRICT const * pOutputs, std::uint8_t numberOfChannels, std::uint16_t sampleFrames );
 
-    unsigned int & samplePosition();
+    /// \note Must not be called concurrently with read().
     void restart();
 
+    std::uint32_t underruns() const { return underruns_.load( std::memory_order_relaxed ); }
+
     juce::File   const & sampleFile    () const { return sampleFile_; }
     juce::String const & sampleFileName() const { return sampleFile().getFullPathName(); }
 
@@ -74,7 +84,7 @@ private:
     {
         bool recreate( std::size_t newSizeInSamplesPerChannel );
 
-        void takeDataFrom( DataHolder & other );
+        ChannelData channel( std::uint8_t index ) const;
 
         boost::scoped_array<float> pBuffer;
         float * pChannel1End      ;
@@ -83,22 +93,91 @@ private:
     };
 
     class Impl;
+    class Stream;
+    class PrefetchThread;
 
 private:
     // To be implemented for each platform separately.
     LE_NOTHROWNOALIAS
     static char const * doLoad( juce::String const & sampleFileName, unsigned int desiredSampleRate, DataHolder & data );
 
+    void publish( Stream * );
+
+    Stream * LE_FASTCALL acquireStream();
+    void     LE_FASTCALL releaseStream();
+
+    void prefetch();
+
 private:
-    DataHolder data_;
+    /// \note pPublishedStream_ and pStreamInUse_ form a single hazard pointer
+    /// pair: the audio thread announces the stream it is about to read in
+    /// pStreamInUse_ and the background threads may only destroy a stream
+    /// after it has been unpublished and is no longer announced as in use.
+    std::atomic<Stream *> pPublishedStream_;
+    std::atomic<Stream *> pStreamInUse_    ;
+
+    std::atomic<std::uint32_t> underruns_;
 
-    unsigned int samplePosition_;
+    /// \note Serialises the background (loader and prefetch) threads, the
+    /// audio thread never touches it.
+    Utility::CriticalSection streamOwnershipLock_;
+
+    juce::ScopedPointer<PrefetchThread> pPrefetchThread_;
 
     juce::File sampleFile_;
 
     static unsigned int const fixedNumberOfChannels = 2;
 }; // class Sample
 
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class Sample::Stream
+///
+/// \brief A single loaded sample: its source data, the fractional read
+/// position (32.32 fixed point) used for resampling and the interleaved stereo
+/// ring buffer filled by the prefetch thread.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class Sample::Stream
+{
+public:
+    Stream( std::uint32_t ringCapacityInFrames );
+
+    char const * openWAVE ( juce::String const & fileName, unsigned int desiredSampleRate );
+    void         useCached( SampleCache::EntryPtr        pDecodedData                      );
+
+    /// Prefetch thread only (or with the consumer excluded, see rewind()).
+    bool LE_FASTCALL prefetch();
+
+    /// Audio thread only.
+    LE_NOTHROWNOALIAS
+    std::uint16_t LE_FASTCALL read( float * LE_RESTRICT const * pOutputs, std::uint8_t numberOfChannels, std::uint16_t sampleFrames );
+
+    /// Both the producer and consumer sides must be excluded.
+    void rewind();
+
+    std::uint32_t lengthInFrames() const { return sourceFrames_; }
+
+private:
+    std::uint32_t LE_FASTCALL decodeSourceBlock( std::uint32_t firstFrame, float * LE_RESTRICT pInterleavedStereo, std::uint32_t frames );
+
+private:
+    using Ring = boost::lockfree::spsc_queue<float>;
+
+    AudioIO::InputWaveFile wave_   ;
+    SampleCache::EntryPtr  pDecoded_;
+
+    std::uint32_t sourceFrames_  ;
+    std::uint8_t  sourceChannels_;
+
+    std::uint64_t position_; // source frames, 32.32 fixed point
+    std::uint64_t step_    ; // source frames per output frame, 32.32 fixed point
+
+    Ring ring_;
+}; // class Sample::Stream
+
 //------------------------------------------------------------------------------
 } // namespace LE
 //------------------------------------------------------------------------------
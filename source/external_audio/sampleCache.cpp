@@ -0,0 +1,485 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// sampleCache.cpp
+/// ---------------
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#include "sampleCache.hpp"
+
+#include "le/math/vector.hpp"
+#include "le/utility/criticalSection.hpp"
+
+#include <boost/assert.hpp>
+#include <boost/core/ignore_unused.hpp>
+#include <boost/optional/optional.hpp>
+
+#ifdef _WIN32
+    #include "boost/mmap/mappble_objects/shared_memory/win32/flags.hpp"
+
+    #include "windows.h"
+#else
+    #include "boost/mmap/mappble_objects/shared_memory/posix/flags.hpp"
+
+    #include "fcntl.h"
+    #include "sys/mman.h"
+    #include "sys/stat.h"
+    #include "unistd.h"
+#endif // _WIN32
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <new>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+
+namespace
+{
+    using View         = boost::mmap::basic_mapped_view_ref;
+    using OptionalView = boost::optional<View>;
+
+#ifdef _WIN32
+    using Mapping      = boost::mmap::mapping            <boost::mmap::win32>;
+    using Flags        = boost::mmap::shared_memory_flags<boost::mmap::win32>;
+#else
+    using Mapping      = boost::mmap::mapping            <boost::mmap::posix>;
+    using Flags        = boost::mmap::shared_memory_flags<boost::mmap::posix>;
+#endif // _WIN32
+
+#if LE_SW_CROSS_PROCESS_SAMPLE_CACHE
+    /// \note Shared memory object names are derived from the key hash so that
+    /// separate processes arrive at the same name for the same sample (the
+    /// object header holds the full key which is verified on opening).
+    class ObjectName
+    {
+    public:
+    #ifdef _WIN32
+        using char_t = wchar_t;
+    #else
+        using char_t = char;
+    #endif // _WIN32
+
+        explicit ObjectName( SampleCache::Key const & key )
+        {
+        #ifdef _WIN32
+            BOOST_VERIFY( ::_snwprintf( value_, _countof( value_ ), L"Local\\LE.SW.sample.%016llx", static_cast<unsigned long long>( key.hash ) ) > 0 );
+        #else
+            BOOST_VERIFY( std::snprintf( value_, sizeof( value_ ), "/LE.SW.sample.%016llx", static_cast<unsigned long long>( key.hash ) ) > 0 );
+        #endif // _WIN32
+        }
+
+        operator char_t const * () const { return value_; }
+
+    private:
+        // Prefix + 16 hexadecimal digits + terminator (also fits the 31
+        // character OS X shm_open() limit).
+        char_t value_[ 36 ];
+    }; // class ObjectName
+#endif // LE_SW_CROSS_PROCESS_SAMPLE_CACHE
+
+    std::uint64_t fnv1a( void const * const pData, std::size_t const size, std::uint64_t hash )
+    {
+        auto const * LE_RESTRICT const pBytes( static_cast<unsigned char const *>( pData ) );
+        for ( std::size_t byte( 0 ); byte < size; ++byte )
+        {
+            hash ^= pBytes[ byte ];
+            hash *= 0x100000001B3ULL;
+        }
+        return hash;
+    }
+} // anonymous namespace
+
+
+/// \note Lives at the beginning of every shared memory object. Sized so that
+/// the sample data that follows stays 16 byte aligned.
+struct SampleCache::Entry::Header
+{
+    enum State : std::uint32_t { Decoding, Ready };
+
+    Key                        key   ;
+    std::uint32_t              frames;
+    std::atomic<std::uint32_t> state ;
+    std::uint32_t              padding[ 2 ];
+
+    float const * data() const { return reinterpret_cast<float const *>( this + 1 ); }
+    float       * data()       { return reinterpret_cast<float       *>( this + 1 ); }
+
+    static std::size_t objectSize( std::uint32_t const frames ) { return sizeof( Header ) + frames * 2 * sizeof( float ); }
+}; // struct SampleCache::Entry::Header
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// SampleCache::Registry
+//
+////////////////////////////////////////////////////////////////////////////////
+
+class SampleCache::Registry
+{
+public:
+    static Registry & singleton()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    EntryPtr find( Key const & key )
+    {
+        {
+            Utility::CriticalSectionLock const lock( lock_ );
+            auto const pEntry( entries_.find( key.hash ) );
+            if ( pEntry != entries_.end() && pEntry->second->key_ == key )
+                return EntryPtr( pEntry->second );
+        }
+        return openShared( key );
+    }
+
+    EntryPtr insert( Key const & key, ChannelData const left, ChannelData const right )
+    {
+        static_assert( sizeof( Entry::Header ) % 16 == 0, "Sample data misaligned" );
+        BOOST_ASSERT( left.size() == right.size() );
+        auto const frames( static_cast<std::uint32_t>( left.size() ) );
+
+        bool alreadyExists( false );
+        bool ownsName     ( false );
+        OptionalView view( createShared( key, Entry::Header::objectSize( frames ), key.shareable(), alreadyExists, ownsName ) );
+        if ( alreadyExists )
+        {
+            EntryPtr pExisting( openShared( key ) );
+            if ( pExisting )
+                return pExisting;
+            // The name is taken by a different sample (a hash collision):
+            // fall back to a private copy.
+            view = createShared( key, Entry::Header::objectSize( frames ), false, alreadyExists, ownsName );
+        }
+        if ( !view )
+            return nullptr;
+
+        auto & header( *reinterpret_cast<Entry::Header *>( view->begin() ) );
+        header.key    = key   ;
+        header.frames = frames;
+        Math::copy( left .begin(), header.data()         , frames );
+        Math::copy( right.begin(), header.data() + frames, frames );
+        header.state.store( Entry::Header::Ready, std::memory_order_release );
+
+        // From now on the data is immutable, let the MMU enforce it.
+    #ifdef _WIN32
+        DWORD previousProtection;
+        BOOST_VERIFY( ::VirtualProtect( view->begin(), view->size(), PAGE_READONLY, &previousProtection ) );
+    #else
+        BOOST_VERIFY( ::mprotect( view->begin(), view->size(), PROT_READ ) == 0 );
+    #endif // _WIN32
+
+        return add( key, *view, ownsName );
+    }
+
+    void release( Entry const & entry )
+    {
+        {
+            // Lookups add references only under the registry lock so an entry
+            // whose count dropped to zero here cannot be resurrected.
+            Utility::CriticalSectionLock const lock( lock_ );
+            if ( --entry.referenceCount_ )
+                return;
+            auto const pEntry( entries_.find( entry.key_.hash ) );
+            if ( pEntry != entries_.end() && pEntry->second == &entry )
+                entries_.erase( pEntry );
+        }
+        delete &entry;
+    }
+
+private:
+    EntryPtr add( Key const & key, View const & view, bool const ownsName )
+    {
+        Entry * const pNewEntry( new ( std::nothrow ) Entry( key, view, ownsName ) );
+        if ( !pNewEntry )
+        {
+            View::unmap( view );
+            return nullptr;
+        }
+
+        EntryPtr pWinner;
+        {
+            Utility::CriticalSectionLock const lock( lock_ );
+            auto const insertion( entries_.insert( std::make_pair( key.hash, pNewEntry ) ) );
+            if ( insertion.second )
+                return EntryPtr( pNewEntry );
+            // A different sample with the same hash holds the slot: keep the
+            // new entry unregistered (private to the caller).
+            if ( insertion.first->second->key_ != key )
+                return EntryPtr( pNewEntry );
+            pWinner = insertion.first->second;
+        }
+        // Lost a race with another instance from this process: use its entry.
+        delete pNewEntry;
+        return pWinner;
+    }
+
+    /// Creates a new (named, if enabled and requested) shared memory object
+    /// and maps it read-write.
+    static OptionalView createShared( Key const & key, std::size_t const size, bool const named, bool & alreadyExists, bool & ownsName )
+    {
+        alreadyExists = false;
+        ownsName      = false;
+        auto flags
+        (
+            Flags::create
+            (
+                Flags::handle_access_rights::read | Flags::handle_access_rights::write,
+                Flags::share_mode  ::shared,
+                Flags::system_hints::default_
+            )
+        );
+
+    #ifdef _WIN32
+        boost::ignore_unused( ownsName );
+        ULARGE_INTEGER largeSize; largeSize.QuadPart = size;
+        HANDLE const handle
+        (
+            ::CreateFileMappingW
+            (
+                INVALID_HANDLE_VALUE, nullptr,
+                flags.create_mapping_flags,
+                largeSize.HighPart, largeSize.LowPart,
+            #if LE_SW_CROSS_PROCESS_SAMPLE_CACHE
+                named ? static_cast<wchar_t const *>( ObjectName( key ) ) : nullptr
+            #else
+                ( boost::ignore_unused( key, named ), nullptr )
+            #endif // LE_SW_CROSS_PROCESS_SAMPLE_CACHE
+            )
+        );
+        if ( !handle )
+            return boost::none;
+        // Views keep the section alive after the mapping handle is closed.
+        Mapping const sharedMemory( handle, flags.map_view_flags );
+        alreadyExists = ( ::GetLastError() == ERROR_ALREADY_EXISTS );
+        if ( alreadyExists )
+            return boost::none;
+        View const view( View::map( sharedMemory, 0, size ) );
+    #else
+        int fileDescriptor( -1 );
+    #if LE_SW_CROSS_PROCESS_SAMPLE_CACHE
+        if ( named )
+        {
+            ObjectName const name( key );
+            fileDescriptor = ::shm_open( name, O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR );
+            if ( fileDescriptor == -1 )
+            {
+                alreadyExists = ( errno == EEXIST );
+                return boost::none;
+            }
+            if ( ::ftruncate( fileDescriptor, static_cast<off_t>( size ) ) != 0 )
+            {
+                BOOST_VERIFY( ::close     ( fileDescriptor ) == 0 );
+                BOOST_VERIFY( ::shm_unlink( name           ) == 0 );
+                return boost::none;
+            }
+            ownsName = true;
+        }
+        else
+        {
+            flags.flags |= MAP_ANONYMOUS;
+        }
+    #else
+        boost::ignore_unused( key, named );
+        flags.flags |= MAP_ANONYMOUS;
+    #endif // LE_SW_CROSS_PROCESS_SAMPLE_CACHE
+        View const view( View::map( Mapping( fileDescriptor, flags ), 0, size ) );
+        if ( fileDescriptor != -1 )
+            BOOST_VERIFY( ::close( fileDescriptor ) == 0 );
+    #endif // _WIN32
+
+        if ( view.empty() )
+            return boost::none;
+        return view;
+    }
+
+    /// Maps a shared memory object created (and filled) by another process.
+    EntryPtr openShared( Key const & key )
+    {
+    #if LE_SW_CROSS_PROCESS_SAMPLE_CACHE
+        if ( !key.shareable() )
+            return nullptr;
+
+        ObjectName const name( key );
+
+    #ifdef _WIN32
+        HANDLE const handle( ::OpenFileMappingW( FILE_MAP_READ, false, name ) );
+        if ( !handle )
+            return nullptr;
+        Mapping const sharedMemory( handle, FILE_MAP_READ );
+        std::size_t const objectSize( std::size_t( -1 ) );
+    #else
+        int const fileDescriptor( ::shm_open( name, O_RDONLY, 0 ) );
+        if ( fileDescriptor == -1 )
+            return nullptr;
+        struct ::stat status;
+        bool const statusValid( ::fstat( fileDescriptor, &status ) == 0 );
+        std::size_t const objectSize( statusValid ? static_cast<std::size_t>( status.st_size ) : 0 );
+        Mapping const sharedMemory
+        (
+            fileDescriptor,
+            Flags::create( Flags::handle_access_rights::read, Flags::share_mode::shared, Flags::system_hints::default_ )
+        );
+    #endif // _WIN32
+
+        OptionalView view;
+        if ( objectSize >= sizeof( Entry::Header ) )
+        {
+            View const headerView( View::map( sharedMemory, 0, sizeof( Entry::Header ) ) );
+            if ( !headerView.empty() )
+            {
+                auto const & header( *reinterpret_cast<Entry::Header const *>( headerView.begin() ) );
+                // The creating process publishes the object before filling
+                // it: give it a (bounded) chance to finish.
+                for ( unsigned int attempt( 0 ); header.state.load( std::memory_order_acquire ) != Entry::Header::Ready && attempt < 100; ++attempt )
+                    juce::Thread::sleep( 10 );
+                bool const valid
+                (
+                    header.state.load( std::memory_order_acquire ) == Entry::Header::Ready &&
+                    header.key == key                                                      &&
+                    Entry::Header::objectSize( header.frames ) <= objectSize
+                );
+                std::size_t const fullSize( Entry::Header::objectSize( header.frames ) );
+                View::unmap( headerView );
+                if ( valid )
+                {
+                    View const fullView( View::map( sharedMemory, 0, fullSize ) );
+                    if ( !fullView.empty() )
+                        view = fullView;
+                }
+            }
+        }
+    #ifndef _WIN32
+        BOOST_VERIFY( ::close( fileDescriptor ) == 0 );
+    #endif // _WIN32
+        if ( !view )
+            return nullptr;
+        return add( key, *view, false );
+    #else
+        boost::ignore_unused( key );
+        return nullptr;
+    #endif // LE_SW_CROSS_PROCESS_SAMPLE_CACHE
+    }
+
+private:
+    Utility::CriticalSection          lock_   ;
+    std::map<std::uint64_t, Entry *> entries_;
+}; // class SampleCache::Registry
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// SampleCache
+//
+////////////////////////////////////////////////////////////////////////////////
+
+SampleCache::Key SampleCache::Key::create( juce::File const & file, unsigned int const sampleRate )
+{
+    juce::String const path( file.getFullPathName() );
+
+    Key key;
+    key.fileSize         = file.getSize();
+    key.modificationTime = file.getLastModificationTime().toMilliseconds();
+    key.sampleRate       = sampleRate;
+    key.pathLength       = static_cast<std::uint32_t>( path.getNumBytesAsUTF8() );
+    std::memcpy( key.path, path.toRawUTF8(), std::min<std::size_t>( key.pathLength, sizeof( key.path ) ) );
+
+    std::uint64_t hash( 0xCBF29CE484222325ULL );
+    hash = fnv1a( path.toRawUTF8()     , key.pathLength                , hash );
+    hash = fnv1a( &key.fileSize        , sizeof( key.fileSize         ), hash );
+    hash = fnv1a( &key.modificationTime, sizeof( key.modificationTime ), hash );
+    hash = fnv1a( &key.sampleRate      , sizeof( key.sampleRate       ), hash );
+    key.hash = hash;
+
+    return key;
+}
+
+
+bool SampleCache::Key::operator==( Key const & other ) const
+{
+    return
+        hash             == other.hash             &&
+        fileSize         == other.fileSize         &&
+        modificationTime == other.modificationTime &&
+        sampleRate       == other.sampleRate       &&
+        pathLength       == other.pathLength       &&
+        shareable()                                &&
+        std::memcmp( path, other.path, pathLength ) == 0;
+}
+
+
+SampleCache::EntryPtr SampleCache::find( Key const & key )
+{
+    return Registry::singleton().find( key );
+}
+
+
+SampleCache::EntryPtr SampleCache::insert( Key const & key, ChannelData const left, ChannelData const right )
+{
+    return Registry::singleton().insert( key, left, right );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// SampleCache::Entry
+//
+////////////////////////////////////////////////////////////////////////////////
+
+SampleCache::Entry::Entry( Key const & key, View const & view, bool const ownsName )
+    :
+    key_     ( key      ),
+    view_    ( view     ),
+    ownsName_( ownsName )
+{
+    BOOST_ASSERT( view.size() == Header::objectSize( header().frames ) );
+}
+
+
+SampleCache::Entry::~Entry()
+{
+    View::unmap( view_ );
+#if LE_SW_CROSS_PROCESS_SAMPLE_CACHE && !defined( _WIN32 )
+    // Only removes the name, other processes keep their existing mappings.
+    if ( ownsName_ )
+        ::shm_unlink( ObjectName( key_ ) );
+#endif // LE_SW_CROSS_PROCESS_SAMPLE_CACHE && POSIX
+}
+
+
+SampleCache::Entry::Header const & SampleCache::Entry::header() const
+{
+    return *reinterpret_cast<Header const *>( view_.begin() );
+}
+
+
+SampleCache::ChannelData SampleCache::Entry::channel( std::uint8_t const index ) const
+{
+    BOOST_ASSERT( index < 2 );
+    std::uint32_t const frames  ( lengthInFrames()                );
+    float const * const pChannel( header().data() + index * frames );
+    return ChannelData( pChannel, pChannel + frames );
+}
+
+
+std::uint32_t SampleCache::Entry::lengthInFrames() const { return header().frames; }
+
+
+void SampleCache::Entry::release() const { Registry::singleton().release( *this ); }
+
+
+void LE_FASTCALL intrusive_ptr_add_ref( SampleCache::Entry const * const pEntry ) { ++pEntry->referenceCount_; }
+void LE_FASTCALL intrusive_ptr_release( SampleCache::Entry const * const pEntry ) { pEntry->release();         }
+
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
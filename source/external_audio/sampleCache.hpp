@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file sampleCache.hpp
+/// ---------------------
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef sampleCache_hpp__5E0B7D21_3C4A_4F8E_9A61_2D7F0C8B14E3
+#define sampleCache_hpp__5E0B7D21_3C4A_4F8E_9A61_2D7F0C8B14E3
+#pragma once
+//------------------------------------------------------------------------------
+#include "le/utility/platformSpecifics.hpp"
+#include "le/utility/referenceCounter.hpp"
+
+#include "boost/mmap/mapped_view/mapped_view.hpp"
+
+#include <juce/juce_core/juce_core.h>
+
+#include <boost/range/iterator_range_core.hpp>
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+
+#include <cstdint>
+//------------------------------------------------------------------------------
+
+/// \note When enabled decoded samples are published as named shared memory
+/// objects so that plugin instances living in different (sandboxed) host
+/// processes also share a single copy of the decoded data. Otherwise the
+/// cache is shared only among instances within the same process.
+#ifndef LE_SW_CROSS_PROCESS_SAMPLE_CACHE
+    #define LE_SW_CROSS_PROCESS_SAMPLE_CACHE 0
+#endif // LE_SW_CROSS_PROCESS_SAMPLE_CACHE
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class SampleCache
+///
+/// \brief Process wide (and optionally system wide) cache of decoded,
+/// resampled stereo samples.
+///
+/// \details Decoded samples are stored (planar, left channel followed by the
+/// right one) in read-only shared memory and handed out as reference counted
+/// Entry objects, keyed by the sample file (path, size and modification time)
+/// and the target sample rate. Many instances loading the same side-chain
+/// sample therefore decode it only once and share the same physical pages.
+/// An entry is evicted when its last user releases it.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class SampleCache
+{
+public:
+    using ChannelData = boost::iterator_range<float const * LE_RESTRICT>;
+
+    class Entry;
+    using EntryPtr = boost::intrusive_ptr<Entry const>;
+
+    /// \note The complete key is stored with (and compared against) every
+    /// entry, the hash only picks the slot (and the shared memory object
+    /// name). Keys of paths longer than maximumPathLength are not shared
+    /// (their entries are private to the inserting instance).
+    struct Key
+    {
+        static std::uint16_t BOOST_CONSTEXPR_OR_CONST maximumPathLength = 4096 - 32;
+
+        static Key LE_FASTCALL create( juce::File const &, unsigned int sampleRate );
+
+        bool LE_FASTCALL operator==( Key const & ) const;
+        bool             operator!=( Key const & other ) const { return !( *this == other ); }
+
+        bool shareable() const { return pathLength <= maximumPathLength; }
+
+        std::uint64_t hash            ; ///< Of all the fields below.
+        std::int64_t  fileSize        ;
+        std::int64_t  modificationTime;
+        std::uint32_t sampleRate      ;
+        std::uint32_t pathLength      ;
+        char          path[ maximumPathLength ]; ///< UTF-8, not terminated
+    }; // struct Key
+
+public:
+    /// Returns an already decoded sample (or a null pointer).
+    static EntryPtr LE_FASTCALL find( Key const & );
+
+    /// Copies the decoded data into a new shared entry. If another instance
+    /// (or process) raced to insert the same sample its entry is returned
+    /// instead.
+    static EntryPtr LE_FASTCALL insert( Key const &, ChannelData left, ChannelData right );
+
+private:
+    class Registry;
+}; // class SampleCache
+
+
+class SampleCache::Entry
+{
+public:
+    ChannelData   LE_FASTCALL channel       ( std::uint8_t index ) const;
+    std::uint32_t LE_FASTCALL lengthInFrames(                    ) const;
+
+private: friend class SampleCache; friend class SampleCache::Registry;
+    struct Header;
+
+    Entry( Key const &, boost::mmap::basic_mapped_view_ref const &, bool ownsName );
+    ~Entry();
+
+    Header const & header() const;
+
+    void release() const;
+
+    friend void LE_FASTCALL intrusive_ptr_add_ref( Entry const * );
+    friend void LE_FASTCALL intrusive_ptr_release( Entry const * );
+
+private:
+    Key                                const key_     ;
+    boost::mmap::basic_mapped_view_ref const view_    ;
+    bool                               const ownsName_;
+
+    mutable Utility::ReferenceCount referenceCount_;
+}; // class SampleCache::Entry
+
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // sampleCache_hpp
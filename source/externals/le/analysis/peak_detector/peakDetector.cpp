@@ -12,7 +12,7 @@
 #include "le/math/conversion.hpp"
 #include "le/math/math.hpp"
 #include "le/math/vector.hpp"
-#include "le/utility/clear.hpp"
+#include "le/utility/intrinsics.hpp"
 
 #include "boost/simd/preprocessor/stack_buffer.hpp"
 
@@ -20,6 +20,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 //------------------------------------------------------------------------------
 LE_IMPL_NAMESPACE_BEGIN( LE )
 //------------------------------------------------------------------------------
@@ -42,6 +43,9 @@ bool operator<( Peak const & left, Peak const & right )
 
 namespace
 {
+    // Search floor (avoids small amplitudes), in dB relative to the global maximum.
+    float const lowestAmplitudeThreshold( -55 );
+
     std::int16_t findThdStart( float const * const amp, float const thd, std::uint16_t const num )
     {
         // Try to find stronger amplitude
@@ -168,7 +172,6 @@ void PeakDetector::setZeroDecibelValue( float const zeroDecibel )
 
 void PeakDetector::restart()
 {
-    Utility::clear( isPeak_ );
     numberOfPeaks_ = 0;
 }
 
@@ -268,7 +271,6 @@ void LE_FASTCALL LE_HOT PeakDetector::findPeaksImpl
     {
         // Find starting bin that is above some threshold, to avoid small amplitudes
         {
-            float const lowestAmplitudeThreshold( -55 );
             auto const thdStart( findThdStart( &ampsdB[ pos ], lowestAmplitudeThreshold, numBins - pos ) );
             if ( thdStart == -1 )
                 break; // if not found exit
@@ -312,8 +314,6 @@ void LE_FASTCALL LE_HOT PeakDetector::findPeaksImpl
                 ( pPeak->strength > strengthThreshold_ )          // is peak strong enough?
             )
             {
-                std::fill( &isPeak_[ pPeak->startPos + 1 ], &isPeak_[ pPeak->stopPos ], true );
-
                 if ( fs )
                     calculateTrueFrequency( *pPeak, numberOfBins, fs, ampsdB );
 
@@ -331,6 +331,123 @@ void LE_FASTCALL LE_HOT PeakDetector::findPeaksImpl
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+//
+// PeakDetector::trackPeaks()
+// --------------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+
+void LE_FASTCALL LE_HOT PeakDetector::trackPeaks
+(
+    float         const * LE_RESTRICT const amplitudes,
+    std::uint16_t                     const numBins,
+    Tracks                          &       tracks
+)
+{
+    restart();
+
+    using namespace Math;
+
+    LE_LOCALLY_DISABLE_FPU_EXCEPTIONS();
+
+    // Same reference levels as in findPeaksImpl():
+    float       maxLocal ( Math::max( amplitudes, numBins ) );
+    float const maxGlobal( std ::max( maxGlobal_, maxLocal ) );
+    maxLocal   = normalisedLinear2dB( maxLocal / maxGlobal );
+    maxGlobal_ = maxGlobal;
+
+    float const floor( maxGlobal * dB2NormalisedLinear( lowestAmplitudeThreshold ) );
+    auto  const dB   ( [=]( std::uint16_t const bin ) { return normalisedLinear2dB( amplitudes[ bin ] / maxGlobal ); } );
+
+    auto         const seeds        ( tracks.tops_ );
+    std::uint8_t const numberOfSeeds( tracks.size_ );
+    std::uint8_t       seed         ( 0            );
+    tracks.size_ = 0;
+
+    std::uint16_t const lastBin( numBins - 1 );
+    std::uint16_t       cursor ( 0 ); // end of the last found peak (pos in findPeaksImpl())
+    std::uint16_t       probe  ( 0 );
+    while ( probe < lastBin )
+    {
+        // Previous peaks (that were not swallowed by an already found one) are
+        // tried first, the remaining bins are probed coarsely for new peaks:
+        while ( ( seed < numberOfSeeds ) && ( seeds[ seed ] < cursor ) )
+            ++seed;
+        std::uint16_t position;
+        if ( ( seed < numberOfSeeds ) && ( seeds[ seed ] <= probe ) )
+        {
+            position = seeds[ seed++ ];
+        }
+        else
+        {
+            position = probe;
+            probe   += 2;
+        }
+        if ( !( amplitudes[ position ] > floor ) )
+            continue;
+
+        // Climb to the maximum (findUpMax()):
+        std::uint16_t top( position );
+        if ( amplitudes[ top + 1 ] >= amplitudes[ top ] )
+        {
+            do { ++top; } while ( ( top < lastBin ) && ( amplitudes[ top + 1 ] >= amplitudes[ top ] ) );
+            if ( top == lastBin )
+                break; // rising until the end
+        }
+        else
+        {
+            while ( ( top > cursor ) && ( amplitudes[ top - 1 ] > amplitudes[ top ] ) )
+                --top;
+        }
+
+        // Find where the peak ends (findDownMin()):
+        std::uint16_t stop( top );
+        while ( ( stop < lastBin ) && ( amplitudes[ stop + 1 ] < amplitudes[ stop ] ) )
+            ++stop;
+        if ( stop == lastBin )
+            break; // falling until the end
+
+        // ...and where it starts (findThdStart()):
+        std::uint16_t start( top );
+        while ( ( start > cursor ) && ( amplitudes[ start - 1 ] <= amplitudes[ start ] ) && ( amplitudes[ start - 1 ] > floor ) )
+            --start;
+
+        cursor = stop;
+        probe  = stop;
+
+        if ( start == top )
+            continue;
+
+        // Decide if peak is OK (as in findPeaksImpl()):
+        float const mag     ( dB( top )                              );
+        float const strength( mag - ( dB( start ) + dB( stop ) ) / 2 );
+        if
+        (
+            (
+                ( ( maxLocal - mag ) < localThreshold_  ) ||
+                ( ( 0        - mag ) < globalThreshold_ )
+            )
+              &&
+            ( strength > strengthThreshold_ )
+        )
+        {
+            Peak & peak( peaks_[ numberOfPeaks_ ] );
+            peak.startPos = start;
+            peak.maxPos   = top;
+            peak.stopPos  = stop;
+            peak.strength = strength;
+            peak.valid    = true;
+
+            tracks.tops_[ tracks.size_++ ] = top;
+
+            if ( ++numberOfPeaks_ >= peaks_.size() )
+                break;
+        }
+    }
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 //
 // PeakDetector::getPeak()
@@ -376,7 +493,8 @@ namespace
     void LE_FASTCALL LE_HOT attenuateBins
     (
         float         * LE_RESTRICT const pAmplitudes,
-        bool          * LE_RESTRICT const pPeaks,
+        Peak    const * LE_RESTRICT const pPeaks,
+        std::uint8_t                const numberOfPeaks,
         std::uint16_t               const startBin,
         std::uint16_t               const stopInclusive,
         float                       const factor,
@@ -390,11 +508,24 @@ namespace
                 : Math::dB2NormalisedLinear( -factor )
         );
 
-        for ( auto pos( startBin ); pos <= stopInclusive; ++pos )
+        // Build a gain mask from the peak ranges (the bins between a peak's
+        // start and stop positions) and apply it with a single vectorised
+        // multiplication. The mask is offset so that it is compatibly aligned
+        // with the amplitudes (which need not start at an aligned bin).
+        std::uint16_t const maskSize    ( stopInclusive + 1 );
+        std::uint8_t  const misalignment( static_cast<std::uint8_t>( reinterpret_cast<std::uintptr_t>( pAmplitudes ) % Utility::Constants::vectorAlignment / sizeof( float ) ) );
+        BOOST_SIMD_ALIGNED_SCOPED_STACK_BUFFER( maskStorage, SW::Engine::real_t, misalignment + maskSize );
+        float * LE_RESTRICT const pMask( maskStorage.begin() + misalignment );
+        Math::fill( pMask, ifPeak ? 1 : gain, maskSize );
+        for ( std::uint8_t peak( 0 ); peak < numberOfPeaks; ++peak )
         {
-            if ( pPeaks[ pos ] == ifPeak )
-                pAmplitudes[ pos ] *= gain;
+            std::uint16_t const first( pPeaks[ peak ].startPos + 1                                 );
+            std::uint16_t const last ( std::min<std::uint16_t>( pPeaks[ peak ].stopPos, maskSize ) );
+            if ( first < last )
+                Math::fill( &pMask[ first ], ifPeak ? gain : 1, last - first );
         }
+
+        Math::multiply( &pMask[ startBin ], &pAmplitudes[ startBin ], &pAmplitudes[ stopInclusive + 1 ] );
     }
 } // anonymous namespace
 
@@ -402,7 +533,7 @@ LE_OPTIMIZE_FOR_SPEED_END()
 
 void PeakDetector::attenuatePeaks( float * const amplitudes, std::uint16_t const startBin, std::uint16_t const stopInclusive, float const factor )
 {
-    attenuateBins( amplitudes, &isPeak_[ 0 ], startBin, stopInclusive, factor, true );
+    attenuateBins( amplitudes, &peaks_[ 0 ], numberOfPeaks_, startBin, stopInclusive, factor, true );
 }
 
 
@@ -415,7 +546,7 @@ void PeakDetector::attenuatePeaks( float * const amplitudes, std::uint16_t const
 
 void PeakDetector::attenuateNonPeaks( float * const amplitudes, std::uint16_t const startBin, std::uint16_t const stopInclusive, float const factor )
 {
-    attenuateBins( amplitudes, &isPeak_[ 0 ], startBin, stopInclusive, factor, false );
+    attenuateBins( amplitudes, &peaks_[ 0 ], numberOfPeaks_, startBin, stopInclusive, factor, false );
 }
 
 //------------------------------------------------------------------------------
@@ -73,6 +73,27 @@ class PeakDetector
 public:
     PeakDetector();
 
+    ////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \class Tracks
+    ///
+    /// \brief Peak positions found in the previous trackPeaks() call for a
+    /// particular signal (channel).
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+
+    class Tracks
+    {
+    public:
+        Tracks() : size_( 0 ) {}
+
+        void reset() { size_ = 0; }
+
+    private: friend class PeakDetector;
+        std::array<std::uint16_t, MAX_NUM_PEAKS> tops_;
+        std::uint8_t                             size_;
+    }; // class Tracks
+
     ////////////////////////////////////////////////////////////////////////////////
     //
     // setStrengthThreshold()
@@ -155,6 +176,42 @@ public:
     void LE_FASTCALL findPeaksAndEstimateFrequency( float const * amplitudes, std::uint16_t numberOfBins, std::uint32_t fs );
     
 
+    ////////////////////////////////////////////////////////////////////////////
+    //
+    // trackPeaks()
+    // ------------
+    //
+    ////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \brief Finds the same peaks as findPeaks() but incrementally, seeding
+    /// the search with the peaks found in the previous frame.
+    ///
+    ///   A peak is fully determined by the shape of the spectrum around its
+    /// maximum (the nondecreasing run up to it and the strictly decreasing run
+    /// after it) so peaks are independent of each other and can be searched
+    /// for in any order: previous peaks are revalidated by climbing to the
+    /// nearest maximum from their old positions (a few bins for stationary
+    /// signals) while new peaks are searched for by coarsely probing (every
+    /// second bin, enough to hit every peak that can pass as valid) the
+    /// remaining bins. Amplitudes are compared in the linear domain, only the
+    /// found peaks are converted to decibels (findPeaks() converts all bins),
+    /// so the results can differ from findPeaks() only for amplitudes whose
+    /// order or relation to the -55 dB search floor changes in the float
+    /// rounding of the decibel conversion. Peak frequencies are not estimated.
+    ///
+    /// \param amplitudes   - Input amplitudes.
+    /// \param numberOfBins - Number of bins.
+    /// \param tracks       - Peaks of the previous frame of the same signal
+    ///                       (replaced with the peaks of this frame).
+    /// \return None.
+    ///
+    /// \throws None.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+
+    void LE_FASTCALL trackPeaks( float const * amplitudes, std::uint16_t numberOfBins, Tracks & );
+
+
     ////////////////////////////////////////////////////////////////////////////////
     //
     // getNumPeaks()
@@ -200,7 +257,8 @@ public:
     //
     ////////////////////////////////////////////////////////////////////////////////
     ///
-    /// \brief Attenuates peaks.
+    /// \brief Attenuates peaks (found by the last findPeaks*() or
+    /// trackPeaks() call). The amplitudes have to be (SIMD) aligned.
     ///
     /// \param amplitudes    - target data
     /// \param startBin      - start bin
@@ -249,8 +307,7 @@ private:
 
     std::uint8_t numberOfPeaks_;
 
-    std::array<Peak, MAX_NUM_PEAKS                               > peaks_ ;
-    std::array<bool, SW::Engine::StaticHalfFFTBuffer::static_size> isPeak_;
+    std::array<Peak, MAX_NUM_PEAKS> peaks_;
 }; // class PeakDetector
 
 //------------------------------------------------------------------------------
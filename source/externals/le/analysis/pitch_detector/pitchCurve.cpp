@@ -0,0 +1,307 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// pitchCurve.cpp
+/// --------------
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#include "pitchCurve.hpp"
+
+#include "pitchDetector.hpp"
+
+#include "le/math/dft/domainConversion.hpp"
+#include "le/math/dft/fft.hpp"
+#include "le/math/vector.hpp"
+#include "le/math/windows.hpp"
+#include "le/spectrumworx/engine/buffers.hpp"
+#include "le/spectrumworx/engine/setup.hpp"
+
+#include "boost/simd/preprocessor/stack_buffer.hpp"
+
+#include "boost/assert.hpp"
+
+#if defined( _WIN32 )
+    #include "le/utility/windowsLite.hpp"
+#else
+    #include "pthread.h"
+#endif // OS
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_BEGIN( LE )
+//------------------------------------------------------------------------------
+
+namespace
+{
+    char const outOfMemory[] = "Out of memory.";
+
+    /// \note Each chunk is preceded by a few discarded hops so that the
+    /// detector's continuity state (the last pitch) at the start of the chunk
+    /// matches the one of a sequential analysis.
+    std::uint8_t const warmUpHops( 8 );
+} // anonymous namespace
+
+
+struct PitchCurve::Chunk
+{
+    float             const * pSamples       ;
+    std::uint32_t             numberOfSamples;
+    SW::Engine::Setup const * pSetup         ;
+    float                     lowerBound     ;
+    float                     upperBound     ;
+    std::uint32_t             beginHop       ;
+    std::uint32_t             endHop         ;
+    float                   * pPitches       ;
+    char              const * error          ;
+
+#ifdef _WIN32
+    HANDLE      thread ;
+#else
+    ::pthread_t thread ;
+    bool        running;
+#endif // _WIN32
+}; // struct PitchCurve::Chunk
+
+
+PitchCurve::PitchCurve() : numberOfHops_( 0 ) {}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// PitchCurve::analyse()
+// ---------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+
+LE_NOTHROW LE_COLD
+char const * PitchCurve::analyse
+(
+    float         const * const pSamples,
+    std::uint32_t         const numberOfSamples,
+    std::uint32_t         const sampleRate,
+    std::uint16_t         const fftSize,
+    std::uint8_t          const overlapFactor,
+    float                 const lowerBound,
+    float                 const upperBound,
+    std::uint8_t                numberOfThreads
+)
+{
+    SW::Engine::Setup setup;
+    setup.setFFTSize          ( fftSize       );
+    setup.setOverlappingFactor( overlapFactor );
+    setup.setSampleRate       ( sampleRate    );
+
+    auto const stepSize( setup.stepSize<std::uint32_t>() );
+
+    // Every hop completed by the signal plus the ones that flush it:
+    std::uint32_t const numberOfHops( ( numberOfSamples + fftSize - 1 ) / stepSize );
+    pPitches_.reset( new ( std::nothrow ) float[ numberOfHops ] );
+    if ( !pPitches_ )
+    {
+        numberOfHops_ = 0;
+        return outOfMemory;
+    }
+    numberOfHops_ = numberOfHops;
+
+    numberOfThreads = static_cast<std::uint8_t>( std::max<std::uint32_t>( 1, std::min<std::uint32_t>( numberOfThreads, numberOfHops / ( warmUpHops * 4 ) ) ) );
+    std::unique_ptr<Chunk[]> const pChunks( new ( std::nothrow ) Chunk[ numberOfThreads ] );
+    if ( !pChunks )
+        return outOfMemory;
+
+    std::uint32_t const hopsPerChunk( ( numberOfHops + numberOfThreads - 1 ) / numberOfThreads );
+    for ( std::uint8_t chunkIndex( 0 ); chunkIndex < numberOfThreads; ++chunkIndex )
+    {
+        Chunk & chunk( pChunks[ chunkIndex ] );
+        chunk.pSamples        = pSamples;
+        chunk.numberOfSamples = numberOfSamples;
+        chunk.pSetup          = &setup;
+        chunk.lowerBound      = lowerBound;
+        chunk.upperBound      = upperBound;
+        chunk.beginHop        = std::min( chunkIndex * hopsPerChunk, numberOfHops );
+        chunk.endHop          = std::min( chunk.beginHop + hopsPerChunk, numberOfHops );
+        chunk.pPitches        = pPitches_.get();
+        chunk.error           = nullptr;
+    }
+
+    // The first chunk is analysed by the calling thread, chunks whose thread
+    // could not be created are analysed serially after it.
+    for ( std::uint8_t chunkIndex( 1 ); chunkIndex < numberOfThreads; ++chunkIndex )
+    {
+        Chunk & chunk( pChunks[ chunkIndex ] );
+    #ifdef _WIN32
+        chunk.thread = ::CreateThread
+        (
+            nullptr, 0,
+            []( void * const pChunk ) -> DWORD { analyseChunk( *static_cast<Chunk *>( pChunk ) ); return 0; },
+            &chunk, 0, nullptr
+        );
+    #else
+        chunk.running = ::pthread_create( &chunk.thread, nullptr, []( void * const pChunk ) -> void * { analyseChunk( *static_cast<Chunk *>( pChunk ) ); return nullptr; }, &chunk ) == 0;
+    #endif // _WIN32
+    }
+
+    analyseChunk( pChunks[ 0 ] );
+
+    char const * error( pChunks[ 0 ].error );
+    for ( std::uint8_t chunkIndex( 1 ); chunkIndex < numberOfThreads; ++chunkIndex )
+    {
+        Chunk & chunk( pChunks[ chunkIndex ] );
+    #ifdef _WIN32
+        if ( chunk.thread )
+        {
+            BOOST_VERIFY( ::WaitForSingleObject( chunk.thread, INFINITE ) == WAIT_OBJECT_0 );
+            BOOST_VERIFY( ::CloseHandle        ( chunk.thread           )                  );
+        }
+    #else
+        if ( chunk.running )
+            BOOST_VERIFY( ::pthread_join( chunk.thread, nullptr ) == 0 );
+    #endif // _WIN32
+        else
+            analyseChunk( chunk );
+        if ( chunk.error )
+            error = chunk.error;
+    }
+
+    return error;
+}
+
+
+LE_NOTHROW LE_HOT
+void PitchCurve::analyseChunk( Chunk & chunk )
+{
+    using namespace SW::Engine;
+
+    Setup const & setup( *chunk.pSetup );
+
+    auto const fftSize     ( setup.fftSize <std::uint16_t>() );
+    auto const stepSize    ( setup.stepSize<std::uint16_t>() );
+    auto const numberOfBins( setup.numberOfBins()            );
+    auto const imagsOffset ( Math::alignIndex( numberOfBins ) );
+
+    StorageFactors factors;
+    factors.fftSize          = fftSize;
+#if LE_SW_ENGINE_WINDOW_PRESUM
+    factors.windowSizeFactor = 1;
+#endif // LE_SW_ENGINE_WINDOW_PRESUM
+    factors.overlapFactor    = setup.windowOverlappingFactor<std::uint8_t>();
+    factors.numberOfChannels = 1;
+    factors.resolutionLayers = 1;
+    factors.samplerate       = setup.sampleRate<std::uint32_t>();
+
+    HeapSharedStorage fftStorage;
+    if ( !fftStorage.resize( Math::FFT_float_real_1D::requiredStorage( factors ) ) )
+    {
+        chunk.error = outOfMemory;
+        return;
+    }
+    Math::FFT_float_real_1D fft;
+    Storage storage( fftStorage );
+    fft.resize( factors, storage );
+
+    BOOST_SIMD_ALIGNED_SCOPED_STACK_BUFFER( window    , float, fftSize          );
+    BOOST_SIMD_ALIGNED_SCOPED_STACK_BUFFER( frame     , float, imagsOffset * 2u );
+    BOOST_SIMD_ALIGNED_SCOPED_STACK_BUFFER( amplitudes, float, numberOfBins     );
+    BOOST_SIMD_ALIGNED_SCOPED_STACK_BUFFER( phases    , float, numberOfBins     );
+    Math::calculateWindow( Math::DataRange( window.begin(), window.end() ), setup.windowFunction() );
+
+    float const * LE_RESTRICT const pSamples( chunk.pSamples );
+    float       * LE_RESTRICT const pFrame  ( frame.begin()  );
+    float       * LE_RESTRICT const pImags  ( &pFrame[ imagsOffset ] );
+
+    PitchDetector::ChannelState cs;
+    cs.reset();
+    for ( std::uint32_t hop( ( chunk.beginHop > warmUpHops ) ? chunk.beginHop - warmUpHops : 0 ); hop < chunk.endHop; ++hop )
+    {
+        // The frame ending at ( hop + 1 ) * stepSize, zero padded outside the
+        // signal (as the engine starts with windowSize - stepSize silent
+        // samples):
+        std::int64_t const frameBegin( std::int64_t( hop + 1 ) * stepSize - fftSize );
+        for ( std::uint16_t n( 0 ); n < fftSize; ++n )
+        {
+            std::int64_t const sample( frameBegin + n );
+            pFrame[ n ] = ( ( sample >= 0 ) && ( sample < chunk.numberOfSamples ) ) ? pSamples[ sample ] * window[ n ] : 0;
+        }
+        fft.transform( pFrame, Math::DataRange( pImags, pImags + numberOfBins ), true );
+        Math::reim2AmPh( pFrame, pImags, amplitudes.begin(), phases.begin(), numberOfBins );
+
+        float const pitch
+        (
+            PitchDetector::findPitch
+            (
+                ReadOnlyDataRange( amplitudes.begin(), amplitudes.end() ),
+                cs,
+                chunk.lowerBound,
+                chunk.upperBound,
+                setup
+            )
+        );
+        if ( hop >= chunk.beginHop )
+            chunk.pPitches[ hop ] = pitch;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// PitchCurve::smooth()
+// --------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+
+LE_NOTHROW LE_COLD
+char const * PitchCurve::smooth( std::uint8_t lookahead, std::uint8_t const maximumGap )
+{
+    lookahead = std::min( lookahead, maximumLookahead );
+
+    std::unique_ptr<float[]> pSmoothed( new ( std::nothrow ) float[ numberOfHops_ ] );
+    if ( !pSmoothed )
+        return outOfMemory;
+
+    float const * LE_RESTRICT const pPitches( pPitches_.get() );
+
+    // Median of the voiced hops around each voiced hop:
+    float neighbourhood[ 2 * maximumLookahead + 1 ];
+    for ( std::uint32_t hop( 0 ); hop < numberOfHops_; ++hop )
+    {
+        if ( pPitches[ hop ] == 0 )
+        {
+            pSmoothed[ hop ] = 0;
+            continue;
+        }
+        std::uint32_t const first( ( hop > lookahead ) ? hop - lookahead : 0 );
+        std::uint32_t const last ( std::min( hop + lookahead, numberOfHops_ - 1 ) );
+        std::uint8_t numberOfVoiced( 0 );
+        for ( std::uint32_t neighbour( first ); neighbour <= last; ++neighbour )
+        {
+            if ( pPitches[ neighbour ] != 0 )
+                neighbourhood[ numberOfVoiced++ ] = pPitches[ neighbour ];
+        }
+        BOOST_ASSERT( numberOfVoiced );
+        float * const pMedian( &neighbourhood[ numberOfVoiced / 2 ] );
+        std::nth_element( &neighbourhood[ 0 ], pMedian, &neighbourhood[ numberOfVoiced ] );
+        pSmoothed[ hop ] = *pMedian;
+    }
+
+    // Bridge short unvoiced gaps (consonants, detection dropouts) between
+    // voiced hops:
+    std::uint32_t lastVoiced( numberOfHops_ );
+    for ( std::uint32_t hop( 0 ); hop < numberOfHops_; ++hop )
+    {
+        if ( pSmoothed[ hop ] == 0 )
+            continue;
+        if ( ( lastVoiced != numberOfHops_ ) && ( hop - lastVoiced - 1 <= maximumGap ) )
+            std::fill( &pSmoothed[ lastVoiced + 1 ], &pSmoothed[ hop ], pSmoothed[ lastVoiced ] );
+        lastVoiced = hop;
+    }
+
+    pPitches_ = std::move( pSmoothed );
+    return nullptr;
+}
+
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_END( LE )
+//------------------------------------------------------------------------------
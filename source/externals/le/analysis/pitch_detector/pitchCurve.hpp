@@ -0,0 +1,86 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file pitchCurve.hpp
+/// --------------------
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef pitchCurve_hpp__5E0C27A9_B41D_4F36_8A9E_C73D162F08B4
+#define pitchCurve_hpp__5E0C27A9_B41D_4F36_8A9E_C73D162F08B4
+#pragma once
+//------------------------------------------------------------------------------
+#include "le/utility/platformSpecifics.hpp"
+
+#include "boost/config.hpp"
+
+#include <cstdint>
+#include <memory>
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_BEGIN( LE )
+//------------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class PitchCurve
+///
+/// \brief Per STFT hop pitch of a whole (offline) signal.
+///
+///   The first pass of batch pitch correction: PitchDetector::findPitch() is
+/// run over every hop of the signal, framed exactly as Engine::Processor frames
+/// it (hop n ends at sample ( n + 1 ) * stepSize), with the signal split into
+/// chunks analysed in parallel. As each hop is known in advance the curve can
+/// then be smoothed non-causally (with lookahead) so that note onsets and
+/// octave jumps are resolved using the hops that follow them. The second pass
+/// is a regular processing pass with TuneWorx modules following the curve
+/// instead of detecting the pitch (see Engine::ModuleDSP::followPitchCurve()).
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class PitchCurve
+{
+public:
+    PitchCurve();
+
+    /// Detects the pitch of every hop of the given mono signal, hops without
+    /// a detected pitch get a zero pitch. Returns nullptr on success or an
+    /// error message otherwise.
+    LE_NOTHROW char const * LE_FASTCALL analyse
+    (
+        float const * pSamples,
+        std::uint32_t numberOfSamples,
+        std::uint32_t sampleRate,
+        std::uint16_t fftSize,
+        std::uint8_t  overlapFactor,
+        float         lowerBound,
+        float         upperBound,
+        std::uint8_t  numberOfThreads
+    );
+
+    /// Replaces each voiced hop's pitch with the median of the voiced hops in
+    /// the surrounding +/- lookahead hops and bridges unvoiced gaps of up to
+    /// maximumGap hops (with the pitch of the hop preceding the gap). Returns
+    /// nullptr on success or an error message otherwise.
+    LE_NOTHROW char const * LE_FASTCALL smooth( std::uint8_t lookahead, std::uint8_t maximumGap );
+
+    float pitch( std::uint32_t const hop ) const { return ( hop < numberOfHops_ ) ? pPitches_[ hop ] : 0; }
+
+    std::uint32_t numberOfHops() const { return numberOfHops_; }
+
+    static std::uint8_t BOOST_CONSTEXPR_OR_CONST maximumLookahead = 32;
+
+private:
+    struct Chunk;
+
+    static void LE_FASTCALL analyseChunk( Chunk & );
+
+private:
+    std::unique_ptr<float[]> pPitches_    ;
+    std::uint32_t            numberOfHops_;
+}; // class PitchCurve
+
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_END( LE )
+//------------------------------------------------------------------------------
+#endif // pitchCurve_hpp
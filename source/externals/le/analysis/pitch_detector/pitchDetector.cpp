@@ -120,6 +120,26 @@ float LE_FASTCALL PitchDetector::findPitch
     float                                 const hfb,
     SW::Engine::Setup             const &       engineSetup
 )
+{
+    Candidates candidates;
+    analyse( amplitudes, candidates, engineSetup );
+    return estimate( candidates, cs, lfb, hfb );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// PitchDetector::analyse()
+// ------------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+
+void LE_FASTCALL PitchDetector::analyse
+(
+    SW::Engine::ReadOnlyDataRange const & amplitudes,
+    Candidates                          & candidates,
+    SW::Engine::Setup             const & engineSetup
+)
 {
     auto const numberOfBins( static_cast<std::uint16_t>( amplitudes.size() ) );
 
@@ -141,8 +161,41 @@ float LE_FASTCALL PitchDetector::findPitch
     // Find HPS spectrum:
     BOOST_SIMD_ALIGNED_SCOPED_STACK_BUFFER( hps, HPS, numberOfBins );
     findHarmonicProductSpectrumAndSort( filteredAmps, hps );
-    // Estimate pitch:
-    float pitch( estimatePitch( cs.lastPitch, lfb, hfb, hps, pd ) );
+
+    // Resolve the peaks of the strongest HPS bins (the only ones estimatePitch()
+    // considers):
+    candidates.size = static_cast<std::uint8_t>( std::min<std::uint16_t>( Candidates::maximumSize, numberOfBins ) );
+    for ( std::uint8_t k( 0 ); k < candidates.size; ++k )
+    {
+        auto       & candidate( candidates.candidates[ k ] );
+        auto const   pPeak    ( binPeak( hps[ k ].bin, pd ) );
+        candidate.harmonicProduct = hps[ k ].harmonicProduct;
+        candidate.bin             = hps[ k ].bin;
+        candidate.frequency       = pPeak ? pPeak->freq      : 0;
+        candidate.strength        = pPeak ? pPeak->strength  : 0;
+    #ifdef LE_SW_PURE_ANALYSIS
+        candidate.amplitude       = pPeak ? pPeak->amplitude : 0;
+    #endif // LE_SW_PURE_ANALYSIS
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// PitchDetector::estimate()
+// -------------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+
+float LE_FASTCALL PitchDetector::estimate
+(
+    Candidates   const &       candidates,
+    ChannelState       &       cs,
+    float              const lfb,
+    float              const hfb
+)
+{
+    float pitch( estimatePitch( cs.lastPitch, lfb, hfb, candidates ) );
 
 #ifdef LE_SW_PURE_ANALYSIS
     std::uint8_t const maximumConfidence        ( 5    );
@@ -172,19 +225,18 @@ float LE_FASTCALL PitchDetector::findPitch
             }
         }
 
-        BOOST_ASSERT( pd.getNumPeaks() != 0 );
         bool const newPitchIgnored( pitch == cs.lastPitch );
         if ( !newPitchIgnored )
         {
-            for ( std::uint16_t peakIndex( 0 ); ; ++peakIndex )
+            for ( std::uint8_t k( 0 ); ; ++k )
             {
-                Peak const & peak( *pd.getPeak( peakIndex ) );
-                if ( peak.freq == pitch )
+                BOOST_ASSERT( k < candidates.size );
+                auto const & candidate( candidates.candidates[ k ] );
+                if ( candidate.frequency == pitch )
                 {
-                    cs.amplitude = peak.amplitude;
+                    cs.amplitude = candidate.amplitude;
                     break;
                 }
-                BOOST_ASSERT( peakIndex < pd.getNumPeaks() );
             }
         }
     }
@@ -255,13 +307,14 @@ void LE_HOT PitchDetector::findHarmonicProductSpectrumAndSort( SW::Engine::ReadO
 
 float LE_HOT PitchDetector::estimatePitch
 (
-    float                const lastPitch,
-    float                const lowerBound,
-    float                const upperBound,
-    HPSRange             const hps,
-    PeakDetector const &       pd
+    float              const lastPitch,
+    float              const lowerBound,
+    float              const upperBound,
+    Candidates const &       candidates
 )
 {
+    auto const & hps( candidates.candidates );
+
 	float         detectedPitch			   ( 0 );
 	float         detectedPitchPeakStrength( 0 );
 	std::uint16_t detectedPitchBin         ( 0 );
@@ -269,21 +322,20 @@ float LE_HOT PitchDetector::estimatePitch
 
     // Search top 30 in the HPS:
     LE_DISABLE_LOOP_UNROLLING()
-    for ( std::uint8_t k( 0 ); k < 30; ++k ) //...mrmlj...can two HPS' bins be under the same peak?
+    for ( std::uint8_t k( 0 ); k < std::min<std::uint8_t>( 30, candidates.size ); ++k ) //...mrmlj...can two HPS' bins be under the same peak?
     {
         // If HPS bin is inside a peak and within the bounds then it is the pitch:
         auto const hpsBin( hps[ k ].bin );
-        auto const pPeak ( binPeak( hpsBin, pd ) );
-        if ( pPeak )
+        if ( hps[ k ].frequency )
         {
-            float const pitch       ( pPeak->freq                                  );
+            float const pitch       ( hps[ k ].frequency                           );
             float const clampedPitch( Math::clamp( pitch, lowerBound, upperBound ) );
             if ( clampedPitch == pitch )
 			{
                 detectedPitch             = pitch;
 				detectedPitchBin          = hpsBin;
 				detectedPitchHPSIndex     = k;
-				detectedPitchPeakStrength = pPeak->strength;
+				detectedPitchPeakStrength = hps[ k ].strength;
 				break;
 			}
         }
@@ -298,7 +350,7 @@ float LE_HOT PitchDetector::estimatePitch
         LE_DISABLE_LOOP_UNROLLING()
 		while
         (
-            ( pos < 50 /*heuristic*/                                                                        ) &&
+            ( pos < candidates.size /*heuristic*/                                                           ) &&
             ( std::abs( detectedPitch - lastPitch ) > 100 /*heuristic*/ /*Hz*/                              ) &&
             ( hps[ pos ].harmonicProduct > 0.4 /*heuristic*/ * hps[ detectedPitchHPSIndex ].harmonicProduct )
         )
@@ -312,9 +364,8 @@ float LE_HOT PitchDetector::estimatePitch
 			// Check if current bin is possibly a lower harmonic of originally detected pitch:
 			if ( Math::abs( detectedPitchBin - Math::round( detectedPitchBin * 1.0f / lowHarmonicBin ) * lowHarmonicBin ) < 3 )
 			{
-				auto const pPeak( binPeak( lowHarmonicBin, pd ) );
-				auto const lowHarmonicPitch       ( pPeak ? pPeak->freq     : 0 );
-				auto const lowHarmonicPeakStrength( pPeak ? pPeak->strength : 0 );
+				auto const lowHarmonicPitch       ( hps[ pos ].frequency );
+				auto const lowHarmonicPeakStrength( hps[ pos ].strength  );
 				// Accept the lower harmonic as pitch if it is closer to the
 				// previous pitch and if peak strength is large enough:
 				if
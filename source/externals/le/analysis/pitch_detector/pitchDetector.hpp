@@ -16,6 +16,7 @@
 
 #include <boost/range/iterator_range_core.hpp>
 
+#include <array>
 #include <cstdint>
 //------------------------------------------------------------------------------
 namespace LE { namespace SW { LE_IMPL_NAMESPACE_BEGIN( Engine ) class Setup; LE_IMPL_NAMESPACE_END( Engine ) } }
@@ -50,6 +51,11 @@ struct HPS
 /// these two information pitch is estimated. Example: HPS says the pitch
 /// is concentrated in bin x; if bin x belongs to the peak y, then parabola
 /// fit frequency is taken from the peak y and that is the pitch.
+///
+///   The (expensive) peak detection and HPS depend only on the amplitudes
+/// and are available separately (analyse()) from the (cheap) estimation
+/// which depends on the detection bounds and the ChannelState (estimate())
+/// so that the former can be shared by detectors tracking the same signal.
 /// 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -70,14 +76,38 @@ public:
         void reset();
     }; // struct ChannelState
 
+    /// The strongest HPS bins (in descending order) with the peaks they
+    /// belong to (a zero frequency if they do not belong to any).
+    struct Candidates
+    {
+        struct Candidate
+        {
+            float         harmonicProduct;
+            float         frequency      ;
+            float         strength       ;
+        #ifdef LE_SW_PURE_ANALYSIS
+            float         amplitude      ;
+        #endif // LE_SW_PURE_ANALYSIS
+            std::uint16_t bin            ;
+        }; // struct Candidate
+
+        static std::uint8_t const maximumSize = 50;
+
+        std::array<Candidate, maximumSize> candidates;
+        std::uint8_t                       size      ;
+    }; // struct Candidates
+
 public:
     static float LE_FASTCALL findPitch( SW::Engine::ReadOnlyDataRange const & amplitudes, ChannelState &, float lfb, float hfb, SW::Engine::Setup const & );
 
+    static void  LE_FASTCALL analyse ( SW::Engine::ReadOnlyDataRange const & amplitudes, Candidates &, SW::Engine::Setup const & );
+    static float LE_FASTCALL estimate( Candidates const &, ChannelState &, float lfb, float hfb );
+
 private:
     using HPSRange = boost::iterator_range<HPS * LE_RESTRICT>;
 
     static void          LE_FASTCALL findHarmonicProductSpectrumAndSort( SW::Engine::ReadOnlyDataRange amplitudes, HPSRange );
-    static float         LE_FASTCALL estimatePitch( float lastPitch, float lfb, float hfb, HPSRange, PeakDetector const & );
+    static float         LE_FASTCALL estimatePitch( float lastPitch, float lfb, float hfb, Candidates const & );
     static Peak  const * LE_FASTCALL binPeak      ( std::uint16_t bin, PeakDetector const & );
 }; // class PitchDetector
 
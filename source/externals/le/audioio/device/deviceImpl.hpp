@@ -168,7 +168,7 @@ template <ChannelLayout channelLayoutParam, InputOutputLayout ioLayoutParam>
 struct CallbackInfo<Device::Audio<channelLayoutParam, ioLayoutParam>> { static ChannelLayout const channelLayout = channelLayoutParam; static InputOutputLayout const ioLayout = ioLayoutParam; };
 
 #ifdef LE_SDK_DEMO_BUILD
-    Utility::LE_DEMO_LIMITER<500, 6000, 3000> ljitikmer;
+    LE_WEAK_SYMBOL Utility::LE_DEMO_LIMITER<500, 6000, 3000> ljitikmer; // shared by all the device implementations in the module
     #define LE_AUDIOIO_CRIPPLE( ... ) ljitikmer.LE_DEMO_CRIPPLE( __VA_ARGS__ )
 #else
     #define LE_AUDIOIO_CRIPPLE( ... )
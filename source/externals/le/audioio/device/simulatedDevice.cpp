@@ -0,0 +1,381 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// simulatedDevice.cpp
+/// -------------------
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#include "simulatedDevice.hpp"
+
+#include "deviceImpl.hpp"
+
+#include "le/audioio/file/inputWaveFile.hpp"
+#include "le/audioio/file/outputWaveFile.hpp"
+#include "le/utility/pimplPrivate.hpp"
+#include "le/utility/platformSpecifics.hpp"
+
+#include "boost/assert.hpp"
+
+#ifdef _WIN32
+    #include "le/utility/windowsLite.hpp"
+#else
+    #include "pthread.h"
+#endif // _WIN32
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <new>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <utility>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace AudioIO
+{
+//------------------------------------------------------------------------------
+
+#pragma warning( push )
+#pragma warning( disable : 4512 ) // Assignment operator could not be generated.
+
+class SimulatedDeviceImpl
+{
+public:
+    using Simulation = SimulatedDevice::Simulation;
+    using Statistics = SimulatedDevice::Statistics;
+
+    SimulatedDeviceImpl() : render_( nullptr ) {}
+    ~SimulatedDeviceImpl() { stop(); }
+
+    error_msg_t setup( std::uint8_t const numberOfChannels, std::uint32_t const sampleRate, std::uint16_t const callbackSize )
+    {
+        BOOST_ASSERT_MSG( !running(), "SimulatedDevice reconfigured while running." );
+        if ( !numberOfChannels || !sampleRate || !callbackSize )
+            return "Invalid simulated device configuration.";
+
+        pSession_.reset( new ( std::nothrow ) Session );
+        if ( !pSession_ )
+            return "Out of memory.";
+        auto & session( *pSession_ );
+        session.pSamples .reset( new ( std::nothrow ) float  [ numberOfChannels * callbackSize ] );
+        session.pChannels.reset( new ( std::nothrow ) float *[ numberOfChannels                ] );
+        if ( !session.pSamples || !session.pChannels )
+        {
+            pSession_.reset();
+            return "Out of memory.";
+        }
+        for ( std::uint8_t channel( 0 ); channel < numberOfChannels; ++channel )
+            session.pChannels[ channel ] = &session.pSamples[ channel * callbackSize ];
+
+        session.numberOfChannels = numberOfChannels;
+        session.sampleRate       = sampleRate      ;
+        session.callbackSize     = callbackSize    ;
+        return nullptr;
+    }
+
+    error_msg_t setInput( InputWaveFile * const pFile )
+    {
+        BOOST_ASSERT_MSG( pSession_ && !running(), "SimulatedDevice not set up or running." );
+        if ( pFile && pFile->numberOfChannels() != pSession_->numberOfChannels )
+            return "Input file channel count does not match the simulated device configuration.";
+        pSession_->pInputFile = pFile;
+        return nullptr;
+    }
+
+    void setOutput( OutputWaveFile * const pFile )
+    {
+        BOOST_ASSERT_MSG( pSession_ && !running(), "SimulatedDevice not set up or running." );
+        pSession_->pOutputFile = pFile;
+    }
+
+    void setSimulation( Simulation const & simulation )
+    {
+        BOOST_ASSERT_MSG( pSession_ && !running(), "SimulatedDevice not set up or running." );
+        BOOST_ASSERT_MSG( simulation.jitter >= 0, "Negative jitter." );
+        BOOST_ASSERT_MSG( simulation.pProcessingTimes || !simulation.processingTimesCapacity, "Processing time log capacity given without storage." );
+        pSession_->simulation = simulation;
+    }
+
+    std::uint8_t  numberOfChannels() const { BOOST_ASSERT( pSession_ ); return pSession_->numberOfChannels; }
+    std::uint32_t sampleRate      () const { BOOST_ASSERT( pSession_ ); return pSession_->sampleRate      ; }
+
+    template <class DataLayout>
+    error_msg_t setCallback( typename Callback<DataLayout>::parameter_type callback )
+    {
+        BOOST_ASSERT_MSG( pSession_ && !running(), "SimulatedDevice not set up or running." );
+        storeCallback<DataLayout>( callback_, std::move( callback ) );
+        render_ = &SimulatedDeviceImpl::render<DataLayout>;
+        return nullptr;
+    }
+
+    void start()
+    {
+        BOOST_ASSERT_MSG( pSession_ && render_, "SimulatedDevice not set up or no callback set." );
+        BOOST_ASSERT_MSG( !running()          , "SimulatedDevice already running."                );
+        auto & session( *pSession_ );
+        session.stop.store( false, std::memory_order_relaxed );
+    #ifdef _WIN32
+        session.thread = ::CreateThread
+        (
+            nullptr, 0,
+            []( void * const pDevice ) -> DWORD { static_cast<SimulatedDeviceImpl *>( pDevice )->run(); return 0; },
+            this, 0, nullptr
+        );
+        session.running = session.thread != nullptr;
+    #else
+        session.running = ::pthread_create( &session.thread, nullptr, []( void * const pDevice ) -> void * { static_cast<SimulatedDeviceImpl *>( pDevice )->run(); return nullptr; }, this ) == 0;
+    #endif // _WIN32
+        BOOST_ASSERT_MSG( session.running, "Failed to start the simulation thread." );
+    }
+
+    void wait()
+    {
+        if ( !running() )
+            return;
+        auto & session( *pSession_ );
+    #ifdef _WIN32
+        BOOST_VERIFY( ::WaitForSingleObject( session.thread, INFINITE ) == WAIT_OBJECT_0 );
+        BOOST_VERIFY( ::CloseHandle        ( session.thread           )                  );
+        session.thread = nullptr;
+    #else
+        BOOST_VERIFY( ::pthread_join( session.thread, nullptr ) == 0 );
+    #endif // _WIN32
+        session.running = false;
+    }
+
+    void stop()
+    {
+        if ( !running() )
+            return;
+        pSession_->stop.store( true, std::memory_order_relaxed );
+        wait();
+    }
+
+    Statistics const & statistics() const
+    {
+        BOOST_ASSERT_MSG( pSession_ && !running(), "SimulatedDevice not set up or running." );
+        return pSession_->statistics;
+    }
+
+private:
+    using Clock    = std::chrono::steady_clock;
+    using Interval = std::pair<Clock::time_point, Clock::time_point>;
+
+    struct Session
+    {
+        Session()
+            :
+            pInputFile ( nullptr ),
+            pOutputFile( nullptr ),
+            running    ( false   ),
+            stop       ( false   )
+        {
+            simulation.pacing                  = SimulatedDevice::FreeRunning;
+            simulation.jitter                  = 0;
+            simulation.lengthInSampleFrames    = 0;
+            simulation.pProcessingTimes        = nullptr;
+            simulation.processingTimesCapacity = 0;
+        }
+
+        std::unique_ptr<float   []> pSamples ;
+        std::unique_ptr<float * []> pChannels; ///< pointers into pSamples (for the separated channel layouts)
+
+        std::uint8_t  numberOfChannels;
+        std::uint32_t sampleRate      ;
+        std::uint16_t callbackSize    ;
+
+        InputWaveFile  * pInputFile ;
+        OutputWaveFile * pOutputFile;
+
+        Simulation simulation;
+        Statistics statistics;
+
+        bool              running;
+        std::atomic<bool> stop   ;
+    #ifdef _WIN32
+        ::HANDLE    thread;
+    #else
+        ::pthread_t thread;
+    #endif // _WIN32
+    }; // struct Session
+
+    bool running() const { return pSession_ && pSession_->running; }
+
+    float *         signal( std::integral_constant<ChannelLayout, Device::InterleavedChannels> ) const { return pSession_->pSamples .get(); }
+    float * const * signal( std::integral_constant<ChannelLayout, Device::SeparatedChannels  > ) const { return pSession_->pChannels.get(); }
+
+    void clearTail( std::uint32_t const validFrames, std::uint16_t const frames, std::integral_constant<ChannelLayout, Device::InterleavedChannels> )
+    {
+        auto const numberOfChannels( pSession_->numberOfChannels );
+        std::fill( &pSession_->pSamples[ validFrames * numberOfChannels ], &pSession_->pSamples[ frames * numberOfChannels ], 0.0f );
+    }
+    void clearTail( std::uint32_t const validFrames, std::uint16_t const frames, std::integral_constant<ChannelLayout, Device::SeparatedChannels> )
+    {
+        for ( std::uint8_t channel( 0 ); channel < pSession_->numberOfChannels; ++channel )
+            std::fill( &pSession_->pChannels[ channel ][ validFrames ], &pSession_->pChannels[ channel ][ frames ], 0.0f );
+    }
+
+    /// Fetches the input (if any), calls the user callback and stores the
+    /// output (if any). Only the callback itself is timed (the returned
+    /// interval) so that file IO does not count against the deadline.
+    template <class DataLayout>
+    static Interval render( SimulatedDeviceImpl & device, std::uint16_t const frames )
+    {
+        using Info   = CallbackInfo<DataLayout>;
+        using Layout = std::integral_constant<ChannelLayout, Info::channelLayout>;
+
+        auto       & session( *device.pSession_ );
+        auto const   pSignal( device.signal( Layout() ) );
+
+        bool const hasInput ( Info::ioLayout == Device::InputOnly  || Info::ioLayout == Device::Inplace );
+        bool const hasOutput( Info::ioLayout == Device::OutputOnly || Info::ioLayout == Device::Inplace );
+        if ( hasInput )
+        {
+            std::uint32_t const validFrames( session.pInputFile ? session.pInputFile->read( pSignal, frames ) : 0 );
+            device.clearTail( validFrames, frames, Layout() );
+        }
+
+        DataLayout const data = { pSignal, frames };
+        Interval interval;
+        interval.first  = Clock::now();
+        invoke( device.callback_, data );
+        interval.second = Clock::now();
+
+        if ( hasOutput && session.pOutputFile )
+            BOOST_VERIFY( session.pOutputFile->write( pSignal, frames ) == nullptr );
+
+        return interval;
+    }
+
+    void run()
+    {
+        auto       & session   ( *pSession_               );
+        auto const & simulation( session.simulation       );
+        auto       & statistics( session.statistics       );
+
+        auto const period( std::chrono::duration_cast<Clock::duration>( std::chrono::duration<double>( double( session.callbackSize ) / session.sampleRate ) ) );
+
+        std::uint32_t remainingFrames( simulation.lengthInSampleFrames );
+        if ( !remainingFrames )
+            remainingFrames = session.pInputFile ? session.pInputFile->remainingSampleFrames() : std::numeric_limits<std::uint32_t>::max();
+
+        statistics.callbacks             = 0;
+        statistics.deadlineMisses        = 0;
+        statistics.minimumProcessingTime = std::numeric_limits<std::uint32_t>::max();
+        statistics.maximumProcessingTime = 0;
+        statistics.totalProcessingTime   = 0;
+        statistics.bufferPeriod          = static_cast<std::uint32_t>( std::chrono::duration_cast<std::chrono::microseconds>( period ).count() );
+        statistics.processedSampleFrames = 0;
+
+        // Fixed seed: reproducible jitter across runs.
+        std::minstd_rand                      randomGenerator;
+        std::uniform_real_distribution<float> jitter( 0, simulation.jitter );
+
+        bool      const paced         ( simulation.pacing == SimulatedDevice::RealTime );
+        Clock::time_point scheduledStart( Clock::now() );
+        while ( remainingFrames && !session.stop.load( std::memory_order_relaxed ) )
+        {
+            auto const frames( static_cast<std::uint16_t>( std::min<std::uint32_t>( remainingFrames, session.callbackSize ) ) );
+
+            if ( paced )
+                std::this_thread::sleep_until( scheduledStart + std::chrono::duration_cast<Clock::duration>( period * jitter( randomGenerator ) ) );
+
+            auto const interval( render_( *this, frames ) );
+            if ( !paced )
+                scheduledStart = interval.first;
+
+            auto const processingTime( static_cast<std::uint32_t>( std::chrono::duration_cast<std::chrono::microseconds>( interval.second - interval.first ).count() ) );
+            if ( statistics.callbacks < simulation.processingTimesCapacity )
+                simulation.pProcessingTimes[ statistics.callbacks ] = processingTime;
+            statistics.minimumProcessingTime  = std::min( statistics.minimumProcessingTime, processingTime );
+            statistics.maximumProcessingTime  = std::max( statistics.maximumProcessingTime, processingTime );
+            statistics.totalProcessingTime   += processingTime;
+            statistics.processedSampleFrames += frames;
+            statistics.callbacks             ++;
+
+            scheduledStart += period;
+            if ( interval.second > scheduledStart )
+            {
+                ++statistics.deadlineMisses;
+                // Resynchronise (as a device would after an underrun) instead
+                // of counting every following callback as late.
+                if ( paced )
+                    scheduledStart = interval.second;
+            }
+
+            remainingFrames -= frames;
+        }
+
+        if ( !statistics.callbacks )
+            statistics.minimumProcessingTime = 0;
+    }
+
+private:
+    PublicCallback callback_;
+    Interval (* render_)( SimulatedDeviceImpl &, std::uint16_t frames );
+
+    std::unique_ptr<Session> pSession_;
+}; // class SimulatedDeviceImpl
+
+#pragma warning( pop )
+
+//------------------------------------------------------------------------------
+} // namespace AudioIO
+//------------------------------------------------------------------------------
+
+
+////////////////////////////////////////////////////////////////////////////////
+// PImpl forwarders
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Utility
+{
+//------------------------------------------------------------------------------
+
+template <>
+struct Implementation<AudioIO::SimulatedDevice> { using type = AudioIO::SimulatedDeviceImpl; };
+
+//------------------------------------------------------------------------------
+} // namespace Utility
+//------------------------------------------------------------------------------
+namespace AudioIO
+{
+//------------------------------------------------------------------------------
+
+LE_NOTHROW LE_COLD SimulatedDevice:: SimulatedDevice() {}
+LE_NOTHROW LE_COLD SimulatedDevice::~SimulatedDevice() {}
+
+LE_NOTHROW LE_COLD error_msg_t LE_FASTCALL_ABI SimulatedDevice::setup( std::uint8_t const numberOfChannels, std::uint32_t const sampleRate, std::uint16_t const callbackSizeInFrames ) { return impl( *this ).setup( numberOfChannels, sampleRate, callbackSizeInFrames ); }
+
+LE_NOTHROW LE_COLD error_msg_t LE_FASTCALL_ABI SimulatedDevice::setInput     ( InputWaveFile  * const pFile      ) { return impl( *this ).setInput     ( pFile      ); }
+LE_NOTHROW LE_COLD void        LE_FASTCALL_ABI SimulatedDevice::setOutput    ( OutputWaveFile * const pFile      ) { return impl( *this ).setOutput    ( pFile      ); }
+LE_NOTHROW LE_COLD void        LE_FASTCALL_ABI SimulatedDevice::setSimulation( Simulation const &     simulation ) { return impl( *this ).setSimulation( simulation ); }
+
+LE_NOTHROWNOALIAS LE_COLD std::uint8_t  LE_FASTCALL_ABI SimulatedDevice::numberOfChannels() const { return impl( *this ).numberOfChannels(); }
+LE_NOTHROWNOALIAS LE_COLD std::uint32_t LE_FASTCALL_ABI SimulatedDevice::sampleRate      () const { return impl( *this ).sampleRate      (); }
+
+LE_NOTHROW LE_COLD void LE_FASTCALL_ABI SimulatedDevice::start() { impl( *this ).start(); }
+LE_NOTHROW LE_COLD void LE_FASTCALL_ABI SimulatedDevice::wait () { impl( *this ).wait (); }
+LE_NOTHROW LE_COLD void LE_FASTCALL_ABI SimulatedDevice::stop () { impl( *this ).stop (); }
+
+LE_NOTHROWNOALIAS LE_COLD SimulatedDevice::Statistics const & LE_FASTCALL_ABI SimulatedDevice::statistics() const { return impl( *this ).statistics(); }
+
+LE_NOTHROW LE_COLD error_msg_t LE_FASTCALL_ABI SimulatedDevice::setCallback( Device::Callback<Device::Input                 >::parameter_type callback ) { return impl( *this ).setCallback<Device::Input                 >( std::move( callback ) ); }
+LE_NOTHROW LE_COLD error_msg_t LE_FASTCALL_ABI SimulatedDevice::setCallback( Device::Callback<Device::Output                >::parameter_type callback ) { return impl( *this ).setCallback<Device::Output                >( std::move( callback ) ); }
+LE_NOTHROW LE_COLD error_msg_t LE_FASTCALL_ABI SimulatedDevice::setCallback( Device::Callback<Device::InputOutput           >::parameter_type callback ) { return impl( *this ).setCallback<Device::InputOutput           >( std::move( callback ) ); }
+LE_NOTHROW LE_COLD error_msg_t LE_FASTCALL_ABI SimulatedDevice::setCallback( Device::Callback<Device::InterleavedInput      >::parameter_type callback ) { return impl( *this ).setCallback<Device::InterleavedInput      >( std::move( callback ) ); }
+LE_NOTHROW LE_COLD error_msg_t LE_FASTCALL_ABI SimulatedDevice::setCallback( Device::Callback<Device::InterleavedOutput     >::parameter_type callback ) { return impl( *this ).setCallback<Device::InterleavedOutput     >( std::move( callback ) ); }
+LE_NOTHROW LE_COLD error_msg_t LE_FASTCALL_ABI SimulatedDevice::setCallback( Device::Callback<Device::InterleavedInputOutput>::parameter_type callback ) { return impl( *this ).setCallback<Device::InterleavedInputOutput>( std::move( callback ) ); }
+
+//------------------------------------------------------------------------------
+} // namespace AudioIO
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
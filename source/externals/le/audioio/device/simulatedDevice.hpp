@@ -0,0 +1,179 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file simulatedDevice.hpp
+/// -------------------------
+///
+/// Headless (file driven) audio IO.
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef simulatedDevice_hpp__6D2F0C83_A4B1_4E58_9F27_C1E6B3D0847A
+#define simulatedDevice_hpp__6D2F0C83_A4B1_4E58_9F27_C1E6B3D0847A
+#pragma once
+//------------------------------------------------------------------------------
+#include "device.hpp"
+
+#include <cstddef>
+#include <cstdint>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace AudioIO
+{
+//------------------------------------------------------------------------------
+
+class InputWaveFile ;
+class OutputWaveFile;
+
+/// \addtogroup AudioIO
+/// @{
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class SimulatedDevice
+///
+/// \brief Drives the same callbacks as Device but without any audio hardware:
+/// input is read from an InputWaveFile, output is written to an
+/// OutputWaveFile and the callback is called from a private thread either as
+/// fast as possible or paced to (a jittered) real time.
+///
+///   Every callback is timed against its deadline (the scheduled start of the
+/// callback plus the simulated buffer period) which makes it possible to
+/// measure the full, host-style, processing path (e.g. on build machines
+/// without sound hardware).
+///
+/// \nosubgrouping
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class SimulatedDevice
+#ifndef DOXYGEN_ONLY
+    : public Utility::StackPImpl<SimulatedDevice, sizeof( Device::Callback<std::nullptr_t>::type ) + 2 * sizeof( void * )>
+#endif // DOXYGEN_ONLY
+{
+public:
+    LE_NOTHROW  SimulatedDevice();
+    LE_NOTHROW ~SimulatedDevice(); ///< Calls stop().
+
+    enum Pacing
+    {
+        FreeRunning, ///< callbacks follow each other immediately (faster than real time)
+        RealTime     ///< callbacks are started at buffer period intervals
+    };
+
+    struct Simulation
+    {
+        Pacing        pacing;
+        float         jitter;               ///< maximum (random) delay of a callback start, relative to the buffer period (RealTime pacing only)
+        std::uint32_t lengthInSampleFrames; ///< zero - until the input file is exhausted (or stop() is called)
+        std::uint32_t * pProcessingTimes;   ///< optional, receives the processing time (in microseconds) of the first processingTimesCapacity callbacks
+        std::uint32_t   processingTimesCapacity;
+    }; // struct Simulation
+
+    struct Statistics
+    {
+        std::uint32_t callbacks             ;
+        std::uint32_t deadlineMisses        ;
+        std::uint32_t minimumProcessingTime ; ///< in microseconds
+        std::uint32_t maximumProcessingTime ; ///< in microseconds
+        std::uint64_t totalProcessingTime   ; ///< in microseconds
+        std::uint32_t bufferPeriod          ; ///< in microseconds
+        std::uint32_t processedSampleFrames ;
+    }; // struct Statistics
+
+    /// \name Configuration
+    /// @{
+
+    /// <B>Effect:</B> Configures the simulated device to consume and/or
+    /// produce audio data in the given format, with callbacks of (at most)
+    /// <VAR>callbackSizeInFrames</VAR> sample frames.<BR>
+    /// Resets the input, output and simulation settings (to no input, no
+    /// output, free running until stopped).<BR>
+    /// <B>Preconditions:</B> The instance must be in the stopped state.
+    LE_NOTHROW error_msg_t LE_FASTCALL_ABI setup( std::uint8_t numberOfChannels, std::uint32_t sampleRate, std::uint16_t callbackSizeInFrames );
+
+    /// <B>Effect:</B> Sets the file from which the callback input is read
+    /// (null - silence). The file must outlive the simulation.<BR>
+    /// <B>Preconditions:</B>
+    /// - a successful setup() call
+    /// - an opened file with the configured number of channels
+    /// - the instance must be in the stopped state.
+    LE_NOTHROW error_msg_t LE_FASTCALL_ABI setInput ( InputWaveFile  * );
+    /// <B>Effect:</B> Sets the file to which the callback output is written
+    /// (null - discarded). The file must outlive the simulation.<BR>
+    /// <B>Preconditions:</B> the same as for setInput().
+    LE_NOTHROW void        LE_FASTCALL_ABI setOutput( OutputWaveFile * );
+
+    /// <B>Preconditions:</B>
+    /// - a successful setup() call
+    /// - the instance must be in the stopped state.
+    LE_NOTHROW void LE_FASTCALL_ABI setSimulation( Simulation const & );
+
+    LE_NOTHROWNOALIAS std::uint8_t  LE_FASTCALL_ABI numberOfChannels() const;
+    LE_NOTHROWNOALIAS std::uint32_t LE_FASTCALL_ABI sampleRate      () const;
+
+    /// @}
+
+    /// \name Simulation control
+    /// @{
+
+    /// <B>Effect:</B> Starts the simulation thread. Non-blocking, see wait().<BR>
+    /// <B>Preconditions:</B>
+    ///     - successful setup() and setCallback() calls
+    ///     - the instance must be in the stopped state.
+    LE_NOTHROW void LE_FASTCALL_ABI start();
+    /// <B>Effect:</B> Blocks until the simulation finishes (the configured
+    /// length was simulated or the input file exhausted).
+    LE_NOTHROW void LE_FASTCALL_ABI wait ();
+    /// <B>Effect:</B> Ends the simulation (if any) after the current callback.
+    LE_NOTHROW void LE_FASTCALL_ABI stop ();
+
+    /// <B>Preconditions:</B> The instance must be in the stopped state.
+    LE_NOTHROWNOALIAS Statistics const & LE_FASTCALL_ABI statistics() const;
+
+    /// @}
+
+    /// \name Callbacks
+    /// \details The same callback types as with Device::setCallback() are
+    /// supported.<BR>
+    /// <B>Preconditions:</B>
+    /// - a successful setup() call
+    /// - the instance must be in the stopped state.
+    /// @{
+
+    LE_NOTHROW error_msg_t LE_FASTCALL_ABI setCallback( Device::Callback<Device::Input                 >::parameter_type );
+    LE_NOTHROW error_msg_t LE_FASTCALL_ABI setCallback( Device::Callback<Device::Output                >::parameter_type );
+    LE_NOTHROW error_msg_t LE_FASTCALL_ABI setCallback( Device::Callback<Device::InputOutput           >::parameter_type );
+    LE_NOTHROW error_msg_t LE_FASTCALL_ABI setCallback( Device::Callback<Device::InterleavedInput      >::parameter_type );
+    LE_NOTHROW error_msg_t LE_FASTCALL_ABI setCallback( Device::Callback<Device::InterleavedOutput     >::parameter_type );
+    LE_NOTHROW error_msg_t LE_FASTCALL_ABI setCallback( Device::Callback<Device::InterleavedInputOutput>::parameter_type );
+
+#ifndef __APPLE__
+    /// \overload
+    template <class DataLayout, typename Functor>
+    error_msg_t setCallback( Functor && functor ) { return setCallback( typename Device::Callback<DataLayout>::type( std::forward<Functor>( functor ) ) ); }
+#endif // __APPLE__
+
+    /// @}
+
+#if defined( _MSC_VER ) && ( _MSC_VER < 1800 )
+private:
+    SimulatedDevice( SimulatedDevice const  & );
+    SimulatedDevice( SimulatedDevice       && );
+#else
+    SimulatedDevice( SimulatedDevice const  & ) = delete;
+    SimulatedDevice( SimulatedDevice       && ) = delete;
+#endif // _MSC_VER
+}; // class SimulatedDevice
+
+/// @} // group AudioIO
+
+//------------------------------------------------------------------------------
+} // namespace AudioIO
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // simulatedDevice_hpp
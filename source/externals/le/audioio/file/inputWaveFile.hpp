@@ -83,6 +83,8 @@ public:
     ///     - the buffer pointed to by pOutput must be large enough to hold <VAR>numberOfSampleFrames</VAR> * numberOfChannels() samples.
     /// \return Number of sample frames actually read (always <= <VAR>numberOfSampleFrames</VAR>)
     LE_NOTHROW        std::uint32_t  LE_FASTCALL_ABI read             ( float * pOutput, std::uint32_t numberOfSampleFrames ) const;
+    /// <B>Effect:</B> Same as above but deinterleaves the data into numberOfChannels() separate buffers (each large enough to hold <VAR>numberOfSampleFrames</VAR> samples).<BR>
+    LE_NOTHROW        std::uint32_t  LE_FASTCALL_ABI read             ( float * const * pOutputs, std::uint32_t numberOfSampleFrames ) const;
 
     /// <B>Effect:</B> Reads (<VAR>numberOfSampleFrames</VAR> *
     /// numberOfChannels()) interleaved samples into <VAR>pOutput</VAR>. If the
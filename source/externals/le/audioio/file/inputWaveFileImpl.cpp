@@ -9,7 +9,7 @@
 //------------------------------------------------------------------------------
 #include "inputWaveFileImpl.hpp"
 
-#include "le/math/vector.hpp"
+#include "le/math/pcmConversion.hpp"
 
 #include "le/utility/pimplPrivate.hpp"
 #include "le/utility/platformSpecifics.hpp"
@@ -139,11 +139,13 @@ char const * LE_COLD InputWaveFileImpl::open( void const * LE_RESTRICT const map
         (
             dataType == Integer &&
             pFormat->fmt.Format.wBitsPerSample != 16 &&
-            pFormat->fmt.Format.wBitsPerSample != 24
+            pFormat->fmt.Format.wBitsPerSample != 24 &&
+            pFormat->fmt.Format.wBitsPerSample != 32
         ) ||
         (
             dataType == Float &&
-            pFormat->fmt.Format.wBitsPerSample != 32
+            pFormat->fmt.Format.wBitsPerSample != 32 &&
+            pFormat->fmt.Format.wBitsPerSample != 64
         )
     )
     {
@@ -161,65 +163,55 @@ char const * LE_COLD InputWaveFileImpl::open( void const * LE_RESTRICT const map
 }
 
 
-std::uint32_t LE_HOT LE_FASTCALL InputWaveFileImpl::read( float * LE_RESTRICT /*const*/ pOutput, std::uint32_t samples ) const
+Math::PCM::Format InputWaveFileImpl::format() const
 {
-    BOOST_ASSERT_MSG( !!*this, "No file open." );
-
-    samples = std::min( samples, remainingSamples() );
-
     using namespace Detail;
+    using Math::PCM::Format;
 
-    auto const totalSamples( samples * numberOfChannels() );
-
-    if
+    bool const isFloat
     (
         ( pFormat_->Format.wFormatTag == WAVE_FORMAT_IEEE_FLOAT ) ||
         (
             pFormat_->Format.wFormatTag == WAVE_FORMAT_EXTENSIBLE &&
             pFormat_->SubFormat         == KSDATAFORMAT_SUBTYPE_IEEE_FLOAT
         )
-    )
-    {
-        float const * LE_RESTRICT pInput( reinterpret_cast<float const *>( pData_ ) );
-        BOOST_ASSERT( pFormat_->Format.wBitsPerSample == sizeof( *pInput ) * 8 );
-        std::copy( pInput, pInput + totalSamples, pOutput );
-        pData_ += totalSamples * sizeof( *pInput );
-        return samples;
-    }
+    );
 
     switch ( pFormat_->Format.wBitsPerSample )
     {
-        case 16:
-        {
-            auto pInput( reinterpret_cast<std::int16_t const * LE_RESTRICT>( pData_ ) );
-            Math::convertSamples( pInput, pOutput, totalSamples );
-            pInput += totalSamples;
-            pData_ = reinterpret_cast<char const *>( pInput );
-            break;
-        }
-
-        case 24:
-        {
-            float const scale( 1.0f / ( 1U << 23 ) );
-
-            char const * pInput( pData_ );
-            auto const pOutputEnd( pOutput + totalSamples );
-            while ( pOutput < pOutputEnd )
-            {
-                std::int32_t inputSample;
-                std::memcpy( &inputSample, pInput - 1, sizeof( inputSample ) );
-                inputSample >>= 8;
-                float const outputSample( static_cast<float>( inputSample ) * scale );
-                *pOutput++ = outputSample;
-                pInput += 3;
-            }
-            pData_ = pInput;
-
-            break;
-        }
-
+        case 16: return Format::Int16;
+        case 24: return Format::Int24;
+        case 32: return isFloat ? Format::Float32 : Format::Int32;
+        case 64: return Format::Float64;
         LE_DEFAULT_CASE_UNREACHABLE();
     }
+}
+
+
+std::uint32_t LE_HOT LE_FASTCALL InputWaveFileImpl::read( float * LE_RESTRICT const pOutput, std::uint32_t samples ) const
+{
+    BOOST_ASSERT_MSG( !!*this, "No file open." );
+
+    samples = std::min( samples, remainingSamples() );
+
+    auto const pcmFormat   ( format()                          );
+    auto const totalSamples( samples * numberOfChannels()      );
+    Math::PCM::decode( pcmFormat, pData_, pOutput, totalSamples );
+    pData_ += totalSamples * Math::PCM::bytesPerSample( pcmFormat );
+
+    return samples;
+}
+
+
+std::uint32_t LE_HOT LE_FASTCALL InputWaveFileImpl::read( float * const * const pOutputs, std::uint32_t samples ) const
+{
+    BOOST_ASSERT_MSG( !!*this, "No file open." );
+
+    samples = std::min( samples, remainingSamples() );
+
+    auto const pcmFormat( format() );
+    Math::PCM::decode( pcmFormat, pData_, pOutputs, numberOfChannels(), samples );
+    pData_ += samples * numberOfChannels() * Math::PCM::bytesPerSample( pcmFormat );
 
     return samples;
 }
@@ -250,7 +242,8 @@ char const * LE_COLD InputWaveFileImpl::open( char const * const fileName )
 // PImpl forwarders
 ////////////////////////////////////////////////////////////////////////////////
 
-LE_NOTHROW std::uint32_t InputWaveFile::read( float * const pOutput, std::uint32_t const samples ) const { return impl( *this ).read( pOutput, samples ); }
+LE_NOTHROW std::uint32_t InputWaveFile::read( float *         const pOutput , std::uint32_t const samples ) const { return impl( *this ).read( pOutput , samples ); }
+LE_NOTHROW std::uint32_t InputWaveFile::read( float * const * const pOutputs, std::uint32_t const samples ) const { return impl( *this ).read( pOutputs, samples ); }
 
 LE_NOTHROW LE_PURE_FUNCTION std::uint8_t  InputWaveFile::numberOfChannels     () const { return impl( *this ).numberOfChannels(); }
 LE_NOTHROW LE_PURE_FUNCTION std::uint32_t InputWaveFile::sampleRate           () const { return impl( *this ).sampleRate      (); }
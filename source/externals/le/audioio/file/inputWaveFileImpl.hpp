@@ -14,6 +14,7 @@
 #include "inputWaveFile.hpp"
 #include "structures.hpp"
 
+#include "le/math/pcmConversion.hpp"
 #include "le/utility/filesystem.hpp"
 #include "le/utility/pimplPrivate.hpp"
 #include "le/utility/platformSpecifics.hpp"
@@ -42,7 +43,8 @@ public:
 
     void close() { mappedFile_ = InputWaveFileImpl::MappedWAVE(); }
 
-    std::uint32_t LE_FASTCALL read( float * pOutput, std::uint32_t samples ) const;
+    std::uint32_t LE_FASTCALL read( float *         pOutput , std::uint32_t samples ) const;
+    std::uint32_t LE_FASTCALL read( float * const * pOutputs, std::uint32_t samples ) const;
 
     std::uint8_t  numberOfChannels() const;
     std::uint32_t sampleRate      () const;
@@ -55,7 +57,12 @@ public:
     LE_COLD
     void setTimePosition( std::uint32_t const positionInMilliseconds ) { setSamplePosition( milliseconds2samples( positionInMilliseconds ) ); }
     LE_COLD
-    void setSamplePosition( std::uint32_t const positionInSampleFrames ) { pData_ = pDataBegin_ + numberOfChannels() * positionInSampleFrames; }
+    void setSamplePosition( std::uint32_t const positionInSampleFrames )
+    {
+        BOOST_ASSERT_MSG( pFormat_->Format.nBlockAlign == ( pFormat_->Format.wBitsPerSample / 8 * numberOfChannels() ), "Unexpected sample frame size" );
+        BOOST_ASSERT_MSG( positionInSampleFrames <= remainingSampleFramesFrom( pDataBegin_ ), "Position out of range" );
+        pData_ = pDataBegin_ + std::size_t( pFormat_->Format.nBlockAlign ) * positionInSampleFrames;
+    }
     LE_COLD
     std::uint32_t getTimePosition() const { return samples2milliseconds( getSamplePosition() ); }
     LE_COLD
@@ -70,6 +77,8 @@ public:
 private:
     char const * open( void const * mappedFileData, std::uint32_t fileSize );
 
+    Math::PCM::Format LE_FASTCALL format() const;
+
     std::uint32_t remainingSampleFramesFrom( char const * const pDataBegin ) const
     {
         BOOST_ASSERT_MSG( pFormat_->Format.nBlockAlign == ( pFormat_->Format.wBitsPerSample / 8 * numberOfChannels() ), "Unexpected sample frame size" );
@@ -45,7 +45,7 @@ typedef char const * error_msg_t;
 class OutputWaveFile
 #ifndef DOXYGEN_ONLY
     :
-    public Utility::StackPImpl<OutputWaveFile, 18 * sizeof( std::uint32_t )>
+    public Utility::StackPImpl<OutputWaveFile, 19 * sizeof( std::uint32_t )>
 #endif // DOXYGEN_ONLY
 {
 public:
@@ -68,6 +68,11 @@ public:
     ///     - a successful create() call
     ///     - the buffer pointed to by pInput must hold at least <VAR>numberOfSampleFrames</VAR> * <VAR>numberOfChannels</VAR> samples.
     LE_NOTHROW error_msg_t LE_FASTCALL_ABI write( float const * pInput, std::uint32_t numberOfSampleFrames );
+    /// <B>Effect:</B> Same as above but for deinterleaved data (one buffer of <VAR>numberOfSampleFrames</VAR> samples per channel).<BR>
+    LE_NOTHROW error_msg_t LE_FASTCALL_ABI write( float const * const * pInputs, std::uint32_t numberOfSampleFrames );
+
+    /// <B>Effect:</B> Enables or disables TPDF dithering of subsequently written samples (when the storage format is an integer one). Disabled by default.<BR>
+    LE_NOTHROW void LE_FASTCALL_ABI setDither( bool enable );
 
     LE_NOTHROW LE_PURE_FUNCTION std::uint32_t LE_FASTCALL_ABI getTimePosition  () const;
     LE_NOTHROW LE_PURE_FUNCTION std::uint32_t LE_FASTCALL_ABI getSamplePosition() const;
@@ -86,9 +91,12 @@ private:
 /// \class OutputWaveFileAsync
 ///
 /// \brief An OutputWaveFile clone for asynchronous file operations
-/// \details The write() member function is non-blocking (it copies and
-/// schedules the passed data to a background worker thread) and thus safe to
-/// use in real time (audio rendering) threads/callbacks.
+/// \details The write() member function is wait-free (it only copies the
+/// passed data into a lock-free ring buffer preallocated by create()) and thus
+/// safe to use in real time (audio rendering) threads/callbacks. A background
+/// worker thread converts and writes the buffered data in large chunks.
+/// Recordings that outgrow the 4 GB RIFF limit are automatically finalised as
+/// RF64 files.
 ///
 /// \nosubgrouping
 ///
@@ -100,24 +108,31 @@ class OutputWaveFileAsync
     public Utility::StackPImpl
     <
         OutputWaveFileAsync,
-        sizeof( OutputWaveFile ) +
-        #if defined( __ANDROID__ ) && __LP64__
-            33 * sizeof( std::uint32_t ) + 30 * sizeof( void * )
-        #elif defined( __ANDROID__ ) && !defined( __i386__ )
-            33 * sizeof( std::uint32_t ) + 28 * sizeof( void * )
-        #elif defined( __APPLE__ )
-             1 * sizeof( std::uint16_t ) +  1 * sizeof( void * )
-        #else
-            33 * sizeof( std::uint32_t ) + 21 * sizeof( void * )
-        #endif
+        sizeof( OutputWaveFile ) + 4 * sizeof( std::uint32_t ) + 2 * sizeof( void * )
     >
 #endif // DOXYGEN_ONLY
 {
+public:
+    /// Buffering, durability and conversion settings (applied by the next create() call).
+    struct Policy
+    {
+        std::uint16_t bufferMilliseconds; ///< Capacity of the ring buffer between write() and the worker thread.
+        std::uint16_t flushMilliseconds ; ///< Longest time buffered data waits for a full chunk before being written out anyway (0 - data is written only in full chunks until close()).
+        std::uint16_t syncMilliseconds  ; ///< Period of forced commits (fsync) of the written data to stable storage (0 - no periodic commits).
+        bool          syncOnClose       ; ///< Commit the file to stable storage in close().
+        bool          dither            ; ///< TPDF dither samples converted to an integer storage format.
+    }; // struct Policy
+
+    static Policy const defaultPolicy;
+
 public:
     LE_NOTHROW  OutputWaveFileAsync();
     LE_NOTHROW  OutputWaveFileAsync( OutputWaveFileAsync && );
     LE_NOTHROW ~OutputWaveFileAsync(); ///< \details Implicitly calls close().
 
+    /// <B>Effect:</B> Same as OutputWaveFile::create() with the addition of
+    /// allocating the ring buffer (as specified by the current Policy) and
+    /// starting the worker thread.<BR>
     template <Utility::SpecialLocations rootLocation>
     LE_NOTHROW error_msg_t LE_FASTCALL_ABI create( char const * pathToFile, std::uint8_t numberOfChannels, std::uint32_t sampleRate );
 
@@ -127,8 +142,15 @@ public:
     /// calls (since the last successfull create() call) asynchronously failed.
     LE_NOTHROW bool LE_FASTCALL_ABI close();
 
+    /// <B>Effect:</B> Queues interleaved <VAR>numberOfSampleFrames</VAR> * <VAR>numberOfChannels</VAR> samples for writing. Never blocks or allocates: if the ring buffer does not have enough room the whole block is dropped and counted as an overrun.<BR>
     LE_NOTHROW error_msg_t LE_FASTCALL_ABI write( float const * pInput, std::uint16_t numberOfSampleFrames );
 
+    LE_NOTHROW void LE_FASTCALL_ABI setPolicy( Policy const & );
+
+    /// Number of sample frames dropped by write() (since the last create()
+    /// call) because the worker thread could not keep up.
+    LE_NOTHROW LE_PURE_FUNCTION std::uint32_t LE_FASTCALL_ABI overruns() const;
+
     LE_NOTHROW LE_PURE_FUNCTION std::uint32_t LE_FASTCALL_ABI getTimePosition  () const;
     LE_NOTHROW LE_PURE_FUNCTION std::uint32_t LE_FASTCALL_ABI getSamplePosition() const;
 
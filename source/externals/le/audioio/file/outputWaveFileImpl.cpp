@@ -13,6 +13,7 @@
 #include "structures.hpp"
 
 #include "le/math/conversion.hpp"
+#include "le/math/pcmConversion.hpp"
 #include "le/math/vector.hpp"
 #include "le/utility/countof.hpp"
 #include "le/utility/filesystem.hpp"
@@ -20,23 +21,29 @@
 #include "le/utility/platformSpecifics.hpp"
 #include "le/utility/tracePrivate.hpp"
 
+#include "le/utility/buffers.hpp"
+#include "le/utility/conditionVariable.hpp"
+
 #include "boost/simd/preprocessor/stack_buffer.hpp"
 
 #include "boost/assert.hpp"
+#include "boost/lockfree/spsc_queue.hpp"
 
 #include "fcntl.h"
-#if defined( __APPLE__ )
-    #define _GNU_SOURCE
-    #include "pthread.h"
-    #include "sys/stat.h"
-#elif defined( _WIN32 )
-    #include "le/utility/parentFromMember.hpp"
+#if defined( _WIN32 )
+    #include "le/utility/windowsLite.hpp"
 
-    #include "io.h" // _get_osfhandle
+    #include "io.h" // _commit
+#else
+    #include "pthread.h"
+    #include "unistd.h" // fsync
 #endif // OS
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
 //------------------------------------------------------------------------------
 namespace LE
 {
@@ -49,6 +56,8 @@ LE_OPTIMIZE_FOR_SIZE_BEGIN()
 
 LE_COLD
 OutputWaveFileBase::OutputWaveFileBase()
+    :
+    dither_( false )
 {
     using namespace Detail;
 
@@ -238,10 +247,11 @@ error_msg_t OutputWaveFileImpl::write( float const * LE_RESTRICT /*const*/ pInpu
     {
         auto const blockSamples( std::min<std::uint32_t>( samples, 16384 / sizeof( internal_sample_t ) ) );
         BOOST_SIMD_ALIGNED_SCOPED_STACK_BUFFER( integers, internal_sample_t, blockSamples );
+        auto noise( dither() );
         for ( std::uint32_t sample( 0 ); sample < samples; sample += blockSamples )
         {
             auto const currentSamples( std::min<std::uint32_t>( samples - sample, blockSamples ) );
-            Math::convertSamples( pInput, integers.begin(), currentSamples );
+            Math::PCM::encode( pInput, storageFormat, integers.begin(), currentSamples, noiseIfDithering( noise ) );
             auto const bytesToWrite( static_cast<std::uint32_t>( currentSamples * sizeof( integers.front() ) ) );
             auto const bytesWritten( static_cast<std::uint32_t>( stream_.write( integers.begin(), bytesToWrite ) ) );
             BOOST_ASSERT_MSG( !bytesWritten || ( bytesToWrite == bytesWritten ), "Unexpected result." );
@@ -267,316 +277,450 @@ error_msg_t OutputWaveFileImpl::write( float const * LE_RESTRICT /*const*/ pInpu
 }
 #pragma warning( pop )
 
-//...mrmlj...ugh...revisit this with lots of spare nerves...
-OutputWaveFileAsyncImpl::OutputWaveFileAsyncImpl( OutputWaveFileAsyncImpl && other )
-    :
-    OutputWaveFileImpl
-    ((
-    #if defined( __ANDROID__ )
-        /*mrmlj cause the thread to stop so that it can be restarted with the new object*/other.join(),
-    #endif // __ANDROID__
-        std::move( other )
-    )),
-#if defined( __APPLE__ )
-    dispatcher_( other.dispatcher_                                ),
-    counter_   ( other.counter_.load( std::memory_order_acquire ) ), //...mrmlj...
-    error_     ( other.error_                                     )
+
+error_msg_t OutputWaveFileImpl::write( float const * const * const pInputs, std::uint32_t const sampleFrames )
+{
+    std::uint8_t  const numberOfChannels( format_.fmt.Format.nChannels                 );
+    std::uint16_t const frameSize       ( numberOfChannels * sizeof( internal_sample_t ) );
+
+    auto const blockFrames( std::min<std::uint32_t>( sampleFrames, 16384 / frameSize ) );
+    BOOST_SIMD_ALIGNED_SCOPED_STACK_BUFFER( interleaved, internal_sample_t, blockFrames * numberOfChannels );
+    BOOST_SIMD_ALIGNED_STACK_BUFFER       ( inputs     , float const *    , numberOfChannels               );
+    std::copy_n( pInputs, numberOfChannels, inputs.begin() );
+
+    auto noise( dither() );
+    for ( std::uint32_t frame( 0 ); frame < sampleFrames; frame += blockFrames )
+    {
+        auto const currentFrames( std::min<std::uint32_t>( sampleFrames - frame, blockFrames ) );
+        Math::PCM::encode( inputs.begin(), numberOfChannels, storageFormat, interleaved.begin(), currentFrames, noiseIfDithering( noise ) );
+        auto const bytesToWrite( static_cast<std::uint32_t>( currentFrames * frameSize                                 ) );
+        auto const bytesWritten( static_cast<std::uint32_t>( stream_.write( interleaved.begin(), bytesToWrite ) ) );
+        BOOST_ASSERT_MSG( !bytesWritten || ( bytesToWrite == bytesWritten ), "Unexpected result." );
+        dataHeader_.size += bytesWritten;
+        if ( bytesWritten != bytesToWrite )
+            return "Not enough disk space.";
+        for ( auto & pInput : inputs )
+            pInput += currentFrames;
+    }
+
+    return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// OutputWaveFileAsyncImpl
+//
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+    /// \note The worker thread is never signalled by write() (so that the
+    /// audio thread never touches a lock or a kernel object) but instead polls
+    /// the ring buffer at this period.
+    std::uint16_t const pollMilliseconds = 10;
+
+    /// \note Data is written out in chunks of (up to) this many bytes of
+    /// converted PCM data (i.e. in a single write call).
+    std::uint32_t const chunkBytes = 64 * 1024;
+
+    /// \note Required (on 32 bit POSIX systems) for files larger than 2 GB.
+#ifdef O_LARGEFILE
+    int const largeFileFlag = O_LARGEFILE;
 #else
-    #if defined( __ANDROID__ )
-        bufferNotEmpty_( std::move( other.bufferNotEmpty_ ) ),
-        bufferNotFull_ ( std::move( other.bufferNotFull_  ) ),
-        bufferLock_    ( std::move( other.bufferLock_     ) ),
-        thread_        (            other.thread_           ),
-      //queue_         ( std::move( other.queue_          ) ), //...mrmlj...no move...http://lists.boost.org/boost-users/2014/11/83304.php
-        stopWorker_    ( false                              ),
-    #elif defined( _WIN32 )
-        overlappedIOHandle_( other.overlappedIOHandle_ ),
-    #endif
-    error_(            other.error_   )
- //,cache_( std::move( other.cache_ ) ) //...mrmlj...no move...
-#endif
+    int const largeFileFlag = 0;
+#endif // O_LARGEFILE
+
+    LE_COLD
+    bool commitToStorage( Utility::File::Stream const & stream )
+    {
+    #ifdef _WIN32
+        auto const result( ::_commit( stream.nativeHandle() ) );
+    #else
+        auto const result( ::fsync  ( stream.nativeHandle() ) );
+    #endif // _WIN32
+        LE_TRACE_IF( result != 0, "OutputWaveFileAsync: commit to storage failed (%d).", errno );
+        return result == 0;
+    }
+} // anonymous namespace
+
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class OutputWaveFileAsyncImpl::Pipeline
+///
+/// \brief State shared between write() (the producer) and the worker thread
+/// (the consumer), allocated once by create().
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class OutputWaveFileAsyncImpl::Pipeline
 {
-#if defined( __APPLE__ )
+public:
+    using Ring = boost::lockfree::spsc_queue<float>;
+
+    Pipeline( Policy const & policy, std::uint32_t const ringCapacityInSamples, std::uint32_t const chunkSamples )
+        :
+        policy    ( policy                ),
+        ring      ( ringCapacityInSamples ),
+        stop      ( false                 ),
+        error     ( false                 ),
+        dataBytes ( 0                     ),
+    #ifdef _WIN32
+        thread    ( nullptr               )
+    #else
+        running   ( false                 )
+    #endif // _WIN32
+    {
+        if ( input.resize( chunkSamples ) )
+            output.resize( chunkSamples );
+    }
+
+    explicit operator bool() const { return input && output; }
+
+public:
+    /// \note A copy so that setPolicy() calls take effect only with the
+    /// next create() (and do not race with the worker thread).
+    Policy const policy;
+
+    Ring ring;
+
+    Utility::AlignedHeapBuffer<float            > input ; ///< A chunk popped from the ring buffer...
+    Utility::AlignedHeapBuffer<internal_sample_t> output; ///< ...and converted to the storage format.
+
+    Utility::ConditionVariable       wakeUp;
+    Utility::ConditionVariable::Lock lock  ;
+
+    std::atomic<bool> stop ;
+    std::atomic<bool> error;
+
+    // Worker thread state.
+    Math::PCM::TPDFDither noise    ;
+    std::uint64_t         dataBytes;
+
+#ifdef _WIN32
+    HANDLE      thread ;
 #else
-    #if defined( __ANDROID__ )
-        other.queue_.reset();
-        run();
-    #endif
-    other.cache_.reset();
-#endif
-    new ( &other ) OutputWaveFileAsyncImpl;
+    /// \note Avoid std::thread STL dependency (libc++ vs libstdc++) and bloat
+    /// (due to required static linking).
+    ::pthread_t thread ;
+    bool        running;
+#endif // _WIN32
+}; // class OutputWaveFileAsyncImpl::Pipeline
+
+
+LE_COLD
+OutputWaveFileAsyncImpl::OutputWaveFileAsyncImpl()
+    :
+    policy_      ( OutputWaveFileAsync::defaultPolicy ),
+    overruns_    ( 0                                  ),
+    framesQueued_( 0                                  )
+{}
+
+LE_COLD
+OutputWaveFileAsyncImpl::OutputWaveFileAsyncImpl( OutputWaveFileAsyncImpl && other )
+    :
+    OutputWaveFileImpl( ( /*the worker thread holds a pointer to the object*/other.join(), std::move( other ) ) ),
+    policy_           ( other.policy_                                     ),
+    pPipeline_        ( std::move( other.pPipeline_ )                     ),
+    overruns_         ( other.overruns_.load( std::memory_order_relaxed ) ),
+    framesQueued_     ( other.framesQueued_                               )
+{
+    if ( pPipeline_ )
+        BOOST_VERIFY( run() );
+    other.overruns_     = 0;
+    other.framesQueued_ = 0;
 }
 
+LE_COLD
+OutputWaveFileAsyncImpl::~OutputWaveFileAsyncImpl() { close(); }
+
 
 LE_COLD LE_NOTHROW
-void OutputWaveFileAsyncImpl::join()
+char const * OutputWaveFileAsyncImpl::create
+(
+    Utility::File::Stream && file,
+    std::uint8_t  const numberOfChannels,
+    std::uint32_t const sampleRate
+)
 {
-#if defined( __APPLE__ )
-    if ( dispatcher_ )
+    close();
+
+    if ( auto const pError = OutputWaveFileImpl::create( std::move( file ), numberOfChannels, sampleRate ) )
+        return pError;
+    setDither( policy_.dither );
+
+    // Reserve room for a DS64 chunk (between the RIFF header and the format
+    // chunk) so that the file can be finalised as RF64 (see writeHeaders()).
+    if ( BOOST_UNLIKELY( !stream_.seek( sizeof( Detail::DS64Placeholder ), SEEK_CUR ) ) )
     {
-        //dispatch_semaphore_t sem = dispatch_semaphore_create(0);
-        //dispatch_semaphore_wait
-        BOOST_ASSERT( counter_ >= 0 );
-        while ( BOOST_UNLIKELY( counter_ ) )
-            BOOST_VERIFY( ::sched_yield() == 0 );
-    #ifndef NDEBUG
-        auto const fd( dispatch_io_get_descriptor( dispatcher_ ) );
-        BOOST_ASSERT( stream_.position() == ::lseek( fd, 0, SEEK_CUR ) );
-        struct stat file_status;
-        BOOST_VERIFY( ::fstat( fd, &file_status ) == 0 );
-        BOOST_ASSERT( stream_.size() == file_status.st_size );
-    #endif // NDEBUG
-        dispatch_io_close( dispatcher_, 0/*DISPATCH_IO_STOP*/ );
-        dispatch_release ( dispatcher_                        );
-        dispatcher_ = nullptr;
-        BOOST_ASSERT( counter_ == 0 );
+        BOOST_ASSERT( errno );
+        stream_.close();
+        return "Error creating space in the output file for the WAVE header structures.";
     }
-#elif defined( __ANDROID__ )
-    LE_TRACE_IF( error_, "Async write error" );
-    if ( thread_ != -1 )
+
+    auto const chunkSamples( chunkBytes / sizeof( internal_sample_t ) / numberOfChannels * numberOfChannels );
+    auto const ringSamples
+    (
+        std::max<std::uint32_t>
+        (
+            static_cast<std::uint32_t>( std::uint64_t( policy_.bufferMilliseconds ) * sampleRate / 1000 ) * numberOfChannels,
+            2 * chunkSamples
+        )
+    );
+    pPipeline_.reset( new ( std::nothrow ) Pipeline( policy_, ringSamples, chunkSamples ) );
+    overruns_     = 0;
+    framesQueued_ = 0;
+    if ( BOOST_UNLIKELY( !pPipeline_ || !*pPipeline_ || !run() ) )
     {
-        stopWorker_ = true;
-        bufferNotEmpty_.signal();
-        BOOST_VERIFY( ::pthread_join( thread_, nullptr ) == 0 );
-        thread_ = -1;
+        pPipeline_.reset();
+        stream_.close();
+        return "Out of memory";
     }
-    BOOST_ASSERT( queue_.empty() );
-    cache_.consume_all( []( BufferNode * const pNode ){ delete pNode; } );
-#elif defined( _WIN32 )
-    // Force any completion callbacks to run.
-    ::SleepEx( 0, true );
-    BOOST_ASSERT( ::SleepEx( 0, true ) == 0                                                           );
-    BOOST_VERIFY( ::CloseHandle( overlappedIOHandle_ ) || overlappedIOHandle_ == INVALID_HANDLE_VALUE );
-    overlappedIOHandle_ = INVALID_HANDLE_VALUE;
-    cache_.consume_all( []( BufferNode * const pNode ){ delete pNode; } );
-#endif // OS
+
+    return nullptr;
 }
 
 
 LE_COLD LE_NOTHROW
 bool OutputWaveFileAsyncImpl::close()
 {
+    if ( !pPipeline_ )
+    {
+        BOOST_ASSERT( !stream_ );
+        return true;
+    }
+
     join();
-    OutputWaveFileImpl::close();
-    return error_;
+
+    bool succeeded( !pPipeline_->error.load( std::memory_order_relaxed ) );
+    LE_TRACE_IF( !succeeded, "Async write error" );
+
+    writeHeaders();
+    if ( pPipeline_->policy.syncOnClose )
+        succeeded &= commitToStorage( stream_ );
+
+    stream_.close();
+    pPipeline_.reset();
+
+    return succeeded;
 }
 
-#if defined( __APPLE__ )
-namespace
+
+error_msg_t OutputWaveFileAsyncImpl::write( float const * LE_RESTRICT const pInput, std::uint16_t const sampleFrames )
 {
-    LE_NOTHROWRESTRICTNOALIAS LE_CONST_FUNCTION
-    dispatch_queue_t LE_FASTCALL gdcQueueSingleton()
+    BOOST_ASSERT_MSG( pPipeline_, "No file open" );
+    auto & pipeline( *pPipeline_ );
+
+    std::uint32_t const samples( sampleFrames * format_.fmt.Format.nChannels );
+
+    // All or nothing so that the ring buffer (and the file) always holds
+    // whole sample frames.
+    if ( BOOST_UNLIKELY( pipeline.ring.write_available() < samples ) )
     {
-        /// \note QOS_CLASS_BACKGROUND is available only since OSX 10.10/iOS 8.
-        ///                                   (24.04.2015.) (Domagoj Saric)
-        auto const queue( dispatch_get_global_queue( DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0 ) );
-        BOOST_ASSERT( queue );
-        return queue;
+        // Single writer: no need for a (possibly locked) RMW operation.
+        overruns_.store( overruns_.load( std::memory_order_relaxed ) + sampleFrames, std::memory_order_relaxed );
+        return "Asynchronous write overrun (data dropped)";
     }
-} // anonymous namespace
-#endif // OS
+    BOOST_VERIFY( pipeline.ring.push( pInput, samples ) == samples );
+    framesQueued_ += sampleFrames;
+
+    return BOOST_UNLIKELY( pipeline.error.load( std::memory_order_relaxed ) ) ? "Asynchronous write error" : nullptr;
+}
+
 
 LE_COLD
-error_msg_t OutputWaveFileAsyncImpl::write( float const * LE_RESTRICT const pInput, std::uint16_t const sampleFrames )
+std::uint32_t OutputWaveFileAsyncImpl::getTimePosition() const
 {
-    std::uint8_t  const numberOfChannels( format_.fmt.Format.nChannels    );
-    std::uint32_t const samples         ( sampleFrames * numberOfChannels );
+    return static_cast<std::uint32_t>( std::uint64_t( getSamplePosition() ) * 1000 / format_.fmt.Format.nSamplesPerSec );
+}
 
-#ifdef __APPLE__
-    dispatch_data_t data( nullptr );
-    if ( write16bitData )
-    {
-        LE_ALIGN( 16 ) internal_sample_t integers[ samples ];
-        Math::convertSamples( pInput, integers, samples );
-        auto const numberOfBytes( samples * sizeof( integers[ 0 ] ) );
-        data = dispatch_data_create( integers, numberOfBytes, nullptr, DISPATCH_DATA_DESTRUCTOR_DEFAULT );
-        dataHeader_.size += numberOfBytes;
-    }
-    else
-    {
-        auto const numberOfBytes( samples * sizeof( *pInput ) );
-        data = dispatch_data_create( pInput  , numberOfBytes, nullptr, DISPATCH_DATA_DESTRUCTOR_DEFAULT );
-        dataHeader_.size += numberOfBytes;
-    }
-    if ( BOOST_UNLIKELY( !data ) )
-        return "Out of memory";
-    BOOST_ASSERT( counter_ >= 0 );
-    ++counter_;
-    dispatch_io_write
-    (
-        dispatcher_,
-        0,
-        data,
-        gdcQueueSingleton(),
-        ^( bool const done, dispatch_data_t const data, int const error )
-        {
-            LE_TRACE_IF( error, "Dispatch write handler %d", error );
-            error_ |= ( error != 0 );
-            if ( done )
-            {
-                BOOST_ASSERT( data == nullptr );
-                BOOST_ASSERT( counter_ > 0    );
-                --counter_;
-            }
-        }
-    );
-    return nullptr;
-#else
-#ifdef _WIN32
-    ::SleepEx( 0, true );
-#endif // _WIN32
-    BufferNode * LE_RESTRICT pBuffer( nullptr );
-    auto cachedBuffers( cache_.read_available() );
-    if ( cachedBuffers )
-    {
-        while ( cachedBuffers-- )
-        {
-            BOOST_VERIFY( cache_.pop( pBuffer ) );
-            if ( pBuffer->capacity >= sampleFrames )
-            {
-                pBuffer->size = sampleFrames;
-                break;
-            }
-            LE_TRACE( "Discarding an insufficient cache buffer." );
-            delete pBuffer;
-        }
-        pBuffer = nullptr;
-    }
-    if ( !pBuffer )
-    {
-        auto const storage( new ( std::nothrow ) char[ 1 * sizeof( BufferNode ) + samples * sizeof( pBuffer->data[ 0 ] ) ] );
-        if ( !storage ) return "Out of memory";
-        pBuffer = new ( storage ) BufferNode( sampleFrames, *this );
-    }
 
-    Math::convertSamples( pInput, pBuffer->data, samples );
-#ifdef __ANDROID__
-    while ( BOOST_UNLIKELY( !queue_.push( static_cast<BufferNode *>( pBuffer ) ) ) )
+LE_COLD
+bool OutputWaveFileAsyncImpl::writeOut( std::uint32_t const maximumSamples )
+{
+    auto & pipeline( *pPipeline_ );
+
+    auto const samples( static_cast<std::uint32_t>( pipeline.ring.pop( pipeline.input.begin(), maximumSamples ) ) );
+    if ( !samples )
+        return false;
+    BOOST_ASSERT( samples % format_.fmt.Format.nChannels == 0 );
+
+    Math::PCM::encode( pipeline.input.begin(), storageFormat, pipeline.output.begin(), samples, noiseIfDithering( pipeline.noise ) );
+
+    auto const bytesToWrite( static_cast<std::uint32_t>( samples * sizeof( internal_sample_t ) ) );
+    auto const bytesWritten( stream_.write( pipeline.output.begin(), bytesToWrite ) );
+    pipeline.dataBytes += bytesWritten;
+    if ( BOOST_UNLIKELY( bytesWritten != bytesToWrite ) )
     {
-        LE_TRACE( "OutputWaveFileAsync::write() queue full - blocking!" );
-        using Lock = std::lock_guard<Utility::ConditionVariable::Lock>;
-        Lock const lock( bufferLock_ );
-        bufferNotFull_.wait( bufferLock_ );
+        LE_TRACE( "OutputWaveFileAsync: asynchronous write error." );
+        pipeline.error.store( true, std::memory_order_relaxed );
     }
-    bufferNotEmpty_.signal();
-#else
-    error_ |=
-        ::WriteFileEx
-        (
-            overlappedIOHandle_, pBuffer->data, pBuffer->size * sizeof( pBuffer->data[ 0 ] ), pBuffer,
-            []( DWORD const errorCode, DWORD const numberOfBytesTransfered, OVERLAPPED * LE_RESTRICT const pOverlapped )
-            {
-                auto & node( *static_cast     <BufferNode *>( pOverlapped )              );
-                auto & impl( *reinterpret_cast<OutputWaveFileAsyncImpl *>( node.hEvent ) );
-                impl.error_ |= ( errorCode != ERROR_SUCCESS );
-                impl.dataHeader_.size += numberOfBytesTransfered;
-                // Return the buffer to the cache or delete it if the cache is
-                // full
-                if ( BOOST_UNLIKELY( !impl.cache_.push( &node ) ) )
-                {
-                    LE_TRACE( "OutputWaveFileAsync::write() cache full!" );
-                    delete &node;
-                }
-            }
-        ) == false;
-#endif // __ANDROID__
-    return BOOST_UNLIKELY( error_ ) ? "Asynchronous write error" : nullptr;
-#endif // OS
+    return true;
 }
 
-#ifdef __ANDROID__
+
 LE_COLD
 void OutputWaveFileAsyncImpl::worker()
 {
+    auto & pipeline( *pPipeline_ );
+
+    auto const & policy      ( pipeline.policy        );
+    auto const   chunkSamples( pipeline.output.size() );
+
+    std::uint32_t millisecondsSinceFlush( 0 );
+    std::uint32_t millisecondsSinceSync ( 0 );
     for ( ; ; )
     {
-        using Lock = std::lock_guard<Utility::ConditionVariable::Lock>;
+        // Everything pushed before the stop request is drained below.
+        bool const stopping( pipeline.stop.load( std::memory_order_acquire ) );
+
+        // Full chunks are written out as soon as they become available,
+        // partial ones only when the flush period expires (or on stop).
+        while ( pipeline.ring.read_available() >= chunkSamples )
+            writeOut( chunkSamples );
+
+        if ( stopping || ( policy.flushMilliseconds && millisecondsSinceFlush >= policy.flushMilliseconds ) )
+        {
+            while ( writeOut( chunkSamples ) ) {}
+            millisecondsSinceFlush = 0;
+        }
 
-        while ( queue_.empty() && !stopWorker_ )
+        if ( policy.syncMilliseconds && millisecondsSinceSync >= policy.syncMilliseconds )
         {
-            Lock const lock( bufferLock_ ); //...mrmlj...lock required?
-            bufferNotEmpty_.wait( bufferLock_ );
+            if ( !commitToStorage( stream_ ) )
+                pipeline.error.store( true, std::memory_order_relaxed );
+            millisecondsSinceSync = 0;
         }
 
-        if ( stopWorker_ && queue_.empty() )
+        if ( stopping )
             break;
 
-        // Consume the first available item
-        BufferNode * pWorkRaw;
-        BOOST_VERIFY( queue_.pop( pWorkRaw ) );
-        std::unique_ptr<BufferNode> pWork( pWorkRaw );
-
-        bufferNotFull_.signal();
-
-        if ( !pWork->size )
-            LE_TRACE_LOGONLY( "Zero-sized work queued" );
-        error_ = OutputWaveFileImpl::write( pWork->data, pWork->size ) != nullptr;
-        LE_TRACE_IF( error_, "OutputWaveFileAsync: asynchronous write error." );
-
-        //...mrmlj...?...BOOST_VERIFY( cache_.push( pWork.release() ) );
-        // Return the buffer to the cache or delete it if the cache is
-        // full
-        if ( BOOST_LIKELY( cache_.push( pWork.get() ) ) )
-            pWork.release();
-        else
-            LE_TRACE( "OutputWaveFileAsync::write() cache full" );
+        {
+            using Lock = std::lock_guard<Utility::ConditionVariable::Lock>;
+            Lock const lock( pipeline.lock );
+            if ( !pipeline.stop.load( std::memory_order_relaxed ) )
+                pipeline.wakeUp.wait( pipeline.lock, pollMilliseconds );
+        }
+        millisecondsSinceFlush += pollMilliseconds;
+        millisecondsSinceSync  += pollMilliseconds;
     }
 }
-#endif // __ANDROID__
+
 
 LE_COLD
 bool OutputWaveFileAsyncImpl::run()
 {
-    error_ = false;
-#if defined( __APPLE__ )
-    BOOST_ASSERT( !dispatcher_ );
-    dispatcher_ = dispatch_io_create
+    auto & pipeline( *pPipeline_ );
+    pipeline.stop.store( false, std::memory_order_relaxed );
+#ifdef _WIN32
+    BOOST_ASSERT( !pipeline.thread );
+    pipeline.thread = ::CreateThread
     (
-        DISPATCH_IO_STREAM,
-        stream_.nativeHandle(),
-        gdcQueueSingleton(),
-        ^( int const error )
-        {
-            LE_TRACE_IF( error, "Dispatch handler %d", error );
-        }
+        nullptr, 0,
+        []( void * const pFile ) -> DWORD { static_cast<OutputWaveFileAsyncImpl *>( pFile )->worker(); return 0; },
+        this, 0, nullptr
     );
-    #ifndef NDEBUG
-        auto const fd( dispatch_io_get_descriptor( dispatcher_ ) );
-        BOOST_ASSERT( stream_.position() == ::lseek( fd, 0, SEEK_CUR ) );
-        struct stat file_status;
-        BOOST_VERIFY( ::fstat( fd, &file_status ) == 0 );
-        BOOST_ASSERT( stream_.size() == file_status.st_size );
-    #endif // NDEBUG
-    return dispatcher_ != nullptr;
-#elif defined( __ANDROID__ )
-        BOOST_ASSERT( thread_     == -1    );
-        BOOST_ASSERT( stopWorker_ == false );
-    #ifdef SCHED_IDLE
-        auto const schedulingPolicy( SCHED_IDLE  );
-    #else
-        auto const schedulingPolicy( SCHED_OTHER );
-    #endif // SCHED_OTHER
-        sched_param const schedulingParameters = { ::sched_get_priority_min( schedulingPolicy ) };
-        pthread_attr_t threadAttributes;
-        BOOST_VERIFY( pthread_attr_init           ( &threadAttributes                         ) == 0 );
-        BOOST_VERIFY( pthread_attr_setschedpolicy ( &threadAttributes, schedulingPolicy       ) == 0 );
-        BOOST_VERIFY( pthread_attr_setschedparam  ( &threadAttributes, &schedulingParameters  ) == 0 );
-      //BOOST_VERIFY( pthread_attr_setinheritsched( &threadAttributes, PTHREAD_EXPLICIT_SCHED ) == 0 ); // unavailable on Android
-        auto const succeeded( ::pthread_create( &thread_, &threadAttributes, []( void * const pFile ) -> void * { static_cast<OutputWaveFileAsyncImpl *>( pFile )->worker(); return nullptr; }, this ) == 0 );
-        BOOST_VERIFY( pthread_attr_destroy( &threadAttributes ) == 0 );
-        if ( BOOST_LIKELY( succeeded ) )
-        {
-            BOOST_VERIFY( ::pthread_setschedparam( thread_, schedulingPolicy, &schedulingParameters ) == 0 );
-            return true;
-        }
-        thread_ = -1;
-        return false;
-#elif defined( _WIN32 )
-    BOOST_ASSERT( overlappedIOHandle_ == INVALID_HANDLE_VALUE );
-    auto const fileHandle( reinterpret_cast<HANDLE>( _get_osfhandle( stream_.nativeHandle() ) ) );
-    overlappedIOHandle_ = ::ReOpenFile( fileHandle, FILE_GENERIC_WRITE, FILE_SHARE_WRITE, FILE_FLAG_OVERLAPPED );
-    return overlappedIOHandle_ != INVALID_HANDLE_VALUE;
-#endif // OS
+    return pipeline.thread != nullptr;
+#else
+    BOOST_ASSERT( !pipeline.running );
+    pipeline.running = ::pthread_create( &pipeline.thread, nullptr, []( void * const pFile ) -> void * { static_cast<OutputWaveFileAsyncImpl *>( pFile )->worker(); return nullptr; }, this ) == 0;
+    return pipeline.running;
+#endif // _WIN32
+}
+
+
+LE_COLD LE_NOTHROW
+void OutputWaveFileAsyncImpl::join()
+{
+    if ( !pPipeline_ )
+        return;
+    auto & pipeline( *pPipeline_ );
+    {
+        using Lock = std::lock_guard<Utility::ConditionVariable::Lock>;
+        Lock const lock( pipeline.lock );
+        pipeline.stop.store( true, std::memory_order_release );
+        pipeline.wakeUp.signal();
+    }
+#ifdef _WIN32
+    if ( pipeline.thread )
+    {
+        BOOST_VERIFY( ::WaitForSingleObject( pipeline.thread, INFINITE ) == WAIT_OBJECT_0 );
+        BOOST_VERIFY( ::CloseHandle        ( pipeline.thread           )                  );
+        pipeline.thread = nullptr;
+    }
+#else
+    if ( pipeline.running )
+    {
+        BOOST_VERIFY( ::pthread_join( pipeline.thread, nullptr ) == 0 );
+        pipeline.running = false;
+    }
+#endif // _WIN32
+    BOOST_ASSERT( pipeline.ring.read_available() == 0 );
+}
+
+
+/// \note The header layout is: RIFF (or RF64) header, JUNK (or ds64) chunk,
+/// format chunk and data chunk header. The 64 bit data size is tracked by the
+/// worker thread and only if the resulting RIFF chunk does not fit into 32
+/// bits is the file finalised as RF64.
+LE_COLD
+void OutputWaveFileAsyncImpl::writeHeaders()
+{
+    using namespace Detail;
+
+    std::uint64_t const dataBytes( pPipeline_->dataBytes );
+    std::uint64_t const riffBytes
+    (
+        sizeof( riffHeader_ ) - riffHeader_.headerSize()
+            +
+        sizeof( DS64 )
+            +
+        format_.totalSize()
+            +
+        dataHeader_.headerSize()
+            +
+        dataBytes
+    );
+    BOOST_ASSERT( dataBytes % 2 == 0 );
+
+    BOOST_VERIFY( stream_.seek( 0, SEEK_SET ) );
+
+    std::uint32_t const sizeLimit( 0xFFFFFFFF );
+    if ( BOOST_UNLIKELY( riffBytes > sizeLimit ) )
+    {
+        RF64Header rf64Header;
+        rf64Header.size = sizeLimit;
+
+        DS64 ds64;
+        ds64.size            = sizeof( ds64 ) - ds64.headerSize();
+        ds64.riffSizeLow     = static_cast<DWORD>( riffBytes       );
+        ds64.riffSizeHigh    = static_cast<DWORD>( riffBytes >> 32 );
+        ds64.dataSizeLow     = static_cast<DWORD>( dataBytes       );
+        ds64.dataSizeHigh    = static_cast<DWORD>( dataBytes >> 32 );
+        auto const frames( dataBytes / format_.fmt.Format.nBlockAlign );
+        ds64.sampleCountLow  = static_cast<DWORD>( frames          );
+        ds64.sampleCountHigh = static_cast<DWORD>( frames    >> 32 );
+        ds64.tableLength     = 0;
+
+        dataHeader_.size = sizeLimit;
+
+        BOOST_VERIFY( stream_.write( &rf64Header, sizeof( rf64Header ) ) == sizeof( rf64Header ) );
+        BOOST_VERIFY( stream_.write( &ds64      , sizeof( ds64       ) ) == sizeof( ds64       ) );
+    }
+    else
+    {
+        riffHeader_.size = static_cast<DWORD>( riffBytes );
+        dataHeader_.size = static_cast<DWORD>( dataBytes );
+
+        DS64Placeholder junk;
+        junk.size = sizeof( junk ) - junk.headerSize();
+        std::memset( junk.reserved, 0, sizeof( junk.reserved ) );
+
+        BOOST_VERIFY( stream_.write( &riffHeader_, sizeof( riffHeader_ ) ) == sizeof( riffHeader_ ) );
+        BOOST_VERIFY( stream_.write( &junk       , sizeof( junk        ) ) == sizeof( junk        ) );
+    }
+    BOOST_VERIFY( stream_.write( &format_    , format_    .totalSize () ) == format_    .totalSize () );
+    BOOST_VERIFY( stream_.write( &dataHeader_, dataHeader_.headerSize() ) == dataHeader_.headerSize() );
 }
 
 //------------------------------------------------------------------------------
@@ -618,8 +762,10 @@ error_msg_t OutputWaveFile::create( char const * const fileName, std::uint8_t co
     );
 }
 
-error_msg_t OutputWaveFile::write( float const * const pInput, std::uint32_t const sampleFrames ) { return impl( *this ).write( pInput, sampleFrames ); }
+error_msg_t OutputWaveFile::write( float const *         const pInput , std::uint32_t const sampleFrames ) { return impl( *this ).write( pInput , sampleFrames ); }
+error_msg_t OutputWaveFile::write( float const * const * const pInputs, std::uint32_t const sampleFrames ) { return impl( *this ).write( pInputs, sampleFrames ); }
 void        OutputWaveFile::close(                                                              ) { return impl( *this ).close(                      ); }
+void        OutputWaveFile::setDither( bool const enable                                        ) { return impl( *this ).setDither( enable           ); }
 
 LE_PURE_FUNCTION std::uint32_t OutputWaveFile::getTimePosition  () const { return impl( *this ).getTimePosition  (); }
 LE_PURE_FUNCTION std::uint32_t OutputWaveFile::getSamplePosition() const { return impl( *this ).getSamplePosition(); }
@@ -639,21 +785,24 @@ LE_NOTHROW OutputWaveFileAsync:: OutputWaveFileAsync() {}
 LE_NOTHROW OutputWaveFileAsync:: OutputWaveFileAsync( OutputWaveFileAsync && other ) : ConcreteStackPimpl( std::move( other ) ) {}
 LE_NOTHROW OutputWaveFileAsync::~OutputWaveFileAsync() {}
 
+OutputWaveFileAsync::Policy const OutputWaveFileAsync::defaultPolicy = { 2000, 500, 0, true, false };
+
 template <Utility::SpecialLocations rootLocation>
 error_msg_t OutputWaveFileAsync::create( char const * const fileName, std::uint8_t const numberOfChannels, std::uint32_t const sampleRate )
 {
-    auto & impl( Utility::impl( *this ) );
-    impl.join();
-    auto const msg( /*...mrmlj...*/reinterpret_cast<OutputWaveFile &>( impl ).create<rootLocation>( fileName, numberOfChannels, sampleRate ) );
-    if ( msg )
-        return msg;
-    if ( impl.run() )
-        return nullptr;
-    return "Out of memory";
+    return impl( *this ).create
+    (
+        Utility::File::open<rootLocation>( fileName, O_CREAT | O_TRUNC | O_WRONLY | largeFileFlag ),
+        numberOfChannels,
+        sampleRate
+    );
 }
 
-error_msg_t OutputWaveFileAsync::write( float const * const pInput, std::uint16_t const sampleFrames ) { return impl( *this ).write( pInput, sampleFrames ); }
-bool        OutputWaveFileAsync::close(                                                              ) { return impl( *this ).close(); }
+error_msg_t OutputWaveFileAsync::write    ( float const * const pInput, std::uint16_t const sampleFrames ) { return impl( *this ).write    ( pInput, sampleFrames ); }
+bool        OutputWaveFileAsync::close    (                                                              ) { return impl( *this ).close    (                      ); }
+void        OutputWaveFileAsync::setPolicy( Policy const & policy                                        ) { return impl( *this ).setPolicy( policy               ); }
+
+LE_PURE_FUNCTION std::uint32_t OutputWaveFileAsync::overruns() const { return impl( *this ).overruns(); }
 
 LE_PURE_FUNCTION std::uint32_t OutputWaveFileAsync::getTimePosition  () const { return impl( *this ).getTimePosition  (); }
 LE_PURE_FUNCTION std::uint32_t OutputWaveFileAsync::getSamplePosition() const { return impl( *this ).getSamplePosition(); }
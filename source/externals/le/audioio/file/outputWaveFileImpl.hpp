@@ -11,24 +11,15 @@
 #define outputWaveFileImpl_hpp__C66141DB_3639_4C62_A8AF_A4D90342A69B
 #pragma once
 //------------------------------------------------------------------------------
+#include "outputWaveFile.hpp"
 #include "structures.hpp"
 
-#include "le/utility/conditionVariable.hpp"
+#include "le/math/pcmConversion.hpp"
 #include "le/utility/filesystem.hpp"
 
-#ifdef __APPLE__
-    #include "dispatch/dispatch.h"
-
-    #include <atomic>
-#elif defined( _WIN32 )
-    #include "boost/lockfree/spsc_queue.hpp"
-#else
-    #include "boost/lockfree/spsc_queue.hpp"
-
-    #include "pthread.h"
-
-    #include <mutex>
-#endif // __APPLE__
+#include <atomic>
+#include <cstdint>
+#include <memory>
 //------------------------------------------------------------------------------
 namespace LE
 {
@@ -43,6 +34,8 @@ public:
     LE_NOTHROW std::uint32_t LE_FASTCALL getTimePosition  () const;
     LE_NOTHROW std::uint32_t LE_FASTCALL getSamplePosition() const;
 
+    void setDither( bool const enable ) { dither_ = enable; }
+
 protected:
     static bool const write16bitData    = true ;
     static bool const useExtendedFormat = false;
@@ -50,13 +43,22 @@ protected:
 protected:
     LE_NOTHROW OutputWaveFileBase();
     LE_NOTHROW OutputWaveFileBase( OutputWaveFileBase && other )
-        : riffHeader_( other.riffHeader_ ), format_( other.format_ ), dataHeader_( other.dataHeader_ )
+        : riffHeader_( other.riffHeader_ ), format_( other.format_ ), dataHeader_( other.dataHeader_ ), dither_( other.dither_ )
     {
         new ( &other ) OutputWaveFileBase();
     }
 
     using internal_sample_t = boost::mpl::if_c<write16bitData, std::int16_t, float>::type;
 
+    static Math::PCM::Format BOOST_CONSTEXPR_OR_CONST storageFormat = write16bitData ? Math::PCM::Format::Int16 : Math::PCM::Format::Float32;
+
+    /// \note The dither noise sequence is keyed on the number of samples
+    /// written so far so no extra state is needed.
+    Math::PCM::TPDFDither dither() const { return Math::PCM::TPDFDither( dataHeader_.size / sizeof( internal_sample_t ) ); }
+
+    /// Null unless dithering is enabled (see setDither()).
+    Math::PCM::TPDFDither * noiseIfDithering( Math::PCM::TPDFDither & noise ) const { return dither_ ? &noise : nullptr; }
+
     std::uint16_t headerSize      () const;
     void          initialiseHeader( std::uint8_t numberOfChannels, std::uint32_t sampleRate );
 
@@ -66,6 +68,7 @@ protected:
     Detail::RIFFHeader riffHeader_;
     Detail::Format     format_    ;
     Detail::DataHeader dataHeader_;
+    bool               dither_    ;
 }; // class OutputWaveFileBase
 
 
@@ -82,137 +85,56 @@ public:
 
     LE_NOTHROW char const * LE_FASTCALL create( Utility::File::Stream &&, std::uint8_t numberOfChannels, std::uint32_t sampleRate );
     LE_NOTHROW void         LE_FASTCALL close();
-    LE_NOTHROW char const * LE_FASTCALL write( float const * pInput, std::uint32_t sampleFrames );
+    LE_NOTHROW char const * LE_FASTCALL write( float const *         pInput , std::uint32_t sampleFrames );
+    LE_NOTHROW char const * LE_FASTCALL write( float const * const * pInputs, std::uint32_t sampleFrames );
 
 protected:
     Utility::File::Stream stream_;
 }; // OutputWaveFileImpl
 
-#ifdef _MSC_VER
-    #pragma warning( push )
-    #pragma warning( disable : 4127 ) // Conditional expression is constant (in boost::lockfree::spsc_queue).
-#endif // _MSC_VER
 class OutputWaveFileAsyncImpl : public OutputWaveFileImpl
 {
 public:
-    OutputWaveFileAsyncImpl()
-        :
-    #if defined( __APPLE__ )
-        dispatcher_( nullptr ),
-        counter_   ( 0       ),
-        error_     ( false   )
-    #else
-        #if defined( __ANDROID__ )
-            thread_    ( -1    ),
-            stopWorker_( false ),
-        #elif defined( _WIN32 )
-            overlappedIOHandle_( INVALID_HANDLE_VALUE ),
-        #endif
-        error_( false )
-    #endif
-    {}
+    using Policy = OutputWaveFileAsync::Policy;
+
+    OutputWaveFileAsyncImpl();
     OutputWaveFileAsyncImpl( OutputWaveFileAsyncImpl && );
-    ~OutputWaveFileAsyncImpl() { join(); }
+    ~OutputWaveFileAsyncImpl();
     OutputWaveFileAsyncImpl( OutputWaveFileAsyncImpl const & ) = delete;
 
-#if 0 //...mrmlj...
-    template <Utility::SpecialLocations rootLocation>
-    LE_NOTHROW error_msg_t LE_FASTCALL_ABI create( char const * const pathToFile, std::uint8_t const numberOfChannels, std::uint32_t const sampleRate )
-    {
-        return OutputWaveFileImpl::create<rootLocation>( fileName, numberOfChannels, sampleRate );
-    }
-#endif
-
+    LE_NOTHROW char const * LE_FASTCALL create( Utility::File::Stream &&, std::uint8_t numberOfChannels, std::uint32_t sampleRate );
     LE_NOTHROW bool         LE_FASTCALL close();
     LE_NOTHROW char const * LE_FASTCALL write( float const * pInput, std::uint16_t sampleFrames );
 
+    void setPolicy( Policy const & policy ) { policy_ = policy; }
+
+    std::uint32_t overruns() const { return overruns_.load( std::memory_order_relaxed ); }
+
+    LE_NOTHROW std::uint32_t LE_FASTCALL getTimePosition  () const;
+    LE_NOTHROW std::uint32_t LE_FASTCALL getSamplePosition() const { return framesQueued_; }
+
+private:
+    class Pipeline;
+
     bool run ();
     void join();
 
-private:
-#ifdef __ANDROID__
-    void worker();
-#endif // __ANDROID__
+    void LE_FASTCALL worker   (                                 );
+    bool LE_FASTCALL writeOut ( std::uint32_t maximumSamples    );
+    void LE_FASTCALL writeHeaders();
 
 private:
-#ifdef __APPLE__
-    // https://developer.apple.com/library/ios/documentation/Performance/Reference/GCD_libdispatch_Ref/index.html#//apple_ref/c/func/dispatch_io_write
-    // http://amattn.com/p/grand_central_dispatch_gcd_summary_syntax_best_practices.html
-    // http://www.objc.io/issue-2/low-level-concurrency-apis.html
-    // http://nathanmock.com/files/com.apple.adc.documentation.AppleiOS6.0.iOSLibrary.docset/Contents/Resources/Documents/#documentation/FileManagement/Conceptual/FileSystemProgrammingGUide/TechniquesforReadingandWritingCustomFiles/TechniquesforReadingandWritingCustomFiles.html
-    // portable libdispatch http://stackoverflow.com/questions/7542840/compiler-doesn-t-locate-gcd-header-file-on-windows
-    dispatch_io_t             dispatcher_;
-    std::atomic_uint_least8_t counter_   ;
-    bool                      error_     ;
-#else
-#ifdef _MSC_VER
-    #pragma warning( push )
-    #pragma warning( disable : 4200 ) // Nonstandard extension used: zero-sized array in struct/union.
-#endif // _MSC_VER
-    struct BufferNode
-    #ifdef _WIN32
-        : OVERLAPPED
-    #endif // _WIN32
-    {
-        BufferNode( std::uint16_t const sz, OutputWaveFileAsyncImpl & impl )
-            : capacity( sz ), size( sz )
-        {
-        #ifdef _WIN32
-            OVERLAPPED & overlappedIO( *this );
-            overlappedIO = { 0 };
-            overlappedIO.Offset     = static_cast<DWORD>( -1 );
-            overlappedIO.OffsetHigh = static_cast<DWORD>( -1 );
-            overlappedIO.hEvent     = reinterpret_cast<HANDLE>( &impl );
-        #endif // _WIN32
-        }
-
-        std::uint16_t const capacity/*in frames*/;
-        std::uint16_t       size    /*in frames*/;
-    #ifdef _WIN32
-        internal_sample_t   data[];
-    #else
-        float               data[];
-    #endif // OS
-    }; // class BufferNode
-#ifdef _MSC_VER
-    #pragma warning( push )
-#endif // _MSC_VER
-
-    // http://www.boost.org/doc/libs/release/doc/html/boost/lockfree/spsc_queue.html
-    // https://github.com/arielelkin/BionicLooper/blob/master/TheAmazingAudioEngine/Modules/TPCircularBuffer/TPCircularBuffer.h
-    // http://www.1024cores.net/home/lock-free-algorithms/queues/unbounded-spsc-queue
-    static std::uint8_t const queueCapacity
-    #if defined( _WIN32 ) || ( defined( __ANDROID__ ) && ( __LP64__ || defined( __i386__ ) ) )
-        = 4;
-    #elif defined( __ANDROID__ )
-        = 10;
-    #endif // _WIN32
-    using Queue = boost::lockfree::spsc_queue<BufferNode *, boost::lockfree::capacity<queueCapacity>>;
-
-#if defined( __ANDROID__ )
-    Utility::ConditionVariable       bufferNotEmpty_;
-    Utility::ConditionVariable       bufferNotFull_ ;
-    Utility::ConditionVariable::Lock bufferLock_    ;
-
-    /// \note Avoid std::thread STL dependency (libc++ vs libstdc++) and bloat
-    /// (due to required static linking).
-    ///                                       (09.12.2015.) (Domagoj Saric)
-    ::pthread_t thread_;
-
-    Queue queue_;
-
-    volatile bool stopWorker_;
-#elif defined( _WIN32 )
-    HANDLE overlappedIOHandle_;
-#endif // __ANDROID__
-    bool error_;
-
-    Queue cache_;
-#endif // OS
+    Policy policy_;
+
+    /// \note All the state shared with the worker thread (the ring buffer,
+    /// the conversion buffers and the thread itself) is allocated by create()
+    /// in a single block so that write() never allocates and the object itself
+    /// stays small (and movable while no file is open).
+    std::unique_ptr<Pipeline> pPipeline_;
+
+    std::atomic<std::uint32_t> overruns_    ;
+    std::uint32_t              framesQueued_; // producer (write()) side position
 }; // class OutputWaveFileAsyncImpl
-#ifdef _MSC_VER
-    #pragma warning( pop )
-#endif // _MSC_VER
 
 //------------------------------------------------------------------------------
 } // namespace AudioIO
@@ -154,6 +154,46 @@ namespace Detail
 
     using DataHeader = ChunkHeader<'atad'>;
 
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \struct RF64Header
+    /// \brief RIFF header replacement for files with chunks larger than 4 GB
+    /// (EBU Tech 3306). The 32 bit RIFF and data chunk sizes are set to
+    /// 0xFFFFFFFF and the real ones are stored in the DS64 chunk.
+    ////////////////////////////////////////////////////////////////////////////
+
+    struct RF64Header : ChunkHeader<'46FR'>
+    {
+        FixedValue<DWORD, 'EVAW'> waveTag;
+    }; // struct RF64Header
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \struct DS64
+    ////////////////////////////////////////////////////////////////////////////
+
+    struct DS64 : ChunkHeader<'46sd'>
+    {
+        DWORD riffSizeLow    ; DWORD riffSizeHigh    ;
+        DWORD dataSizeLow    ; DWORD dataSizeHigh    ;
+        DWORD sampleCountLow ; DWORD sampleCountHigh ;
+        DWORD tableLength    ;
+    }; // struct DS64
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \struct DS64Placeholder
+    /// \brief A JUNK chunk reserving room for a DS64 chunk so that a file can
+    /// be turned into an RF64 one in place (by rewriting only the headers).
+    ////////////////////////////////////////////////////////////////////////////
+
+    struct DS64Placeholder : ChunkHeader<'KNUJ'>
+    {
+        std::uint8_t reserved[ sizeof( DS64 ) - sizeof( ChunkHeader<'KNUJ'> ) ];
+    }; // struct DS64Placeholder
+
+    static_assert( sizeof( DS64Placeholder ) == sizeof( DS64 ), "Internal inconsistency" );
+
     #pragma warning( pop )
     #pragma pack   ( pop )
 
@@ -7,11 +7,22 @@
 ///
 ////////////////////////////////////////////////////////////////////////////////
 //------------------------------------------------------------------------------
+#include "le/utility/platformSpecifics.hpp"
+
+LE_OPTIMIZE_FOR_SPEED_BEGIN()
+LE_FAST_MATH_ON()
+
 #include "domainConversion.hpp"
 
+#include "le/math/constants.hpp"
 #include "le/math/vector.hpp"
 
 #include "boost/assert.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 //------------------------------------------------------------------------------
 namespace LE
 {
@@ -19,16 +30,112 @@ namespace LE
 LE_IMPL_NAMESPACE_BEGIN( Math )
 //------------------------------------------------------------------------------
 
+namespace
+{
+    ////////////////////////////////////////////////////////////////////////////
+    // Polynomials<accuracy>
+    ////////////////////////////////////////////////////////////////////////////
+    // Implementation note:
+    //   Near-minimax (iteratively reweighted least squares) fits: atan() over
+    // [-1, 1], sin() and cos() over [-pi/2, pi/2].
+    ////////////////////////////////////////////////////////////////////////////
+
+    template <ConversionAccuracy> struct Polynomials;
+
+    template <>
+    struct Polynomials<CoarseConversion>
+    {
+        static float atan( float const x ) { float const x2( x * x ); return x * ( 0.99535551f  + x2 * ( -0.288679859f + x2 * 0.079330501f   ) ); }
+        static float sin ( float const x ) { float const x2( x * x ); return x * ( 0.999696761f + x2 * ( -0.16567306f  + x2 * 0.00751437082f ) ); }
+        static float cos ( float const x ) { float const x2( x * x ); return       0.999403187f + x2 * ( -0.49558071f  + x2 * 0.036791626f   )  ; }
+    }; // struct Polynomials<CoarseConversion>
+
+    template <>
+    struct Polynomials<FineConversion>
+    {
+        static float atan( float const x ) { float const x2( x * x ); return x * ( 0.999866243f + x2 * ( -0.330303572f + x2 * ( 0.180154774f   + x2 * ( -0.085150178f   + x2 * 0.0208423226f ) ) ) ); }
+        static float sin ( float const x ) { float const x2( x * x ); return x * ( 0.999996616f + x2 * ( -0.166648284f + x2 * ( 0.00830632498f + x2 *   -0.000183636481f ) ) ); }
+        static float cos ( float const x ) { float const x2( x * x ); return       0.999993295f + x2 * ( -0.499912438f + x2 * ( 0.0414877457f  + x2 *   -0.00127120885f  ) )  ; }
+    }; // struct Polynomials<FineConversion>
+
+
+    // Implementation note:
+    //   The approximated conversions are written in "select form" (without
+    // branches) so that the loops get vectorised.
+
+    template <ConversionAccuracy accuracy>
+    LE_HOT
+    void approximateRectangular2Polar
+    (
+        float const * LE_RESTRICT const pReals     , float const * LE_RESTRICT const pImags ,
+        float       * LE_RESTRICT const pAmplitudes, float       * LE_RESTRICT const pPhases,
+        std::uint16_t                               const numberOfSamples
+    )
+    {
+        for ( std::uint16_t sample( 0 ); sample < numberOfSamples; ++sample )
+        {
+            float const real   ( pReals[ sample ]   );
+            float const imag   ( pImags[ sample ]   );
+            float const absReal( std::abs( real )   );
+            float const absImag( std::abs( imag )   );
+            // atan() of the smaller over the larger component (0 / 0 -> 0):
+            float const ratio  ( std::min( absReal, absImag ) / std::max( std::max( absReal, absImag ), std::numeric_limits<float>::min() ) );
+            float       phase  ( Polynomials<accuracy>::atan( ratio ) );
+            phase = ( absImag > absReal ) ? Constants::pi / 2 - phase : phase;
+            phase = ( real    < 0       ) ? Constants::pi     - phase : phase;
+            pPhases    [ sample ] = ( imag < 0 ) ? -phase : phase;
+            pAmplitudes[ sample ] = std::sqrt( real * real + imag * imag );
+        }
+    }
+
+
+    template <ConversionAccuracy accuracy>
+    LE_HOT
+    void approximatePolar2Rectangular
+    (
+        float const * LE_RESTRICT const pAmplitudes, float const * LE_RESTRICT const pPhases,
+        float       * LE_RESTRICT const pReals     , float       * LE_RESTRICT const pImags ,
+        std::uint16_t                               const numberOfSamples
+    )
+    {
+        for ( std::uint16_t sample( 0 ); sample < numberOfSamples; ++sample )
+        {
+            float const phase    ( pPhases[ sample ] );
+            // Wrap into [-pi, pi] (effects do not necessarily keep their
+            // output phases wrapped):
+            float const periods  ( phase * ( 1 / Constants::twoPi ) );
+            float const wrapped  ( phase - Constants::twoPi * static_cast<float>( static_cast<std::int32_t>( periods + ( ( periods < 0 ) ? -0.5f : 0.5f ) ) ) );
+            // Fold into [-pi/2, pi/2] (sin( x ) = sin( pi - x ), cos( x ) =
+            // -cos( pi - x )):
+            bool  const fold     ( std::abs( wrapped ) > Constants::pi / 2           );
+            float const mirror   ( ( wrapped < 0 ) ? -Constants::pi : Constants::pi );
+            float const folded   ( fold ? mirror - wrapped : wrapped                 );
+            float const cosine   ( Polynomials<accuracy>::cos( folded )              );
+            float const amplitude( pAmplitudes[ sample ] );
+            pReals[ sample ] = amplitude * ( fold ? -cosine : cosine );
+            pImags[ sample ] = amplitude * Polynomials<accuracy>::sin( folded );
+        }
+    }
+} // anonymous namespace
+
+
 void LE_FASTCALL reim2AmPh
 (
     float const * const reals     , float const * const imags ,  // input
     float       * const amplitudes, float       * const phases,  // output
-    std::uint16_t const numberOfSamples
+    std::uint16_t const numberOfSamples,
+    ConversionAccuracy const accuracy
 )
 {
     BOOST_ASSERT( reals && imags && amplitudes && phases );
 
-    rectangular2polar( reals, imags, amplitudes, phases, numberOfSamples );
+    switch ( accuracy )
+    {
+        case CoarseConversion: approximateRectangular2Polar<CoarseConversion>( reals, imags, amplitudes, phases, numberOfSamples ); break;
+        case FineConversion  : approximateRectangular2Polar<FineConversion  >( reals, imags, amplitudes, phases, numberOfSamples ); break;
+        case FullConversion  : rectangular2polar                               ( reals, imags, amplitudes, phases, numberOfSamples ); break;
+        LE_DEFAULT_CASE_UNREACHABLE();
+    }
 }
 
 
@@ -36,12 +143,19 @@ void LE_FASTCALL amph2ReIm
 (
     float const * const amplitudes, float const * const phases,  // input
     float       * const reals     , float       * const imags ,  // output
-    std::uint16_t const numberOfSamples
+    std::uint16_t const numberOfSamples,
+    ConversionAccuracy const accuracy
 )
 {
     BOOST_ASSERT( amplitudes && phases && reals && imags );
 
-    polar2rectangular( amplitudes, phases, reals, imags, numberOfSamples );
+    switch ( accuracy )
+    {
+        case CoarseConversion: approximatePolar2Rectangular<CoarseConversion>( amplitudes, phases, reals, imags, numberOfSamples ); break;
+        case FineConversion  : approximatePolar2Rectangular<FineConversion  >( amplitudes, phases, reals, imags, numberOfSamples ); break;
+        case FullConversion  : polar2rectangular                               ( amplitudes, phases, reals, imags, numberOfSamples ); break;
+        LE_DEFAULT_CASE_UNREACHABLE();
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -49,3 +163,5 @@ LE_IMPL_NAMESPACE_END( Math )
 //------------------------------------------------------------------------------
 } // namespace LE
 //------------------------------------------------------------------------------
+
+LE_OPTIMIZE_FOR_SPEED_END()
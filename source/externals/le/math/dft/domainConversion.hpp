@@ -21,18 +21,31 @@ namespace LE
 LE_IMPL_NAMESPACE_BEGIN( Math )
 //------------------------------------------------------------------------------
 
+/// Accuracy tiers of the polar <-> rectangular conversions (ordered from the
+/// cheapest). The tiers differ only in the phase (atan2) and sine/cosine
+/// accuracy, amplitudes are always exact. The given errors are the measured
+/// maximum absolute phase/sine/cosine errors.
+enum ConversionAccuracy : std::uint8_t
+{
+    CoarseConversion, ///< 5th order polynomials (~6e-4)
+    FineConversion  , ///< 7th/9th order polynomials (~1e-5)
+    FullConversion    ///< the Math::rectangular2polar() and polar2rectangular() precision
+};
+
 void LE_FASTCALL reim2AmPh
 (
     float const * reals     , float const * imags ,  // input
     float       * amplitudes, float       * phases,  // output
-    std::uint16_t numberOfSamples
+    std::uint16_t numberOfSamples,
+    ConversionAccuracy = FullConversion
 );
 
 void LE_FASTCALL amph2ReIm
 (
     float const * amplitudes, float const * phases,  // input
     float       * reals     , float       * imags ,  // output
-    std::uint16_t numberOfSamples
+    std::uint16_t numberOfSamples,
+    ConversionAccuracy = FullConversion
 );
 
 //------------------------------------------------------------------------------
@@ -13,6 +13,7 @@
 #define math_hpp__C20A5FD2_AC91_41D7_8F61_B10C67B19A6D
 #pragma once
 //------------------------------------------------------------------------------
+#include "le/utility/binaryTrace.hpp"
 #include "le/utility/platformSpecifics.hpp"
 
 #ifdef LE_HAS_NT2
@@ -377,8 +378,16 @@ void LE_FASTCALL verifyFPValues
     long         const line
 )
 {
-#ifdef NDEBUG
+#if defined( NDEBUG ) && defined( LE_NO_BINARY_TRACE )
     boost::ignore_unused_variable_warning( pRange && rangeSize && valueName );
+#elif defined( NDEBUG )
+    // Release builds report (instead of asserting) through the binary trace
+    // ring and only scan the values when the Numerics category is enabled.
+    boost::ignore_unused_variable_warning( function );
+    if ( BOOST_LIKELY( !Utility::BinaryTracer::enabled( Utility::BinaryTracer::Numerics ) ) )
+        return;
+    unsigned int const fpClasses( has<FPClasses>( pRange, rangeSize ) );
+    LE_TRACE_RT_IF( fpClasses, Numerics, "unexpected values (classes %#x) in %s @ %s(%ld)", fpClasses, valueName, file, line );
 #else
     #ifdef BOOST_ENABLE_ASSERT_HANDLER
         #define LE_AUX_VERIFY_FP_VALUES_FAILURE( ... ) boost::assertion_failed_msg( __VA_ARGS__ )
@@ -410,10 +419,15 @@ void verifyFPValues
     return verifyFPValues<FPClasses>( range.begin(), range.size(), valueName, function, file, line );
 }
 
-#ifdef NDEBUG
+#if defined( NDEBUG ) && defined( LE_NO_BINARY_TRACE )
     #ifndef LE_MATH_VERIFY_VALUES // required for unity builds
         #define LE_MATH_VERIFY_VALUES( fpClasses, range, valueName ) (void(0))
     #endif // LE_MATH_VERIFY_VALUES
+#elif defined( NDEBUG )
+    #ifndef LE_MATH_VERIFY_VALUES // required for unity builds
+        #define LE_MATH_VERIFY_VALUES( fpClasses, range, valueName )   \
+            /*::LE::*/Math::verifyFPValues<fpClasses>( range, valueName, nullptr, __FILE__, __LINE__ )
+    #endif // LE_MATH_VERIFY_VALUES
 #else
     #define LE_MATH_VERIFY_VALUES( fpClasses, range, valueName )   \
         /*::LE::*/Math::verifyFPValues<fpClasses>( range, valueName, BOOST_CURRENT_FUNCTION, __FILE__, __LINE__ )
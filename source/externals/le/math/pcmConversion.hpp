@@ -0,0 +1,387 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file pcmConversion.hpp
+/// -----------------------
+///
+/// \brief Conversion between float sample data and PCM storage formats
+/// (interleaved or deinterleaved, with optional TPDF dither).
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef pcmConversion_hpp__3B9D2E47_81F6_4C0A_B5D3_7A2E64C1F908
+#define pcmConversion_hpp__3B9D2E47_81F6_4C0A_B5D3_7A2E64C1F908
+#pragma once
+//------------------------------------------------------------------------------
+#include "le/utility/platformSpecifics.hpp"
+
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_BEGIN( Math )
+//------------------------------------------------------------------------------
+namespace PCM
+{
+//------------------------------------------------------------------------------
+
+/// \note Like convertSamples() in vector.hpp, everything here is used by both
+/// AudioIO and SW (which do not share the LE.Math library) so it all lives in
+/// the header. The kernels are plain, branchless (per sample) loops written so
+/// that they get autovectorized (with byte shuffles for the 24 bit format) and
+/// dispatched once per call on the storage format.
+
+enum class Format : std::uint8_t
+{
+    Int16,
+    Int24,
+    Int32,
+    Float32,
+    Float64
+}; // enum class Format
+
+LE_CONST_FUNCTION BOOST_CONSTEXPR inline
+std::uint8_t bytesPerSample( Format const format )
+{
+    return ( format == Format::Int16   ) ? 2 :
+           ( format == Format::Int24   ) ? 3 :
+           ( format == Format::Int32   ) ? 4 :
+           ( format == Format::Float32 ) ? 4 :
+                                           8 ;
+}
+
+LE_CONST_FUNCTION BOOST_CONSTEXPR inline
+bool isInteger( Format const format ) { return format < Format::Float32; }
+
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class TPDFDither
+///
+/// \brief Triangular PDF dither noise (+/- 1 LSB).
+///
+/// \details Counter based (a hash of the running sample index) rather than a
+/// recursive PRNG so that there is no loop carried dependency (and the
+/// dithered encoding loops still vectorize) and so that the only state is the
+/// sample counter itself (which writers usually already track).
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class TPDFDither
+{
+public:
+    explicit TPDFDither( std::uint32_t const initialSampleIndex = 0 ) : sampleIndex_( initialSampleIndex ) {}
+
+    /// Noise for the sample at <VAR>offset</VAR> from the current position,
+    /// in LSBs.
+    LE_FORCEINLINE LE_CONST_FUNCTION
+    float operator[]( std::uint32_t const offset ) const
+    {
+        // A cheap integer mix (lowbias32) split into two 16 bit uniform
+        // variables whose sum has the triangular distribution.
+        std::uint32_t hash( sampleIndex_ + offset );
+        hash ^= hash >> 16; hash *= 0x7FEB352D;
+        hash ^= hash >> 15; hash *= 0x846CA68B;
+        hash ^= hash >> 16;
+        auto const uniform1( static_cast<std::int32_t>( hash & 0xFFFF ) );
+        auto const uniform2( static_cast<std::int32_t>( hash >> 16    ) );
+        return static_cast<float>( uniform1 + uniform2 - 0xFFFF ) * ( 1.0f / 0x10000 );
+    }
+
+    void advance( std::uint32_t const samples ) { sampleIndex_ += samples; }
+
+private:
+    std::uint32_t sampleIndex_;
+}; // class TPDFDither
+
+
+namespace Detail
+{
+    template <typename T>
+    LE_FORCEINLINE T load( unsigned char const * LE_RESTRICT const pSource ) { T value; std::memcpy( &value, pSource, sizeof( value ) ); return value; }
+
+    template <typename T>
+    LE_FORCEINLINE void store( T const value, unsigned char * LE_RESTRICT const pTarget ) { std::memcpy( pTarget, &value, sizeof( value ) ); }
+
+    /// \note Quantizes an already scaled sample: round to nearest and clamp
+    /// (in the float domain, which maps to min/max instructions, so that
+    /// full scale positive input does not wrap around).
+    LE_FORCEINLINE std::int32_t quantize( float const scaledSample, float const maximum )
+    {
+        float const clamped( std::min( std::max( scaledSample, -maximum - 1 ), maximum ) );
+        return static_cast<std::int32_t>( std::floor( clamped + 0.5f ) );
+    }
+
+    template <Format> struct Codec;
+
+    template <> struct Codec<Format::Int16>
+    {
+        static std::uint8_t const size = 2;
+        static BOOST_CONSTEXPR float scale() { return 32768.0f; }
+
+        LE_FORCEINLINE static float decode( unsigned char const * LE_RESTRICT const p ) { return load<std::int16_t>( p ) * ( 1.0f / scale() ); }
+        LE_FORCEINLINE static void  encode( float const sample, unsigned char * LE_RESTRICT const p ) { store( static_cast<std::int16_t>( quantize( sample * scale(), 32767.0f ) ), p ); }
+    };
+
+    template <> struct Codec<Format::Int24>
+    {
+        static std::uint8_t const size = 3;
+        static BOOST_CONSTEXPR float scale() { return 8388608.0f; }
+
+        LE_FORCEINLINE static float decode( unsigned char const * LE_RESTRICT const p )
+        {
+            // Assemble in the upper 24 bits and shift back to sign extend.
+            auto const value( static_cast<std::int32_t>( ( std::uint32_t( p[ 0 ] ) << 8 ) | ( std::uint32_t( p[ 1 ] ) << 16 ) | ( std::uint32_t( p[ 2 ] ) << 24 ) ) >> 8 );
+            return static_cast<float>( value ) * ( 1.0f / scale() );
+        }
+        LE_FORCEINLINE static void encode( float const sample, unsigned char * LE_RESTRICT const p )
+        {
+            auto const value( static_cast<std::uint32_t>( quantize( sample * scale(), 8388607.0f ) ) );
+            p[ 0 ] = static_cast<unsigned char>( value       );
+            p[ 1 ] = static_cast<unsigned char>( value >>  8 );
+            p[ 2 ] = static_cast<unsigned char>( value >> 16 );
+        }
+    };
+
+    template <> struct Codec<Format::Int32>
+    {
+        static std::uint8_t const size = 4;
+        static BOOST_CONSTEXPR float scale() { return 2147483648.0f; }
+
+        LE_FORCEINLINE static float decode( unsigned char const * LE_RESTRICT const p ) { return static_cast<float>( load<std::int32_t>( p ) ) * ( 1.0f / scale() ); }
+        /// \note The largest float below 2^31 is used as the positive limit
+        /// (2^31 - 1 is not representable).
+        LE_FORCEINLINE static void  encode( float const sample, unsigned char * LE_RESTRICT const p ) { store( quantize( sample * scale(), 2147483520.0f ), p ); }
+    };
+
+    template <> struct Codec<Format::Float32>
+    {
+        static std::uint8_t const size = 4;
+        static BOOST_CONSTEXPR float scale() { return 1.0f; }
+
+        LE_FORCEINLINE static float decode( unsigned char const * LE_RESTRICT const p ) { return load<float>( p ); }
+        LE_FORCEINLINE static void  encode( float const sample, unsigned char * LE_RESTRICT const p ) { store( sample, p ); }
+    };
+
+    template <> struct Codec<Format::Float64>
+    {
+        static std::uint8_t const size = 8;
+        static BOOST_CONSTEXPR float scale() { return 1.0f; }
+
+        LE_FORCEINLINE static float decode( unsigned char const * LE_RESTRICT const p ) { return static_cast<float>( load<double>( p ) ); }
+        LE_FORCEINLINE static void  encode( float const sample, unsigned char * LE_RESTRICT const p ) { store( static_cast<double>( sample ), p ); }
+    };
+
+
+    template <Format format>
+    LE_HOT LE_NOTHROWNOALIAS
+    void decode( unsigned char const * LE_RESTRICT pInput, float * LE_RESTRICT const pOutput, std::uint32_t const samples )
+    {
+        using codec = Codec<format>;
+    #ifdef __clang__
+        #pragma clang loop vectorize( enable ) interleave( enable )
+    #endif // __clang__
+        for ( std::uint32_t sample( 0 ); sample < samples; ++sample )
+            pOutput[ sample ] = codec::decode( &pInput[ sample * codec::size ] );
+    }
+
+    template <Format format>
+    LE_HOT LE_NOTHROWNOALIAS
+    void decode( unsigned char const * LE_RESTRICT pInput, float * LE_RESTRICT const * LE_RESTRICT const pOutputs, std::uint8_t const numberOfChannels, std::uint32_t const frames )
+    {
+        using codec = Codec<format>;
+        switch ( numberOfChannels )
+        {
+            case 1:
+                decode<format>( pInput, pOutputs[ 0 ], frames );
+                break;
+
+            case 2:
+            {
+                float * LE_RESTRICT const pLeft ( pOutputs[ 0 ] );
+                float * LE_RESTRICT const pRight( pOutputs[ 1 ] );
+            #ifdef __clang__
+                #pragma clang loop vectorize( enable ) interleave( enable )
+            #endif // __clang__
+                for ( std::uint32_t frame( 0 ); frame < frames; ++frame )
+                {
+                    pLeft [ frame ] = codec::decode( &pInput[ ( frame * 2 + 0 ) * codec::size ] );
+                    pRight[ frame ] = codec::decode( &pInput[ ( frame * 2 + 1 ) * codec::size ] );
+                }
+                break;
+            }
+
+            default:
+                for ( std::uint8_t channel( 0 ); channel < numberOfChannels; ++channel )
+                {
+                    float               * LE_RESTRICT const pOutput ( pOutputs[ channel ]                        );
+                    unsigned char const * LE_RESTRICT const pChannel( &pInput[ channel * codec::size ]           );
+                    std::uint32_t                     const stride  ( numberOfChannels * std::uint32_t( codec::size ) );
+                    for ( std::uint32_t frame( 0 ); frame < frames; ++frame )
+                        pOutput[ frame ] = codec::decode( &pChannel[ frame * stride ] );
+                }
+        }
+    }
+
+    template <Format format, bool dither>
+    LE_HOT LE_NOTHROWNOALIAS
+    void encode( float const * LE_RESTRICT const pInput, unsigned char * LE_RESTRICT const pOutput, std::uint32_t const samples, TPDFDither const & noise )
+    {
+        using codec = Codec<format>;
+        float const lsb( 1.0f / codec::scale() );
+    #ifdef __clang__
+        #pragma clang loop vectorize( enable ) interleave( enable )
+    #endif // __clang__
+        for ( std::uint32_t sample( 0 ); sample < samples; ++sample )
+            codec::encode( dither ? pInput[ sample ] + noise[ sample ] * lsb : pInput[ sample ], &pOutput[ sample * codec::size ] );
+    }
+
+    template <Format format, bool dither>
+    LE_HOT LE_NOTHROWNOALIAS
+    void encode( float const * LE_RESTRICT const * LE_RESTRICT const pInputs, std::uint8_t const numberOfChannels, unsigned char * LE_RESTRICT const pOutput, std::uint32_t const frames, TPDFDither const & noise )
+    {
+        using codec = Codec<format>;
+        float const lsb( 1.0f / codec::scale() );
+        switch ( numberOfChannels )
+        {
+            case 1:
+                encode<format, dither>( pInputs[ 0 ], pOutput, frames, noise );
+                break;
+
+            case 2:
+            {
+                float const * LE_RESTRICT const pLeft ( pInputs[ 0 ] );
+                float const * LE_RESTRICT const pRight( pInputs[ 1 ] );
+            #ifdef __clang__
+                #pragma clang loop vectorize( enable ) interleave( enable )
+            #endif // __clang__
+                for ( std::uint32_t frame( 0 ); frame < frames; ++frame )
+                {
+                    codec::encode( dither ? pLeft [ frame ] + noise[ frame * 2 + 0 ] * lsb : pLeft [ frame ], &pOutput[ ( frame * 2 + 0 ) * codec::size ] );
+                    codec::encode( dither ? pRight[ frame ] + noise[ frame * 2 + 1 ] * lsb : pRight[ frame ], &pOutput[ ( frame * 2 + 1 ) * codec::size ] );
+                }
+                break;
+            }
+
+            default:
+                for ( std::uint8_t channel( 0 ); channel < numberOfChannels; ++channel )
+                {
+                    float         const * LE_RESTRICT const pChannel( pInputs[ channel ]                        );
+                    unsigned char       * LE_RESTRICT const pTarget ( &pOutput[ channel * codec::size ]         );
+                    std::uint32_t                     const stride  ( numberOfChannels * std::uint32_t( codec::size ) );
+                    for ( std::uint32_t frame( 0 ); frame < frames; ++frame )
+                        codec::encode( dither ? pChannel[ frame ] + noise[ frame * numberOfChannels + channel ] * lsb : pChannel[ frame ], &pTarget[ frame * stride ] );
+                }
+        }
+    }
+
+    template <Format format, typename Input>
+    LE_FORCEINLINE
+    void encodeDispatched( Input const pInput, std::uint8_t const numberOfChannels, void * const pOutput, std::uint32_t const frames, TPDFDither * const pDither )
+    {
+        auto const pBytes( static_cast<unsigned char *>( pOutput ) );
+        if ( pDither && isInteger( format ) )
+        {
+            encode<format, true >( pInput, numberOfChannels, pBytes, frames, *pDither );
+            pDither->advance( frames * numberOfChannels );
+        }
+        else
+        {
+            encode<format, false>( pInput, numberOfChannels, pBytes, frames, TPDFDither() );
+        }
+    }
+} // namespace Detail
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Decoding (PCM storage -> float)
+////////////////////////////////////////////////////////////////////////////////
+
+/// Converts <VAR>samples</VAR> samples (keeping the interleaving, if any).
+inline LE_NOTHROWNOALIAS
+void decode( Format const format, void const * LE_RESTRICT const pInput, float * LE_RESTRICT const pOutput, std::uint32_t const samples )
+{
+    auto const pBytes( static_cast<unsigned char const *>( pInput ) );
+    switch ( format )
+    {
+        case Format::Int16  : Detail::decode<Format::Int16  >( pBytes, pOutput, samples ); break;
+        case Format::Int24  : Detail::decode<Format::Int24  >( pBytes, pOutput, samples ); break;
+        case Format::Int32  : Detail::decode<Format::Int32  >( pBytes, pOutput, samples ); break;
+        case Format::Float32: std::memcpy( pOutput, pInput, samples * sizeof( float ) );   break;
+        case Format::Float64: Detail::decode<Format::Float64>( pBytes, pOutput, samples ); break;
+        LE_DEFAULT_CASE_UNREACHABLE();
+    }
+}
+
+/// Converts and deinterleaves <VAR>frames</VAR> sample frames.
+inline LE_NOTHROWNOALIAS
+void decode( Format const format, void const * LE_RESTRICT const pInterleavedInput, float * LE_RESTRICT const * LE_RESTRICT const pOutputs, std::uint8_t const numberOfChannels, std::uint32_t const frames )
+{
+    auto const pBytes( static_cast<unsigned char const *>( pInterleavedInput ) );
+    switch ( format )
+    {
+        case Format::Int16  : Detail::decode<Format::Int16  >( pBytes, pOutputs, numberOfChannels, frames ); break;
+        case Format::Int24  : Detail::decode<Format::Int24  >( pBytes, pOutputs, numberOfChannels, frames ); break;
+        case Format::Int32  : Detail::decode<Format::Int32  >( pBytes, pOutputs, numberOfChannels, frames ); break;
+        case Format::Float32: Detail::decode<Format::Float32>( pBytes, pOutputs, numberOfChannels, frames ); break;
+        case Format::Float64: Detail::decode<Format::Float64>( pBytes, pOutputs, numberOfChannels, frames ); break;
+        LE_DEFAULT_CASE_UNREACHABLE();
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Encoding (float -> PCM storage)
+////////////////////////////////////////////////////////////////////////////////
+
+/// Converts <VAR>samples</VAR> samples (keeping the interleaving, if any).
+/// Integer formats are TPDF dithered if <VAR>pDither</VAR> is given (which is
+/// then advanced past the written samples), float formats are never dithered.
+inline LE_NOTHROWNOALIAS
+void encode( float const * LE_RESTRICT const pInput, Format const format, void * LE_RESTRICT const pOutput, std::uint32_t const samples, TPDFDither * const pDither = nullptr )
+{
+    switch ( format )
+    {
+        // A single 'channel' of samples is encoded exactly as interleaved data.
+        case Format::Int16  : Detail::encodeDispatched<Format::Int16  >( &pInput, 1, pOutput, samples, pDither ); break;
+        case Format::Int24  : Detail::encodeDispatched<Format::Int24  >( &pInput, 1, pOutput, samples, pDither ); break;
+        case Format::Int32  : Detail::encodeDispatched<Format::Int32  >( &pInput, 1, pOutput, samples, pDither ); break;
+        case Format::Float32: std::memcpy( pOutput, pInput, samples * sizeof( float ) );                         break;
+        case Format::Float64: Detail::encodeDispatched<Format::Float64>( &pInput, 1, pOutput, samples, nullptr ); break;
+        LE_DEFAULT_CASE_UNREACHABLE();
+    }
+}
+
+/// Converts and interleaves <VAR>frames</VAR> sample frames. Dithering as
+/// for the interleaved overload.
+inline LE_NOTHROWNOALIAS
+void encode( float const * LE_RESTRICT const * LE_RESTRICT const pInputs, std::uint8_t const numberOfChannels, Format const format, void * LE_RESTRICT const pInterleavedOutput, std::uint32_t const frames, TPDFDither * const pDither = nullptr )
+{
+    switch ( format )
+    {
+        case Format::Int16  : Detail::encodeDispatched<Format::Int16  >( pInputs, numberOfChannels, pInterleavedOutput, frames, pDither ); break;
+        case Format::Int24  : Detail::encodeDispatched<Format::Int24  >( pInputs, numberOfChannels, pInterleavedOutput, frames, pDither ); break;
+        case Format::Int32  : Detail::encodeDispatched<Format::Int32  >( pInputs, numberOfChannels, pInterleavedOutput, frames, pDither ); break;
+        case Format::Float32: Detail::encodeDispatched<Format::Float32>( pInputs, numberOfChannels, pInterleavedOutput, frames, nullptr ); break;
+        case Format::Float64: Detail::encodeDispatched<Format::Float64>( pInputs, numberOfChannels, pInterleavedOutput, frames, nullptr ); break;
+        LE_DEFAULT_CASE_UNREACHABLE();
+    }
+}
+
+
+//------------------------------------------------------------------------------
+} // namespace PCM
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_END( Math )
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // pcmConversion_hpp
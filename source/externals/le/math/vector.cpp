@@ -106,6 +106,10 @@ LE_FAST_MATH_ON()
 #include "boost/simd/arithmetic/include/functions/simd/sqr.hpp"
 #include "boost/simd/arithmetic/include/functions/simd/sqrt.hpp"
 #include "boost/simd/arithmetic/include/functions/simd/fma.hpp"
+#include "boost/simd/arithmetic/include/functions/simd/max.hpp"
+#include "boost/simd/arithmetic/include/functions/simd/min.hpp"
+#include "boost/simd/boolean/include/functions/simd/if_else.hpp"
+#include "boost/simd/boolean/include/functions/simd/if_zero_else.hpp"
 #include "boost/simd/constant/constants/pi.hpp"
 #include "boost/simd/constant/constants/zero.hpp"
 #include "boost/simd/include/functions/simd/load.hpp"
@@ -113,6 +117,10 @@ LE_FAST_MATH_ON()
 #include "boost/simd/memory/is_aligned.hpp"
 #include "boost/simd/memory/include/functions/simd/splat.hpp"
 #include "boost/simd/meta/is_pointing_to.hpp"
+#include "boost/simd/operator/include/functions/simd/is_greater.hpp"
+#include "boost/simd/operator/include/functions/simd/is_less.hpp"
+#include "boost/simd/operator/include/functions/simd/logical_and.hpp"
+#include "boost/simd/operator/include/functions/simd/minus.hpp"
 #include "boost/simd/operator/include/functions/simd/multiplies.hpp"
 #include "boost/simd/operator/include/functions/simd/plus.hpp"
 #include "boost/simd/operator/include/functions/simd/unary_minus.hpp"
@@ -167,6 +175,7 @@ LE_FAST_MATH_ON()
 #include <algorithm>
 #include <cmath>
 #include <functional>
+#include <limits>
 #include <numeric>
 //------------------------------------------------------------------------------
 namespace LE
@@ -692,6 +701,63 @@ void symmetricMovingAverage( InputRange const & input, OutputRange const output,
 }
 
 
+void gate( InputOutputRange const & data, float const threshold )
+{
+    gate( data.begin(), data.end(), threshold );
+}
+
+
+void limit( InputOutputRange const & data, float const ceiling )
+{
+    limit( data.begin(), data.end(), ceiling );
+}
+
+
+void gateAndLimit( InputOutputRange const & data, float const threshold, float const ceiling )
+{
+    gateAndLimit( data.begin(), data.end(), threshold, ceiling );
+}
+
+
+void expand( InputOutputRange const & data, float const threshold, float const ratio, float const floor )
+{
+    expand( data.begin(), data.end(), threshold, ratio, floor );
+}
+
+
+void slewLimit( InputOutputRange const & data, InputRange const & previous, float const lowerGain, float const upperGain )
+{
+    BOOST_ASSERT_MSG( previous.size() == data.size(), "Range sizes mismatch." );
+    slewLimit( data.begin(), data.end(), previous.begin(), lowerGain, upperGain );
+}
+
+
+// Every stepWidth sized step is replaced with a line starting at its first
+// value and rising (slope = 1) towards its last value.
+void quantise( InputOutputRange data, unsigned int const stepWidth, float const slope )
+{
+    BOOST_ASSERT_MSG( stepWidth, "Wrong parameters." );
+
+    float const slopePerElement( slope / convert<float>( stepWidth ) );
+    while ( data )
+    {
+        unsigned int const currentStepWidth( std::min<unsigned int>( static_cast<unsigned int>( data.size() ), stepWidth ) );
+
+        float * LE_RESTRICT const pStep( data.begin() );
+        data.advance_begin( currentStepWidth );
+
+        float const start( pStep[ 0                    ] );
+        float const end  ( pStep[ currentStepWidth - 1 ] );
+        float const delta( ( end - start ) * slopePerElement );
+
+        // Computed from the index (instead of accumulated) so that there is no
+        // loop carried dependency and the loop gets vectorised.
+        for ( unsigned int i( 0 ); i < currentStepWidth; ++i )
+            pStep[ i ] = start + convert<float>( i ) * delta;
+    }
+}
+
+
 void swap( InputOutputRange const & range1, InputOutputRange const & range2 )
 {
     BOOST_ASSERT_MSG( range1.size() == range2.size(), "Buffer sizes mismatch." );
@@ -1126,6 +1192,132 @@ void squareRoot( float * const pInputOutput, float const * const pOutputEnd )
 }
 
 
+// Implementation note:
+//   The dynamics operations are written in "select form" (both outcomes are
+// computed and the result is chosen with a mask) so that neither the NT2 nor
+// the scalar (autovectorisable) versions branch per element.
+
+LE_NOINLINE_NT2 LE_NOTHROWNOALIAS
+void gate( float * LE_RESTRICT const pInputOutput, float const * LE_RESTRICT const pOutputEnd, float const threshold )
+{
+#ifdef LE_MATH_USE_NT2
+    vector_t const thresholds( boost::simd::splat<vector_t>( threshold ) );
+    EdgeRestoredAlignedRange const outputRange( pInputOutput, pOutputEnd );
+    for ( auto & pack : outputRange )
+    {
+        pack = boost::simd::if_zero_else( boost::simd::is_less( pack, thresholds ), pack );
+    }
+#else
+    for ( float * LE_RESTRICT pValue( pInputOutput ); pValue != pOutputEnd; ++pValue )
+        *pValue = ( *pValue < threshold ) ? 0 : *pValue;
+#endif // LE_MATH_USE_NT2
+}
+
+
+LE_NOINLINE_NT2 LE_NOTHROWNOALIAS
+void limit( float * LE_RESTRICT const pInputOutput, float const * LE_RESTRICT const pOutputEnd, float const ceiling )
+{
+#ifdef LE_MATH_USE_NT2
+    vector_t const ceilings( boost::simd::splat<vector_t>( ceiling ) );
+    EdgeRestoredAlignedRange const outputRange( pInputOutput, pOutputEnd );
+    for ( auto & pack : outputRange )
+    {
+        pack = boost::simd::min( pack, ceilings );
+    }
+#else
+    for ( float * LE_RESTRICT pValue( pInputOutput ); pValue != pOutputEnd; ++pValue )
+        *pValue = std::min( *pValue, ceiling );
+#endif // LE_MATH_USE_NT2
+}
+
+
+LE_NOINLINE_NT2 LE_NOTHROWNOALIAS
+void gateAndLimit( float * LE_RESTRICT const pInputOutput, float const * LE_RESTRICT const pOutputEnd, float const threshold, float const ceiling )
+{
+#ifdef LE_MATH_USE_NT2
+    vector_t const thresholds( boost::simd::splat<vector_t>( threshold ) );
+    vector_t const ceilings  ( boost::simd::splat<vector_t>( ceiling   ) );
+    EdgeRestoredAlignedRange const outputRange( pInputOutput, pOutputEnd );
+    for ( auto & pack : outputRange )
+    {
+        pack = boost::simd::if_zero_else( boost::simd::is_less( pack, thresholds ), boost::simd::min( pack, ceilings ) );
+    }
+#else
+    for ( float * LE_RESTRICT pValue( pInputOutput ); pValue != pOutputEnd; ++pValue )
+        *pValue = ( *pValue < threshold ) ? 0 : std::min( *pValue, ceiling );
+#endif // LE_MATH_USE_NT2
+}
+
+
+// Below the threshold (and above the floor) the distance from the threshold
+// (in dB) is divided by the ratio: x -> threshold * ( x / threshold )^( 1 / ratio ).
+LE_NOINLINE_NT2 LE_NOTHROWNOALIAS
+void expand( float * LE_RESTRICT const pInputOutput, float const * LE_RESTRICT const pOutputEnd, float const threshold, float const ratio, float const floor )
+{
+    BOOST_ASSERT_MSG( ( threshold > 0 ) && ( ratio > 0 ) && ( floor >= 0 ), "Wrong parameters." );
+
+    float const logThreshold( std::log( threshold ) );
+    float const inverseRatio( 1 / ratio             );
+#ifdef LE_MATH_USE_NT2
+    using boost::simd::splat;
+    vector_t const thresholds   ( splat<vector_t>( threshold    ) );
+    vector_t const floors       ( splat<vector_t>( floor        ) );
+    vector_t const logThresholds( splat<vector_t>( logThreshold ) );
+    vector_t const inverseRatios( splat<vector_t>( inverseRatio ) );
+    EdgeRestoredAlignedRange const outputRange( pInputOutput, pOutputEnd );
+    for ( auto & pack : outputRange )
+    {
+        vector_t const expanded( thresholds * nt2::exp( ( nt2::log( pack ) - logThresholds ) * inverseRatios ) );
+        pack = boost::simd::if_else
+        (
+            boost::simd::logical_and( boost::simd::is_less( pack, thresholds ), boost::simd::is_greater( pack, floors ) ),
+            expanded,
+            pack
+        );
+    }
+#else
+    for ( float * LE_RESTRICT pValue( pInputOutput ); pValue != pOutputEnd; ++pValue )
+    {
+        float const value   ( *pValue                                                                     );
+        float const expanded( threshold * std::exp( ( std::log( value ) - logThreshold ) * inverseRatio ) );
+        *pValue = ( ( value < threshold ) & ( value > floor ) ) ? expanded : value;
+    }
+#endif // LE_MATH_USE_NT2
+}
+
+
+// The bounds are applied to the value itself (instead of clamping the
+// current / previous gain) so that there is no division per element.
+LE_NOINLINE_NT2 LE_NOTHROWNOALIAS
+void slewLimit( float * LE_RESTRICT const pInputOutput, float const * LE_RESTRICT const pOutputEnd, float const * LE_RESTRICT const pPrevious, float const lowerGain, float const upperGain )
+{
+    BOOST_ASSERT_MSG( ( lowerGain >= 0 ) && ( lowerGain <= upperGain ), "Wrong parameters." );
+
+    float const minimum( std::numeric_limits<float>::epsilon() );
+#ifdef LE_MATH_USE_NT2
+    using boost::simd::splat;
+    vector_t const minimums  ( splat<vector_t>( minimum   ) );
+    vector_t const lowerGains( splat<vector_t>( lowerGain ) );
+    vector_t const upperGains( splat<vector_t>( upperGain ) );
+    EdgeRestoredAlignedRange const outputRange( pInputOutput, pOutputEnd );
+    BOOST_ASSERT_MSG( outputRange.compatiblyAligned( pPrevious ), "Misaligned data" );
+    vector_t const * LE_RESTRICT pPreviousPack( alignDown( pPrevious ) );
+    for ( auto & pack : outputRange )
+    {
+        vector_t const previous( boost::simd::max( *pPreviousPack++, minimums ) );
+        pack = boost::simd::min( boost::simd::max( pack, previous * lowerGains ), previous * upperGains );
+    }
+#else
+    float const * LE_RESTRICT pPreviousValue( pPrevious );
+    for ( float * LE_RESTRICT pValue( pInputOutput ); pValue != pOutputEnd; ++pValue )
+    {
+        float const previous( std::max( *pPreviousValue++, minimum ) );
+        *pValue = std::min( std::max( *pValue, previous * lowerGain ), previous * upperGain );
+    }
+#endif // LE_MATH_USE_NT2
+}
+
+
 float LE_NOINLINE_NT2 rms( float const * const pData, float const * const pDataEnd )
 {
 #if defined( LE_MATH_USE_ACC )
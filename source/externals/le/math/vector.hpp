@@ -84,6 +84,18 @@ void mix( InputRange const & amps, InputRange const & phases, InputOutputRange c
 void movingAverage         ( InputOutputRange const &             , unsigned int windowWidth );
 void symmetricMovingAverage( InputRange       const &, OutputRange, unsigned int windowWidth );
 
+/// Dynamics style (magnitude shaping) operations. All levels are linear,
+/// expand() works on the dB (log) scale relative to the threshold.
+/// slewLimit() smooths each band (bin) across hops: it keeps every value
+/// within [lowerGain, upperGain] times the band's previous value (kept above
+/// epsilon so that a band can rise from silence).
+void gate        ( InputOutputRange const &, float threshold                                          ); // x < threshold -> 0
+void limit       ( InputOutputRange const &, float ceiling                                            ); // min( x, ceiling )
+void gateAndLimit( InputOutputRange const &, float threshold, float ceiling                           );
+void expand      ( InputOutputRange const &, float threshold, float ratio, float floor                 ); // floor < x < threshold
+void quantise    ( InputOutputRange        , unsigned int stepWidth, float slope                        ); // piecewise linear steps
+void slewLimit   ( InputOutputRange const &, InputRange const & previous, float lowerGain, float upperGain ); // per band smoothing
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Iterator interfaces.
@@ -127,6 +139,12 @@ void exp( float * pInputOutput, float const * pOutputEnd );
 void square    ( float * pInputOutput, float const * pOutputEnd );
 void squareRoot( float * pInputOutput, float const * pOutputEnd );
 
+void gate        ( float * pInputOutput, float const * pOutputEnd, float threshold                                );
+void limit       ( float * pInputOutput, float const * pOutputEnd, float ceiling                                  );
+void gateAndLimit( float * pInputOutput, float const * pOutputEnd, float threshold, float ceiling                 );
+void expand      ( float * pInputOutput, float const * pOutputEnd, float threshold, float ratio, float floor       );
+void slewLimit   ( float * pInputOutput, float const * pOutputEnd, float const * pPrevious, float lowerGain, float upperGain );
+
 float rms( float const * pData, float const * pDataEnd );
 
 void mix( float const * pInput1, float const * pInput2, float * pOutput, float const * pOutputEnd, float input1Weight                     );
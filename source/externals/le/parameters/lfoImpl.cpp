@@ -149,12 +149,13 @@ std::uint16_t LFO::setPeriodInMilliseconds( std::uint16_t const periodInMiliseco
 float LFO::setPeriodInSeconds( float const periodInSeconds )
 {
     auto & impl( static_cast<LFOImpl &>( *this ) );
-    auto const periodScale( periodInSeconds / LFOImpl::Timer::basePeriod() );
+    auto const periodScale     ( periodInSeconds / LFOImpl::Timer::basePeriod() );
+    auto const measureNumerator( LFOImpl::Timer::measureNumerator()            );
     auto const clampedPeriodScale
     (
         ( impl.syncTypes() == LFO::Free )
-            ? impl.clampFreePeriod ( periodScale                   )
-            : impl.snapSyncedPeriod( periodScale, impl.syncTypes() ).first
+            ? impl.clampFreePeriod ( periodScale                  , measureNumerator )
+            : impl.snapSyncedPeriod( periodScale, impl.syncTypes(), measureNumerator ).first
     );
     impl.setPeriodScale( clampedPeriodScale );
     return clampedPeriodScale * LFOImpl::Timer::basePeriod();
@@ -220,8 +221,9 @@ void LFOImpl::setPeriodScale( value_type const newPeriodScale )
 }
 
 
-LFOImpl::value_type LE_NOTHROWNOALIAS LFOImpl::currentPeriodScaleMinimum() { return ( 2.0f / 3.0f /*for triplets    */ ) / LFOImpl::minimumPeriodAsMaximumBeatDenominator / LFOImpl::Timer::measureNumeratorFloat(); }
-LFOImpl::value_type LE_NOTHROWNOALIAS LFOImpl::currentPeriodScaleMaximum() { return ( 3.0f / 2.0f /*for dotted notes*/ ) * LFOImpl::maximumPeriodInNumberOfBars                                                    ; }
+LFOImpl::value_type LE_NOTHROWNOALIAS LFOImpl::currentPeriodScaleMinimum( std::uint8_t const measureNumerator ) { return ( 2.0f / 3.0f /*for triplets    */ ) / LFOImpl::minimumPeriodAsMaximumBeatDenominator / Math::convert<value_type>( measureNumerator ); }
+LFOImpl::value_type LE_NOTHROWNOALIAS LFOImpl::currentPeriodScaleMinimum(                                      ) { return currentPeriodScaleMinimum( LFOImpl::Timer::measureNumerator() )                                                                       ; }
+LFOImpl::value_type LE_NOTHROWNOALIAS LFOImpl::currentPeriodScaleMaximum(                                      ) { return ( 3.0f / 2.0f /*for dotted notes*/ ) * LFOImpl::maximumPeriodInNumberOfBars                                                           ; }
 
 namespace
 {
@@ -377,6 +379,34 @@ namespace
         &dirac          ,
         &diracUpsideDown
     };
+
+
+    LE_FORCEINLINE
+    lfo_value_t periodOffset( lfo_value_t const periodScale, lfo_value_t const phase )
+    {
+        //...mrmlj...
+    #ifndef NDEBUG
+        return Math::abs( periodScale * phase );
+    #else
+        return            periodScale * phase  ;
+    #endif // _DEBUG
+    }
+
+
+    LE_FORCEINLINE
+    lfo_value_t mapToBounds( lfo_value_t const value, lfo_value_t const lowerBound, lfo_value_t const upperBound )
+    {
+        return Math::convertLinearRange
+        <
+            lfo_value_t,
+            lfo_value_t, LFOImpl::minimumValue, LFOImpl::maximumValue - LFOImpl::minimumValue, 1
+        >
+        (
+           value     ,
+           lowerBound,
+           upperBound
+        );
+    }
 } // anonymous namespace
 
 LE_NOTHROWNOALIAS
@@ -395,14 +425,8 @@ LFOImpl::value_type LE_NOTHROWNOALIAS LFOImpl::getWaveformAmplitudeForPosition(
 
 LFOImpl::value_type LE_NOTHROWNOALIAS LFOImpl::getValue( Timer const & timer ) const
 {
-    value_type const periodScale( this->periodScale() );
-
-    //...mrmlj...
-#ifndef NDEBUG
-    value_type const periodOffset( Math::abs( periodScale * phase() ) );
-#else
-    value_type const periodOffset(            periodScale * phase()   );
-#endif // _DEBUG
+    value_type const periodScale ( this->periodScale()                              );
+    value_type const periodOffset( LE::Parameters::periodOffset( periodScale, phase() ) );
 
     value_type const currentPeriodNormalisedPosition( Math::splitFloat( ( periodOffset + timer.currentTimeInBars() ) / periodScale ).fractional );
     BOOST_ASSERT( currentPeriodNormalisedPosition >= 0 );
@@ -416,25 +440,68 @@ LFOImpl::value_type LE_NOTHROWNOALIAS LFOImpl::getValue( Timer const & timer ) c
     value_type const newValue( getWaveformAmplitudeForPosition( currentPeriodNormalisedPosition, newPeriod ) );
 
     BOOST_ASSERT( isValueInRange( newValue ) );
-    value_type const result
-    (
-        Math::convertLinearRange
-        <
-            value_type,
-            value_type, LFOImpl::minimumValue, LFOImpl::maximumValue - LFOImpl::minimumValue, 1
-        >
-        (
-           newValue    ,
-           lowerBound(),
-           upperBound()
-        )
-    );
+    value_type const result( mapToBounds( newValue, lowerBound(), upperBound() ) );
     BOOST_ASSERT( isValueInBounds( result ) );
 
     return result;
 }
 
 
+#ifndef LE_NO_LFOs
+void LFOImpl::Batch::add( LFOImpl const & lfo )
+{
+    BOOST_ASSERT( !full() );
+    value_type const periodScale( lfo.periodScale() );
+    periodScales_ [ size_ ] = periodScale;
+    periodOffsets_[ size_ ] = periodOffset( periodScale, lfo.phase() );
+    lowerBounds_  [ size_ ] = lfo.lowerBound();
+    upperBounds_  [ size_ ] = lfo.upperBound();
+    pLFOs_        [ size_ ] = &lfo;
+    ++size_;
+}
+
+
+LE_NOTHROWNOALIAS
+void LFOImpl::Batch::evaluate( Timer const & timer )
+{
+    value_type   const currentTimeInBars ( timer.currentTimeInBars () );
+    value_type   const previousTimeInBars( timer.previousTimeInBars() );
+    std::uint8_t const size              ( size_                       );
+
+    // Period positions and boundaries: the same calculations as in getValue()
+    // with the (out-of-line) Math::splitFloat() and
+    // Math::PositiveFloats::modulo() calls expanded so that the loop can be
+    // vectorised.
+    for ( std::uint8_t lfo( 0 ); lfo < size; ++lfo )
+    {
+        value_type const periodScale    ( periodScales_ [ lfo ] );
+        value_type const periodOffset   ( periodOffsets_[ lfo ] );
+        value_type const currentPeriods ( ( periodOffset + currentTimeInBars  ) / periodScale );
+        value_type const previousPeriods( ( periodOffset + previousTimeInBars ) / periodScale );
+
+        value_type const previousPeriodPosition  ( ( periodOffset + previousTimeInBars ) - static_cast<std::int32_t>( previousPeriods ) * periodScale );
+        value_type const periodEndForPreviousTime( previousTimeInBars + ( periodScale - previousPeriodPosition )                                   );
+
+        positions_ [ lfo ] = currentPeriods - static_cast<std::int32_t>( currentPeriods );
+        newPeriods_[ lfo ] = currentTimeInBars > periodEndForPreviousTime;
+    }
+
+    // Waveforms.
+    for ( std::uint8_t lfo( 0 ); lfo < size; ++lfo )
+    {
+        BOOST_ASSERT( positions_[ lfo ] >= 0 );
+        BOOST_ASSERT( positions_[ lfo ] <= 1 );
+        values_[ lfo ] = pLFOs_[ lfo ]->getWaveformAmplitudeForPosition( positions_[ lfo ], newPeriods_[ lfo ] );
+        BOOST_ASSERT( isValueInRange( values_[ lfo ] ) );
+    }
+
+    // Bounds.
+    for ( std::uint8_t lfo( 0 ); lfo < size; ++lfo )
+        values_[ lfo ] = mapToBounds( values_[ lfo ], lowerBounds_[ lfo ], upperBounds_[ lfo ] );
+}
+#endif // LE_NO_LFOs
+
+
 // Implementation note:
 //   'Free' LFO absolute<->relative value conversion. See the implementation
 // note for the static barDuration member for more details.
@@ -455,9 +522,9 @@ template <>
 LFOImpl::PeriodScale::value_type LFOImpl::adjustValueFromPreset<LFOImpl::PeriodScale>( LFOImpl::PeriodScale::value_type const periodScale ) const
 {
     if ( syncTypes() == LFO::Free )
-        return clampFreePeriod ( periodScale / LFOImpl::Timer::basePeriod() / 1000 );
+        return clampFreePeriod ( periodScale / LFOImpl::Timer::basePeriod() / 1000, LFOImpl::Timer::measureNumerator() );
     else
-        return snapSyncedPeriod( periodScale, syncTypes() ).first;
+        return snapSyncedPeriod( periodScale, syncTypes(), LFOImpl::Timer::measureNumerator() ).first;
 }
 
 
@@ -467,10 +534,10 @@ void LFOImpl::snapPeriodScaleFromAutomation( PeriodScale & periodScale )
     auto const & lfo       ( Utility::ParentFromMember         <LFOImpl, Parameters, &LFOImpl::parameters_>()( parameters  ) );
 
     if ( lfo.syncTypes() != LFO::Free )
-        periodScale = snapSyncedPeriod( periodScale, lfo.syncTypes() ).first;
+        periodScale = snapSyncedPeriod( periodScale, lfo.syncTypes(), LFOImpl::Timer::measureNumerator() ).first;
     else
     {
-        BOOST_ASSERT( clampFreePeriod( periodScale ) == periodScale );
+        BOOST_ASSERT( clampFreePeriod( periodScale, LFOImpl::Timer::measureNumerator() ) == periodScale );
     }
 }
 
@@ -487,21 +554,21 @@ bool LFOImpl::isValueInRange( value_type const value )
 }
 
 
-LFOImpl::value_type LFOImpl::clampFreePeriod( value_type const absolutePeriod )
+LFOImpl::value_type LFOImpl::clampFreePeriod( value_type const absolutePeriod, std::uint8_t const measureNumerator )
 {
-    return Math::clamp( absolutePeriod, currentPeriodScaleMinimum(), currentPeriodScaleMaximum() );
+    return Math::clamp( absolutePeriod, currentPeriodScaleMinimum( measureNumerator ), currentPeriodScaleMaximum() );
 }
 
 
 namespace
 {
-    lfo_value_t snapSyncedPeriodScale( lfo_value_t const periodScale )
+    lfo_value_t snapSyncedPeriodScale( lfo_value_t const periodScale, std::uint8_t const measureNumeratorInteger )
     {
         using namespace Math;
 
-        float        const measureNumerator ( LFOImpl::Timer::measureNumeratorFloat() );
+        float        const measureNumerator ( convert<float>( measureNumeratorInteger ) );
         std::uint8_t const numberOfBeats    ( round( periodScale * measureNumerator ) );
-        if ( numberOfBeats > LFOImpl::Timer::measureNumerator() )
+        if ( numberOfBeats > measureNumeratorInteger )
         {
             float const numberOfBeatsClampedToPowerOfTwo( convert<float>( PowerOfTwo::round( numberOfBeats ) ) );
 
@@ -516,13 +583,13 @@ namespace
             BOOST_ASSERT
             (
                 ( numberOfBeats >= 1                                  ) &&
-                ( numberOfBeats <= LFOImpl::Timer::measureNumerator() )
+                ( numberOfBeats <= measureNumeratorInteger )
             );
 
-            auto const wholeDivisorFinder( []( std::uint8_t const value ) { return LFOImpl::Timer::measureNumerator() % value == 0; } );
+            auto const wholeDivisorFinder( [=]( std::uint8_t const value ) { return measureNumeratorInteger % value == 0; } );
 
-            auto const upperClosest( *boost::find_if( boost::counting_range( numberOfBeats    , LFOImpl::Timer::measureNumerator() ), wholeDivisorFinder ) );
-            auto const lowerClosest( *boost::find_if( boost::counting_range( std::uint8_t( 1 ), numberOfBeats                      ), wholeDivisorFinder ) );
+            auto const upperClosest( *boost::find_if( boost::counting_range( numberOfBeats    , measureNumeratorInteger ), wholeDivisorFinder ) );
+            auto const lowerClosest( *boost::find_if( boost::counting_range( std::uint8_t( 1 ), numberOfBeats           ), wholeDivisorFinder ) );
             auto const closest
             (
                 ( ( upperClosest - numberOfBeats ) < ( numberOfBeats - lowerClosest ) )
@@ -548,19 +615,19 @@ namespace
         }
     }
 
-    lfo_value_t snapSyncedPeriodScale( lfo_value_t const periodScale, float const tempoScale )
+    lfo_value_t snapSyncedPeriodScale( lfo_value_t const periodScale, float const tempoScale, std::uint8_t const measureNumerator )
     {
-        return snapSyncedPeriodScale( periodScale * tempoScale ) / tempoScale;
+        return snapSyncedPeriodScale( periodScale * tempoScale, measureNumerator ) / tempoScale;
     }
 } // anonymous namespace
 
-LFOImpl::SnappedPeriod LFOImpl::snapSyncedPeriod( value_type const periodScale, std::uint8_t const syncTypes )
+LFOImpl::SnappedPeriod LFOImpl::snapSyncedPeriod( value_type const periodScale, std::uint8_t const syncTypes, std::uint8_t const measureNumerator )
 {
     BOOST_ASSERT( syncTypes != Free );
 
-    float const quarterPeriod( snapSyncedPeriodScale( periodScale, 1 / 1.0f ) );
-    float const tripletPeriod( snapSyncedPeriodScale( periodScale, 3 / 2.0f ) );
-    float const dottedPeriod ( snapSyncedPeriodScale( periodScale, 2 / 3.0f ) );
+    float const quarterPeriod( snapSyncedPeriodScale( periodScale, 1 / 1.0f, measureNumerator ) );
+    float const tripletPeriod( snapSyncedPeriodScale( periodScale, 3 / 2.0f, measureNumerator ) );
+    float const dottedPeriod ( snapSyncedPeriodScale( periodScale, 2 / 3.0f, measureNumerator ) );
 
     SnappedPeriod const nearestPeriods[] =
     {
@@ -587,8 +654,8 @@ LFOImpl::SnappedPeriod LFOImpl::snapSyncedPeriod( value_type const periodScale,
 LFOImpl::SnappedPeriod LFOImpl::snapPeriodScale( value_type const periodScale, std::uint8_t const syncTypes )
 {
     return ( syncTypes == Free )
-                ? SnappedPeriod( clampFreePeriod( periodScale ), Free )
-                : snapSyncedPeriod( periodScale, syncTypes );
+                ? SnappedPeriod( clampFreePeriod( periodScale, Timer::measureNumerator() ), Free )
+                : snapSyncedPeriod( periodScale, syncTypes, Timer::measureNumerator() );
 }
 
 
@@ -597,13 +664,13 @@ void LFOImpl::updateForNewTimingInformation( Timer::TimingInformationChange cons
     if ( syncTypes() == Free )
     {
         if ( timingInformationChage.barDurationChanged() )
-            setPeriodScale( clampFreePeriod( periodScale() * timingInformationChage.barDurationChangeRatio_ ) );
+            setPeriodScale( clampFreePeriod( periodScale() * timingInformationChage.barDurationChangeRatio_, timingInformationChage.measureNumerator_ ) );
     }
     else
     {
         BOOST_ASSERT( syncTypes() != Free );
         if ( timingInformationChage.measureNumeratorChanged() )
-            setPeriodScale( snapSyncedPeriod( periodScale(), syncTypes() ).first );
+            setPeriodScale( snapSyncedPeriod( periodScale(), syncTypes(), timingInformationChage.measureNumerator_ ).first );
     }
 }
 
@@ -696,13 +763,18 @@ Plugins::AutomatedParameterValue LFOImpl::linearisePeriodScale( Plugins::Automat
 // variable is used. This should not create problems if the assumption that no
 // host uses more than one tempo value at any given time is correct.
 //                                            (07.01.2011.) (Domagoj Saric)
+//   Timers track their own timing information (and detect changes against it)
+// so only the code without access to a timer (the above, parameter bounds and
+// the GUI) relies on the global (reference) timing.
 // Assume 120 BPM 4/4
-LFOImpl::value_type LFOImpl::Timer::barDuration_        ( 60.0f / 120 * 4 );
-std::uint8_t        LFOImpl::Timer::measureNumerator_   ( 4               );
-bool                LFOImpl::Timer::hasTempoInformation_( false           );
+LFOImpl::Timer::Timing LFOImpl::Timer::referenceTiming_ = { 60.0f / 120 * 4, 4, false };
 
 
-LFOImpl::Timer::Timer() { reset(); }
+LFOImpl::Timer::Timer()
+{
+    timing_ = referenceTiming_;
+    reset();
+}
 
 
 LFOImpl::Timer::TimingInformationChange LE_FASTCALL
@@ -723,31 +795,12 @@ LFOImpl::Timer::updatePositionAndTimingInformation
     previousTimeInBars_ = currentTimeInBars_;
     currentTimeInBars_  = positionInBars    ;
 
-    // Timing info
-    // Implementation note:
-    //   Bar duration change alone (e.g. when only the tempo changes) would be
-    // implicitly handled (i.e. no update would be required because we remember
-    // LFO durations relative to bar durations anyway) if it weren't for free
-    // LFOs which require that their (absolute) value remains constant
-    // (therefore their relative duration must be updated when the bar
-    // duration changes).
-    //                                        (02.02.2011.) (Domagoj Saric)
-    TimingInformationChange const changeInfo =
-    {
-        barDuration_      / barDuration,      // barDurationChangeRatio_
-        measureNumerator_ != measureNumerator // measureNumeratorChanged_
-    };
-
-    hasTempoInformation_ = true;
-
-    barDuration_      = barDuration;
-    measureNumerator_ = measureNumerator;
-
     BOOST_ASSERT( std::isfinite( currentTimeInBars_  ) );
     BOOST_ASSERT( std::isfinite( previousTimeInBars_ ) );
-    BOOST_ASSERT( std::isfinite( barDuration_        ) );
 
-    return changeInfo;
+    // Timing info
+    Timing const newTiming = { barDuration, measureNumerator, true };
+    return updateTiming( newTiming );
 }
 
 
@@ -759,8 +812,8 @@ LFOImpl::Timer::updatePositionAndTimingInformation
 )
 {
     // Position
-    float const timeToAdvanceInSeconds( Math::convert<float>( deltaNumberOfSamples  ) / sampleRate   );
-    float const timeToAdvanceInBars   (                       timeToAdvanceInSeconds  / barDuration_ );
+    float const timeToAdvanceInSeconds( Math::convert<float>( deltaNumberOfSamples  ) / sampleRate          );
+    float const timeToAdvanceInBars   (                       timeToAdvanceInSeconds  / timing_.barDuration );
 
     BOOST_ASSERT( ( currentTimeInBars_ >= previousTimeInBars_ ) || ( currentTimeInBars_ == 0 ) );
     previousTimeInBars_  = currentTimeInBars_;
@@ -771,16 +824,33 @@ LFOImpl::Timer::updatePositionAndTimingInformation
     std::uint8_t const measureNumerator( 4                              );
     float        const barDuration     ( 60.0f / 120 * measureNumerator );
 
+    Timing const newTiming = { barDuration, measureNumerator, false };
+    return updateTiming( newTiming );
+}
+
+
+LFOImpl::Timer::TimingInformationChange LE_FASTCALL
+LFOImpl::Timer::updateTiming( Timing const & newTiming )
+{
+    BOOST_ASSERT( std::isfinite( newTiming.barDuration ) );
+
+    // Implementation note:
+    //   Bar duration change alone (e.g. when only the tempo changes) would be
+    // implicitly handled (i.e. no update would be required because we remember
+    // LFO durations relative to bar durations anyway) if it weren't for free
+    // LFOs which require that their (absolute) value remains constant
+    // (therefore their relative duration must be updated when the bar
+    // duration changes).
+    //                                        (02.02.2011.) (Domagoj Saric)
     TimingInformationChange const changeInfo =
     {
-        barDuration_      / barDuration,      // barDurationChangeRatio_
-        measureNumerator_ != measureNumerator // measureNumeratorChanged_
+        timing_.barDuration      / newTiming.barDuration,     // barDurationChangeRatio_
+        timing_.measureNumerator != newTiming.measureNumerator, // measureNumeratorChanged_
+        newTiming.measureNumerator                              // measureNumerator_
     };
 
-    hasTempoInformation_ = false;
-
-    barDuration_         = barDuration;
-    measureNumerator_    = measureNumerator;
+    timing_          = newTiming;
+    referenceTiming_ = newTiming;
 
     return changeInfo;
 }
@@ -796,13 +866,13 @@ void LFOImpl::Timer::setPosition( float const timeInSeconds )
 {
 #ifndef LE_SW_SDK_BUILD
     // Assume 120 BPM 4/4
-    LE_ASSUME( hasTempoInformation_ == false           );
-    LE_ASSUME( barDuration_         == 4               );
-    LE_ASSUME( measureNumerator_    == 60.0f / 120 * 4 );
+    LE_ASSUME( timing_.hasTempoInformation == false           );
+    LE_ASSUME( timing_.barDuration         == 4               );
+    LE_ASSUME( timing_.measureNumerator    == 60.0f / 120 * 4 );
 #endif // LE_SW_SDK_BUILD
 
     // Position
-    float const timeInBars( timeInSeconds / barDuration_ );
+    float const timeInBars( timeInSeconds / timing_.barDuration );
 
     BOOST_ASSERT( ( currentTimeInBars_ > previousTimeInBars_ ) || ( currentTimeInBars_ == 0 ) );
     previousTimeInBars_ = currentTimeInBars_;
@@ -816,7 +886,7 @@ void LFOImpl::Timer::reset()
     previousTimeInBars_ = 0;
 
     // Assume 120 BPM 4/4
-    /// \note The hasTempoInformation_ flag is not reset here because this
+    /// \note The hasTempoInformation flag is not reset here because this
     /// causes bogus sporadic "Loaded preset uses tempo-synced LFOs but the host
     /// does not provide tempo information." popups in Live! when browsing
     /// through presets. This is most probably due to the threading logic in
@@ -825,9 +895,10 @@ void LFOImpl::Timer::reset()
     /// LFOImpl::Timer::reset()) and process() (which again fetches valid tempo
     /// information).
     ///                                       (28.05.2012.) (Domagoj Saric)
-    //hasTempoInformation_ = false;
-    barDuration_         = 60.0f / 120 * 4;
-    measureNumerator_    = 4;
+    //timing_.hasTempoInformation = false;
+    timing_.barDuration      = 60.0f / 120 * 4;
+    timing_.measureNumerator = 4;
+    referenceTiming_         = timing_;
 }
 
 
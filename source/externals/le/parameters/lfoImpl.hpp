@@ -175,19 +175,41 @@ public:
             bool barDurationChanged     () const;
             bool measureNumeratorChanged() const { return measureNumeratorChanged_; }
 
-            value_type const barDurationChangeRatio_ ;
-            bool       const measureNumeratorChanged_;
+            value_type   const barDurationChangeRatio_ ;
+            bool         const measureNumeratorChanged_;
+            std::uint8_t const measureNumerator_       ; ///< the new one
         }; // struct TimingInformationChange
     #ifdef _MSC_VER
         #pragma warning( pop )
     #endif // _MSC_VER
 
+        struct Timing
+        {
+            value_type   barDuration        ; ///< in seconds
+            std::uint8_t measureNumerator   ;
+            bool         hasTempoInformation;
+        }; // struct Timing
+
     public:
         Timer();
 
         value_type const & currentTimeInBars () const { return currentTimeInBars_ ; }
         value_type const & previousTimeInBars() const { return previousTimeInBars_; }
 
+        /// Position at the given fraction of the interval between the two
+        /// most recent position updates.
+        value_type timeInBars( value_type const fraction ) const { return previousTimeInBars_ + ( currentTimeInBars_ - previousTimeInBars_ ) * fraction; }
+
+        /// A copy of the timer spanning only the given interval (used to
+        /// evaluate LFOs for individual STFT hops within a process() call).
+        Timer between( value_type const fromTimeInBars, value_type const toTimeInBars ) const
+        {
+            Timer timer( *this );
+            timer.previousTimeInBars_ = fromTimeInBars;
+            timer.currentTimeInBars_  = toTimeInBars  ;
+            return timer;
+        }
+
         TimingInformationChange LE_FASTCALL updatePositionAndTimingInformation( float positionInBars, float barDuration, std::uint8_t measureNumerator );
         TimingInformationChange LE_FASTCALL updatePositionAndTimingInformation( unsigned int deltaNumberOfSamples, float sampleRate                    );
 
@@ -196,18 +218,31 @@ public:
 
         void reset();
 
-        static bool               hasTempoInformation  () { return hasTempoInformation_; }
-        static value_type const & basePeriod           () { return barDuration_        ; }
-        static std::uint8_t       measureNumerator     () { return measureNumerator_   ; }
+        /// Timing information of this timer (changes are detected against it
+        /// so that timers fed by different hosts/tempo contexts do not
+        /// interfere).
+        Timing     const & timing     () const { return timing_            ; }
+        value_type const & barDuration() const { return timing_.barDuration; }
+
+        /// Reference timing information: the one of the most recently updated
+        /// (or reset) timer, for code that has no access to the timer in use
+        /// (preset loading and saving, parameter bounds, the GUI...).
+        static Timing     const & referenceTiming      () { return referenceTiming_                    ; }
+        static bool               hasTempoInformation  () { return referenceTiming_.hasTempoInformation; }
+        static value_type const & basePeriod           () { return referenceTiming_.barDuration        ; }
+        static std::uint8_t       measureNumerator     () { return referenceTiming_.measureNumerator   ; }
         static value_type         measureNumeratorFloat();
 
+    private:
+        TimingInformationChange LE_FASTCALL updateTiming( Timing const & );
+
     private:
         value_type currentTimeInBars_ ;
         value_type previousTimeInBars_;
 
-        static value_type   barDuration_        ;
-        static std::uint8_t measureNumerator_   ;
-        static bool         hasTempoInformation_;
+        Timing timing_;
+
+        static Timing referenceTiming_;
     }; // class Timer
 #endif // LE_NO_LFOs
 public:
@@ -224,7 +259,54 @@ public:
 
     void updateForNewTimingInformation( Timer::TimingInformationChange const & );
 
+#ifndef LE_NO_LFOs
+    ////////////////////////////////////////////////////////////////////////////
+    /// \class Batch
+    /// \brief Evaluates a number of LFOs (e.g. all the enabled ones in a module
+    /// chain) at once.
+    ///
+    ///   The settings of the added LFOs are gathered into separate arrays so
+    /// that the period position, period boundary and bounds mapping parts of
+    /// getValue() are computed with simple (vectorisable) loops over all of
+    /// them. Only the waveform evaluation (a per LFO dispatch which also
+    /// updates the state of the random waveforms) is done one LFO at a time.
+    ////////////////////////////////////////////////////////////////////////////
+
+    class Batch
+    {
+    public:
+        static std::uint8_t BOOST_CONSTEXPR_OR_CONST capacity = 16;
+
+        Batch() : size_( 0 ) {}
+
+        std::uint8_t size () const { return size_;             }
+        bool         empty() const { return size_ == 0;        }
+        bool         full () const { return size_ == capacity; }
+
+        void LE_FASTCALL add  ( LFOImpl const & );
+        void             clear() { size_ = 0; }
+
+        /// Evaluates all the added LFOs (the results equal the ones of
+        /// getValue()) into values().
+        void LE_NOTHROWNOALIAS LE_FASTCALL evaluate( Timer const & );
+
+        value_type const * values() const { return values_; }
+
+    private:
+        value_type      periodScales_ [ capacity ];
+        value_type      periodOffsets_[ capacity ];
+        value_type      lowerBounds_  [ capacity ];
+        value_type      upperBounds_  [ capacity ];
+        value_type      positions_    [ capacity ];
+        value_type      values_       [ capacity ];
+        bool            newPeriods_   [ capacity ];
+        LFOImpl const * pLFOs_        [ capacity ];
+        std::uint8_t    size_;
+    }; // class Batch
+#endif // LE_NO_LFOs
+
     static value_type LE_NOTHROWNOALIAS currentPeriodScaleMinimum();
+    static value_type LE_NOTHROWNOALIAS currentPeriodScaleMinimum( std::uint8_t measureNumerator );
     static value_type LE_NOTHROWNOALIAS currentPeriodScaleMaximum();
 
     static SnappedPeriod snapPeriodScale( value_type periodScale, std::uint8_t syncTypes );
@@ -254,8 +336,8 @@ public:
     static Plugins::AutomatedParameterValue   linearisePeriodScale( Plugins::AutomatedParameterValue nonlinearNormalisedPeriodScale  );
 
 private: friend class LFO;
-    static value_type    clampFreePeriod ( value_type absolutePeriod                      );
-    static SnappedPeriod snapSyncedPeriod( value_type periodScale, std::uint8_t syncTypes );
+    static value_type    clampFreePeriod ( value_type absolutePeriod                        , std::uint8_t measureNumerator );
+    static SnappedPeriod snapSyncedPeriod( value_type periodScale  , std::uint8_t syncTypes, std::uint8_t measureNumerator );
 
     value_type LE_NOTHROWNOALIAS getWaveformAmplitudeForPosition( value_type position, bool newPeriodBegun ) const;
 
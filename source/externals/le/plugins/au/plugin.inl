@@ -19,8 +19,10 @@
 #include "boost/assert.hpp"
 #include "boost/range/iterator_range_core.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 //------------------------------------------------------------------------------
 #if MAC_OS_X_VERSION_MAX_ALLOWED <= MAC_OS_X_VERSION_10_6
 typedef OSStatus (*AudioComponentMethod) (void *self,...);
@@ -358,46 +360,46 @@ public: // Callbacks
         LE_ASSUME( element == 0                      );
         BOOST_ASSERT( std::isfinite( value ) );
 
-        /// \todo Implement this properly.
-        ///                                   (12.11.2015.) (Domagoj Saric)
-        LE_TRACE_IF( bufferOffset != 0, "\tSW AU: host tried to make a scheduled set of parameter " LE_OSX_INT_FORMAT( u ) " (offset " LE_OSX_INT_FORMAT( u ) ").", parameterID, bufferOffset );
-
-        instance.impl().setParameter( ParameterID{ parameterID }, value );
+        instance.impl().setParameter( ParameterID{ parameterID }, value, bufferOffset );
 	    return noErr;
     }
 
     static OSStatus LE_NOTHROW AUMethodScheduleParameters( This & instance, ::AudioUnitParameterEvent const * LE_RESTRICT const pEvents, ::UInt32 const numberOfEvents )
     {
-        /// \todo Implement this properly.
-        ///                                   (12.11.2015.) (Domagoj Saric)
         for ( auto const & __restrict event : boost::make_iterator_range_n( pEvents, numberOfEvents ) )
         {
-            ::AudioUnitParameterValue const * __restrict pValue;
-            ::SInt32                                     offset;
+            //...mrmlj...SW HARDCODE...
+            LE_ASSUME( event.scope   == kAudioUnitScope_Global );
+            LE_ASSUME( event.element == 0                      );
             if ( event.eventType == kParameterEvent_Immediate )
             {
-                pValue = &event.eventValues.immediate.value;
-                offset =  event.eventValues.immediate.bufferOffset;
+                BOOST_VERIFY
+                (
+                    AUMethodSetParameter
+                    (
+                        instance,
+                        event.parameter,
+                        event.scope,
+                        event.element,
+                        event.eventValues.immediate.value,
+                        event.eventValues.immediate.bufferOffset
+                    ) == noErr
+                );
             }
             else
             {
                 BOOST_ASSERT( event.eventType == kParameterEvent_Ramped );
-                LE_TRACE( "\tSW AU: host tried to make a ramped set of parameter " LE_OSX_INT_FORMAT( u ) ".", event.parameter );
-                pValue = &event.eventValues.ramp.endValue;
-                offset =  event.eventValues.ramp.startBufferOffset + event.eventValues.ramp.durationInFrames;
-            }
-            BOOST_VERIFY
-            (
-                AUMethodSetParameter
+                auto const & ramp( event.eventValues.ramp );
+                BOOST_ASSERT( std::isfinite( ramp.startValue ) && std::isfinite( ramp.endValue ) );
+                instance.impl().setParameter
                 (
-                    instance,
-                    event.parameter,
-                    event.scope,
-                    event.element,
-                    *pValue,
-                    offset
-                ) == noErr
-            );
+                    ParameterID{ event.parameter },
+                    ramp.startValue,
+                    ramp.endValue,
+                    static_cast<std::uint32_t>( std::max<::SInt32>( ramp.startBufferOffset, 0 ) ),
+                    ramp.durationInFrames
+                );
+            }
         }
 
 	    return noErr;
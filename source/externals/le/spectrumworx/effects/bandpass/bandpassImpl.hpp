@@ -13,6 +13,7 @@
 //------------------------------------------------------------------------------
 #include "bandpass.hpp"
 
+#include "le/math/dft/domainConversion.hpp"
 #include "le/spectrumworx/effects/effects.hpp"
 #include "le/spectrumworx/engine/buffers.hpp"
 //------------------------------------------------------------------------------
@@ -44,6 +45,8 @@ namespace Detail ///< \internal
 
         void setup( IndexRange const &, Engine::Setup const & );
 
+        static Math::ConversionAccuracy BOOST_CONSTEXPR_OR_CONST conversionAccuracy = Math::CoarseConversion; // amplitudes only
+
     protected:
         float attenuation_;
         #ifdef LE_BAND_FILTER_USE_ENGINE_WINDOW
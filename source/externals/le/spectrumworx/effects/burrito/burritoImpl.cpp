@@ -10,6 +10,7 @@
 #include "burritoImpl.hpp"
 
 #include "le/spectrumworx/effects/indexRange.hpp"
+#include "le/spectrumworx/engine/binKernels.hpp"
 #include "le/spectrumworx/engine/channelDataAmPh.hpp"
 #include "le/spectrumworx/engine/setup.hpp"
 #include "le/math/conversion.hpp"
@@ -100,30 +101,27 @@ void BurritoImpl::process( ChannelState & channelState, Engine::MainSideChannelD
         }
     }
 
-    Mode::value_type const mode    ( parameters().get<Mode>() );
-    float            const sideGain( sideGain_                );
-    bool const * LE_RESTRICT pPosition( channelState.positions.begin() );
-    while ( data )
+    float                    const sideGain  ( sideGain_                      );
+    bool const * LE_RESTRICT const pPositions( channelState.positions.begin() );
+
+    using namespace Engine::BinKernels;
+    dispatch<2>( parameters().get<Mode>(), [ &data, sideGain, pPositions ]( auto const mode )
     {
-        // Replace:
-        if ( *pPosition++ )
+        forEach( data, [ sideGain, pPositions ]( auto & bin, std::uint16_t const k )
         {
-            float       & mainAmp( data.main().amps().front() );
-            float const   sideAmp( data.side().amps().front() );
+            using boost::simd::if_else;
 
-            float newMainAmp( sideAmp * sideGain );
+            // Replace:
+            auto const replace( flags( pPositions, k, bin ) );
 
-            switch ( mode )
-            {
-                case Mode::Replace: data.main().phases().front() = data.side().phases().front(); break;
-                case Mode::Sum    : newMainAmp += mainAmp;                                       break;
-                LE_DEFAULT_CASE_UNREACHABLE();
-            }
+            auto const sideAmp     ( bin.sideAmp * bin.splat( sideGain ) );
+            auto const newMainAmp  ( ( mode == Mode::Sum     ) ? ( sideAmp + bin.mainAmp ) : sideAmp       );
+            auto const newMainPhase( ( mode == Mode::Replace ) ? bin.sidePhase             : bin.mainPhase );
 
-            mainAmp = newMainAmp;
-        }
-        ++data;
-    }
+            bin.mainAmp   = if_else( replace, newMainAmp  , bin.mainAmp   );
+            bin.mainPhase = if_else( replace, newMainPhase, bin.mainPhase );
+        });
+    });
 }
 
 //------------------------------------------------------------------------------
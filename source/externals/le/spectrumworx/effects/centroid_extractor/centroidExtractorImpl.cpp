@@ -16,6 +16,7 @@
 #include "le/math/vector.hpp"
 #include "le/parameters/uiElements.hpp"
 #include "le/spectrumworx/engine/channelDataAmPh.hpp"
+#include "le/spectrumworx/engine/processor.hpp"
 #include "le/spectrumworx/engine/setup.hpp"
 
 #include <utility>
@@ -93,7 +94,7 @@ void CentroidExtractorImpl::process( ChannelState & cs, Engine::ChannelData_AmPh
     IndexRange::value_type desiredCentralBin;
     switch ( parameters().get<Mode>().getValue() )
     {
-        case Mode::Centroid: desiredCentralBin = centroid( data.full().amps()            ); break;
+        case Mode::Centroid: desiredCentralBin = centroid( data.full().amps(), setup     ); break;
         case Mode::Peak    : desiredCentralBin = maxPeak ( data.full().amps(), setup     ); break;
         case Mode::Dominant: desiredCentralBin = dominant( data.full().amps(), setup, cs ); break;
 
@@ -153,21 +154,9 @@ void CentroidExtractorImpl::process( ChannelState & cs, Engine::ChannelData_AmPh
 //
 ////////////////////////////////////////////////////////////////////////////////
 
-IndexRange::value_type CentroidExtractorImpl::centroid( ReadOnlyDataRange amplitudes ) const
+IndexRange::value_type CentroidExtractorImpl::centroid( ReadOnlyDataRange const & amplitudes, Engine::Setup const & engineSetup ) const
 {
-    float binmag( 0 );
-    float mag   ( std::numeric_limits<float>::epsilon() );
-
-    float binCounter( 0 );
-    while ( amplitudes )
-    {
-        float const amp( amplitudes.front() );
-        binmag += binCounter++ * amp;
-        mag    +=                amp;
-        amplitudes.advance_begin( 1 );
-    }
-
-    float const centroid( binmag / mag );
+    float const centroid( Engine::Processor::fromEngineSetup( engineSetup ).features().centroid( amplitudes ) );
     return Math::convert<IndexRange::value_type>( centroid );
 }
 
@@ -182,7 +171,7 @@ IndexRange::value_type CentroidExtractorImpl::centroid( ReadOnlyDataRange amplit
 IndexRange::value_type CentroidExtractorImpl::dominant( ReadOnlyDataRange const & amplitudes, Engine::Setup const & engineSetup, ChannelState & cs ) const
 {
     using namespace Math;
-    float const c  ( PitchDetector::findPitch( amplitudes, cs, 50, 50*2*2*2*2*2, engineSetup ) );
+    float const c  ( Engine::Processor::fromEngineSetup( engineSetup ).features().pitch( amplitudes, cs, 50, 50*2*2*2*2*2, engineSetup ) );
     float const bin( c * convert<float>( amplitudes.size() ) / engineSetup.sampleRate<float>() );
     return convert<IndexRange::value_type>( bin );
 }
@@ -36,7 +36,7 @@ public: // LE::Effect required interface.
     void process( ChannelState &, Engine::ChannelData_AmPh, Engine::Setup const & ) const;
 
 private: 
-    IndexRange::value_type centroid( ReadOnlyDataRange         amplitudes                                        ) const;
+    IndexRange::value_type centroid( ReadOnlyDataRange const & amplitudes, Engine::Setup const &                 ) const;
     IndexRange::value_type dominant( ReadOnlyDataRange const & amplitudes, Engine::Setup const &, ChannelState & ) const;
     IndexRange::value_type maxPeak ( ReadOnlyDataRange const & amplitudes, Engine::Setup const &                 ) const;
 
@@ -9,6 +9,7 @@
 //------------------------------------------------------------------------------
 #include "denoiserImpl.hpp"
 
+#include "le/spectrumworx/engine/binKernels.hpp"
 #include "le/spectrumworx/engine/channelDataAmPh.hpp"
 #include "le/spectrumworx/engine/setup.hpp"
 #include "le/math/conversion.hpp"
@@ -90,36 +91,36 @@ void DenoiserImpl::process( Engine::MainSideChannelData_AmPh data, Engine::Setup
     /// Stronger components survive, weaker are further attenuated.
     ///                                       (11.09.2013.) (Domagoj Saric)
 
-    Mode::value_type const mode  ( parameters().get<Mode>() );
-    float            const factor( factor_                  );
+    float const factor( factor_ );
 
-    while ( data )
+    using namespace Engine::BinKernels;
+    dispatch<3>( parameters().get<Mode>(), [ &data, factor ]( auto const mode )
     {
-        float       & mainAmp( data.main().amps().front() );
-        float const   sideAmp( data.side().amps().front() );
-        ++data;
-
-        /// \note Mode::Side requires special handling because the basic DAFX
-        /// formula is not suited for side-chain based denoising, with low side
-        /// chain levels it can produce high amplification/correction factors
-        /// resulting in clipping or auto-muting. For this reason we limit it so
-        /// that the input signal is never amplified (maximum correction factor
-        /// is 1).
-        ///                                   (11.09.2013.) (Domagoj Saric)
-        float c;
-        switch ( mode )
+        forEach( data, [ factor ]( auto & bin, std::uint16_t )
         {
-            case Mode::Main: c =   mainAmp                   ;                                      break;
-            case Mode::Side: c =             sideAmp         ; c = std::max( c, mainAmp - factor ); break;
-            case Mode::Sum : c = ( mainAmp + sideAmp ) / 2.0f;                                      break;
-            LE_DEFAULT_CASE_UNREACHABLE();
-        }
-
-        float const correctionFactor( mainAmp / ( c + factor ) );
-        LE_ASSUME( correctionFactor >= 0 );
-        LE_ASSUME( correctionFactor <= 1 );
-        mainAmp *= correctionFactor;
-    }
+            auto const mainAmp( bin.mainAmp          );
+            auto const sideAmp( bin.sideAmp          );
+            auto const c0     ( bin.splat( factor ) );
+            auto const half   ( bin.splat( 0.5f   ) );
+
+            /// \note Mode::Side requires special handling because the basic DAFX
+            /// formula is not suited for side-chain based denoising, with low side
+            /// chain levels it can produce high amplification/correction factors
+            /// resulting in clipping or auto-muting. For this reason we limit it so
+            /// that the input signal is never amplified (maximum correction factor
+            /// is 1).
+            ///                                   (11.09.2013.) (Domagoj Saric)
+            auto const c
+            (
+                ( mode == Mode::Main ) ? mainAmp                                   :
+                ( mode == Mode::Side ) ? boost::simd::max( sideAmp, mainAmp - c0 ) :
+                                         ( mainAmp + sideAmp ) * half
+            );
+
+            auto const correctionFactor( mainAmp / ( c + c0 ) );
+            bin.mainAmp = mainAmp * correctionFactor;
+        });
+    });
 }
 
 //------------------------------------------------------------------------------
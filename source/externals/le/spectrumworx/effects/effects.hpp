@@ -107,7 +107,18 @@ namespace Effects
 //    setup() call
 //  - each effect implementation class is free to choose to work with any of the
 //    various ChannelData classes (it makes the choice by simply declaring its
-//    process() function to use the desired type).
+//    process() function to use the desired type)
+//  - (optional - if the effect uses only the amplitudes of the AmPh data)
+//    may define a Math::ConversionAccuracy 'conversionAccuracy' static
+//    constant allowing the engine to use a cheaper (less accurate) phase
+//    conversion for hops in which all the active modules tolerate it (the
+//    default is Math::FullConversion).
+//  - (optional - if the effect needs per-hop temporary buffers) may define a
+//    'static std::uint32_t scratchStorage( Engine::StorageFactors const & )'
+//    member function returning the number of bytes its process() function
+//    allocates (through ScratchArena::Scope) from the Processor's
+//    Engine::ScratchArena, which should be used instead of stack buffers (the
+//    default is zero). The result must not depend on the sampling rate.
 //
 //  The Base-Impl separation is required to facilitate easier extraction of
 // effects into the SW SDK without duplication and without disclosing
@@ -9,6 +9,7 @@
 //------------------------------------------------------------------------------
 #include "etherealImpl.hpp"
 
+#include "le/spectrumworx/engine/binKernels.hpp"
 #include "le/spectrumworx/engine/channelDataAmPh.hpp"
 #include "le/math/conversion.hpp"
 #include "le/parameters/uiElements.hpp"
@@ -78,23 +79,31 @@ void EtherealImpl::process( Engine::MainSideChannelData_AmPh data, Engine::Setup
 
     float const threshold( threshold_ );
 
-    Engine::MainSideChannelData_AmPh const & constData( data );
-    ReadOnlyDataRange const & ampSource  ( mode_.magnitudes() ? constData.side().amps  () : constData.main().amps  () );
-    ReadOnlyDataRange const & phaseSource( mode_.phases    () ? constData.side().phases() : constData.main().phases() );
+    // Implementation note:
+    //   The options are loop invariant and only select between already loaded
+    // values so (unlike modes that change the computation) they need not be
+    // made compile time constants for the kernel to vectorise.
+    bool const sideMagnitudes( mode_.magnitudes() );
+    bool const sidePhases    ( mode_.phases    () );
 
-    while ( data )
+    Engine::BinKernels::forEach( data, [ = ]( auto & bin, std::uint16_t )
     {
-        bool const sideIsWeaker ( data.side().amps().front() < ( data.main().amps().front() * threshold ) );
-        bool const shouldReplace( sideIsWeaker == replaceWhenWeaker                                       );
-
-        if ( shouldReplace )
-        {
-            data.main().amps  ().front() = ampSource  .front();
-            data.main().phases().front() = phaseSource.front();
-        }
-
-        ++data;
-    }
+        using boost::simd::if_else;
+
+        auto const weakerLimit  ( bin.mainAmp * bin.splat( threshold ) );
+        auto const shouldReplace
+        (
+            replaceWhenWeaker
+                ? boost::simd::is_less         ( bin.sideAmp, weakerLimit )
+                : boost::simd::is_greater_equal( bin.sideAmp, weakerLimit )
+        );
+
+        auto const ampSource  ( sideMagnitudes ? bin.sideAmp   : bin.mainAmp   );
+        auto const phaseSource( sidePhases     ? bin.sidePhase : bin.mainPhase );
+
+        bin.mainAmp   = if_else( shouldReplace, ampSource  , bin.mainAmp   );
+        bin.mainPhase = if_else( shouldReplace, phaseSource, bin.mainPhase );
+    });
 }
 
 //------------------------------------------------------------------------------
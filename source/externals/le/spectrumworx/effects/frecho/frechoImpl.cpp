@@ -12,14 +12,13 @@
 #include "le/spectrumworx/effects/indexRange.hpp"
 #include "le/spectrumworx/engine/channelDataAmPh.hpp"
 #include "le/spectrumworx/engine/channelDataReIm.hpp"
+#include "le/spectrumworx/engine/processor.hpp"
 #include "le/spectrumworx/engine/setup.hpp"
 #include "le/math/conversion.hpp"
 #include "le/math/dft/domainConversion.hpp"
 #include "le/math/math.hpp"
 #include "le/math/vector.hpp"
 #include "le/parameters/uiElements.hpp"
-
-#include "boost/simd/preprocessor/stack_buffer.hpp"
 //------------------------------------------------------------------------------
 /// \todo Investigate frequency-domain echo cancelation.
 /// http://jmvalin.ca/papers/valin_hscma2008.pdf
@@ -80,6 +79,20 @@ void FrechoImpl::setup( IndexRange const &, Engine::Setup const & engineSetup )
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+//
+// FrechoImpl::scratchStorage()
+// ----------------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+
+LE_COLD
+std::uint32_t FrechoImpl::scratchStorage( Engine::StorageFactors const & factors )
+{
+    return Engine::ScratchArena::requiredStorage<char>( Engine::ChannelData_AmPhStorage::requiredStorage( factors.fftSize ) );
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 //
 // FrechoImpl::process()
@@ -143,7 +156,8 @@ void FrechoImpl::doProcess
     if ( !ps_.skipProcessing() )
     {
         unsigned int const fftSize( engineSetup.fftSize<unsigned int>() );
-        BOOST_SIMD_ALIGNED_SCOPED_STACK_BUFFER( pitchShiftedEchoStorage, char, Engine::ChannelData_AmPhStorage::requiredStorage( fftSize ) );
+        Engine::ScratchArena::Scope scratch( Engine::Processor::fromEngineSetup( engineSetup ).scratch() );
+        Engine::Storage const pitchShiftedEchoStorage( scratch.allocate<char>( Engine::ChannelData_AmPhStorage::requiredStorage( fftSize ) ) );
         Engine::ChannelData_AmPhStorage pitchShiftedEcho( fftSize, target.beginBin(), target.endBin(), pitchShiftedEchoStorage );
 
         Math::reim2AmPh
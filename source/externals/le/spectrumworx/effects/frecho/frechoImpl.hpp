@@ -63,6 +63,8 @@ public: // LE::Effect interface.
     void setup( IndexRange const &, Engine::Setup const & );
     void process( ChannelState &, Engine::ChannelData_ReIm, Engine::Setup const & ) const;
 
+    static std::uint32_t scratchStorage( Engine::StorageFactors const & );
+
 protected:
     void doProcess( ChannelState &, Engine::ChannelData_ReIm &, Engine::Setup const & ) const;
 
@@ -108,6 +110,7 @@ public: // LE::Effect interface.
 
     void process( ChannelState &, Engine::ChannelData_ReIm, Engine::Setup const & ) const;
     using FrechoImpl::setup;
+    using FrechoImpl::scratchStorage;
 
     using Frevcho::description;
     using Frevcho::title;
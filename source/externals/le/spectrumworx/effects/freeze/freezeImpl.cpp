@@ -93,8 +93,7 @@ void FreezeImpl::process( ChannelState & cs, Engine::ChannelData_AmPh data, Engi
     DataRange const & currentMag ( data.amps  () );
     DataRange const & currentFreq( data.phases() );
 
-    auto const fullNumberOfBins( data.full().numberOfBins() );
-    auto const beginBin        ( data.beginBin()            );
+    auto const beginBin( data.beginBin() );
 
     //------------------------------------------------------------------------//
 
@@ -117,10 +116,10 @@ void FreezeImpl::process( ChannelState & cs, Engine::ChannelData_AmPh data, Engi
         cs.frameCounter = 0;
 
         // Freeze current frame, and save the previous frozen frame, so we can
-        // make a transition between two frozen frames:
-
-        copy( cs.frozenMagNew .begin(), cs.frozenMagOld .begin(), fullNumberOfBins );
-        copy( cs.frozenFreqNew.begin(), cs.frozenFreqOld.begin(), fullNumberOfBins );
+        // make a transition between two frozen frames (the old frozen frame is
+        // discarded so the buffers are simply swapped instead of copied):
+        cs.frozenMagOld .swap( cs.frozenMagNew  );
+        cs.frozenFreqOld.swap( cs.frozenFreqNew );
 
         copy( currentFullMag , cs.frozenMagNew  );
         copy( currentFullFreq, cs.frozenFreqNew );
@@ -11,6 +11,7 @@
 
 #include "le/math/conversion.hpp"
 #include "le/math/math.hpp"
+#include "le/math/vector.hpp"
 #include "le/parameters/uiElements.hpp"
 #include "le/spectrumworx/engine/channelDataAmPh.hpp"
 #include "le/spectrumworx/engine/setup.hpp"
@@ -70,14 +71,7 @@ void FreqnamicsImpl::setup( IndexRange const &, Engine::Setup const & engineSetu
 
 void FreqnamicsImpl::process( Engine::ChannelData_AmPh data, Engine::Setup const & ) const
 {
-    float const limit( thrLimiter_   );
-    float const gate ( thrNoisegate_ );
-    for ( auto & amp : data.amps() )
-    {
-        amp = ( amp < gate )
-            ? 0
-            : std::min( amp, limit );
-    }
+    Math::gateAndLimit( data.amps(), thrNoisegate_, thrLimiter_ );
 }
 
 //------------------------------------------------------------------------------
@@ -19,11 +19,10 @@
 #include "le/parameters/uiElements.hpp"
 #include "le/spectrumworx/engine/channelDataAmPh.hpp"
 #include "le/spectrumworx/engine/channelDataReIm.hpp"
+#include "le/spectrumworx/engine/processor.hpp"
 #include "le/spectrumworx/engine/setup.hpp"
 #include "le/utility/platformSpecifics.hpp"
 
-#include "boost/simd/preprocessor/stack_buffer.hpp"
-
 #include "boost/assert.hpp"
 
 #include <cstdint>
@@ -82,6 +81,20 @@ void FreqverbImpl::setup( IndexRange const &, Engine::Setup const & engineSetup
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+//
+// FreqverbImpl::scratchStorage()
+// ------------------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+
+LE_COLD
+std::uint32_t FreqverbImpl::scratchStorage( Engine::StorageFactors const & factors )
+{
+    return Engine::ScratchArena::requiredStorage<char>( Engine::ChannelData_AmPhStorage::requiredStorage( factors.fftSize ) );
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 //
 // FreqverbImpl::process()
@@ -174,7 +187,8 @@ void FreqverbImpl::process
     }
 
     {
-        BOOST_SIMD_ALIGNED_SCOPED_STACK_BUFFER( data2Storage, char, Engine::ChannelData_AmPhStorage::requiredStorage( engineSetup.fftSize<std::uint16_t>() ) );
+        Engine::ScratchArena::Scope scratch( Engine::Processor::fromEngineSetup( engineSetup ).scratch() );
+        Engine::Storage const data2Storage( scratch.allocate<char>( Engine::ChannelData_AmPhStorage::requiredStorage( engineSetup.fftSize<std::uint16_t>() ) ) );
         Engine::ChannelData_AmPhStorage data2( engineSetup.fftSize<std::uint16_t>(), 0, noEchoBin_, data2Storage );
         BOOST_ASSERT( data2.numberOfBins() == noEchoBin_ );
 
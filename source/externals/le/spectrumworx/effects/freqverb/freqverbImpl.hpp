@@ -49,6 +49,8 @@ public: // LE::Effect required interface.
     void setup  ( IndexRange const &, Engine::Setup const & );
     void process( ChannelState &, Engine::ChannelData_ReIm, Engine::Setup const & ) const;
 
+    static std::uint32_t scratchStorage( Engine::StorageFactors const & );
+
 private:
     float         roomLevel_;
     std::uint16_t noEchoBin_;
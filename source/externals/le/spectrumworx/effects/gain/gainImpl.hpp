@@ -13,6 +13,7 @@
 //------------------------------------------------------------------------------
 #include "gain.hpp"
 
+#include "le/math/dft/domainConversion.hpp"
 #include "le/spectrumworx/effects/effects.hpp"
 //------------------------------------------------------------------------------
 namespace LE
@@ -34,6 +35,8 @@ public: // LE::Effect interface.
 
     static void setup  ( IndexRange      const &, Engine::Setup const & ) {}
     static void process( Engine::ChannelData_AmPh const &, Engine::Setup const & ) {}
+
+    static Math::ConversionAccuracy BOOST_CONSTEXPR_OR_CONST conversionAccuracy = Math::CoarseConversion; // amplitudes only
 };
 
 //------------------------------------------------------------------------------
@@ -25,6 +25,29 @@ ReversedHistoryBufferState::HistoryData ReversedHistoryBufferState::getCurrentSt
     std::uint16_t const numberOfBins,
     DataRange     const historyData
 )
+{
+    Steps const steps( getCurrentSteps( historyLengthInSteps ) );
+
+    unsigned int const numberOfBinsAligned( Math::alignIndex( numberOfBins ) );
+    unsigned int const fullFrameSize      ( numberOfBinsAligned * 2     );
+
+    float * const pTargetAmplitudesOrReals( &historyData[ steps.target * fullFrameSize ] );
+    float * const pTargetPhasesOrImags    ( pTargetAmplitudesOrReals + numberOfBinsAligned );
+
+    float * const pSourceAmplitudesOrReals( &historyData[ steps.source * fullFrameSize ] );
+    float * const pSourcePhasesOrImags    ( pSourceAmplitudesOrReals + numberOfBinsAligned );
+
+    HistoryData const result =
+    {
+        { pTargetAmplitudesOrReals, pTargetPhasesOrImags },
+        { pSourceAmplitudesOrReals, pSourcePhasesOrImags }
+    };
+
+    return result;
+}
+
+
+ReversedHistoryBufferState::Steps ReversedHistoryBufferState::getCurrentSteps( std::uint16_t const historyLengthInSteps )
 {
     // Implementation note:
     //   The step counter has to be incremented at the beginning/before actual
@@ -96,14 +119,7 @@ ReversedHistoryBufferState::HistoryData ReversedHistoryBufferState::getCurrentSt
 
     BOOST_ASSERT_MSG( step_ < historyLengthInSteps, "Step overflow." );
 
-    unsigned int const numberOfBinsAligned( Math::alignIndex( numberOfBins ) );
-    unsigned int const fullFrameSize      ( numberOfBinsAligned * 2     );
-
-    float * const pTargetAmplitudesOrReals( &historyData[ step_ * fullFrameSize ]          );
-    float * const pTargetPhasesOrImags    ( pTargetAmplitudesOrReals + numberOfBinsAligned );
-
-    float *       pSourceAmplitudesOrReals( pTargetAmplitudesOrReals                       );
-    float *       pSourcePhasesOrImags    ( pTargetPhasesOrImags                           );
+    Steps steps = { step_, step_ };
 
     // Implementation note:
     //   If the current (desired) reversing length is longer than the history we
@@ -117,8 +133,7 @@ ReversedHistoryBufferState::HistoryData ReversedHistoryBufferState::getCurrentSt
     {
         if ( step_ >= actualHistoryLengthInSteps_ )
         {
-            pSourceAmplitudesOrReals = &historyData[ ( step_ - emulatedHistoryStepOffset_ ) * fullFrameSize ];
-            pSourcePhasesOrImags     = pSourceAmplitudesOrReals + numberOfBinsAligned;
+            steps.source = step_ - emulatedHistoryStepOffset_;
 
             // Implementation note:
             //   We have to move the emulated history 'pointer' one point back
@@ -145,13 +160,7 @@ ReversedHistoryBufferState::HistoryData ReversedHistoryBufferState::getCurrentSt
         emulatedHistoryStepOffset_  = 0                   ;
     }
 
-    HistoryData const result =
-    {
-        { pTargetAmplitudesOrReals, pTargetPhasesOrImags },
-        { pSourceAmplitudesOrReals, pSourcePhasesOrImags }        
-    };
-
-    return result;
+    return steps;
 }
 
 
@@ -12,6 +12,7 @@
 #pragma once
 //------------------------------------------------------------------------------
 #include "le/spectrumworx/engine/buffers.hpp"
+#include "le/spectrumworx/engine/channelDataAmPh.hpp"
 #include "le/spectrumworx/engine/configuration.hpp"
 #include "le/utility/buffers.hpp"
 #include "le/utility/platformSpecifics.hpp"
@@ -19,6 +20,7 @@
 #include "boost/range/iterator_range_core.hpp"
 
 #include <cstdint>
+#include <utility>
 //------------------------------------------------------------------------------
 namespace LE
 {
@@ -44,7 +46,7 @@ template <typename T, std::uint16_t milliSeconds>
 struct HistoryBuffer : public Utility::SharedStorageBuffer<T>
 {
     LE_NOTHROWNOALIAS LE_NOINLINE
-    static std::uint32_t requiredStorage( Engine::StorageFactors const & factors )
+    static std::uint32_t numberOfFrames( Engine::StorageFactors const & factors )
     {
         // Implementation note:
         // N - number of required audio samples per second per channel
@@ -67,6 +69,15 @@ struct HistoryBuffer : public Utility::SharedStorageBuffer<T>
 
         BOOST_ASSERT( samplesRounded % frameSize == 0 );
 
+        return samplesRounded / frameSize;
+    }
+
+    LE_NOTHROWNOALIAS LE_NOINLINE
+    static std::uint32_t requiredStorage( Engine::StorageFactors const & factors )
+    {
+        auto const numberOfFrames( HistoryBuffer::numberOfFrames( factors ) );
+        auto const samplesRounded( numberOfFrames * factors.fftSize         );
+
         /// \note For each DFT frame we get "2 * ( DFT-size / 2 + 1 ) samples =
         /// DFT-size + 2 samples" (in ReIm or AmPh form). IOW for each frame we
         /// need storage for two additional samples in the frequency domain (for
@@ -76,7 +87,6 @@ struct HistoryBuffer : public Utility::SharedStorageBuffer<T>
         ///                                   (16.07.2012.) (Domagoj Saric)
         auto const dftRepresentationOverhead( 2                                                                            );
         auto const maximumAlignmentPadding  ( Utility::Constants::vectorAlignment / sizeof( T ) - 1                        );
-        auto const numberOfFrames           ( samplesRounded / frameSize                                                   );
         auto const overhead                 ( numberOfFrames * ( dftRepresentationOverhead + 2 * maximumAlignmentPadding ) );
 
         auto const storageBytes( ( samplesRounded + overhead ) * sizeof( T ) );
@@ -179,6 +189,24 @@ public:
     #pragma warning( pop )
 #endif // _MSC_VER
 
+    ////////////////////////////////////////////////////////////////////////////
+    ///
+    /// \struct Steps
+    ///
+    ///   The HistoryData equivalent for history buffers that are not laid out
+    /// as a single contiguous range of frames: the indices of the target and
+    /// source history steps/frames.
+    ///
+    ////////////////////////////////////////////////////////////////////////////
+
+    struct Steps
+    {
+        std::uint16_t target;
+        std::uint16_t source;
+
+        bool isEmulated() const { return target != source; }
+    }; // struct Steps
+
 public:
     HistoryData LE_FASTCALL getCurrentStepData
     (
@@ -187,6 +215,8 @@ public:
         DataRange     historyData
     );
 
+    Steps LE_FASTCALL getCurrentSteps( std::uint16_t historyLengthInSteps );
+
     void reset();
 
 private:
@@ -238,6 +268,117 @@ private:
     ReversedHistoryBufferState bufferState_;
 }; // class ReversedHistoryChannelState
 
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class ReversedFrameHistoryChannelState
+///
+/// \brief A ReversedHistoryChannelState equivalent that stores full AmPh
+/// frames (laid out like the engine's own FullChannelData_AmPh) in separate,
+/// individually addressable slots.
+///
+///   The slots are accessed through a table of frame pointers with one spare
+/// frame in addition to the frames of the history proper. Every step the
+/// target frame is exchanged with the spare one (in O(1)) so that the consumed
+/// history frame (i.e. the output for the current step) stays untouched by
+/// the new input for the rest of the step and can be lent to the engine
+/// (Engine::Processor::lendFrame()) instead of being copied out.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+template <unsigned int historyLengthInMilliseconds>
+class ReversedFrameHistoryChannelState
+{
+public:
+    struct Frame
+    {
+        float * pAmplitudes;
+        float * pPhases    ;
+    }; // struct Frame
+
+    struct HistoryFrames
+    {
+        Frame target; // where the new input is to be stored
+        Frame source; // the history for the current step
+
+        bool emulated;
+
+        /// The source frame belongs to the history proper (and must not be
+        /// lent) only when history is emulated, otherwise it is the spare
+        /// frame, free until the next step.
+        bool isEmulated() const { return emulated; }
+    }; // struct HistoryFrames
+
+public:
+    HistoryFrames LE_FASTCALL getCurrentStepFrames( std::uint16_t const historyLengthInSteps )
+    {
+        ReversedHistoryBufferState::Steps const steps( bufferState_.getCurrentSteps( historyLengthInSteps ) );
+        BOOST_ASSERT_MSG( steps.target < spareSlot(), "Step overflow." );
+
+        float * & pSpare ( frameTable_[ spareSlot()   ] );
+        float * & pTarget( frameTable_[ steps.target  ] );
+        std::swap( pTarget, pSpare );
+
+        HistoryFrames const result =
+        {
+            frame( pTarget ),
+            frame( steps.isEmulated() ? frameTable_[ steps.source ] : pSpare ),
+            steps.isEmulated()
+        };
+        return result;
+    }
+
+    void reset()
+    {
+        bufferState_.reset();
+        frames_     .clear();
+        for ( std::uint16_t slot( 0 ); slot < frameTable_.size(); ++slot )
+            frameTable_[ slot ] = &frames_[ slot * frameSize_ ];
+    }
+
+    static std::uint32_t requiredStorage( Engine::StorageFactors const & factors )
+    {
+        return numberOfSlots( factors ) * ( frameStorage( factors ) + sizeof( float * ) );
+    }
+
+    void resize( Engine::StorageFactors const & factors, Engine::Storage & storage )
+    {
+        auto const slots( numberOfSlots( factors ) );
+        frames_    .resize( slots * frameStorage( factors ), storage );
+        frameTable_.resize( slots * sizeof( float * )     , storage );
+        frameSize_    = frameStorage( factors ) / sizeof( float );
+        phasesOffset_ = Engine::FullChannelData_AmPh::phasesOffset( factors );
+    }
+
+private:
+    static std::uint32_t numberOfSlots( Engine::StorageFactors const & factors )
+    {
+        return HistoryBuffer<float, historyLengthInMilliseconds>::numberOfFrames( factors ) + 1;
+    }
+
+    static std::uint32_t frameStorage( Engine::StorageFactors const & factors )
+    {
+        return Utility::align( Engine::FullChannelData_AmPh::requiredStorage( factors ) );
+    }
+
+    std::uint32_t spareSlot() const { return frameTable_.size() - 1; }
+
+    Frame frame( float * const pFrame ) const
+    {
+        Frame const result = { pFrame, pFrame + phasesOffset_ };
+        return result;
+    }
+
+private:
+    Utility::SharedStorageBuffer<float  > frames_    ;
+    Utility::SharedStorageBuffer<float *> frameTable_; // the last slot is the spare one
+
+    std::uint32_t frameSize_   ; // in floats
+    std::uint32_t phasesOffset_; // in floats
+
+    ReversedHistoryBufferState bufferState_;
+}; // class ReversedFrameHistoryChannelState
+
 //------------------------------------------------------------------------------
 } // namespace Effects
 //------------------------------------------------------------------------------
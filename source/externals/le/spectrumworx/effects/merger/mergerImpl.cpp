@@ -12,6 +12,7 @@
 #include "le/math/conversion.hpp"
 #include "le/math/math.hpp"
 #include "le/parameters/uiElements.hpp"
+#include "le/spectrumworx/engine/binKernels.hpp"
 #include "le/spectrumworx/engine/channelDataAmPh.hpp"
 #include "le/spectrumworx/engine/setup.hpp"
 #include "le/utility/platformSpecifics.hpp"
@@ -80,33 +81,34 @@ void MergerImpl::setup( IndexRange const &, Engine::Setup const & engineSetup )
 
 void MergerImpl::process( Engine::MainSideChannelData_AmPh data, Engine::Setup const & ) const
 {
-    // Possible threshold value sources
-    ReadOnlyDataRange const &       mainAmps ( static_cast<Engine::ChannelData_AmPh const &>( data.main() ).amps() );
-    ReadOnlyDataRange const &       sideAmps (                                                data.side()  .amps() );
-    ReadOnlyDataRange         const threshold( &threshold_, &threshold_ + 1                                        );
+    float const threshold( threshold_ );
 
-    ReadOnlyDataRange const * pLargerValue ;
-    ReadOnlyDataRange const * pSmallerValue;
-    switch ( parameters().get<Operation>().getValue() )
+    using namespace Engine::BinKernels;
+    dispatch<6>( parameters().get<Operation>(), [ &data, threshold ]( auto const operation )
     {
-        case Operation::MainLargerThanSide: pLargerValue = &mainAmps ; pSmallerValue = &sideAmps ; break;
-        case Operation::SideLargerThanMain: pLargerValue = &sideAmps ; pSmallerValue = &mainAmps ; break;
-        case Operation::MainAboveThreshold: pLargerValue = &mainAmps ; pSmallerValue = &threshold; break;
-        case Operation::MainBelowThreshold: pLargerValue = &threshold; pSmallerValue = &mainAmps ; break;
-        case Operation::SideAboveThreshold: pLargerValue = &sideAmps ; pSmallerValue = &threshold; break;
-        case Operation::SideBelowThreshold: pLargerValue = &threshold; pSmallerValue = &sideAmps ; break;
-        LE_DEFAULT_CASE_UNREACHABLE();
-    }
-
-    while ( data )
-    {
-        if ( *pLargerValue->begin() > *pSmallerValue->begin() )
+        forEach( data, [ threshold ]( auto & bin, std::uint16_t )
         {
-            data.main().amps  ().front() = data.side().amps  ().front();
-            data.main().phases().front() = data.side().phases().front();
-        }
-        ++data;
-    }
+            using boost::simd::if_else   ;
+            using boost::simd::is_greater;
+
+            auto const mainAmp( bin.mainAmp             );
+            auto const sideAmp( bin.sideAmp             );
+            auto const thr    ( bin.splat( threshold ) );
+
+            auto const replace
+            (
+                ( operation == Operation::MainLargerThanSide ) ? is_greater( mainAmp, sideAmp ) :
+                ( operation == Operation::SideLargerThanMain ) ? is_greater( sideAmp, mainAmp ) :
+                ( operation == Operation::MainAboveThreshold ) ? is_greater( mainAmp, thr     ) :
+                ( operation == Operation::MainBelowThreshold ) ? is_greater( thr    , mainAmp ) :
+                ( operation == Operation::SideAboveThreshold ) ? is_greater( sideAmp, thr     ) :
+                                                                 is_greater( thr    , sideAmp )
+            );
+
+            bin.mainAmp   = if_else( replace, sideAmp      , mainAmp       );
+            bin.mainPhase = if_else( replace, bin.sidePhase, bin.mainPhase );
+        });
+    });
 }
 
 
@@ -10,14 +10,14 @@
 #include "octaverImpl.hpp"
 
 #include "le/spectrumworx/engine/channelData.hpp"
+#include "le/spectrumworx/engine/processor.hpp"
 #include "le/spectrumworx/engine/setup.hpp"
 #include "le/math/conversion.hpp"
 #include "le/math/math.hpp"
 #include "le/math/dft/domainConversion.hpp"
 #include "le/math/vector.hpp"
 #include "le/parameters/uiElements.hpp"
-
-#include "boost/simd/preprocessor/stack_buffer.hpp"
+#include "le/utility/countof.hpp"
 //------------------------------------------------------------------------------
 namespace LE
 {
@@ -90,7 +90,7 @@ EFFECT_ENUMERATED_PARAMETER_STRINGS
 
 void OctaverImpl::setup( IndexRange const & workingRange, Engine::Setup const & engineSetup )
 {
-    ps_.setup( engineSetup );
+    pvs_.setup( engineSetup );
 
     octaveParameters_[ 0 ].gain       = Math::dB2NormalisedLinear  ( parameters().get<GainOctave1>()            );
     octaveParameters_[ 1 ].gain       = Math::dB2NormalisedLinear  ( parameters().get<GainOctave2>()            );
@@ -111,6 +111,21 @@ void OctaverImpl::setup( IndexRange const & workingRange, Engine::Setup const &
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+//
+// OctaverImpl::scratchStorage()
+// -----------------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+
+LE_COLD
+std::uint32_t OctaverImpl::scratchStorage( Engine::StorageFactors const & factors )
+{
+    // The shared analysis and the current voice:
+    return 2 * Engine::ScratchArena::requiredStorage<char>( Engine::ChannelData_AmPhStorage::requiredStorage( factors.fftSize ) );
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 //
 // OctaverImpl::process()
@@ -136,14 +151,33 @@ void OctaverImpl::process( ChannelState & cs, Engine::ChannelData_AmPh2ReIm data
         engineSetup.numberOfBins()
     );
 
+    // The PV analysis is shared by the voices (octaves) so that each one adds
+    // only its bin remapping, synthesis and mixing.
+    bool const voiceActive[] =
     {
-        // Allocate temporary AmPh storage for mixing:
+        !is<1>( octaveParameters_[ 0 ].pitchScale ),
+        !is<1>( octaveParameters_[ 1 ].pitchScale )
+    };
+    if ( voiceActive[ 0 ] || voiceActive[ 1 ] )
+    {
+        // Allocate temporary AmPh storage for the analysis and mixing:
         auto const fftSize( engineSetup.fftSize<std::uint16_t>() );
-        BOOST_SIMD_ALIGNED_SCOPED_STACK_BUFFER( pitchShiftedStorage, char, ChannelData_AmPhStorage::requiredStorage( fftSize ) );
-        ChannelData_AmPhStorage shiftedInput( fftSize, inputData.beginBin(), inputData.endBin(), pitchShiftedStorage );
-
-        shiftAndMix( data, shiftedInput, engineSetup, cs.pv1, 0 );
-        shiftAndMix( data, shiftedInput, engineSetup, cs.pv2, 1 );
+        Engine::ScratchArena::Scope scratch( Engine::Processor::fromEngineSetup( engineSetup ).scratch() );
+        Engine::Storage const analysedStorage( scratch.allocate<char>( ChannelData_AmPhStorage::requiredStorage( fftSize ) ) );
+        Engine::Storage const voiceStorage   ( scratch.allocate<char>( ChannelData_AmPhStorage::requiredStorage( fftSize ) ) );
+        ChannelData_AmPhStorage analysed( fftSize, inputData.beginBin(), inputData.endBin(), analysedStorage );
+        ChannelData_AmPhStorage voice   ( fftSize, inputData.beginBin(), inputData.endBin(), voiceStorage    );
+
+        pvs_.analyse( cs.analysis, inputData, analysed );
+
+        PhaseVocoderShared::MultiVoicePitchShifter::VoiceChannelState * const voiceStates[] = { &cs.voice1, &cs.voice2 };
+        for ( std::uint8_t octave( 0 ); octave < _countof( voiceStates ); ++octave )
+        {
+            if ( !voiceActive[ octave ] )
+                continue;
+            OctaveSetup const & octaveParameters( octaveParameters_[ octave ] );
+            pvs_.addVoice( octaveParameters.pitchScale, octaveParameters.gain, cs.analysis, *voiceStates[ octave ], inputData, analysed, voice, outputData );
+        }
     }
 
     BOOST_ASSERT( cutoff_ <= outputData.numberOfBins() );
@@ -151,38 +185,6 @@ void OctaverImpl::process( ChannelState & cs, Engine::ChannelData_AmPh2ReIm data
     clear( outputData.imags().begin() + cutoff_, outputData.imags().end() );
 }
 
-
-////////////////////////////////////////////////////////////////////////////////
-//
-// OctaverImpl::shiftAndMix()
-// --------------------------
-//
-////////////////////////////////////////////////////////////////////////////////
-
-void OctaverImpl::shiftAndMix
-(
-    Engine::ChannelData_AmPh2ReIm                        &       data,
-    Engine::ChannelData_AmPh                             &       shiftedData,
-    Engine::Setup                                  const &       engineSetup,
-    PhaseVocoderShared::PitchShifter::ChannelState       &       pvState,
-    std::uint8_t                                           const octave
-) const
-{
-    using namespace Engine;
-    using namespace Math  ;
-
-    OctaveSetup const & octaveParameters( octaveParameters_[ octave ] );
-    if ( is<1>( octaveParameters.pitchScale ) )
-        return;
-
-    ChannelData_AmPh const & inputData ( data.input.main() );
-    ChannelData_ReIm       & outputData( data.output       );
-
-    copy( inputData.full().jointView(), shiftedData.full().jointView() );
-    ps_.process( octaveParameters.pitchScale, pvState, std::forward<ChannelData_AmPh>( shiftedData ), engineSetup );
-    mix( shiftedData.amps(), shiftedData.phases(), outputData.reals(), outputData.imags(), octaveParameters.gain, 1 );
-}
-
 //------------------------------------------------------------------------------
 } // namespace Effects
 //------------------------------------------------------------------------------
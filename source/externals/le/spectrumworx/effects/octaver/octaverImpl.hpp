@@ -39,22 +39,15 @@ public: // LE::Effect interface.
     LE_NAMED_DYNAMIC_CHANNEL_STATE
     (
         ChannelState,
-        ( ( PhaseVocoderShared::PitchShifter::ChannelState )( pv1 ) )
-        ( ( PhaseVocoderShared::PitchShifter::ChannelState )( pv2 ) )
+        ( ( PhaseVocoderShared::AnalysisChannelState                      )( analysis ) )
+        ( ( PhaseVocoderShared::MultiVoicePitchShifter::VoiceChannelState )( voice1   ) )
+        ( ( PhaseVocoderShared::MultiVoicePitchShifter::VoiceChannelState )( voice2   ) )
     );
 
     void setup  ( IndexRange const &, Engine::Setup const & );
     void process( ChannelState &, Engine::ChannelData_AmPh2ReIm, Engine::Setup const & ) const;
 
-private:
-    void LE_FASTCALL shiftAndMix
-    (
-        Engine::ChannelData_AmPh2ReIm                        & data,
-        Engine::ChannelData_AmPh                             & shiftedData,
-        Engine::Setup                                  const & engineSetup,
-        PhaseVocoderShared::PitchShifter::ChannelState       & pvState,
-        std::uint8_t                                           octave
-    ) const;
+    static std::uint32_t scratchStorage( Engine::StorageFactors const & );
 
 private:
     struct OctaveSetup
@@ -68,7 +61,7 @@ private:
 
     std::uint16_t cutoff_;
 
-    PhaseVocoderShared::PitchShifter ps_;
+    PhaseVocoderShared::MultiVoicePitchShifter pvs_;
 };
 
 //------------------------------------------------------------------------------
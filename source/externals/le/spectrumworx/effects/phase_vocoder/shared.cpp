@@ -15,6 +15,7 @@
 #include "le/math/vector.hpp"
 #include "le/parameters/uiElements.hpp"
 #include "le/spectrumworx/engine/channelDataAmPh.hpp"
+#include "le/spectrumworx/engine/channelDataReIm.hpp"
 #include "le/spectrumworx/engine/setup.hpp"
 
 #include "boost/simd/sdk/config/arch.hpp"
@@ -198,6 +199,100 @@ void LE_NOINLINE PitchShifter::process( ChannelState & channelState, Engine::Cha
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+//
+// MultiVoicePitchShifter::analyse()
+// ---------------------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+
+void LE_NOINLINE MultiVoicePitchShifter::analyse
+(
+    AnalysisChannelState           &       analysisState,
+    Engine::ChannelData_AmPh const &       input,
+    Engine::ChannelData_AmPh       &       analysed
+) const
+{
+    using namespace Math;
+
+    if ( analysisState.reinitializePhases )
+    {
+        Detail::AnalysisBinStateData * LE_RESTRICT pBinState( analysisState.binData.begin() );
+        for ( auto const inputPhase : input.full().phases() )
+        {
+            pBinState->lastPhase     = inputPhase;
+        #ifdef LE_PV_USE_TSS
+            pBinState->lastLastPhase = inputPhase;
+        #endif // LE_PV_USE_TSS
+            ++pBinState;
+        }
+        analysisState.reinitializePhases = false;
+    }
+
+    copy( input.full().jointView(), analysed.full().jointView() );
+    analysis( analysisState, analysed.full(), *this );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// MultiVoicePitchShifter::addVoice()
+// ----------------------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+
+void LE_NOINLINE MultiVoicePitchShifter::addVoice
+(
+    float                            const pitchScale,
+    float                            const gain,
+    AnalysisChannelState           &       analysisState,
+    VoiceChannelState              &       voiceState,
+    Engine::ChannelData_AmPh const &       input,
+    Engine::ChannelData_AmPh const &       analysed,
+    Engine::ChannelData_AmPh       &       voice,
+    Engine::ChannelData_ReIm       &       output
+) const
+{
+    using namespace Math;
+
+    PitchShiftParameters pitchShiftParameters;
+    pitchShiftParameters.setScalingFactor( pitchScale, input.full().numberOfBins() );
+
+    // See the related notes in PitchShifter::process().
+    float const scaleFactor( pitchShiftParameters.scale() );
+    if
+    (
+        voiceState.reinitializePhases ||
+        (
+            ( !equal( voiceState.previousScaleFactor, scaleFactor ) ) &&
+            (
+                ( truncate(     scaleFactor ) ==     scaleFactor ) ||
+                ( truncate( 1 / scaleFactor ) == 1 / scaleFactor )
+            )
+        )
+    )
+    {
+        multiply( input.full().phases(), scaleFactor, voiceState.phaseSum() );
+        voiceState.reinitializePhases = false;
+    }
+    voiceState.previousScaleFactor = scaleFactor;
+
+    copy( analysed.full().jointView(), voice.full().jointView() );
+
+#ifdef LE_PV_USE_TSS
+    voice.pAnalysisState  = &analysisState;
+    voice.pSynthesisState = &voiceState;
+#else
+    boost::ignore_unused_variable_warning( analysisState );
+#endif // LE_PV_USE_TSS
+
+    pitchShiftAndScale(             voice                , pitchShiftParameters );
+    synthesis         ( voiceState, voice.full().phases(), *this                );
+
+    mix( voice.amps(), voice.phases(), output.reals(), output.imags(), gain, 1 );
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 //
 // Phase vocoder core
@@ -21,6 +21,7 @@
 #include "le/spectrumworx/effects/indexRange.hpp"
 #include "le/spectrumworx/engine/buffers.hpp"
 #include "le/spectrumworx/engine/channelDataAmPh.hpp"
+#include "le/spectrumworx/engine/channelData_fwd.hpp"
 #include "le/utility/platformSpecifics.hpp"
 
 #include "boost/assert.hpp"
@@ -320,6 +321,67 @@ public: // LE::Effect interface.
 }; // class PitchShifter
 
 
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class MultiVoicePitchShifter
+///
+/// \brief Pitch shifts a single input into several voices mixed into a
+/// common (ReIm) output.
+///
+///   The PV analysis (the per bin instantaneous frequency estimation) depends
+/// only on the input so it is done once per hop (analyse()) and shared by all
+/// voices. Each voice (addVoice()) then only costs the bin remapping, its own
+/// synthesis phase accumulation and the mixing into the output.
+///
+///   Unlike with PitchShifter, a voice's pitch scale change (to an integer
+/// value) reinitialises only that voice's synthesis phases (the shared
+/// analysis state is reinitialised only on reset).
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class MultiVoicePitchShifter : private BaseParameters
+{
+public:
+    struct VoiceChannelState : SynthesisChannelState
+    {
+        void reset()
+        {
+            SynthesisChannelState::reset();
+            previousScaleFactor = 1   ;
+            reinitializePhases  = true;
+        }
+        float previousScaleFactor;
+        bool  reinitializePhases ;
+    }; // struct VoiceChannelState
+
+public: // LE::Effect interface.
+    using BaseParameters::setup;
+
+public:
+    /// Copies the input into the analysed buffer replacing its phases with the
+    /// estimated bin frequencies.
+    void LE_FASTCALL analyse
+    (
+        AnalysisChannelState           &,
+        Engine::ChannelData_AmPh const & input,
+        Engine::ChannelData_AmPh       & analysed
+    ) const;
+
+    /// Remaps the analysed data into the voice buffer, synthesises the voice's
+    /// phases and mixes it (with the given gain) into the output.
+    void LE_FASTCALL addVoice
+    (
+        float pitchScale, float gain,
+        AnalysisChannelState           &,
+        VoiceChannelState              &,
+        Engine::ChannelData_AmPh const & input,
+        Engine::ChannelData_AmPh const & analysed,
+        Engine::ChannelData_AmPh       & voice,
+        Engine::ChannelData_ReIm       & output
+    ) const;
+}; // class MultiVoicePitchShifter
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// \internal
 /// \class CombinedChannelState
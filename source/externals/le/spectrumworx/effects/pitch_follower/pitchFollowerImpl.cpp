@@ -10,6 +10,7 @@
 #include "pitchFollowerImpl.hpp"
 
 #include "le/spectrumworx/engine/channelDataAmPh.hpp"
+#include "le/spectrumworx/engine/processor.hpp"
 #include "le/spectrumworx/engine/setup.hpp"
 #include "le/math/conversion.hpp"
 #include "le/parameters/uiElements.hpp"
@@ -55,8 +56,9 @@ namespace Detail
 
     float PitchFollowerBaseImpl::findTargetPitch( ChannelState & cs, Engine::MainSideChannelData_AmPh const & data, Engine::Setup const & setup ) const
     {
-        float const estimatedPitchMain( PitchDetector::findPitch( data.full().main().amps(), cs, 70, 7000, setup ) );
-        float const estimatedPitchSide( PitchDetector::findPitch( data.full().side().amps(), cs, 70, 7000, setup ) );
+        auto & features( Engine::Processor::fromEngineSetup( setup ).features() );
+        float const estimatedPitchMain( features.pitch( data.full().main().amps(), cs, 70, 7000, setup ) );
+        float const estimatedPitchSide( features.pitch( data.full().side().amps(), cs, 70, 7000, setup ) );
 
         float pitchScale
         (
@@ -10,6 +10,7 @@
 #include "pitchMagnetImpl.hpp"
 
 #include "le/spectrumworx/engine/channelDataAmPh.hpp"
+#include "le/spectrumworx/engine/processor.hpp"
 #include "le/spectrumworx/engine/setup.hpp"
 #include "le/math/conversion.hpp"
 #include "le/math/math.hpp"
@@ -58,7 +59,7 @@ namespace Detail
 
     float PitchMagnetBaseImpl::findTargetPitch( ChannelState & cs, Engine::ChannelData_AmPh const & data, Engine::Setup const & engineSetup ) const
     {
-        float const estimatedPitchMain( PitchDetector::findPitch( data.full().amps(), cs, 70, 7000, engineSetup ) );
+        float const estimatedPitchMain( Engine::Processor::fromEngineSetup( engineSetup ).features().pitch( data.full().amps(), cs, 70, 7000, engineSetup ) );
 
         float pitchScale
         (
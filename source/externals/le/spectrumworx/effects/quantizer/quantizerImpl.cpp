@@ -14,6 +14,7 @@
 #include "le/spectrumworx/engine/setup.hpp"
 #include "le/math/conversion.hpp"
 #include "le/math/math.hpp"
+#include "le/math/vector.hpp"
 #include "le/parameters/uiElements.hpp"
 //------------------------------------------------------------------------------
 namespace LE
@@ -101,32 +102,9 @@ void QuantizerImpl::process( Engine::ChannelData_AmPh data, Engine::Setup const
 //
 ////////////////////////////////////////////////////////////////////////////////
 
-void QuantizerImpl::quantize( DataRange amps ) const
+void QuantizerImpl::quantize( DataRange const amps ) const
 {
-    auto const chunkSize( chunkSize_ );
-
-    float const origamiByChunkSize( origami_ / Math::convert<float>( chunkSize ) );
-
-    while ( amps )
-    {
-        auto const currentChunkSize( std::min( static_cast<IndexRange::value_type>( amps.size() ), chunkSize ) );
-
-        float * pCurrentChunkValue( amps.begin() );
-
-        amps.advance_begin( currentChunkSize );
-
-        float const magStart( *pCurrentChunkValue   );
-        float const magEnd  ( *( amps.begin() - 1 ) );
-
-        float const dm( ( magEnd - magStart ) * origamiByChunkSize );
-
-        float mag( magStart );
-        while ( pCurrentChunkValue < amps.begin() )
-        {
-            *pCurrentChunkValue++  = mag;
-            mag                   += dm;
-        }
-    }
+    Math::quantise( amps, chunkSize_, origami_ );
 }
 
 //------------------------------------------------------------------------------
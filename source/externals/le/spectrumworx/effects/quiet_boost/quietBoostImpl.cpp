@@ -11,6 +11,7 @@
 
 #include "le/math/conversion.hpp"
 #include "le/math/math.hpp"
+#include "le/math/vector.hpp"
 #include "le/parameters/uiElements.hpp"
 #include "le/spectrumworx/engine/channelDataAmPh.hpp"
 #include "le/spectrumworx/engine/setup.hpp"
@@ -48,37 +49,34 @@ EFFECT_PARAMETER_NAME( QuietBoost::NoiseGateThreshold, "Noise threshold" )
 
 ////////////////////////////////////////////////////////////////////////////////
 //
-// QuietBoostImpl::process()
-// -------------------------
+// QuietBoostImpl::setup()
+// -----------------------
 //
 ////////////////////////////////////////////////////////////////////////////////
 
-void QuietBoostImpl::process( Engine::ChannelData_AmPh data, Engine::Setup const & setup ) const
+void QuietBoostImpl::setup( IndexRange const &, Engine::Setup const & engineSetup )
 {
-    float const maxGlobal( setup.maximumAmplitude() );
-
-    float const threshold         ( parameters().get<Threshold         >() );
-    float const ratio             ( parameters().get<Ratio             >() );
-    float const noiseGateThreshold( parameters().get<NoiseGateThreshold>() );
+    // Global max as the reference:
+    float const zeroDecibel( engineSetup.maximumAmplitude() );
 
-    /// \todo Convert all the parameters to linear values to avoid the linear<->
-    /// dB conversions inside the loop.
-    ///                                       (13.10.2011.) (Domagoj Saric)
-
-    for ( auto & amp : data.amps() )
-    {
-        // Transfer magnitudes to decibel scale, take global Max as a reference:
-        float mag( Math::normalisedLinear2dB( amp / maxGlobal + 0.000000001f ) );
+    threshold_          = zeroDecibel * Math::dB2NormalisedLinear( parameters().get<Threshold         >() );
+    noiseGateThreshold_ = zeroDecibel * Math::dB2NormalisedLinear( parameters().get<NoiseGateThreshold>() );
+}
 
-        // Expander:
 
-        // If magnitude lower than threshold, "expand" it:
-        if ( mag < threshold && mag > noiseGateThreshold )
-            mag = threshold - ( threshold - mag ) / ratio;
+////////////////////////////////////////////////////////////////////////////////
+//
+// QuietBoostImpl::process()
+// -------------------------
+//
+////////////////////////////////////////////////////////////////////////////////
 
-        // Back from dB:
-        amp = maxGlobal * Math::dB2NormalisedLinear( mag );
-    }
+void QuietBoostImpl::process( Engine::ChannelData_AmPh data, Engine::Setup const & ) const
+{
+    // Magnitudes lower than the threshold (and above the noise gate) get
+    // "expanded" (their distance from the threshold, in dB, gets divided by
+    // the ratio):
+    Math::expand( data.amps(), threshold_, parameters().get<Ratio>(), noiseGateThreshold_ );
 }
 
 //------------------------------------------------------------------------------
@@ -13,6 +13,7 @@
 //------------------------------------------------------------------------------
 #include "quietBoost.hpp"
 
+#include "le/math/dft/domainConversion.hpp"
 #include "le/spectrumworx/effects/effects.hpp"
 //------------------------------------------------------------------------------
 namespace LE
@@ -33,8 +34,14 @@ public: // LE::Effect interface.
     // setup() and process()
     ////////////////////////////////////////////////////////////////////////////
 
-    static void setup( IndexRange const &, Engine::Setup const & ) {}
+    void setup  ( IndexRange const &, Engine::Setup const & );
     void process( Engine::ChannelData_AmPh, Engine::Setup const & ) const;
+
+    static Math::ConversionAccuracy BOOST_CONSTEXPR_OR_CONST conversionAccuracy = Math::CoarseConversion; // amplitudes only
+
+private:
+    float threshold_         ;
+    float noiseGateThreshold_;
 };
 
 //------------------------------------------------------------------------------
@@ -12,6 +12,7 @@
 #include "le/math/vector.hpp"
 #include "le/parameters/uiElements.hpp"
 #include "le/spectrumworx/engine/channelDataAmPh.hpp"
+#include "le/spectrumworx/engine/processor.hpp"
 #include "le/spectrumworx/engine/setup.hpp"
 #include "le/utility/buffers.hpp"
 //------------------------------------------------------------------------------
@@ -64,32 +65,20 @@ void ReverserImpl::setup( IndexRange const &, Engine::Setup const & engineSetup
 //
 ////////////////////////////////////////////////////////////////////////////////
 
-void ReverserImpl::process( ChannelState & cs, Engine::ChannelData_AmPh data, Engine::Setup const & ) const
+void ReverserImpl::process( ChannelState & cs, Engine::ChannelData_AmPh data, Engine::Setup const & engineSetup ) const
 {
     using namespace Math;
 
     auto const fullNumberOfBins( data.full().numberOfBins() );
 
-    ReversedHistoryBufferState::HistoryData const historyData
-    (
-        cs.getCurrentStepData( lengthInSteps_, fullNumberOfBins )
-    );
-
-    //   First we save the new input data and output the current history data.
-    // After a chunk/step/frame of history is output we have no more need for it
-    // so we can overwrite it with current/new input data. To accomplish saving
-    // the current history chunk to output and the current input data to
-    // the same location (the current history chunk) without an auxiliary buffer
-    // the Math::swap() function is used. Since the individual history chunks
-    // were already saved time-reversed we in effect play/output the
-    // time-reversed version of the signal history.
-    //                                        (21.05.2010.) (Domagoj Saric)
-    auto const startBin( data.beginBin() );
-    swap( data.amps  ().begin(), data.amps  ().end(), historyData.targetHistory.pAmplitudesOrReals + startBin );
-    swap( data.phases().begin(), data.phases().end(), historyData.targetHistory.pPhasesOrImags     + startBin );
-
-    data.copySkippedRanges( Engine::DataPair::Amps  , historyData.targetHistory.pAmplitudesOrReals );
-    data.copySkippedRanges( Engine::DataPair::Phases, historyData.targetHistory.pPhasesOrImags     );
+    auto const historyFrames( cs.getCurrentStepFrames( lengthInSteps_ ) );
+
+    //   First we save the new input data (into the frame freed up by the
+    // previous step) and then output the current history data. Since the
+    // individual history chunks were already saved time-reversed we in effect
+    // play/output the time-reversed version of the signal history.
+    copy( data.full().amps  ().begin(), historyFrames.target.pAmplitudes, fullNumberOfBins );
+    copy( data.full().phases().begin(), historyFrames.target.pPhases    , fullNumberOfBins );
 
     // Time reverse the new, saved, history frame.
     // Implementation note:
@@ -102,16 +91,26 @@ void ReverserImpl::process( ChannelState & cs, Engine::ChannelData_AmPh data, En
     // symmetrical, while on phases it has the effect of negation because they
     // are anti-symmetrical).
     //                                        (14.05.2010.) (Domagoj Saric)
-    negate( historyData.targetHistory.pPhasesOrImags, fullNumberOfBins );
-
-    // If the requested history data was emulated, the output (from
-    // historyData.targetHistory) contains garbage so we must copy the emulated
-    // history to the output).
-    if ( historyData.isEmulated() )
+    negate( historyFrames.target.pPhases, fullNumberOfBins );
+
+    // An emulated history frame is still part of the history (it will be
+    // output again) so it has to be copied. Otherwise the consumed history
+    // frame is no longer needed (until it gets reused for the next step's
+    // input) so the engine simply takes it over as the output instead of
+    // having it copied in.
+    if ( historyFrames.isEmulated() )
     {
+        auto const startBin    ( data.beginBin    () );
         auto const numberOfBins( data.numberOfBins() );
-        copy( historyData.sourceHistory.pAmplitudesOrReals + startBin, data.amps  ().begin(), numberOfBins );
-        copy( historyData.sourceHistory.pPhasesOrImags     + startBin, data.phases().begin(), numberOfBins );
+        copy( historyFrames.source.pAmplitudes + startBin, data.amps  ().begin(), numberOfBins );
+        copy( historyFrames.source.pPhases     + startBin, data.phases().begin(), numberOfBins );
+    }
+    else
+    {
+        // Bins outside of the working range pass through unmodified.
+        data.copySkippedRanges( Engine::DataPair::Amps  , historyFrames.source.pAmplitudes );
+        data.copySkippedRanges( Engine::DataPair::Phases, historyFrames.source.pPhases     );
+        Engine::Processor::fromEngineSetup( engineSetup ).lendFrame( data, historyFrames.source.pAmplitudes );
     }
 }
 
@@ -35,7 +35,7 @@ public: // LE::Effect interface.
     // ChannelState
     ////////////////////////////////////////////////////////////////////////////
 
-    typedef ReversedHistoryChannelState<Length::unscaledMaximum> ChannelState;
+    typedef ReversedFrameHistoryChannelState<Length::unscaledMaximum> ChannelState;
 
 
     ////////////////////////////////////////////////////////////////////////////
@@ -10,12 +10,13 @@
 #include "shapelessImpl.hpp"
 
 #include "le/parameters/uiElements.hpp"
+#include "le/spectrumworx/engine/binKernels.hpp"
 #include "le/spectrumworx/engine/channelDataAmPh.hpp"
 #include "le/spectrumworx/engine/setup.hpp"
 #include "le/utility/platformSpecifics.hpp"
 
+#include <algorithm>
 #include <limits>
-#include <numeric>
 //------------------------------------------------------------------------------
 namespace LE
 {
@@ -85,24 +86,27 @@ void ShapelessImpl::process( Engine::MainSideChannelData_AmPh data, Engine::Setu
     if ( !width )
         return;
 
-    while ( data )
+    using namespace Engine::BinKernels;
+
+    float const * const pMagnOut  ( data.main().amps().begin() );
+    float const * const pMagnShape( data.side().amps().begin() );
+
+    std::uint16_t const numberOfBins( data.numberOfBins() );
+    for ( std::uint16_t bandBegin( 0 ); bandBegin < numberOfBins; )
     {
-        auto const currentWidth( std::min( data.size(), width ) );
-        auto *       LE_RESTRICT pMagnOut     ( data.main().amps().begin() );
-        auto *       LE_RESTRICT pMagnShape   ( data.side().amps().begin() );
-        data.advance_begin( currentWidth );
-        auto * const LE_RESTRICT pMagnOutEnd  ( data.main().amps().begin() );
-        auto * const LE_RESTRICT pMagnShapeEnd( data.side().amps().begin() );
+        auto const bandEnd( static_cast<std::uint16_t>( bandBegin + std::min<std::uint16_t>( numberOfBins - bandBegin, width ) ) );
 
-        float const inOut  ( std::accumulate( pMagnOut  , pMagnOutEnd  , std::numeric_limits<float>::epsilon() ) );
-        float const inShape( std::accumulate( pMagnShape, pMagnShapeEnd, std::numeric_limits<float>::epsilon() ) );
+        float const inOut  ( std::numeric_limits<float>::epsilon() + sum( pMagnOut  , bandBegin, bandEnd ) );
+        float const inShape( std::numeric_limits<float>::epsilon() + sum( pMagnShape, bandBegin, bandEnd ) );
 
         float const amplt( inOut / inShape );
 
-        while ( pMagnOut != pMagnOutEnd )
+        forEach( data, bandBegin, bandEnd, [ amplt ]( auto & bin, std::uint16_t )
         {
-            *pMagnOut++ = amplt * *pMagnShape++;
-        }
+            bin.mainAmp = bin.sideAmp * bin.splat( amplt );
+        });
+
+        bandBegin = bandEnd;
     }
 }
 
@@ -13,6 +13,7 @@
 //------------------------------------------------------------------------------
 #include "sharper.hpp"
 
+#include "le/math/dft/domainConversion.hpp"
 #include "le/spectrumworx/effects/effects.hpp"
 //------------------------------------------------------------------------------
 namespace LE
@@ -36,6 +37,8 @@ public: // LE::Effect required interface.
     void setup  ( IndexRange const &, Engine::Setup const & );
     void process( Engine::ChannelData_AmPh, Engine::Setup const & ) const;
 
+    static Math::ConversionAccuracy BOOST_CONSTEXPR_OR_CONST conversionAccuracy = Math::CoarseConversion; // amplitudes only
+
 private:
     unsigned int filterLenHalf_;
     float        intensity_    ;
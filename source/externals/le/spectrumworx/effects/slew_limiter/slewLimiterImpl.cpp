@@ -101,30 +101,11 @@ void SlewLimiterImpl::process( ChannelState & cs, Engine::ChannelData_AmPh data,
 
     if ( cs.isInitialised )
     {
-        float const gainLowerBound( gainLowerBound_ );
-        float const gainUpperBound( gainUpperBound_ );
-
-        float       * LE_RESTRICT pCurrentAmp ( data.amps().begin()             );
-        float const * LE_RESTRICT pPreviousAmp( &cs.magsPrev[ data.beginBin() ] );
-
-        float const * const pEnd( data.amps().end() );
-        while ( pCurrentAmp != pEnd )
-        {
-            /// \note previousAmp must be kept above zero in order for the
-            /// signal to be able to ever rise from initial silence (because
-            /// previousAmp * clampedGain will alwas yield zero if previousAmp
-            /// is zero). Additionally, it helps avoiding floating point
-            /// exceptions in the currentAmp / previousAmp expression.
-            ///                               (19.06.2012.) (Domagoj Saric)
-            float const previousAmp( std::max( *pPreviousAmp++, std::numeric_limits<float>::epsilon() ) );
-            float const currentAmp (           *pCurrentAmp                                             );
-
-            float const gain( currentAmp / previousAmp );
-
-            float const clampedGain( clamp( gain, gainLowerBound, gainUpperBound ) );
-
-            *pCurrentAmp++ = previousAmp * clampedGain;
-        }
+        // Each amplitude is kept within [gainLowerBound_, gainUpperBound_]
+        // times its previous value (kept above epsilon by slewLimit() so that
+        // the signal can rise from silence).
+        float const * const pPreviousAmps( &cs.magsPrev[ data.beginBin() ] );
+        slewLimit( data.amps(), ReadOnlyDataRange( pPreviousAmps, pPreviousAmps + data.amps().size() ), gainLowerBound_, gainUpperBound_ );
     }
 
     // Save new and unused amplitudes for next comparison:
@@ -12,14 +12,13 @@
 #include "le/spectrumworx/effects/indexRange.hpp"
 #include "le/spectrumworx/engine/channelData.hpp"
 #include "le/spectrumworx/engine/channelDataAmPh.hpp"
+#include "le/spectrumworx/engine/processor.hpp"
 #include "le/spectrumworx/engine/setup.hpp"
 #include "le/math/dft/domainConversion.hpp"
 #include "le/math/math.hpp"
 #include "le/math/conversion.hpp"
 #include "le/math/vector.hpp"
 #include "le/parameters/uiElements.hpp"
-
-#include "boost/simd/preprocessor/stack_buffer.hpp"
 //------------------------------------------------------------------------------
 namespace LE
 {
@@ -68,6 +67,20 @@ void SumoPitchImpl::setup( IndexRange const &, Engine::Setup const & engineSetup
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+//
+// SumoPitchImpl::scratchStorage()
+// -------------------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+
+LE_COLD
+std::uint32_t SumoPitchImpl::scratchStorage( Engine::StorageFactors const & factors )
+{
+    return Engine::ScratchArena::requiredStorage<char>( Engine::ChannelData_AmPhStorage::requiredStorage( factors.fftSize ) );
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 //
 // SumoPitchImpl::process()
@@ -108,8 +121,9 @@ void SumoPitchImpl::process( ChannelState & cs, Engine::ChannelData_AmPh2ReIm da
     float pitchScaleSide;
 
     {
-        float const estimatedPitchMain( PitchDetector::findPitch( amPhData.full().main().amps(), cs.pdState, 70, 7000, engineSetup ) );
-        float const estimatedPitchSide( PitchDetector::findPitch( amPhData.full().side().amps(), cs.pdState, 70, 7000, engineSetup ) );
+        auto & features( Engine::Processor::fromEngineSetup( engineSetup ).features() );
+        float const estimatedPitchMain( features.pitch( amPhData.full().main().amps(), cs.pdState, 70, 7000, engineSetup ) );
+        float const estimatedPitchSide( features.pitch( amPhData.full().side().amps(), cs.pdState, 70, 7000, engineSetup ) );
 
         if ( estimatedPitchMain && estimatedPitchSide )
         {
@@ -131,7 +145,8 @@ void SumoPitchImpl::process( ChannelState & cs, Engine::ChannelData_AmPh2ReIm da
         limitPitchScale( pitchScaleSide, cs.prevPitchScaleSideSemitones, pitchChangeLimitSemitones_ );
     }
 
-    BOOST_SIMD_ALIGNED_SCOPED_STACK_BUFFER( workBufferStorage, char, Engine::ChannelData_AmPhStorage::requiredStorage( engineSetup.fftSize<unsigned int>() ) );
+    Engine::ScratchArena::Scope scratch( Engine::Processor::fromEngineSetup( engineSetup ).scratch() );
+    Engine::Storage const workBufferStorage( scratch.allocate<char>( Engine::ChannelData_AmPhStorage::requiredStorage( engineSetup.fftSize<unsigned int>() ) ) );
     Engine::ChannelData_AmPhStorage psWorkBuffer( engineSetup.fftSize<unsigned int>(), amPhData.beginBin(), amPhData.endBin(), workBufferStorage );
 
     { // Pitch shift:
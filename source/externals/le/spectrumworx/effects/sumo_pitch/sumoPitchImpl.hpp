@@ -59,6 +59,8 @@ public: // LE::Effect interface.
     void setup  ( IndexRange const &, Engine::Setup const & );
     void process( ChannelState &, Engine::ChannelData_AmPh2ReIm, Engine::Setup const & ) const;
 
+    static std::uint32_t scratchStorage( Engine::StorageFactors const & );
+
 private:
     float amount_;
     float pitchChangeLimitSemitones_;
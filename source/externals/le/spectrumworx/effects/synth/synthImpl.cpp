@@ -240,10 +240,10 @@ void SynthImpl::setup( IndexRange const & workingRange, Engine::Setup const & en
         auto const startCoefficient        ( coefficientsMiddle - halfNumberOfCoefficients                 );
         std::copy( &pAmps[ freqBin - halfNumberOfCoefficients ], &pAmps[ freqBin + 1 + halfNumberOfCoefficients ], &coefficients_[ startCoefficient ] );
 
-        resetState_ = true;
+        // (the channel states are reset by the next process() call, see
+        // ChannelState::stateGeneration)
+        ++stateGeneration_;
     }
-    else
-        resetState_ = false;
 }
 
 LE_COLD
@@ -260,6 +260,7 @@ void SynthImpl::ChannelState::reset()
 #else
     Math::clear( phases.front().begin(), phases.back().end() );
 #endif // initial phases generation
+    stateGeneration = 0;
 }
 
 LE_COLD
@@ -321,11 +322,15 @@ namespace //...mrmlj...copy-pasted from phase vocoder sources...
 LE_HOT
 void SynthImpl::process( SynthImpl::ChannelState & cs, Engine::MainSideChannelData_AmPh data, Engine::Setup const & engineSetup ) const
 {
-    if ( BOOST_UNLIKELY( resetState_ ) )
+    if ( BOOST_UNLIKELY( cs.stateGeneration != stateGeneration_ ) )
+    {
         cs.reset();
+        cs.stateGeneration = stateGeneration_;
+    }
 
 #if 1
     auto & targetData( const_cast<Engine::ChannelData_AmPh &>( data.side() ) );
+    Engine::Processor::fromEngineSetup( engineSetup ).features().sideChannelModified();
 #else
     auto & targetData(                                         data.main()   );
 #endif
@@ -39,7 +39,7 @@ public:
   //static std::uint8_t const numberOfOscillators     = numberOfTones;
 
 public: // LE::Effect required interface.
-    SynthImpl() : lastFreq_( 0 ), lastWindow_( static_cast<Engine::Constants::Window>( -1 ) ), lastFFTSize_( 0 ) {}
+    SynthImpl() : lastFreq_( 0 ), lastWindow_( static_cast<Engine::Constants::Window>( -1 ) ), lastFFTSize_( 0 ), stateGeneration_( 0 ) {}
 
     struct ChannelState
     {
@@ -48,6 +48,11 @@ public: // LE::Effect required interface.
 
         Phases phases;
 
+        /// The SynthImpl::stateGeneration_ the state was last reset for (the
+        /// effect setup is skipped while nothing changes so it cannot signal
+        /// the reset with a one-shot flag).
+        std::uint8_t stateGeneration;
+
                void          LE_FASTCALL reset          ();
                void          LE_FASTCALL resize         ( Engine::StorageFactors const &, Engine::Storage & );
         static std::uint32_t LE_FASTCALL requiredStorage( Engine::StorageFactors const & );
@@ -75,7 +80,7 @@ private:
     float                      lastFreq_    ;
     Engine::Constants::Window  lastWindow_  ;
     std::uint16_t              lastFFTSize_ ;
-    bool                       resetState_  ;
+    std::uint8_t               stateGeneration_;
 }; // class SynthImpl
 
 //------------------------------------------------------------------------------
@@ -64,8 +64,6 @@
 #include "le/spectrumworx/engine/processor.hpp"
 #include "le/spectrumworx/engine/setup.hpp"
 
-#include "boost/simd/preprocessor/stack_buffer.hpp"
-
 #include "boost/assert.hpp"
 //------------------------------------------------------------------------------
 namespace LE
@@ -112,6 +110,24 @@ void TalkingWindImpl::setup( IndexRange const &, Engine::Setup const & engineSet
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+//
+// TalkingWindImpl::scratchStorage()
+// ---------------------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+
+LE_COLD
+std::uint32_t TalkingWindImpl::scratchStorage( Engine::StorageFactors const & factors )
+{
+    using Engine::ScratchArena;
+    std::uint16_t const numberOfBins( factors.fftSize / 2 + 1 );
+    return
+        ScratchArena::requiredStorage<Engine::real_t>( Math::alignIndex( numberOfBins ) * 2 ) + // process() work buffer
+        ScratchArena::requiredStorage<Engine::real_t>( numberOfBins + 2                     );  // lifter (cutoff_ <= numberOfBins)
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 //
 // TalkingWindImpl::process()
@@ -140,7 +156,8 @@ void TalkingWindImpl::process( Engine::MainSideChannelData_AmPh data, Engine::Se
     // time domain frame (i.e. the size of the FFT but allocate it as "two
     // aligned half-FFT size" buffers so that it can be used for both time
     // domain and ReIm intermediate results):
-    BOOST_SIMD_ALIGNED_STACK_BUFFER( doubleWorkBuffer, Engine::real_t, ( alignIndex( fullNumberOfBins ) * 2 ) );
+    Engine::ScratchArena::Scope scratch( Engine::Processor::fromEngineSetup( setup ).scratch() );
+    DataRange const doubleWorkBuffer( scratch.allocate<Engine::real_t>( alignIndex( fullNumberOfBins ) * 2 ) );
     DataRange envelope( &doubleWorkBuffer[ 0 ], &doubleWorkBuffer[ fullNumberOfBins ] );
 
     std::uint16_t const skippedLeadingBins ( data.beginBin()                  );
@@ -149,9 +166,7 @@ void TalkingWindImpl::process( Engine::MainSideChannelData_AmPh data, Engine::Se
     // Cepstrum-based envelope calculation needs its work buffer to be the
     // whole frame size and to thus alias the envelope buffer (for inplace
     // DFT calculation).
-    add( data.full().main().amps(), std::numeric_limits<float>::epsilon(), envelope );
-    ln ( envelope );
-    lowPassSpectrum_cepstrum( envelope, doubleWorkBuffer, setup );
+    lowPassSpectrum_cepstrum( data.full().main().amps(), envelope, doubleWorkBuffer, setup );
     envelope.advance_begin( + skippedLeadingBins  );
     envelope.advance_end  ( - skippedTrailingBins );
     exp( envelope );
@@ -188,9 +203,10 @@ void TalkingWindImpl::process( Engine::MainSideChannelData_AmPh data, Engine::Se
 
 void LE_HOT TalkingWindImpl::lowPassSpectrum_cepstrum
 (
-    DataRange     const & spectrum,
-    DataRange     const & workBuffer,
-    Engine::Setup const & engineSetup
+    ReadOnlyDataRange const & amplitudes,
+    DataRange         const & spectrum,
+    DataRange         const & workBuffer,
+    Engine::Setup     const & engineSetup
 ) const
 {
     using namespace Math;
@@ -222,18 +238,6 @@ void LE_HOT TalkingWindImpl::lowPassSpectrum_cepstrum
     BOOST_ASSERT( spectrum.begin() == workBuffer.begin() );
     BOOST_ASSERT( spectrum.end  () <  workBuffer.end  () );
 
-    float * LE_RESTRICT const pReals( spectrum.begin()                                );
-    float * LE_RESTRICT const pImags( static_cast<float *>( align( spectrum.end() ) ) );
-    // Dummy/null imaginary components (the spectrum is real):
-    clear( pImags, engineSetup.numberOfBins() );
-
-    // Transform into the quefrency domain (the cepstrum):
-    FFT_float_real_1D const & fft( Engine::Processor::fromEngineSetup( engineSetup ).fft() );
-    fft.inverseTransform( pReals, pImags, fft.size() );
-
-    // Inplace FFT: pReals now points to/contains the real cepstrum:
-    float * const pCepstrum( pReals );
-
     // "Low pass" the spectrum:
     float const scale( envgain_ );
 
@@ -243,20 +247,13 @@ void LE_HOT TalkingWindImpl::lowPassSpectrum_cepstrum
     /// currently skipped as a quick-fix.
     ///                               (07.11.2013.) (Domagoj Saric)
     float const udoGain( scale /** 2*/ );
-    if ( cutoff > 2 )
-    {
-        multiply( &pCepstrum[ 1 ], udoGain, cutoff - 2 );
-        // an attempt to make the LP less of a brick...
-        pCepstrum[ 0          ] *= 0.50f * udoGain;
-        pCepstrum[ cutoff - 1 ] *= 0.75f * udoGain;
-    }
-        pCepstrum[ cutoff     ] *= 0.50f * udoGain;
-        pCepstrum[ cutoff + 1 ] *= 0.25f * udoGain;
-    clear( &pCepstrum[ cutoff + 2 ], workBuffer.end() );
+    Engine::ScratchArena::Scope scratch( Engine::Processor::fromEngineSetup( engineSetup ).scratch() );
+    DataRange const lifter( scratch.allocate<Engine::real_t>( cutoff + 2 ) );
+    Engine::SpectralEnvelope::udoBrickLifter( cutoff, udoGain, lifter );
 
-    // Transform back into the frequency domain (low passed spectrum/envelope)
-    // and discard the imaginary components:
-    fft.transform( pCepstrum, pImags, fft.size() );
+    // Cepstral smoothing (directly or through the FFT, sharing the cepstrum
+    // with other modules through the Engine::SpectralFeatures cache):
+    Engine::Processor::fromEngineSetup( engineSetup ).spectralEnvelope().cepstral( amplitudes, lifter, workBuffer, engineSetup );
 }
 
 //------------------------------------------------------------------------------
@@ -38,8 +38,10 @@ public: // LE::Effect required interface.
     void setup  ( IndexRange const &              , Engine::Setup const & );
     void process( Engine::MainSideChannelData_AmPh, Engine::Setup const & ) const;
 
+    static std::uint32_t scratchStorage( Engine::StorageFactors const & );
+
 private:
-    void lowPassSpectrum_cepstrum( DataRange const & spectrum, DataRange const & workBuffer, Engine::Setup const & ) const;
+    void lowPassSpectrum_cepstrum( ReadOnlyDataRange const & amplitudes, DataRange const & spectrum, DataRange const & workBuffer, Engine::Setup const & ) const;
 
 private:
     float         envgain_;
@@ -108,10 +108,10 @@ void AtonalImpl::setup( IndexRange const &, Engine::Setup const & engineSetup )
 //
 ////////////////////////////////////////////////////////////////////////////////
 
-void TonalImpl::process( Engine::ChannelData_AmPh data, Engine::Setup const & ) const
+void TonalImpl::process( ChannelState & cs, Engine::ChannelData_AmPh data, Engine::Setup const & ) const
 {
-    unsigned int const numberOfBins( data.numberOfBins() );
-    pd_.findPeaks        ( data.amps().begin(), numberOfBins );
+    auto const numberOfBins( data.numberOfBins() );
+    pd_.trackPeaks       ( data.amps().begin(), numberOfBins, cs.peaks );
     pd_.attenuateNonPeaks( data.amps().begin(), 0, numberOfBins - 1, parameters().get<Tonal::Attenuation>() );
 }
 
@@ -123,10 +123,10 @@ void TonalImpl::process( Engine::ChannelData_AmPh data, Engine::Setup const & )
 //
 ////////////////////////////////////////////////////////////////////////////////
 
-void AtonalImpl::process( Engine::ChannelData_AmPh data, Engine::Setup const & ) const
+void AtonalImpl::process( ChannelState & cs, Engine::ChannelData_AmPh data, Engine::Setup const & ) const
 {
-    unsigned int const numberOfBins( data.numberOfBins() );
-    pd_.findPeaks     ( data.amps().begin(), numberOfBins );
+    auto const numberOfBins( data.numberOfBins() );
+    pd_.trackPeaks    ( data.amps().begin(), numberOfBins, cs.peaks );
     pd_.attenuatePeaks( data.amps().begin(), 0, numberOfBins - 1, parameters().get<Atonal::Attenuation>() );
 }
 
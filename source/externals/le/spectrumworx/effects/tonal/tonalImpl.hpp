@@ -32,6 +32,16 @@ namespace Detail ///< \internal
     {
     public: // LE::Effect required interface.
 
+        ////////////////////////////////////////////////////////////////////////
+        // ChannelState
+        ////////////////////////////////////////////////////////////////////////
+
+        struct ChannelState : StaticChannelState
+        {
+            PeakDetector::Tracks peaks;
+            void reset() { peaks.reset(); }
+        };
+
         ////////////////////////////////////////////////////////////////////////
         // setup() and process()
         ////////////////////////////////////////////////////////////////////////
@@ -68,7 +78,7 @@ public: // LE::Effect required interface.
     ////////////////////////////////////////////////////////////////////////////
 
     void setup( IndexRange const &, Engine::Setup const & );
-    void process( Engine::ChannelData_AmPh, Engine::Setup const & ) const;
+    void process( ChannelState &, Engine::ChannelData_AmPh, Engine::Setup const & ) const;
 };
 
 
@@ -84,7 +94,7 @@ public: // LE::Effect required interface.
     ////////////////////////////////////////////////////////////////////////////
 
     void setup( IndexRange const &, Engine::Setup const & );
-    void process( Engine::ChannelData_AmPh, Engine::Setup const & ) const;
+    void process( ChannelState &, Engine::ChannelData_AmPh, Engine::Setup const & ) const;
 };
 
 //------------------------------------------------------------------------------
@@ -10,7 +10,9 @@
 #include "tuneWorxImpl.hpp"
 
 #include "le/spectrumworx/engine/channelDataAmPh.hpp"
+#include "le/spectrumworx/engine/processor.hpp"
 #include "le/spectrumworx/engine/setup.hpp"
+#include "le/analysis/pitch_detector/pitchCurve.hpp"
 #include "le/math/conversion.hpp"
 #include "le/math/math.hpp"
 #include "le/parameters/uiElements.hpp"
@@ -239,7 +241,8 @@ namespace Detail
         #if defined( LE_MELODIFY_SDK_BUILD )
             Detail::melodifyFixedPitch
         #else
-            PitchDetector::findPitch
+            pPitchCurve_ ? pPitchCurve_->pitch( cs.hop++ ) :
+            Engine::Processor::fromEngineSetup( engineSetup ).features().pitch
             (
                 data.full().amps(),
                 cs,
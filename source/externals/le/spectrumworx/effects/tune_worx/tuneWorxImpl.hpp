@@ -21,6 +21,8 @@
 #include "le/analysis/musical_scales/musicalScales.hpp"
 #include "le/analysis/pitch_detector/pitchDetector.hpp"
 //------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_BEGIN( LE ) class PitchCurve; LE_IMPL_NAMESPACE_END( LE )
+//------------------------------------------------------------------------------
 namespace LE
 {
 //------------------------------------------------------------------------------
@@ -49,8 +51,9 @@ namespace Detail
             PitchDetector::ChannelState,
             VibratoEffect::ChannelState
         {
-            unsigned int tuneStep      ;
-			float        lastTargetTone;
+            unsigned int  tuneStep      ;
+			float         lastTargetTone;
+            std::uint32_t hop           ; // of a followed PitchCurve
 
 			void reset()
 			{
@@ -58,25 +61,46 @@ namespace Detail
 				VibratoEffect::ChannelState::reset();
 				tuneStep       = 0;
 				lastTargetTone = 0;
+                hop            = 0;
 			}
         };
     #elif defined( LE_SW_TW_RETUNE_TEST )
         struct ChannelState : PitchDetector::ChannelState
         {
-            unsigned int tuneStep      ;
-            float        lastTargetTone;
+            unsigned int  tuneStep      ;
+            float         lastTargetTone;
+            std::uint32_t hop           ; // of a followed PitchCurve
 
 			void reset()
 			{
 				PitchDetector::ChannelState::reset();
 				tuneStep       = 0;
 				lastTargetTone = 0;
+                hop            = 0;
 			}
         };
     #else
-        typedef PitchDetector::ChannelState ChannelState;
+        struct ChannelState : PitchDetector::ChannelState
+        {
+            std::uint32_t hop; // of a followed PitchCurve
+
+            void reset()
+            {
+                PitchDetector::ChannelState::reset();
+                hop = 0;
+            }
+        };
     #endif // LE_SW_SDK_BUILD
 
+        TuneWorxBaseImpl() : pPitchCurve_( nullptr ) {}
+
+        /// Batch (offline) pitch correction: the module uses the (precomputed
+        /// and smoothed) pitch of the given curve for each hop instead of
+        /// detecting it (nullptr restores the detection). Has to be set before
+        /// the first hop after a reset, the curve has to outlive its use (see
+        /// Engine::ModuleDSP::followPitchCurve()).
+        void followPitchCurve( PitchCurve const * const pPitchCurve ) { pPitchCurve_ = pPitchCurve; }
+
     protected:
         float findNewPitchScale( Engine::ChannelData_AmPh const &, Engine::Setup const &, ChannelState & ) const;
 		float findVibratoPitch ( ChannelState & ) const;
@@ -92,6 +116,8 @@ namespace Detail
         unsigned int retuneTime_  ;
     #endif // LE_SW_SDK_BUILD
 
+        PitchCurve const * pPitchCurve_;
+
         Music::Scale userScale_;
     }; // class TuneWorxBaseImpl
 } // namespace Detail
@@ -9,6 +9,7 @@
 //------------------------------------------------------------------------------
 #include "vaxateerImpl.hpp"
 
+#include "le/spectrumworx/engine/binKernels.hpp"
 #include "le/spectrumworx/engine/channelDataAmPh.hpp"
 #include "le/spectrumworx/engine/setup.hpp"
 #include "le/math/conversion.hpp"
@@ -100,90 +101,32 @@ void VaxateerImpl::process( Engine::MainSideChannelData_AmPh data, Engine::Setup
 
     float const thr( rmsGain_ * Math::rms( pRMSSource->amps() ) );
 
-    // Setup threshold comparison sources:
-    ReadOnlyDataRange const &       mainAmps ( static_cast<Engine::ChannelData_AmPh const &>( data.main() ).amps() );
-    ReadOnlyDataRange const &       sideAmps (                                                data.side()  .amps() );
-    ReadOnlyDataRange         const threshold( &thr, &thr + 1                                                      );
-
-    ReadOnlyDataRange const * pThresholdComparisonHigherSource;
-    ReadOnlyDataRange const * pThresholdComparisonLowerSource;
-    ReadOnlyDataRange const * pAmpSideComparisonHigherSource;
-    ReadOnlyDataRange const * pAmpSideComparisonLowerSource;
-    
-    switch ( parameters().get<Mode>().getValue() )
+    // Modes M1-M4 compare the main and M5-M8 the side channel against the
+    // threshold (M3, M4, M7 and M8 test for amplitudes below the threshold)
+    // while the odd modes require the main and the even ones the side channel
+    // to be the stronger one.
+    using namespace Engine::BinKernels;
+    dispatch<8>( parameters().get<Mode>(), [ &data, thr ]( auto const mode )
     {
-        case Mode::M1:
-            pThresholdComparisonHigherSource = &mainAmps;
-            pThresholdComparisonLowerSource  = &threshold;
-            pAmpSideComparisonHigherSource   = &mainAmps;
-            pAmpSideComparisonLowerSource    = &sideAmps;
-            break;
-
-        case Mode::M2:
-            pThresholdComparisonHigherSource = &mainAmps;
-            pThresholdComparisonLowerSource  = &threshold;
-            pAmpSideComparisonHigherSource   = &sideAmps;
-            pAmpSideComparisonLowerSource    = &mainAmps;
-            break;
-
-        case Mode::M3:
-            pThresholdComparisonHigherSource = &threshold;
-            pThresholdComparisonLowerSource  = &mainAmps;
-            pAmpSideComparisonHigherSource   = &mainAmps;
-            pAmpSideComparisonLowerSource    = &sideAmps;
-            break;
-
-        case Mode::M4:
-            pThresholdComparisonHigherSource = &threshold;
-            pThresholdComparisonLowerSource  = &mainAmps;
-            pAmpSideComparisonHigherSource   = &sideAmps;
-            pAmpSideComparisonLowerSource    = &mainAmps;
-            break;
-
-        case Mode::M5:
-            pThresholdComparisonHigherSource = &sideAmps;
-            pThresholdComparisonLowerSource  = &threshold;
-            pAmpSideComparisonHigherSource   = &mainAmps;
-            pAmpSideComparisonLowerSource    = &sideAmps;
-            break;
-
-        case Mode::M6:
-            pThresholdComparisonHigherSource = &sideAmps;
-            pThresholdComparisonLowerSource  = &threshold;
-            pAmpSideComparisonHigherSource   = &sideAmps;
-            pAmpSideComparisonLowerSource    = &mainAmps;
-            break;
-
-        case Mode::M7:
-            pThresholdComparisonHigherSource = &threshold;
-            pThresholdComparisonLowerSource  = &sideAmps;
-            pAmpSideComparisonHigherSource   = &mainAmps;
-            pAmpSideComparisonLowerSource    = &sideAmps;
-            break;
-
-        case Mode::M8:
-            pThresholdComparisonHigherSource = &threshold;
-            pThresholdComparisonLowerSource  = &sideAmps;
-            pAmpSideComparisonHigherSource   = &sideAmps;
-            pAmpSideComparisonLowerSource    = &mainAmps;
-            break;
+        forEach( data, [ thr ]( auto & bin, std::uint16_t )
+        {
+            using boost::simd::is_greater;
 
-        LE_DEFAULT_CASE_UNREACHABLE();
-    }
+            auto const mainAmp  ( bin.mainAmp       );
+            auto const sideAmp  ( bin.sideAmp       );
+            auto const threshold( bin.splat( thr ) );
 
-    while ( data )
-    {
-        if
-        (
-            ( *pThresholdComparisonHigherSource->begin() > *pThresholdComparisonLowerSource->begin() ) &&
-            ( *pAmpSideComparisonHigherSource  ->begin() > *pAmpSideComparisonLowerSource  ->begin() )
-        )
-        {
-            data.main().amps().front() = data.side().amps().front();
-        }
+            bool const sideThresholdSource( mode >= Mode::M5                     );
+            bool const belowThreshold     ( ( ( mode - Mode::M1 ) / 2 ) % 2 != 0 );
+            bool const sideStronger       ( ( ( mode - Mode::M1 )     ) % 2 != 0 );
 
-        ++data;
-    }
+            auto const thresholdSource( sideThresholdSource ? sideAmp : mainAmp );
+            auto const thresholdPassed( belowThreshold ? is_greater( threshold, thresholdSource ) : is_greater( thresholdSource, threshold ) );
+            auto const strongerPassed ( sideStronger   ? is_greater( sideAmp  , mainAmp         ) : is_greater( mainAmp        , sideAmp   ) );
+
+            bin.mainAmp = boost::simd::if_else( boost::simd::logical_and( thresholdPassed, strongerPassed ), sideAmp, mainAmp );
+        });
+    });
 }
 
 //------------------------------------------------------------------------------
@@ -47,7 +47,7 @@ namespace Effects
 
 struct Vocoder
 {
-    LE_ENUMERATED_PARAMETER( FilterMethod, ( CepstrumUdoBrick )( CepstrumBrick )( CepstrumHamming )( MovingAverage )( Envelope )( MelEnvelope )( Passthrough ) );
+    LE_ENUMERATED_PARAMETER( FilterMethod, ( CepstrumUdoBrick )( CepstrumBrick )( CepstrumHamming )( MovingAverage )( Envelope )( MelEnvelope )( Passthrough )( LPC ) );
 
     LE_DEFINE_PARAMETERS
     (
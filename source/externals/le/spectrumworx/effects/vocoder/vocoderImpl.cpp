@@ -70,8 +70,6 @@
 
 #include "boost/range/adaptor/reversed.hpp"
 
-#include "boost/simd/preprocessor/stack_buffer.hpp"
-
 #include "boost/assert.hpp"
 #include "boost/concept_check.hpp"
 //------------------------------------------------------------------------------
@@ -115,6 +113,7 @@ EFFECT_ENUMERATED_PARAMETER_STRINGS
     (( Envelope        , "Envelope"               ))
     (( MelEnvelope     , "Mel envelope"           ))
     (( Passthrough     , "Passthrough"            ))
+    (( LPC             , "LPC"                    ))
 )
 
 
@@ -130,6 +129,7 @@ void VocoderImpl::setup( IndexRange const & workingRange, Engine::Setup const &
     std::uint32_t envelopeBorder( parameters().get<EnvelopeBorder>() );
 
     filterLength_ = 0;
+    lpcOrder_     = 0;
     switch ( filterMethod() )
     {
         case FilterMethod::MovingAverage:
@@ -150,6 +150,34 @@ void VocoderImpl::setup( IndexRange const & workingRange, Engine::Setup const &
     }
 
     cutoff_ = engineSetup.frequencyInHzToBin( envelopeBorder );
+
+    if ( filterMethod() == FilterMethod::LPC )
+    {
+        // An all-pole model of an order equal to the number of retained
+        // cepstral coefficients gives an envelope of similar detail.
+        std::uint16_t const maximumOrder( std::min<std::uint16_t>( Engine::SpectralEnvelope::maximumLPCOrder, engineSetup.numberOfBins() - 1 ) );
+        lpcOrder_ = static_cast<std::uint8_t>( std::max<std::uint16_t>( 2, std::min( cutoff_, maximumOrder ) ) );
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// VocoderImpl::scratchStorage()
+// -----------------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+
+LE_COLD
+std::uint32_t VocoderImpl::scratchStorage( Engine::StorageFactors const & factors )
+{
+    // The largest of the filter methods' requirements (the cepstrum methods'
+    // work buffer and lifter):
+    using Engine::ScratchArena;
+    std::uint16_t const numberOfBins( factors.fftSize / 2 + 1 );
+    return
+        ScratchArena::requiredStorage<Engine::real_t>( Math::alignIndex( numberOfBins ) * 2 ) +
+        ScratchArena::requiredStorage<Engine::real_t>( numberOfBins + 2                     );
 }
 
 
@@ -282,10 +310,12 @@ void VocoderImpl::process( Engine::MainSideChannelData_AmPh data, Engine::Setup
     Matlab::Engine::singleton().setVariable( "amps", envelope );
 #endif // LE_UTILITY_MATLAB_INTEROP
 
+    Engine::ScratchArena::Scope scratch( Engine::Processor::fromEngineSetup( setup ).scratch() );
+
     if ( filterMethod() == FilterMethod::MovingAverage )
     {
         //...mrmlj...probably still broken 'reduced range' operation...
-        BOOST_SIMD_ALIGNED_SCOPED_STACK_BUFFER( workBuffer, Engine::real_t, fullNumberOfBins );
+        DataRange const workBuffer( scratch.allocate<Engine::real_t>( fullNumberOfBins ) );
         lowPassSpectrum_movingAverage( envelope, workBuffer, setup );
     #ifndef NDEBUG //...mrmlj...?...clear out negative values to avoid assertion failures.
         for ( auto & amp : envelope ) { amp = std::max( 0.0f, amp ); }
@@ -318,20 +348,25 @@ void VocoderImpl::process( Engine::MainSideChannelData_AmPh data, Engine::Setup
     {
     }
     else
+    if ( filterMethod() == FilterMethod::LPC )
+    {
+        DataRange const fullEnvelope( scratch.allocate<Engine::real_t>( fullNumberOfBins ) );
+        Engine::Processor::fromEngineSetup( setup ).spectralEnvelope().lpc( data.full().main().amps(), lpcOrder_, fullEnvelope );
+        envelope = DataRange( &fullEnvelope[ skippedLeadingBins ], &fullEnvelope[ fullNumberOfBins - skippedTrailingBins ] );
+    }
+    else
     {
         // Allocate a work buffer for envelope calculation that can hold a whole
         // time domain frame (i.e. the size of the FFT but allocate it as "two
         // aligned half-FFT size" buffers so that it can be used for both time
         // domain and ReIm intermediate results):
-        BOOST_SIMD_ALIGNED_STACK_BUFFER( doubleWorkBuffer, Engine::real_t, ( alignIndex( fullNumberOfBins ) * 2 ) );
+        DataRange const doubleWorkBuffer( scratch.allocate<Engine::real_t>( alignIndex( fullNumberOfBins ) * 2 ) );
         envelope = DataRange( &doubleWorkBuffer[ 0 ], &doubleWorkBuffer[ fullNumberOfBins ] );
 
         // Cepstrum-based envelope calculation needs its work buffer to be the
         // whole frame size and to thus alias the envelope buffer (for inplace
         // DFT calculation).
-        add( data.full().main().amps(), std::numeric_limits<float>::epsilon(), envelope );
-        ln ( envelope );
-        lowPassSpectrum_cepstrum( envelope, doubleWorkBuffer, setup );
+        lowPassSpectrum_cepstrum( data.full().main().amps(), envelope, doubleWorkBuffer, setup );
         envelope.advance_begin( + skippedLeadingBins  );
         envelope.advance_end  ( - skippedTrailingBins );
         exp( envelope );
@@ -363,6 +398,7 @@ void VocoderImpl::process( Engine::MainSideChannelData_AmPh data, Engine::Setup
         ///                                   (23.10.2015.) (Domagoj Saric)
         // http://www.dsprelated.com/showthread/comp.dsp/102908-1.php
         auto & carrierData( const_cast<Engine::ChannelData_AmPh &>( data.side() ) ); //...mrmlj...
+        Engine::Processor::fromEngineSetup( setup ).features().sideChannelModified();
 
         float const noiseLevel( std::sqrt( Math::percentage2NormalisedLinear( parameters().get<NoiseIntensity>() ) ) );
 
@@ -423,9 +459,10 @@ void VocoderImpl::process( Engine::MainSideChannelData_AmPh data, Engine::Setup
 
 void LE_HOT VocoderImpl::lowPassSpectrum_cepstrum
 (
-    DataRange     const & spectrum,
-    DataRange     const & workBuffer,
-    Engine::Setup const & engineSetup
+    ReadOnlyDataRange const & amplitudes,
+    DataRange         const & spectrum,
+    DataRange         const & workBuffer,
+    Engine::Setup     const & engineSetup
 ) const
 {
     using namespace Math;
@@ -457,21 +494,10 @@ void LE_HOT VocoderImpl::lowPassSpectrum_cepstrum
     BOOST_ASSERT( spectrum.begin() == workBuffer.begin() );
     BOOST_ASSERT( spectrum.end  () <  workBuffer.end  () );
 
-    float * LE_RESTRICT const pReals( spectrum.begin()                                );
-    float * LE_RESTRICT const pImags( static_cast<float *>( align( spectrum.end() ) ) );
-    // Dummy/null imaginary components (the spectrum is real):
-    clear( pImags, engineSetup.numberOfBins() );
-
-    // Transform into the quefrency domain (the cepstrum):
-    FFT_float_real_1D const & fft( Engine::Processor::fromEngineSetup( engineSetup ).fft() );
-    fft.inverseTransform( pReals, pImags, fft.size() );
-
-    // Inplace FFT: pReals now points to/contains the real cepstrum:
-    float * const pCepstrum( pReals );
+    Engine::Processor const & processor( Engine::Processor::fromEngineSetup( engineSetup ) );
 
     // "Low pass" the spectrum:
-    auto const cutoff      ( cutoff_                 );
-    auto const cutoffMirror( fft.size() - cutoff + 1 );
+    auto const cutoff( cutoff_ );
 
     switch ( filterMethod() )
     {
@@ -482,49 +508,62 @@ void LE_HOT VocoderImpl::lowPassSpectrum_cepstrum
             /// currently skipped as a quick-fix.
             ///                               (07.11.2013.) (Domagoj Saric)
             float const udoGain( 1 /*2*/ );
-            if ( cutoff > 2 )
-            {
-                multiply( &pCepstrum[ 1 ], udoGain, cutoff - 2 );
-                // an attempt to make the LP less of a brick...
-                pCepstrum[ 0          ] *= 0.50f * udoGain;
-                pCepstrum[ cutoff - 1 ] *= 0.75f * udoGain;
-            }
-                pCepstrum[ cutoff     ] *= 0.50f * udoGain;
-                pCepstrum[ cutoff + 1 ] *= 0.25f * udoGain;
-            clear( &pCepstrum[ cutoff + 2 ], workBuffer.end() );
+            Engine::ScratchArena::Scope scratch( processor.scratch() );
+            DataRange const lifter( scratch.allocate<Engine::real_t>( cutoff + 2 ) );
+            Engine::SpectralEnvelope::udoBrickLifter( cutoff, udoGain, lifter );
+            processor.spectralEnvelope().cepstral( amplitudes, lifter, workBuffer, engineSetup );
             break;
         }
 
         case FilterMethod::CepstrumBrick:
+        {
+            // The real cepstrum of the log spectrum (the quefrency domain,
+            // shared with other modules through the Engine::SpectralFeatures
+            // cache). This lifter is not symmetric around the actual mirror
+            // quefrencies so it cannot be reduced to a one sided lifter for
+            // the Engine::SpectralEnvelope.
+            processor.features().cepstrum( amplitudes, workBuffer, engineSetup );
+
+            float * LE_RESTRICT const pCepstrum( spectrum.begin()                                );
+            float * LE_RESTRICT const pImags   ( static_cast<float *>( align( spectrum.end() ) ) );
+
+            FFT_float_real_1D const & fft( processor.fft() );
+            auto const cutoffMirror( fft.size() - cutoff + 1 );
+
             clear( &pCepstrum[ cutoff + 2 ], &pCepstrum[ cutoffMirror - 2 ] );
             // an attempt to make the LP less of a brick...
             pCepstrum[ cutoff - 1 ] = pCepstrum[ cutoffMirror + 1 ] = pCepstrum[ cutoff - 1 ] * 0.75f;
             pCepstrum[ cutoff     ] = pCepstrum[ cutoffMirror     ] = pCepstrum[ cutoff     ] * 0.50f;
             pCepstrum[ cutoff + 1 ] = pCepstrum[ cutoffMirror - 1 ] = pCepstrum[ cutoff + 1 ] * 0.25f;
+
+            // Transform back into the frequency domain (low passed spectrum/
+            // envelope) and discard the imaginary components:
+            fft.transform( pCepstrum, pImags, fft.size() );
             break;
+        }
 
         case FilterMethod::CepstrumHamming:
         {
+            // Symmetric lifter: the mirrored quefrencies are accounted for by
+            // doubling the one sided weights.
+            Engine::ScratchArena::Scope scratch( processor.scratch() );
+            DataRange const lifter( scratch.allocate<Engine::real_t>( std::max<std::uint16_t>( cutoff, 1 ) ) );
+            lifter[ 0 ] = 1;
             float const dw( Math::Constants::pi / Math::convert<float>( cutoff ) );
             float        w( cutoff * dw );
             for ( std::uint16_t bin( 1 ); bin < cutoff; ++bin )
             {
                 float const window( static_cast<float>( 0.54 - 0.46 * std::cos( w ) ) );
-                pCepstrum[ bin              ] *= window;
-                pCepstrum[ fft.size() - bin ] *= window;
+                lifter[ bin ] = 2 * window;
                 w += dw;
             }
-            clear( &pCepstrum[ cutoff ], &pCepstrum[ cutoffMirror ] );
+            processor.spectralEnvelope().cepstral( amplitudes, lifter, workBuffer, engineSetup );
             break;
         }
 
         LE_DEFAULT_CASE_UNREACHABLE();
     }
 
-    // Transform back into the frequency domain (low passed spectrum/envelope)
-    // and discard the imaginary components:
-    fft.transform( pCepstrum, pImags, fft.size() );
-
     //...mrmlj...testing what to do about imaginary components...
     //BOOST_ASSERT_MSG( Math::max( pImags, engineSetup.numberOfBins() ) < std::numeric_limits<float>::epsilon() * 10, "Power spectrum not real." );
     //for ( std::uint16_t bin( 0 ); bin < engineSetup.numberOfBins(); ++bin )
@@ -38,15 +38,18 @@ public: // LE::Effect required interface.
     void setup  ( IndexRange const &              , Engine::Setup const & )      ;
     void process( Engine::MainSideChannelData_AmPh, Engine::Setup const & ) const;
 
+    static std::uint32_t scratchStorage( Engine::StorageFactors const & );
+
 private:
-    void lowPassSpectrum_cepstrum     ( DataRange const & spectrum, DataRange const & workBuffer, Engine::Setup const & ) const;
-    void lowPassSpectrum_movingAverage( DataRange const & spectrum, DataRange const & workBuffer, Engine::Setup const & ) const;
+    void lowPassSpectrum_cepstrum     ( ReadOnlyDataRange const & amplitudes, DataRange const & spectrum, DataRange const & workBuffer, Engine::Setup const & ) const;
+    void lowPassSpectrum_movingAverage(                                       DataRange const & spectrum, DataRange const & workBuffer, Engine::Setup const & ) const;
 
     FilterMethod::value_type filterMethod() const { return parameters().get<FilterMethod>(); }
 
 private:
     std::uint16_t cutoff_;
     std::uint16_t filterLength_; // moving average specific
+    std::uint8_t  lpcOrder_    ; // LPC specific
 }; // class VocoderImpl
 
 //------------------------------------------------------------------------------
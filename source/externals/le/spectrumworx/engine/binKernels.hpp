@@ -0,0 +1,240 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file binKernels.hpp
+/// --------------------
+///
+/// Elementwise (per-bin) kernel helpers for frequency domain effects.
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef binKernels_hpp__8C4F1D27_63A0_4B9E_A5E2_0F7B19D3C846
+#define binKernels_hpp__8C4F1D27_63A0_4B9E_A5E2_0F7B19D3C846
+#pragma once
+//------------------------------------------------------------------------------
+#include "channelDataAmPh.hpp"
+
+#include "le/utility/intrinsics.hpp"
+#include "le/utility/platformSpecifics.hpp"
+
+#include "boost/simd/arithmetic/include/functions/max.hpp"
+#include "boost/simd/boolean/include/functions/if_else.hpp"
+#include "boost/simd/include/functions/aligned_load.hpp"
+#include "boost/simd/include/functions/load.hpp"
+#include "boost/simd/include/functions/store.hpp"
+#include "boost/simd/memory/include/functions/splat.hpp"
+#include "boost/simd/operator/include/functions/divides.hpp"
+#include "boost/simd/operator/include/functions/is_greater.hpp"
+#include "boost/simd/operator/include/functions/is_greater_equal.hpp"
+#include "boost/simd/operator/include/functions/is_less.hpp"
+#include "boost/simd/operator/include/functions/logical_and.hpp"
+#include "boost/simd/operator/include/functions/minus.hpp"
+#include "boost/simd/operator/include/functions/multiplies.hpp"
+#include "boost/simd/operator/include/functions/plus.hpp"
+#include "boost/simd/predicates/include/functions/is_nez.hpp"
+#include "boost/simd/reduction/include/functions/sum.hpp"
+#include "boost/simd/sdk/simd/extensions.hpp"
+#include "boost/simd/sdk/simd/logical.hpp"
+#include "boost/simd/sdk/simd/native.hpp"
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_BEGIN( Engine )
+//------------------------------------------------------------------------------
+namespace BinKernels
+{
+//------------------------------------------------------------------------------
+
+/// One SIMD register of floats (the NT2 default extension for the target).
+using Pack = boost::simd::native<float, BOOST_SIMD_DEFAULT_EXTENSION>;
+
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \struct Bin
+///
+/// \brief The main and side channel amplitudes and phases of a single bin
+/// (Value = float) or of Pack::static_size consecutive bins (Value = Pack).
+///
+///   Kernels are generic over the Value type and have to be written in
+/// "select form" (i.e. computing the new values for all bins and choosing
+/// with boost::simd::if_else() instead of conditionally storing) with the
+/// boost::simd functions (that are overloaded for both scalars and packs).
+///
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename Value>
+struct Bin
+{
+    using value_type = Value;
+
+    static Value splat( float const scalar ) { return boost::simd::splat<Value>( scalar ); }
+
+    Value       mainAmp  ;
+    Value       mainPhase;
+    Value const sideAmp  ;
+    Value const sidePhase;
+}; // struct Bin
+
+
+namespace Detail
+{
+    template <class Kernel>
+    LE_FORCEINLINE LE_HOT
+    void forEach( MainSideChannelData_AmPh & data, std::uint16_t const beginBin, std::uint16_t const endBin, Kernel const & kernel )
+    {
+        using boost::simd::load ;
+        using boost::simd::store;
+
+        float       * LE_RESTRICT const pMainAmps  ( data.main().amps  ().begin() );
+        float       * LE_RESTRICT const pMainPhases( data.main().phases().begin() );
+        float const * LE_RESTRICT const pSideAmps  ( data.side().amps  ().begin() );
+        float const * LE_RESTRICT const pSidePhases( data.side().phases().begin() );
+
+        LE_ASSUME( beginBin <= endBin );
+        std::uint16_t const packedEnd( endBin - ( ( endBin - beginBin ) % Pack::static_size ) );
+
+        // The working range starts at an arbitrary bin so unaligned loads and
+        // stores are used.
+        std::uint16_t k( beginBin );
+        for ( ; k < packedEnd; k += Pack::static_size )
+        {
+            Bin<Pack> bin =
+            {
+                load<Pack>( pMainAmps  , k ),
+                load<Pack>( pMainPhases, k ),
+                load<Pack>( pSideAmps  , k ),
+                load<Pack>( pSidePhases, k )
+            };
+            kernel( bin, k );
+            store( bin.mainAmp  , pMainAmps  , k );
+            store( bin.mainPhase, pMainPhases, k );
+        }
+        for ( ; k < endBin; ++k )
+        {
+            Bin<float> bin = { pMainAmps[ k ], pMainPhases[ k ], pSideAmps[ k ], pSidePhases[ k ] };
+            kernel( bin, k );
+            pMainAmps  [ k ] = bin.mainAmp  ;
+            pMainPhases[ k ] = bin.mainPhase;
+        }
+    }
+
+    inline bool flags( bool const * LE_RESTRICT const pFlags, std::uint16_t const k, float ) { return pFlags[ k ]; }
+
+    inline boost::simd::native<boost::simd::logical<float>, BOOST_SIMD_DEFAULT_EXTENSION>
+    flags( bool const * LE_RESTRICT const pFlags, std::uint16_t const k, Pack )
+    {
+        LE_ALIGN( BOOST_SIMD_CONFIG_ALIGNMENT ) float values[ Pack::static_size ];
+        for ( std::uint8_t lane( 0 ); lane < Pack::static_size; ++lane )
+            values[ lane ] = pFlags[ k + lane ];
+        return boost::simd::is_nez( boost::simd::aligned_load<Pack>( &values[ 0 ] ) );
+    }
+} // namespace Detail
+
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \fn forEach()
+///
+/// \brief Invokes kernel( bin, k ) for every group of Pack::static_size bins
+/// of the working range (or of the [beginBin, endBin) subrange of it) followed
+/// by single bins for the tail, k being the index of the first bin in the
+/// group.
+///
+///   Modes and other per-call options that change the computation should be
+/// made compile time constants with dispatch() so that they do not end up
+/// inside the loop.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+template <class Kernel>
+LE_FORCEINLINE LE_HOT
+void forEach( MainSideChannelData_AmPh & data, Kernel const & kernel )
+{
+    Detail::forEach( data, 0, data.numberOfBins(), kernel );
+}
+
+template <class Kernel>
+LE_FORCEINLINE LE_HOT
+void forEach( MainSideChannelData_AmPh & data, std::uint16_t const beginBin, std::uint16_t const endBin, Kernel const & kernel )
+{
+    Detail::forEach( data, beginBin, endBin, kernel );
+}
+
+
+/// Returns the per-bin flags (e.g. a HalfFFTBuffer<bool>) of the bins of a
+/// Bin (starting at bin k) as an if_else() condition.
+template <typename Value>
+LE_FORCEINLINE
+auto flags( bool const * LE_RESTRICT const pFlags, std::uint16_t const k, Bin<Value> const & )
+{
+    return Detail::flags( pFlags, k, Value() );
+}
+
+
+/// Returns the sum of values in the [beginBin, endBin) range.
+LE_FORCEINLINE LE_HOT
+float sum( float const * LE_RESTRICT const pValues, std::uint16_t const beginBin, std::uint16_t const endBin )
+{
+    LE_ASSUME( beginBin <= endBin );
+    std::uint16_t const packedEnd( endBin - ( ( endBin - beginBin ) % Pack::static_size ) );
+
+    Pack packedSum( boost::simd::splat<Pack>( 0.0f ) );
+    std::uint16_t k( beginBin );
+    for ( ; k < packedEnd; k += Pack::static_size )
+        packedSum = packedSum + boost::simd::load<Pack>( pValues, k );
+    float result( boost::simd::sum( packedSum ) );
+    for ( ; k < endBin; ++k )
+        result += pValues[ k ];
+    return result;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \fn dispatch()
+///
+/// \brief Invokes functor( std::integral_constant<std::uint8_t, value>() ) for
+/// the given runtime value in the [0, numberOfValues) range (e.g. an
+/// enumerated parameter's value or a bool).
+///
+////////////////////////////////////////////////////////////////////////////////
+
+namespace Detail
+{
+    template <class Functor, std::uint8_t... values>
+    LE_FORCEINLINE
+    void dispatch( std::uint8_t const value, Functor && functor, std::integer_sequence<std::uint8_t, values...> )
+    {
+        bool const dispatched[] = { ( ( value == values ) && ( functor( std::integral_constant<std::uint8_t, values>() ), true ) )... };
+        static_cast<void>( dispatched );
+    }
+} // namespace Detail
+
+template <std::uint8_t numberOfValues, class Functor>
+LE_FORCEINLINE
+void dispatch( std::uint8_t const value, Functor && functor )
+{
+    LE_ASSUME( value < numberOfValues );
+    Detail::dispatch( value, std::forward<Functor>( functor ), std::make_integer_sequence<std::uint8_t, numberOfValues>() );
+}
+
+//------------------------------------------------------------------------------
+} // namespace BinKernels
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_END( Engine )
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // binKernels_hpp
@@ -66,6 +66,7 @@ struct StorageFactors
 #endif // LE_SW_ENGINE_WINDOW_PRESUM
     std::uint8_t  /*const*/ overlapFactor   ;
     std::uint8_t  /*const*/ numberOfChannels;
+    std::uint8_t  /*const*/ resolutionLayers; // see ResolutionLayers
     std::uint32_t /*const*/ samplerate      ;
 
     bool complete() const
@@ -77,10 +78,27 @@ struct StorageFactors
         #endif // LE_SW_ENGINE_WINDOW_PRESUM
             overlapFactor    &&
             numberOfChannels &&
+            resolutionLayers &&
             samplerate;
     }
 
-    bool operator==( StorageFactors const & other ) const { return std::memcmp( this, &other, sizeof( *this ) ) == 0; }
+    /// Channel (state) instances required for all the resolution layers.
+    std::uint8_t numberOfLayerChannels() const { return static_cast<std::uint8_t>( numberOfChannels * resolutionLayers ); }
+
+    /// \note Compared member by member as the structure now has padding (which
+    /// is not necessarily cleared by aggregate initialisation).
+    bool operator==( StorageFactors const & other ) const
+    {
+        return
+            ( fftSize          == other.fftSize          ) &&
+        #if LE_SW_ENGINE_WINDOW_PRESUM
+            ( windowSizeFactor == other.windowSizeFactor ) &&
+        #endif // LE_SW_ENGINE_WINDOW_PRESUM
+            ( overlapFactor    == other.overlapFactor    ) &&
+            ( numberOfChannels == other.numberOfChannels ) &&
+            ( resolutionLayers == other.resolutionLayers ) &&
+            ( samplerate       == other.samplerate       );
+    }
 }; // struct StorageFactors
 
 #pragma warning( pop )
@@ -72,12 +72,23 @@ namespace
         float         const * LE_RESTRICT &       pInputData,
         DataRange     const               &       outputBuffer,
         std::uint16_t                       const outputBufferPosition,
-        std::uint16_t                       const sizeToCopy
+        std::uint16_t                       const sizeToCopy,
+        std::uint8_t                        const stride
     )
     {
         BOOST_ASSERT_MSG( unsigned( outputBuffer.size() ) >= unsigned( outputBufferPosition + sizeToCopy ), "Buffer overflow." );
-        Math::copy( pInputData, outputBuffer.begin() + outputBufferPosition, sizeToCopy );
-        pInputData += sizeToCopy;
+        if ( stride == 1 )
+        {
+            Math::copy( pInputData, outputBuffer.begin() + outputBufferPosition, sizeToCopy );
+        }
+        else
+        {
+            // Interleaved input: deinterleave straight into the FIFO.
+            float * LE_RESTRICT const pOutput( outputBuffer.begin() + outputBufferPosition );
+            for ( std::uint16_t sample( 0 ); sample < sizeToCopy; ++sample )
+                pOutput[ sample ] = pInputData[ sample * stride ];
+        }
+        pInputData += sizeToCopy * stride;
     }
 } // anonymous namespace
 
@@ -86,13 +97,14 @@ void ChannelBuffers::addNewData
     float const * LE_RESTRICT &       pNewMainChannelData,
     float const * LE_RESTRICT &       pNewSideChannelData,
     std::uint16_t               const sizeToCopy,
+    std::uint8_t                const stride,
     bool                        const useSideChannel
 )
 {
     BOOST_ASSERT_MSG( unsigned( inputOLAPosition_ + sizeToCopy ) <= mainOLA_.size(), "Buffer size mismatch." );
 
-                          addNewDataWorker( pNewMainChannelData, mainOLA_, inputOLAPosition_, sizeToCopy );
-    if ( useSideChannel ) addNewDataWorker( pNewSideChannelData, sideOLA_, inputOLAPosition_, sizeToCopy );
+                          addNewDataWorker( pNewMainChannelData, mainOLA_, inputOLAPosition_, sizeToCopy, stride );
+    if ( useSideChannel ) addNewDataWorker( pNewSideChannelData, sideOLA_, inputOLAPosition_, sizeToCopy, stride );
 
     inputOLAPosition_ += sizeToCopy;
 }
@@ -100,7 +112,7 @@ void ChannelBuffers::addNewData
 
 void ChannelBuffers::setCurrentDataToChannelData
 (
-    bool                            const useSideChannel,
+    HopRequirements         const &       hopRequirements,
     Math::FFT_float_real_1D const &       fft,
     ReadOnlyDataRange       const &       window,
     std::uint8_t                    const windowSizeFactor
@@ -109,8 +121,9 @@ void ChannelBuffers::setCurrentDataToChannelData
     BOOST_ASSERT_MSG( inputDataSize() == unsigned( window.size() ), "Buffer size mismatch." );
     channelData_.setNewTimeDomainData
     (
-                         mainOLA_.begin(),
-        useSideChannel ? sideOLA_.begin() : 0,
+                                               mainOLA_.begin(),
+        ( hopRequirements.sideChannelDemand != NoSideChannel ) ? sideOLA_.begin() : 0,
+        hopRequirements,
         fft,
         window,
         windowSizeFactor
@@ -233,18 +246,29 @@ void ChannelBuffers::extractChunkOfReadyOutputData
 (
     float         * LE_RESTRICT const pTargetBuffer,
     std::uint16_t               const chunkSize,
+    std::uint8_t                const targetStride,
     std::uint16_t               const incompleteOutputOLASamples
 )
 {
     BOOST_ASSERT_MSG( chunkSize <= readyOutputDataSize(), "Insufficient data." );
 
-    // copy the results to the output location.
-    Math::copy
-    (
-        outputOLA_.begin(),
-        pTargetBuffer,
-        chunkSize
-    );
+    // copy the results to the output location (interleaving them straight
+    // into the target for strided output).
+    if ( targetStride == 1 )
+    {
+        Math::copy
+        (
+            outputOLA_.begin(),
+            pTargetBuffer,
+            chunkSize
+        );
+    }
+    else
+    {
+        float const * LE_RESTRICT const pReadyOutput( outputOLA_.begin() );
+        for ( std::uint16_t sample( 0 ); sample < chunkSize; ++sample )
+            pTargetBuffer[ sample * targetStride ] = pReadyOutput[ sample ];
+    }
 
     // Remove the above saved output chunk from the output FIFO buffer by
     // shifting its contents to the left.
@@ -37,12 +37,13 @@ public:
         float const * LE_RESTRICT & pNewMainChannelData,
         float const * LE_RESTRICT & pNewSideChannelData,
         std::uint16_t               sizeToCopy,
+        std::uint8_t                stride, ///< of the new (main and side channel) data
         bool                        useSideChannel
     );
 
     void setCurrentDataToChannelData
     (
-        bool                            useSideChannel,
+        HopRequirements         const & hopRequirements,
         Math::FFT_float_real_1D const & fft,
         ReadOnlyDataRange       const & window,
         std::uint8_t                    windowSizeFactor
@@ -61,6 +62,7 @@ public:
     (
         float         * pTargetBuffer,
         std::uint16_t   chunkSize,
+        std::uint8_t    targetStride,
         std::uint16_t   incompleteOutputOLASamples
     );
 
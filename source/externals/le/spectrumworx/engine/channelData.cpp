@@ -9,7 +9,7 @@
 //------------------------------------------------------------------------------
 #include "channelData.hpp"
 
-#ifndef NDEBUG
+#if !defined( NDEBUG ) || !defined( LE_NO_BINARY_TRACE )
     #include "le/math/math.hpp"
 #else //...mrmlj...
     #ifndef LE_LOCALLY_DISABLE_FPU_EXCEPTIONS
@@ -18,7 +18,7 @@
     #ifndef LE_MATH_VERIFY_VALUES
         #define LE_MATH_VERIFY_VALUES( fpClasses, range, valueName )
     #endif // LE_MATH_VERIFY_VALUES
-#endif // NDEBUG
+#endif // NDEBUG || !LE_NO_BINARY_TRACE
 #include "le/math/conversion.hpp"
 #include "le/math/dft/domainConversion.hpp"
 #include "le/math/dft/fft.hpp"
@@ -38,24 +38,34 @@ LE_IMPL_NAMESPACE_BEGIN( Engine )
 
 ChannelData::ChannelData()
     :
-    amphDataFreshness_( 0 ),
-    dftDataFreshness_ ( 0 )
+    amphDataFreshness_ ( 0                    ),
+    dftDataFreshness_  ( 0                    ),
+    contentGeneration_ ( 0                    ),
+    contentModified_   ( false                ),
+    conversionAccuracy_( Math::FullConversion ),
+    pHomeFrame_        ( nullptr              )
 {
 }
 
 
 void ChannelData::setNewTimeDomainData
 (
-    float                   const * const mainChannel,
-    float                   const * const sideChannel,
-    Math::FFT_float_real_1D const &       fft        ,
-    ReadOnlyDataRange       const &       window     ,
+    float                   const * const mainChannel      ,
+    float                   const * const sideChannel      ,
+    HopRequirements         const &       hopRequirements  ,
+    Math::FFT_float_real_1D const &       fft              ,
+    ReadOnlyDataRange       const &       window           ,
     std::uint8_t                    const windowSizeFactor
 )
 {
-    amphDataFreshness_ = 0;
-    dftDataFreshness_  = 0;
+    amphDataFreshness_  = 0;
+    dftDataFreshness_   = 0;
+    contentGeneration_  = 0;
+    contentModified_    = false;
+    conversionAccuracy_ = hopRequirements.conversionAccuracy;
+    features_.invalidate();
     BOOST_ASSERT( fftSize() == fft.size() );
+    BOOST_ASSERT_MSG( currentAmPhData().amps().begin() == pHomeFrame_, "Lent frame not returned." );
 
     dftAndTimeData_.setToDFTDomain();
     time2DFT
@@ -70,6 +80,8 @@ void ChannelData::setNewTimeDomainData
 
     if ( sideChannel )
     {
+        BOOST_ASSERT_MSG( hopRequirements.sideChannelDemand != NoSideChannel, "Side channel data not requested." );
+
         time2DFT
         (
             sideChannel,
@@ -79,11 +91,15 @@ void ChannelData::setNewTimeDomainData
             windowSizeFactor
         );
 
-        dft2AmPh
-        (
-            dftData ().mutableSide(),
-            amphData().mutableSide()
-        );
+        if ( hopRequirements.sideChannelDemand == SideChannelAmPh )
+        {
+            dft2AmPh
+            (
+                dftData ().mutableSide(),
+                amphData().mutableSide(),
+                conversionAccuracy_
+            );
+        }
     }
 #if 0 //...mrmlj...synth...
     else
@@ -126,6 +142,7 @@ void ChannelData::clearSideChannelData()
     dftAndTimeData_.setToDFTDomain();
     Math::clear( amphData().mutableSide().jointView() );
     Math::clear( dftData ().mutableSide().jointView() );
+    features_.sideChannelModified();
 }
 
 
@@ -175,8 +192,9 @@ void ChannelData::time2DFT
 
 void ChannelData::dft2AmPh
 (
-    FullChannelData_ReIm const & reImData,
-    FullChannelData_AmPh       & amPhData
+    FullChannelData_ReIm     const & reImData,
+    FullChannelData_AmPh           & amPhData,
+    Math::ConversionAccuracy const   accuracy
 )
 {
     using namespace Math;
@@ -190,7 +208,8 @@ void ChannelData::dft2AmPh
         reImData.imags ().begin(),
         amPhData.amps  ().begin(),
         amPhData.phases().begin(),
-        amPhData.numberOfBins()
+        amPhData.numberOfBins(),
+        accuracy
     );
 
     LE_MATH_VERIFY_VALUES( InvalidOrSlow | Negative, amPhData.amps  (), "amplitudes" );
@@ -207,8 +226,9 @@ void ChannelData::dft2AmPh
 
 void ChannelData::amph2DFT
 (
-    FullChannelData_AmPh const & amPhData,
-    FullChannelData_ReIm       & reImData
+    FullChannelData_AmPh     const & amPhData,
+    FullChannelData_ReIm           & reImData,
+    Math::ConversionAccuracy const   accuracy
 )
 {
     using namespace Math;
@@ -222,7 +242,8 @@ void ChannelData::amph2DFT
         amPhData.phases().begin(),
         reImData.reals ().begin(),
         reImData.imags ().begin(),
-        amPhData.numberOfBins()
+        amPhData.numberOfBins(),
+        accuracy
     );
 
     LE_MATH_VERIFY_VALUES( InvalidOrSlow, reImData.reals(), "reals" );
@@ -241,7 +262,8 @@ void ChannelData::updateAmPhData()
         dft2AmPh
         (
             dftData ().main(),
-            amphData().main()
+            amphData().main(),
+            conversionAccuracy_
         );
         amphDataFreshness_ = dftDataFreshness_;
     }
@@ -268,7 +290,8 @@ void ChannelData::updateReImData()
         amph2DFT
         (
             amphData().main(),
-            dftData ().main()
+            dftData ().main(),
+            conversionAccuracy_
         );
         dftDataFreshness_ = amphDataFreshness_;
     }
@@ -281,8 +304,16 @@ void ChannelData::saveCurrentReImDataForBlending()
 }
 
 
+void ChannelData::advanceContentGeneration()
+{
+    contentGeneration_ += contentModified_;
+    contentModified_    = false;
+}
+
+
 FullMainSideChannelData_AmPh & ChannelData::freshAmPhData( bool const saveForDryWetBlending )
 {
+    advanceContentGeneration();
     updateAmPhData();
     if ( saveForDryWetBlending )
     {
@@ -295,6 +326,7 @@ FullMainSideChannelData_AmPh & ChannelData::freshAmPhData( bool const saveForDry
 
 FullMainSideChannelData_ReIm & ChannelData::freshReImData( bool const saveForDryWetBlending )
 {
+    advanceContentGeneration();
     updateReImData();
     if ( saveForDryWetBlending )
     {
@@ -307,6 +339,7 @@ FullMainSideChannelData_ReIm & ChannelData::freshReImData( bool const saveForDry
 
 ChannelData::AmPhReImData ChannelData::freshAmPh2ReImData( bool /*saveForDryWetBlending...see the amPh2ReIm blend quick fix in ModuleDSP::process*/ )
 {
+    advanceContentGeneration();
     updateAmPhData();
     dftDataFreshness_ = amphDataFreshness_ + 1;
     return AmPhReImData( amphData(), dftData() );
@@ -315,14 +348,41 @@ ChannelData::AmPhReImData ChannelData::freshAmPh2ReImData( bool /*saveForDryWetB
 
 ChannelData::AmPhReImData ChannelData::freshReIm2AmPhData( bool /*saveForDryWetBlending*/ )
 {
+    advanceContentGeneration();
     updateReImData();
     amphDataFreshness_ = dftDataFreshness_ + 1;
     return AmPhReImData( amphData(), dftData() );
 }
 
 
+LE_NOTHROW
+void ChannelData::lendFrame( ChannelData_AmPh & data, float * const pFrame )
+{
+    BOOST_ASSERT_MSG( &data.full() == &currentAmPhData(), "Only the main channel AmPh data can be rebound." );
+    BOOST_ASSERT_MSG( !reImDataIsFresh()                , "AmPh data not requested."                       );
+    data.rebind( pFrame );
+}
+
+
+LE_NOTHROW
+void ChannelData::restoreFrame()
+{
+    FullChannelData_AmPh & amphData( currentAmPhData() );
+    if ( BOOST_LIKELY( amphData.amps().begin() == pHomeFrame_ ) )
+        return;
+
+    // The lent frame may hold the latest data so it has to be consumed before
+    // it is returned, after which the own storage holds stale AmPh data.
+    updateReImData();
+    amphData.rebind( pHomeFrame_ );
+    BOOST_ASSERT( dftDataFreshness_ > 0 );
+    amphDataFreshness_ = dftDataFreshness_ - 1;
+}
+
+
 void ChannelData::blendWithPreviousData( float const currentDataWeight, bool const amPh2ReIm )
 {
+    mainDataModified();
     if ( !amPh2ReIm && reImDataIsFresh() )
     {
         DataRange         const wetData( currentReImData().jointView() );
@@ -345,6 +405,7 @@ void ChannelData::blendWithPreviousData( float const currentDataWeight, bool con
 
 void ChannelData::amplifyCurrentData( float const gain )
 {
+    mainDataModified();
     DataRange const data
     (
         reImDataIsFresh()
@@ -355,12 +416,30 @@ void ChannelData::amplifyCurrentData( float const gain )
 }
 
 
+void ChannelData::applyBandMask( ReadOnlyDataRange const & gains )
+{
+    mainDataModified();
+    if ( reImDataIsFresh() )
+    {
+        FullChannelData_ReIm & data( currentReImData() );
+        Math::multiply( gains, data.reals() );
+        Math::multiply( gains, data.imags() );
+    }
+    else
+    {
+        Math::multiply( gains, currentAmPhData().amps() );
+    }
+}
+
+
 std::uint32_t ChannelData::requiredStorage( StorageFactors const & factors )
 {
     return
         FullMainSideChannelData_AmPh::requiredStorage( factors )
             +
-        InPlaceDFTBuffer            ::requiredStorage( factors );
+        InPlaceDFTBuffer            ::requiredStorage( factors )
+            +
+        SpectralFeatures            ::requiredStorage( factors );
 }
 
 
@@ -368,6 +447,8 @@ void ChannelData::resize( StorageFactors const & factors, Storage & storage )
 {
     amphData_      .resize( factors, storage );
     dftAndTimeData_.resize( factors, storage );
+    features_      .resize( factors, storage );
+    pHomeFrame_ = amphData_.main().amps().begin();
 #ifndef NDEBUG
     // Required for "no negative amps assertions".
     Math::clear( amphData_.main().amps() );
@@ -11,8 +11,10 @@
 #define channelData_hpp__D601616B_6FED_492A_BB15_73E6FBBCBB22
 #pragma once
 //------------------------------------------------------------------------------
+#include "channelData_fwd.hpp"
 #include "channelDataAmPh.hpp"
 #include "channelDataReIm.hpp"
+#include "spectralFeatures.hpp"
 
 #include "le/utility/buffers.hpp"
 
@@ -109,12 +111,16 @@ class ChannelData
 public:
     ChannelData();
 
+    /// The side channel (if any) is analysed only up to the requested domain
+    /// (the side channel AmPh data is left stale otherwise). The domain
+    /// conversions of the hop use the requested accuracy.
     void setNewTimeDomainData
     (
-        float                   const * mainChannel,
-        float                   const * sideChannel,
-        Math::FFT_float_real_1D const & fft        ,
-        ReadOnlyDataRange       const & window     ,
+        float                   const * mainChannel      ,
+        float                   const * sideChannel      ,
+        HopRequirements         const & hopRequirements  ,
+        Math::FFT_float_real_1D const & fft              ,
+        ReadOnlyDataRange       const & window           ,
         std::uint8_t                    windowSizeFactor
     );
 
@@ -136,6 +142,19 @@ public:
 
     void blendWithPreviousData( float currentDataWeight, bool amPh2ReIm );
     void amplifyCurrentData   ( float gain                              );
+    /// Per bin gains (see ResolutionLayers::bandMask()).
+    void applyBandMask        ( ReadOnlyDataRange const & gains         );
+
+    /// Has to be called after the main channel data was handed out to a module
+    /// that can write to it (see ModuleParameters::EffectMetaData::modifiesData).
+    void mainDataModified() { contentModified_ = true; }
+
+    SpectralFeatures       & features()       { return features_; }
+    SpectralFeatures const & features() const { return features_; }
+
+    /// \see Processor::lendFrame()
+    LE_NOTHROW void LE_FASTCALL lendFrame   ( ChannelData_AmPh &, float * pFrame );
+    LE_NOTHROW void LE_FASTCALL restoreFrame();
 
 private:
     ////////////////////////////////////////////////////////////////////////////
@@ -193,14 +212,16 @@ private:
     static void dft2AmPh
     (
         FullChannelData_ReIm const & input,
-        FullChannelData_AmPh       & output
+        FullChannelData_AmPh       & output,
+        Math::ConversionAccuracy
     );
 
     LE_NOTHROW
     static void amph2DFT
     (
         FullChannelData_AmPh const & input,
-        FullChannelData_ReIm       & output
+        FullChannelData_ReIm       & output,
+        Math::ConversionAccuracy
     );
 
     LE_NOTHROW void updateAmPhData();
@@ -221,12 +242,29 @@ private:
 
     bool reImDataIsFresh() const { return dftDataFreshness_ >= amphDataFreshness_; }
 
+    /// Identifies the main channel data content within a hop: advanced by the
+    /// first fresh*Data() request following a (potential) modification of
+    /// the main channel data (see mainDataModified()), i.e. modules that
+    /// leave the data unmodified do not change it for their successors.
+    std::uint32_t contentGeneration() const { return contentGeneration_; }
+
+    friend class SpectralFeatures;
+
+private:
+    void advanceContentGeneration();
+
 private:
     std::uint32_t amphDataFreshness_;
     std::uint32_t  dftDataFreshness_;
+    std::uint32_t contentGeneration_;
+    bool          contentModified_  ;
+
+    Math::ConversionAccuracy conversionAccuracy_; // of the current hop
 
     FullMainSideChannelData_AmPh amphData_      ;
     InPlaceDFTBuffer             dftAndTimeData_;
+    SpectralFeatures             features_      ;
+    float                      * pHomeFrame_    ; // own main channel AmPh storage
 
 public:
     static std::uint32_t requiredStorage( StorageFactors const & );
@@ -62,6 +62,23 @@ namespace Detail
 LE_IMPL_NAMESPACE_BEGIN( Engine )
 //------------------------------------------------------------------------------
 
+std::uint32_t FullChannelData_AmPh::phasesOffset( StorageFactors const & factors )
+{
+    // The phases follow the aligned amplitudes and the partial address
+    // aliasing workaround offset (see SharedStorageDataPairImpl::resize()).
+    auto const amplitudesStorage( Utility::align( HalfFFTBuffer<float>::requiredStorage( factors ) ) );
+    return ( requiredStorage( factors ) - amplitudesStorage ) / sizeof( float );
+}
+
+
+void FullChannelData_AmPh::rebind( float * const pFrame )
+{
+    auto const phasesOffset( phases().begin() - amps().begin() );
+    data()[ Amps   ].rebind( pFrame                );
+    data()[ Phases ].rebind( pFrame + phasesOffset );
+}
+
+
 ChannelData_AmPh::ChannelData_AmPh( FullChannelData_AmPh & data, IndexRange const & workingRange )
     :
     SubRange<FullChannelData_AmPh, DataRange>( data, workingRange )
@@ -72,6 +89,16 @@ ChannelData_AmPh::ChannelData_AmPh( FullChannelData_AmPh & data, IndexRange cons
 {
 }
 
+
+void ChannelData_AmPh::rebind( float * const pFrame )
+{
+    auto const beginBin( this->beginBin() );
+    auto const endBin  ( this->endBin  () );
+    full().rebind( pFrame );
+    data()[ Amps   ] = subRange( full().amps  (), beginBin, endBin );
+    data()[ Phases ] = subRange( full().phases(), beginBin, endBin );
+}
+
 namespace
 { //...mrmlj...using internal knowledge of ChannelData_AmPh storage requirements
   //...mrmlj...(that it depends only on the FFT size) only to avoid including
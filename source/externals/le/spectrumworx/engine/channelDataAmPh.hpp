@@ -52,6 +52,14 @@ public:
 
     ReadOnlyDataRange const & amps  () const { return first (); }
     ReadOnlyDataRange const & phases() const { return second(); }
+
+    /// Offset of the phases from the amplitudes (in floats) in frames laid out
+    /// like this data (the complete frame then spans requiredStorage() bytes).
+    static std::uint32_t phasesOffset( StorageFactors const & );
+
+    /// Repositions the data (in O(1), without copying) to the given frame
+    /// which must have the same layout.
+    void rebind( float * pFrame );
 }; // class FullChannelData_AmPh
 
 
@@ -75,6 +83,10 @@ public:
     ReadOnlyDataRange const & amps  () const { return first (); }
     ReadOnlyDataRange const & phases() const { return second(); }
 
+    /// Rebinds the full data (and this working range view of it) to the given
+    /// frame, see FullChannelData_AmPh::rebind().
+    void rebind( float * pFrame );
+
 #ifdef LE_PV_USE_TSS
     //...mrmlj...quick temporary workaround to enable PVD effects to work with
     //...mrmlj...with TSS enabled...
@@ -11,6 +11,10 @@
 #define channelData_fwd_hpp__A3D62820_9F64_4D13_AA59_70401537C88E
 #pragma once
 //------------------------------------------------------------------------------
+#include "le/math/dft/domainConversion.hpp"
+
+#include <cstdint>
+//------------------------------------------------------------------------------
 namespace LE
 {
 //------------------------------------------------------------------------------
@@ -40,6 +44,31 @@ using     MainSideChannelData_ReIm = MainSide<SubRange<FullMainSideChannelData_R
 struct ChannelData_AmPh2ReIm;
 struct ChannelData_ReIm2AmPh;
 
+/// What a module reads from the side channel, ordered by the amount of side
+/// channel analysis it requires.
+enum SideChannelDemand : std::uint8_t
+{
+    NoSideChannel,
+    SideChannelReIm,
+    SideChannelAmPh
+};
+
+/// What the modules processing a hop require from the channel data (the
+/// largest requirements of the individual modules).
+struct HopRequirements
+{
+    SideChannelDemand        sideChannelDemand ;
+    Math::ConversionAccuracy conversionAccuracy;
+};
+
+/// The conversion accuracy used for a module declaring <VAR>declared</VAR>:
+/// while the engine sheds load (see Setup::reducedQuality()) full accuracy is
+/// capped to the cheaper FineConversion tier.
+inline Math::ConversionAccuracy effectiveConversionAccuracy( Math::ConversionAccuracy const declared, bool const reducedQuality )
+{
+    return ( reducedQuality && ( declared > Math::FineConversion ) ) ? Math::FineConversion : declared;
+}
+
 //------------------------------------------------------------------------------
 LE_IMPL_NAMESPACE_END( Engine )
 //------------------------------------------------------------------------------
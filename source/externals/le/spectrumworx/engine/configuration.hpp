@@ -51,6 +51,13 @@ namespace Constants
     unsigned short const maximumOverlapFactor = 8;
     unsigned short const defaultOverlapFactor = 4;
 
+    /// \brief Multi-resolution mode (see ResolutionLayers): the number of STFT
+    /// layers (each one at half the sample rate of the previous one) and the
+    /// one sided length of the resampling filters (in samples of the decimated
+    /// signal).
+    unsigned short const maximumResolutionLayers    = 3;
+    unsigned short const resamplingFilterHalfLength = 6;
+
     unsigned short const defaultSampleRate = 44100;
 
 #ifdef _MSC_VER
@@ -0,0 +1,257 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file effectTraits.hpp
+/// ----------------------
+///
+///   Compile-time effect introspection shared by the module implementations
+/// and static effect chains.
+///
+/// Copyright (c) 2009 - 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef effectTraits_hpp__30F35E36_2442_427E_87AA_80EC088D95DC
+#define effectTraits_hpp__30F35E36_2442_427E_87AA_80EC088D95DC
+#pragma once
+//------------------------------------------------------------------------------
+#include "buffers.hpp"
+#include "channelData.hpp"
+#include "configuration.hpp"
+
+#include "le/math/dft/domainConversion.hpp"
+#include "le/utility/platformSpecifics.hpp"
+
+#include <boost/mpl/has_xxx.hpp>
+#include <boost/range/iterator_range_core.hpp>
+
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_BEGIN( Engine )
+    class Setup;
+LE_IMPL_NAMESPACE_END( Engine )
+//------------------------------------------------------------------------------
+namespace Engine
+{
+//------------------------------------------------------------------------------
+
+namespace Detail ///< \internal
+{
+    BOOST_MPL_HAS_XXX_TRAIT_DEF( ChannelState );
+
+    struct MakeChannelStateHolder
+    {
+        template <class Effect>
+        struct ChannelStates
+        {
+            using ChannelState      = typename Effect::ChannelState;
+            using ChannelStateRange = boost::iterator_range<ChannelState * LE_RESTRICT>;
+
+            template <class Data>
+            void LE_FORCEINLINE LE_HOT callProcess
+            (
+                Effect        const &       effect,
+                std::uint8_t          const channel,
+                Data          const &       data,
+                Engine::Setup const &       setup
+            ) const
+            {
+                effect.process( channelStates_[ channel ], data, setup );
+            }
+
+            LE_OPTIMIZE_FOR_SIZE_BEGIN()
+
+            LE_FORCEINLINE void LE_COLD callReset()
+            {
+            #ifndef _MSC_VER
+                LE_DISABLE_LOOP_UNROLLING()
+                LE_DISABLE_LOOP_VECTORIZATION()
+            #endif // _MSC_VER
+                for ( auto & channelState : channelStates_ )
+                    channelState.reset();
+            }
+
+            static std::uint16_t const sizeOfChannelState = sizeof( ChannelState );
+            static std::uint32_t channelStateRequiredStorage( Engine::StorageFactors const & factors ) { return ChannelState::requiredStorage( factors ); }
+
+            LE_FORCEINLINE LE_NOTHROWNOALIAS LE_COLD
+            void LE_FASTCALL resize( Engine::Storage storage, Engine::StorageFactors const & factors )
+            {
+                // One channel state per channel of each resolution layer:
+                LE_ASSUME( factors.numberOfLayerChannels() <= 16 * Engine::Constants::maximumResolutionLayers );
+                char * const pChannelStatesBegin( storage                                                                          .begin() );
+                char * const pChannelStatesEnd  ( storage.advance_begin( sizeof( ChannelState ) * factors.numberOfLayerChannels() ).begin() );
+                channelStates_ = ChannelStateRange
+                (
+                    reinterpret_cast<ChannelState *>( pChannelStatesBegin ),
+                    reinterpret_cast<ChannelState *>( pChannelStatesEnd   )
+                );
+                BOOST_ASSERT( unsigned( channelStates_.size() ) == factors.numberOfLayerChannels() );
+            #ifndef _MSC_VER
+                LE_DISABLE_LOOP_UNROLLING()
+                LE_DISABLE_LOOP_VECTORIZATION()
+            #endif // _MSC_VER
+                for ( auto & channelState : channelStates_ )
+                {
+                    BOOST_ASSERT( reinterpret_cast<char *>( &channelState ) < storage.end() );
+                    ChannelState * LE_RESTRICT const pNewChannelState( new ( &channelState ) ChannelState );
+                    LE_ASSUME( pNewChannelState );
+                    pNewChannelState->resize( factors, storage );
+                }
+            }
+
+            LE_OPTIMIZE_FOR_SIZE_END()
+
+            ChannelStateRange channelStates_;
+        }; // struct ChannelStates
+    }; // struct MakeChannelStateHolder
+
+    struct MakeEmptyChannelStateHolder
+    {
+        template <class Effect>
+        struct ChannelStates
+        {
+            template <class Data>
+            void LE_FORCEINLINE LE_HOT callProcess
+            (
+                Effect        const & effect,
+                std::uint8_t        /*channel*/,
+                Data          const & data,
+                Engine::Setup const & setup
+            ) const
+            {
+                effect.process( data, setup ); ((void)effect);
+            }
+
+            static void callReset() {}
+
+            static std::uint8_t const sizeOfChannelState = 0;
+            static std::uint8_t channelStateRequiredStorage( Engine::StorageFactors const & ) { return 0; }
+
+            static void resize( Engine::Storage const &, Engine::StorageFactors const & ) {}
+        }; // struct ChannelStates
+    }; // struct MakeEmptyChannelStateHolder
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    // EffectSideChannelDemand<Effect>
+    ////////////////////////////////////////////////////////////////////////////
+    // Implementation note:
+    //   The side channel demand of an effect is deduced from the type of the
+    // data its process() member function takes: a probe convertible only to
+    // the tested data type (a second, user defined, conversion would be
+    // required to reach any other data type) is passed in its place.
+    ////////////////////////////////////////////////////////////////////////////
+
+    template <class Data>
+    struct ProcessDataProbe { operator Data() const; };
+
+    template <class Data, class Effect>
+    auto processesData( Effect const & effect, int  ) -> decltype( effect.process( std::declval<typename Effect::ChannelState &>(), ProcessDataProbe<Data>(), std::declval<Engine::Setup const &>() ), std::true_type() );
+    template <class Data, class Effect>
+    auto processesData( Effect const & effect, long ) -> decltype( effect.process(                                                  ProcessDataProbe<Data>(), std::declval<Engine::Setup const &>() ), std::true_type() );
+    template <class Data, class Effect>
+    std::false_type processesData( Effect const &, ... );
+
+    template <class Effect>
+    struct EffectSideChannelDemand
+    {
+        template <class Data>
+        using Processes = decltype( processesData<Data>( std::declval<Effect const &>(), 0 ) );
+
+        static SideChannelDemand const value =
+            ( Processes<MainSideChannelData_AmPh>::value || Processes<ChannelData_AmPh2ReIm>::value ) ? SideChannelAmPh :
+            ( Processes<MainSideChannelData_ReIm>::value || Processes<ChannelData_ReIm2AmPh>::value ) ? SideChannelReIm :
+                                                                                                          NoSideChannel  ;
+    }; // struct EffectSideChannelDemand
+
+    ////////////////////////////////////////////////////////////////////////////
+    // EffectConversionAccuracy<Effect>
+    ////////////////////////////////////////////////////////////////////////////
+    // The (optional) conversionAccuracy static constant of an effect, effects
+    // that do not declare one get full accuracy conversions.
+    ////////////////////////////////////////////////////////////////////////////
+
+    template <class Effect>
+    auto declaredConversionAccuracy( int  ) -> std::integral_constant<Math::ConversionAccuracy, Effect::conversionAccuracy>;
+    template <class Effect>
+    auto declaredConversionAccuracy( long ) -> std::integral_constant<Math::ConversionAccuracy, Math::FullConversion     >;
+
+    template <class Effect>
+    struct EffectConversionAccuracy : decltype( declaredConversionAccuracy<Effect>( 0 ) ) {};
+
+    ////////////////////////////////////////////////////////////////////////////
+    // EffectModifiesData<Effect>
+    ////////////////////////////////////////////////////////////////////////////
+    // Negation of the (optional) readOnly static constant of an effect, i.e.
+    // (analysis) effects that leave the data they are given unmodified have to
+    // declare it so that they do not invalidate the main channel
+    // SpectralFeatures of their successors (see ChannelData::mainDataModified()).
+    ////////////////////////////////////////////////////////////////////////////
+
+    template <class Effect>
+    auto declaredReadOnly( int  ) -> std::integral_constant<bool, Effect::readOnly>;
+    template <class Effect>
+    auto declaredReadOnly( long ) -> std::false_type;
+
+    template <class Effect>
+    struct EffectModifiesData : std::integral_constant<bool, !decltype( declaredReadOnly<Effect>( 0 ) )::value> {};
+
+    ////////////////////////////////////////////////////////////////////////////
+    // effectScratchStorage<Effect>()
+    ////////////////////////////////////////////////////////////////////////////
+    // The (optional) scratchStorage() static member function of an effect: the
+    // number of bytes its process() member function allocates from the
+    // Processor's ScratchArena (see ScratchArena::requiredStorage()), effects
+    // that do not declare one use no scratch storage.
+    ////////////////////////////////////////////////////////////////////////////
+
+    template <class Effect>
+    auto declaredScratchStorage( StorageFactors const & factors, int  ) -> decltype( std::uint32_t( Effect::scratchStorage( factors ) ) ) { return Effect::scratchStorage( factors ); }
+    template <class Effect>
+    std::uint32_t declaredScratchStorage( StorageFactors const &        , long ) { return 0; }
+
+    template <class Effect>
+    std::uint32_t effectScratchStorage( StorageFactors const & factors ) { return declaredScratchStorage<Effect>( factors, 0 ); }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // EffectData<Effect>
+    ////////////////////////////////////////////////////////////////////////////
+    // The channel data type taken by the effect's process() member function
+    // (deduced with the same probes as its side channel demand).
+    ////////////////////////////////////////////////////////////////////////////
+
+    template <class Effect>
+    struct EffectData
+    {
+        template <class Data>
+        using Processes = typename EffectSideChannelDemand<Effect>:: template Processes<Data>;
+
+        using type =
+            typename std::conditional<Processes<ChannelData_AmPh2ReIm   >::value, ChannelData_AmPh2ReIm   ,
+            typename std::conditional<Processes<ChannelData_ReIm2AmPh   >::value, ChannelData_ReIm2AmPh   ,
+            typename std::conditional<Processes<MainSideChannelData_AmPh>::value, MainSideChannelData_AmPh,
+            typename std::conditional<Processes<MainSideChannelData_ReIm>::value, MainSideChannelData_ReIm,
+            typename std::conditional<Processes<ChannelData_ReIm        >::value, ChannelData_ReIm        ,
+                                                                                  ChannelData_AmPh
+            >::type>::type>::type>::type>::type;
+    }; // struct EffectData
+
+} // namespace Detail
+
+//------------------------------------------------------------------------------
+} // namespace Engine
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // effectTraits_hpp
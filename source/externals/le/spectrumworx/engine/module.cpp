@@ -31,21 +31,121 @@ LE_OPTIMIZE_FOR_SIZE_BEGIN()
 
 LE_COLD ModuleDSP::~ModuleDSP() {}
 
+/// \note The (effect) setup is recomputed only when a parameter (including
+/// through an LFO) or the engine setup changed since the last one. The only
+/// one-shot state effects derive in their setup() comes from trigger
+/// parameters (which setup() consumes without a parameter change) so a setup
+/// that consumed armed triggers is redone once more in the next preProcess()
+/// call (to see them released).
+///   In the multi-resolution mode the trigger parameters consumed by the setup
+/// are remembered so that they can be re-armed for the setups of the deeper
+/// layers (see setupResolutionLayer()). The setup of each layer is kept in the
+/// module's storage so that, as long as it is up to date, switching between
+/// the layers only restores it (instead of redoing it every hop).
 LE_NOTHROW LE_COLD
-void ModuleDSP::preProcess( LFO::Timer const & timer, Setup const & engineSetup )
+void ModuleDSP::preProcess( Setup const & engineSetup )
 {
     if ( bypass() )
         return;
-#ifndef LE_NO_LFOs
-    ModuleParameters::updateBaseParametersFromLFOs  ( timer );
-    ModuleParameters::updateEffectParametersFromLFOs( timer );
-#endif // LE_NO_LFOs
+    bool const layered( engineSetup.resolutionLayers() > 1 );
+    resolutionLayerTriggers_ = layered ? armedTriggers() : 0;
+    if ( setupUpToDate( engineSetup ) )
+    {
+        if ( layered )
+            restoreLayerSetup( 0 );
+        return;
+    }
     setup( engineSetup );
+    if ( layered )
+        doSaveLayerSetup( 0 );
 }
 
 
+LE_NOTHROW LE_COLD
+void ModuleDSP::setupResolutionLayer( Setup const & engineSetup )
+{
+    auto const layer( engineSetup.resolutionLayer() );
+    BOOST_ASSERT( layer != 0 );
+    if ( bypass() )
+        return;
+    if ( setupUpToDate( engineSetup ) )
+    {
+        restoreLayerSetup( layer );
+        return;
+    }
+    rearmTriggers( resolutionLayerTriggers_ );
+    setup( engineSetup );
+    doSaveLayerSetup( layer );
+}
+
+
+void ModuleDSP::restoreLayerSetup( std::uint8_t const layer )
+{
+    workingRange_ = layerSetups_[ layer ].workingRange;
+    doRestoreLayerSetup( layer );
+}
+
+
+std::uint32_t ModuleDSP::armedTriggers() const
+{
+    BOOST_ASSERT( numberOfEffectSpecificParameters() <= 32 );
+    std::uint32_t triggers( 0 );
+    for ( std::uint8_t parameterIndex( 0 ); parameterIndex < numberOfEffectSpecificParameters(); ++parameterIndex )
+    {
+        //...mrmlj...internal TriggerParameter knowledge (see setEffectParameter())...
+        if
+        (
+            ( effectSpecificParameterInfo( parameterIndex ).type == ParameterInfo::Trigger ) &&
+            *static_cast<char const *>( getEffectParameterPtr( parameterIndex ) )
+        )
+            triggers |= 1U << parameterIndex;
+    }
+    return triggers;
+}
+
+
+void ModuleDSP::rearmTriggers( std::uint32_t const triggers )
+{
+    for ( std::uint8_t parameterIndex( 0 ); parameterIndex < numberOfEffectSpecificParameters(); ++parameterIndex )
+    {
+        if ( triggers & ( 1U << parameterIndex ) )
+            *static_cast<char *>( getEffectParameterPtr( parameterIndex ) ) = true;
+    }
+}
+
+
+bool ModuleDSP::setupUpToDate( Setup const & engineSetup ) const
+{
+    LayerSetup const & layerSetup( layerSetups_[ engineSetup.resolutionLayer() ] );
+    return
+        !layerSetup.triggersConsumed                                  &&
+        ( layerSetup.parametersGeneration == parametersGeneration () ) &&
+        ( layerSetup.engineGeneration     == engineSetup.generation() );
+}
+
+
+void ModuleDSP::invalidateSetups()
+{
+    for ( auto & layerSetup : layerSetups_ )
+    {
+        layerSetup.parametersGeneration = parametersGeneration() - 1;
+        layerSetup.engineGeneration     = 0;
+        layerSetup.triggersConsumed     = true;
+    }
+}
+
+
+LE_NOTHROWNOALIAS LE_COLD
+bool ModuleDSP::doFollowPitchCurve( PitchCurve const * ) { return false; }
+
+
 void LE_COLD ModuleDSP::setup( Setup const & engineSetup )
 {
+    LayerSetup & layerSetup( layerSetups_[ engineSetup.resolutionLayer() ] );
+    layerSetup.triggersConsumed     = armedTriggers() != 0;
+    layerSetup.parametersGeneration = parametersGeneration  ();
+    layerSetup.engineGeneration     = engineSetup.generation();
+
     using namespace Effects::BaseParameters;
 
     float const  leftFrequency( baseParameters().get<StartFrequency>() );
@@ -57,6 +157,7 @@ void LE_COLD ModuleDSP::setup( Setup const & engineSetup )
         engineSetup.normalisedFrequencyToBin( std::min( leftFrequency, rightFrequency ) ),
         engineSetup.normalisedFrequencyToBin(                          rightFrequency   )
     );
+    layerSetup.workingRange = workingRange_;
     doPreProcess( engineSetup );
 }
 
@@ -65,12 +166,13 @@ bool LE_COLD ModuleDSP::allocateStorage
 (
     StorageFactors const & storageFactors,
     std::uint16_t const channelStateSize,
-    std::uint32_t const channelStateRequiredStorage // HistoryBuffer requires uint32_t
+    std::uint32_t const channelStateRequiredStorage, // HistoryBuffer requires uint32_t
+    std::uint32_t const layerSetupSize
 )
 {
     using Utility::align;
 
-    auto const numberOfChannels( storageFactors.numberOfChannels );
+    auto const numberOfChannels( storageFactors.numberOfLayerChannels() );
 
     auto const baseNumberOfBytes
     (
@@ -89,7 +191,7 @@ bool LE_COLD ModuleDSP::allocateStorage
         numberOfChannels * align( channelStateRequiredStorage )
     );
 
-    auto const totalBytes
+    auto const channelStatesNumberOfBytes
     (
         baseNumberOfBytes
             +
@@ -98,6 +200,29 @@ bool LE_COLD ModuleDSP::allocateStorage
         bufferNumberOfBytes
     );
 
+    // The setups of the resolution layers (see layerSetupStorage()) follow the
+    // (aligned) channel states in the multi-resolution mode.
+    auto const layerSetupsNumberOfBytes
+    (
+        ( storageFactors.resolutionLayers > 1 )
+            ? storageFactors.resolutionLayers * align( layerSetupSize )
+            : 0
+    );
+
+    auto const totalBytes
+    (
+        layerSetupsNumberOfBytes
+            ? align( channelStatesNumberOfBytes ) + layerSetupsNumberOfBytes
+            :        channelStatesNumberOfBytes
+    );
+
+    // Storage adopted from a pooled predecessor (or left over from a larger
+    // engine setup) is shrunk to the current requirement (which reallocs
+    // normally do in place) so that modules do not hold on to the storage of
+    // the largest setup they ever saw.
+    if ( storage_.size() == totalBytes )
+        return true;
+
     return storage_.resize( totalBytes );
 }
 
@@ -107,7 +232,7 @@ LE_OPTIMIZE_FOR_SPEED_BEGIN()
 LE_NOTHROW
 void ModuleDSP::process( std::uint8_t const channel, ChannelData & channelData, Setup const & engineSetup ) const
 {
-    if ( !bypass() )
+    if ( active( engineSetup ) )
     {
         using namespace Math;
         using namespace Effects::BaseParameters;
@@ -121,6 +246,7 @@ void ModuleDSP::process( std::uint8_t const channel, ChannelData & channelData,
         bool amPh2ReIm;//...mrmlj...quick-fix for blending bug with amPh2ReIm effects...
 
         doProcess( channel, ChannelDataProxy( channelData, *this, blend, amPh2ReIm ), engineSetup );
+        if ( metaData().modifiesData ) { channelData.mainDataModified(); }
 
         if ( blend   ) { channelData.blendWithPreviousData( wet / 100, amPh2ReIm        ); }
         if ( amplify ) { channelData.amplifyCurrentData   ( dB2NormalisedLinear( gain ) ); }
@@ -129,6 +255,26 @@ void ModuleDSP::process( std::uint8_t const channel, ChannelData & channelData,
 LE_OPTIMIZE_FOR_SPEED_END()
 
 
+LE_NOTHROWNOALIAS
+SideChannelDemand ModuleDSP::sideChannelDemand( Setup const & engineSetup ) const
+{
+    return active( engineSetup ) ? metaData().sideChannelDemand : NoSideChannel;
+}
+
+
+LE_NOTHROWNOALIAS
+Math::ConversionAccuracy ModuleDSP::conversionAccuracy( Setup const & engineSetup ) const
+{
+    return active( engineSetup ) ? effectiveConversionAccuracy( metaData().conversionAccuracy, engineSetup.reducedQuality() ) : Math::CoarseConversion;
+}
+
+
+bool ModuleDSP::active( Setup const & engineSetup ) const
+{
+    return !bypass() && !( optional() && engineSetup.shedOptionalModules() );
+}
+
+
 ModuleDSP::ChannelDataProxy::ChannelDataProxy( ChannelData & data, ModuleDSP const & module, bool const doBlend, bool & amPh2ReIm )
     :
     module_       ( module    ),
@@ -207,6 +353,17 @@ void const * ModuleDSP::getEffectParameterPtr( std::uint8_t const parameterIndex
     return const_cast<ModuleDSP &>( *this ).getEffectParameterPtr( parameterIndex );
 }
 
+namespace
+{
+    template <typename T>
+    T assignEffectParameter( void * LE_RESTRICT const pValue, T const newValue, bool & changed )
+    {
+        T & value( *static_cast<T *>( pValue ) );
+        changed = ( value != newValue );
+        return value = newValue;
+    }
+} // anonymous namespace
+
 LE_NOTHROW
 float ModuleDSP::setEffectParameter( std::uint8_t const parameterIndex, float const value, ParameterInfo const & cachedInfo )
 {
@@ -214,16 +371,21 @@ float ModuleDSP::setEffectParameter( std::uint8_t const parameterIndex, float co
     void * LE_RESTRICT const pValue( getEffectParameterPtr( parameterIndex ) );
     BOOST_ASSERT_MSG( static_cast<float>( value ) >= cachedInfo.minimum, "Parameter value out of range" );
     BOOST_ASSERT_MSG( static_cast<float>( value ) <= cachedInfo.maximum, "Parameter value out of range" );
+    bool  changed;
+    float newValue;
     switch ( cachedInfo.type )
     {
          //...mrmlj...internal TriggerParameter knowledge...
-        case ParameterInfo::Trigger      : return ( *static_cast<char          *>( pValue ) |= Math::convert<char         >( value ) );
-        case ParameterInfo::Boolean      : return ( *static_cast<bool          *>( pValue )  = Math::convert<bool         >( value ) );
-        case ParameterInfo::Enumerated   : return ( *static_cast<std::uint8_t  *>( pValue )  = Math::convert<std::uint8_t >( value ) );
-        case ParameterInfo::Integer      : return ( *static_cast<std:: int16_t *>( pValue )  = Math::convert<std:: int16_t>( value ) );
-        case ParameterInfo::FloatingPoint: return ( *static_cast<float         *>( pValue )  =                               value   );
+        case ParameterInfo::Trigger      : newValue = assignEffectParameter( pValue, static_cast<char>( *static_cast<char const *>( pValue ) | Math::convert<char>( value ) ), changed ); break;
+        case ParameterInfo::Boolean      : newValue = assignEffectParameter( pValue, Math::convert<bool         >( value )                                                     , changed ); break;
+        case ParameterInfo::Enumerated   : newValue = assignEffectParameter( pValue, Math::convert<std::uint8_t >( value )                                                     , changed ); break;
+        case ParameterInfo::Integer      : newValue = assignEffectParameter( pValue, Math::convert<std:: int16_t>( value )                                                     , changed ); break;
+        case ParameterInfo::FloatingPoint: newValue = assignEffectParameter( pValue,                                value                                                      , changed ); break;
         LE_DEFAULT_CASE_UNREACHABLE();
     }
+    if ( changed )
+        parametersChanged();
+    return newValue;
 }
 
 
@@ -318,6 +480,9 @@ char const * ModuleBase::effectName() const
 LE_NOTHROWNOALIAS
 ModuleBase::BaseParameters & ModuleBase::baseParameters() { return static_cast<ModuleDSP &>( *this ).baseParameters(); }
 
+LE_NOTHROW
+bool ModuleBase::followPitchCurve( PitchCurve const * const pPitchCurve ) { return static_cast<ModuleDSP &>( *this ).followPitchCurve( pPitchCurve ); }
+
 LE_NOTHROWNOALIAS void LE_FASTCALL_ABI intrusive_ptr_add_ref( ModuleBase const * const pModuleBase ) { intrusive_ptr_add_ref( &node( *static_cast<ModuleDSP const *>( pModuleBase ) ) ); }
 LE_NOTHROW        void LE_FASTCALL_ABI intrusive_ptr_release( ModuleBase const * const pModuleBase ) { intrusive_ptr_release( &node( *static_cast<ModuleDSP const *>( pModuleBase ) ) ); }
 } // namespace Engine
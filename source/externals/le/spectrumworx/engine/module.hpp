@@ -24,10 +24,13 @@
 #include "le/utility/platformSpecifics.hpp"
 
 #include <cstdint>
+#include <utility>
 //------------------------------------------------------------------------------
 namespace LE
 {
 //------------------------------------------------------------------------------
+class PitchCurve;
+//------------------------------------------------------------------------------
 namespace SW
 {
 //------------------------------------------------------------------------------
@@ -91,12 +94,40 @@ public:
     using ModuleParameters::setEffectParameter;
 
             LE_NOTHROW        void LE_FASTCALL initialise( Setup const & engineSetup ) { setup( engineSetup ); }
-            LE_NOTHROW        void LE_FASTCALL preProcess( LFO::Timer const &,                  Setup const & )      ;
+    /// \note The module's LFOs are evaluated (for all the modules in the chain
+    /// at once) by ModuleChainImpl::preProcessAll() before this is called.
+            LE_NOTHROW        void LE_FASTCALL preProcess(                                      Setup const & )      ;
             LE_NOTHROW        void LE_FASTCALL process   ( std::uint8_t channel, ChannelData &, Setup const & ) const;
 
+    /// Sets the module up for a deeper layer of the multi-resolution mode (see
+    /// ResolutionLayers) after the hop's preProcess() (with the engine setup
+    /// switched to that layer).
+            LE_NOTHROW        void LE_FASTCALL setupResolutionLayer( Setup const & );
+
+    /// What the module reads from the side channel when processing with the
+    /// given setup (nothing while it is bypassed or shed).
+    LE_NOTHROWNOALIAS SideChannelDemand LE_FASTCALL sideChannelDemand( Setup const & ) const;
+
+    /// The domain conversion accuracy the module requires when processing
+    /// with the given setup (the cheapest one while it is bypassed or shed).
+    LE_NOTHROWNOALIAS Math::ConversionAccuracy LE_FASTCALL conversionAccuracy( Setup const & ) const;
+
     virtual LE_NOTHROWNOALIAS void LE_FASTCALL reset (                        ) = 0;
     virtual LE_NOTHROWNOALIAS bool LE_FASTCALL resize( StorageFactors const & ) = 0;
 
+    /// Batch (offline) pitch correction: makes a TuneWorx(PVD) module take the
+    /// pitch of each hop from the given (analysed and smoothed) curve instead
+    /// of detecting it (nullptr restores the detection). Returns false for
+    /// modules of other effects.
+    /// \note Has to be called before the first hop after a reset (the curve is
+    /// followed from its first hop) and the curve has to outlive its use.
+    LE_NOTHROW bool LE_FASTCALL followPitchCurve( PitchCurve const * const pPitchCurve ) { invalidateSetups(); return doFollowPitchCurve( pPitchCurve ); }
+
+    /// Module pool support: lets the (channel state) storage outlive the module
+    /// so that it can be reused by the next module created in the same memory.
+    HeapSharedStorage releaseStorage(                             ) { return std::move( storage_ ); }
+    void              adoptStorage  ( HeapSharedStorage && storage ) { BOOST_ASSERT( !storage_.begin() ); storage_ = std::move( storage ); }
+
 protected:
     ModuleDSP
     (
@@ -113,9 +144,13 @@ protected:
     #else
         ModuleParameters     ( metaData, pLFOs      ),
     #endif
-        parametersBaseOffset_( parametersBaseOffset ),
-        pParameterOffsets_   ( pParameterOffsets    )
-    { BOOST_ASSERT( storage_.begin() == nullptr ); }
+        resolutionLayerTriggers_  ( 0                          ),
+        parametersBaseOffset_     ( parametersBaseOffset       ),
+        pParameterOffsets_        ( pParameterOffsets          )
+    {
+        BOOST_ASSERT( storage_.begin() == nullptr );
+        invalidateSetups();
+    }
 
 #ifdef LE_SW_SDK_BUILD //...mrmlj...reinvestigate this...
     public: LE_NOTHROW virtual ~ModuleDSP(); protected:
@@ -125,15 +160,40 @@ protected:
 
     void setup( Setup const & );
 
-    bool LE_FASTCALL allocateStorage( StorageFactors const &, std::uint16_t channelStateSize, std::uint32_t channelStateRequiredStorage );
+    bool setupUpToDate    ( Setup const &        ) const;
+    void invalidateSetups (                      )      ;
+    void restoreLayerSetup( std::uint8_t layer   )      ;
+
+    /// Not bypassed (directly or by optional module shedding).
+    bool active( Setup const & ) const;
+
+    /// Bit mask of the (effect specific) trigger parameters that are set.
+    std::uint32_t armedTriggers(                        ) const;
+    void          rearmTriggers( std::uint32_t triggers )      ;
+
+    bool LE_FASTCALL allocateStorage( StorageFactors const &, std::uint16_t channelStateSize, std::uint32_t channelStateRequiredStorage, std::uint32_t layerSetupSize );
     Storage const & storage() const { return storage_; }
 
+    /// Storage for the (effect) setup of the given resolution layer (at the
+    /// end of the module's storage, allocated only in the multi-resolution
+    /// mode, see allocateStorage()).
+    void * layerSetupStorage( std::uint8_t const layer, std::uint32_t const layerSetupSize ) { return storage_.end() - ( layer + 1 ) * Utility::align( layerSetupSize ); }
+
     Effects::IndexRange const & workingRange() const { return workingRange_; }
 
 private:
     virtual LE_NOTHROWNOALIAS void LE_FASTCALL doPreProcess(                                         Setup const & )       = 0;
     virtual LE_NOTHROWNOALIAS void LE_FASTCALL doProcess   ( std::uint8_t channel, ChannelDataProxy, Setup const & ) const = 0;
 
+    /// Overridden only by TuneWorx(PVD) modules (see
+    /// Detail::PitchCurveFollower), all others simply return false.
+    virtual LE_NOTHROWNOALIAS bool LE_FASTCALL doFollowPitchCurve( PitchCurve const * );
+
+    /// Multi-resolution mode: copy the effect's setup to (save) or from
+    /// (restore) the layer's setup storage (see layerSetupStorage()).
+    virtual LE_NOTHROWNOALIAS void LE_FASTCALL doSaveLayerSetup   ( std::uint8_t layer )       = 0;
+    virtual LE_NOTHROWNOALIAS void LE_FASTCALL doRestoreLayerSetup( std::uint8_t layer )       = 0;
+
 #ifdef LE_SW_SDK_BUILD
 private: // boost::intrusive_ptr required section
     friend LE_NOTHROWNOALIAS void LE_FASTCALL_ABI intrusive_ptr_add_ref( ModuleBase const * );
@@ -150,6 +210,17 @@ private:
 private:
     mutable Effects::IndexRange workingRange_;
 
+    struct LayerSetup
+    {
+        std::uint32_t       parametersGeneration;
+        std::uint32_t       engineGeneration    ;
+        bool                triggersConsumed    ;
+        Effects::IndexRange workingRange        ;
+    }; // struct LayerSetup
+
+    LayerSetup    layerSetups_[ Constants::maximumResolutionLayers ];
+    std::uint32_t resolutionLayerTriggers_  ; // armed for the hop's preProcess()
+
     std::uint16_t                     const parametersBaseOffset_;
     std::uint8_t  const * LE_RESTRICT const pParameterOffsets_   ;
 
@@ -24,6 +24,7 @@ namespace LE
 {
 //------------------------------------------------------------------------------
 namespace Parameters { class LFO; struct RuntimeInformation; }
+class PitchCurve;
 //------------------------------------------------------------------------------
 namespace SW
 {
@@ -137,6 +138,21 @@ public:
     LE_NOTHROWRESTRICTNOALIAS char const * LE_FASTCALL_ABI effectName() const;
     /// @}
 
+    /// \name Batch (offline) pitch correction
+    /// @{
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Makes a TuneWorx(PVD) module take the pitch of each hop from
+    /// <VAR>pPitchCurve</VAR> (see PitchCurve::analyse() and
+    /// PitchCurve::smooth()) instead of detecting it.
+    /// \details A null <VAR>pPitchCurve</VAR> restores the pitch detection.
+    /// The curve is followed from its first hop so this has to be called
+    /// before the first processed hop after a reset and the curve has to
+    /// outlive its use.
+    /// \return false if the module is not a TuneWorx(PVD) module.
+    ////////////////////////////////////////////////////////////////////////////
+    LE_NOTHROW bool LE_FASTCALL_ABI followPitchCurve( PitchCurve const * pPitchCurve );
+    /// @}
+
 public:
     /// \name Factory function
     /// @{
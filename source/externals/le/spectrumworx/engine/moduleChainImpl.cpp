@@ -12,7 +12,9 @@
 #include "module.hpp"
 
 #include "boost/assert.hpp"
+#include "boost/concept_check.hpp"
 
+#include <algorithm>
 #include <utility>
 //------------------------------------------------------------------------------
 namespace LE
@@ -28,6 +30,8 @@ LE_OPTIMIZE_FOR_SIZE_BEGIN()
 
 LE_NOTHROWNOALIAS LE_COLD
 ModuleChainBase::ModuleChainBase()
+    :
+    structureGeneration_( 0 )
 {
     referenceCount_.verifyCountEqual( 0 );
     ++referenceCount_;
@@ -38,6 +42,8 @@ ModuleChainBase::ModuleChainBase()
 
 LE_NOTHROW LE_COLD
 ModuleChainBase::ModuleChainBase( ModuleChainBase && other )
+    :
+    structureGeneration_( 0 )
 {
     referenceCount_.verifyCountEqual( 0 );
     ++referenceCount_;
@@ -85,6 +91,8 @@ void ModuleChainBase::moveAssign( ModuleChainBase && other )
     BOOST_ASSERT( other.referenceCount_ == 3 );
     BOOST_ASSERT( other.empty()              );
     BOOST_ASSERT( this->size() == otherSize  );
+    ++this->structureGeneration_;
+    ++other.structureGeneration_;
 }
 
 LE_NOTHROWNOALIAS LE_COLD
@@ -154,6 +162,7 @@ void ModuleChainBase::clear()
         pCurrentModule = node_algorithms::unlink( pCurrentModule.get() );
     }
     resetRoot();
+    ++structureGeneration_;
 }
 
 LE_NOTHROW LE_COLD
@@ -171,6 +180,7 @@ void ModuleChainBase::moveModule( std::uint8_t const sourceIndex, std::uint8_t c
         node_algorithms::link_after ( pTarget.get(), pSource.get() );
     else
         node_algorithms::link_before( pTarget.get(), pSource.get() );
+    ++structureGeneration_;
     //...mrmlj...
     //boost::swap( pSource->next_    , pTarget->next_     );
     //boost::swap( pSource->previous_, pTarget->previous_ );
@@ -183,6 +193,7 @@ void ModuleChainBase::push_back( Node & module )
 {
     //...mrmlj...BOOST_ASSERT_MSG( node_algorithms::inited( &module ), "Module already belongs to a different chain." );
     node_algorithms::link_before( this, &module );
+    ++structureGeneration_;
 }
 
 LE_NOTHROW LE_COLD
@@ -190,6 +201,7 @@ void ModuleChainBase::insertAtAndReplace( iterator const & pInsertPosition, Node
 {
     BOOST_ASSERT_MSG( node_algorithms::inited( &moduleToInsert ), "Module already belongs to a different chain." );
     node_algorithms::link_before( pInsertPosition.get(), &moduleToInsert );
+    ++structureGeneration_;
     if ( !isEnd( pInsertPosition ) )
         remove( *pInsertPosition );
 }
@@ -206,6 +218,7 @@ void ModuleChainBase::remove( Node & node )
     BOOST_ASSERT( next_     );
 #endif // NDEBUG
     node_algorithms::unlink( &node );
+    ++structureGeneration_;
 #ifndef NDEBUG
     /// \note The unlink procedure must leave the unlinked node's previous and
     /// next pointers intact in case another thread is using the node and wishes
@@ -303,12 +316,90 @@ void module_node_traits::set_previous( node_ptr const n, node_ptr const prev ) {
 } // namespace Detail
 
 LE_NOTHROW LE_COLD
-void ModuleChainImpl::preProcessAll( Parameters::LFOImpl::Timer const & timer, Setup const & engineSetup )
+HopRequirements ModuleChainImpl::preProcessAll( Parameters::LFOImpl::Timer const & timer, Setup const & engineSetup )
 {
+#ifndef LE_NO_LFOs
+    updateParametersFromLFOs( timer );
+#else
+    boost::ignore_unused_variable_warning( timer );
+#endif // LE_NO_LFOs
+    HopRequirements requirements = { NoSideChannel, Math::CoarseConversion };
     forEach<Module>
     (
-        [&]( Module & module ) { module.preProcess( timer, engineSetup ); }
+        [&]( Module & module )
+        {
+            module.preProcess( engineSetup );
+            requirements.sideChannelDemand  = std::max( requirements.sideChannelDemand , module.sideChannelDemand ( engineSetup ) );
+            requirements.conversionAccuracy = std::max( requirements.conversionAccuracy, module.conversionAccuracy( engineSetup ) );
+        }
+    );
+    return requirements;
+}
+
+#ifndef LE_NO_LFOs
+/// \note The enabled LFOs of the whole chain are gathered, in chain and then
+/// parameter order (which preserves the order of the random waveforms' random
+/// number generator calls), into batches evaluated at once. The results are
+/// then scattered to the parameters the LFOs control.
+LE_NOTHROW LE_COLD
+void ModuleChainImpl::updateParametersFromLFOs( Parameters::LFOImpl::Timer const & timer )
+{
+    using LFOBatch = Parameters::LFOImpl::Batch;
+
+    LFOBatch     batch;
+    ModuleDSP *  pModules      [ LFOBatch::capacity ];
+    std::uint8_t lfoableIndices[ LFOBatch::capacity ];
+
+    auto const flush
+    (
+        [&]()
+        {
+            batch.evaluate( timer );
+            for ( std::uint8_t lfo( 0 ); lfo < batch.size(); ++lfo )
+                pModules[ lfo ]->setParameterFromLFO( lfoableIndices[ lfo ], batch.values()[ lfo ] );
+            batch.clear();
+        }
+    );
+
+    forEach<ModuleDSP>
+    (
+        [&]( ModuleDSP & module )
+        {
+            if ( module.bypass() )
+                return;
+            auto const numberOfLFOs( module.numberOfLFOControledParameters() );
+            for ( std::uint8_t lfoableIndex( 0 ); lfoableIndex < numberOfLFOs; ++lfoableIndex )
+            {
+                auto const & lfo( module.lfo( lfoableIndex ) );
+                if ( !lfo.enabled() )
+                    continue;
+                pModules      [ batch.size() ] = &module;
+                lfoableIndices[ batch.size() ] = lfoableIndex;
+                batch.add( lfo );
+                if ( batch.full() )
+                    flush();
+            }
+        }
+    );
+    if ( !batch.empty() )
+        flush();
+}
+#endif // LE_NO_LFOs
+
+LE_NOTHROW LE_COLD
+HopRequirements ModuleChainImpl::setupResolutionLayerAll( Setup const & engineSetup )
+{
+    HopRequirements requirements = { NoSideChannel, Math::CoarseConversion };
+    forEach<Module>
+    (
+        [&]( Module & module )
+        {
+            module.setupResolutionLayer( engineSetup );
+            requirements.sideChannelDemand  = std::max( requirements.sideChannelDemand , module.sideChannelDemand ( engineSetup ) );
+            requirements.conversionAccuracy = std::max( requirements.conversionAccuracy, module.conversionAccuracy( engineSetup ) );
+        }
     );
+    return requirements;
 }
 
 LE_NOTHROW LE_COLD
@@ -11,6 +11,7 @@
 #define moduleChainImpl_hpp__E639274C_2DA1_42EC_9B43_AF42EBB9C987
 #pragma once
 //------------------------------------------------------------------------------
+#include "channelData_fwd.hpp"
 #include "moduleNode.hpp"
 
 #include "le/parameters/lfoImpl.hpp" //...mrmlj...only for the LFOImpl::Timer nested type...
@@ -244,6 +245,11 @@ public:
 
     void LE_FASTCALL remove( Node & );
 
+    /// Changes with every structural change of the chain (module insertion,
+    /// removal, replacement or reordering) so that (module) index based data
+    /// (e.g. ParameterEvents) can detect that it went stale.
+    std::uint32_t structureGeneration() const { return structureGeneration_; }
+
     template <class ActualModule, class Functor>
     void forEach( Functor && f )
     {
@@ -273,6 +279,9 @@ private:
     void LE_FASTCALL resetRoot();
 
     void LE_FASTCALL moveAssign( ModuleChainBase && );
+
+private:
+    std::uint32_t structureGeneration_;
 }; // class ModuleChainBase
 
 
@@ -296,7 +305,16 @@ public:
 #endif // _MSC_VER
     using ModuleChainBase::operator =;
 
-    void LE_NOTHROW LE_FASTCALL preProcessAll( Parameters::LFOImpl::Timer const &, Setup const & );
+    /// Returns the (largest) side channel demand and conversion accuracy of
+    /// the modules that will process the hop (with the parameter values they
+    /// were preprocessed for).
+    /// The LFOs of all the (active) modules are first evaluated together
+    /// (see Parameters::LFOImpl::Batch).
+    HopRequirements LE_NOTHROW LE_FASTCALL preProcessAll( Parameters::LFOImpl::Timer const &, Setup const & );
+
+    /// Sets up the modules for the currently selected (deeper) resolution
+    /// layer, returns the same as preProcessAll().
+    HopRequirements LE_NOTHROW LE_FASTCALL setupResolutionLayerAll( Setup const & );
 
     void LE_NOTHROW resetAll();
 
@@ -305,6 +323,11 @@ public:
         StorageFactors const & newfactors,
         StorageFactors const & currentFactors
     );
+
+#ifndef LE_NO_LFOs
+private:
+    void LE_NOTHROW LE_FASTCALL updateParametersFromLFOs( Parameters::LFOImpl::Timer const & );
+#endif // LE_NO_LFOs
 }; // class ModuleChainImpl
 
 //------------------------------------------------------------------------------
@@ -11,6 +11,7 @@
 #pragma once
 //------------------------------------------------------------------------------
 #include "configuration.hpp"
+#include "effectTraits.hpp"
 #include "module.hpp"
 
 #ifndef LE_NO_LFOs
@@ -34,6 +35,7 @@
 
 #include <array>
 #include <cstdint>
+#include <type_traits>
 #include <utility> // std::(make_)index_sequence
 //------------------------------------------------------------------------------
 #ifdef _MSC_VER // msvc12 does not have std::make_index_sequence
@@ -65,6 +67,8 @@ namespace std
 namespace LE
 {
 //------------------------------------------------------------------------------
+class PitchCurve;
+//------------------------------------------------------------------------------
 namespace Parameters
 {
     template <class Parameter> struct DiscreteValues;
@@ -77,6 +81,8 @@ namespace Parameters
 namespace SW
 {
 //------------------------------------------------------------------------------
+namespace Effects { namespace Detail { class TuneWorxBaseImpl; } }
+//------------------------------------------------------------------------------
 namespace Engine
 {
 //------------------------------------------------------------------------------
@@ -259,100 +265,6 @@ namespace Detail ///< \internal
     template <class Parameters>
     struct ParametersInformation : array_aux<Parameters, ParameterInfo, std::make_index_sequence<Parameters::static_size>> {};
 
-    BOOST_MPL_HAS_XXX_TRAIT_DEF( ChannelState );
-
-    using ChannelDataProxy = Engine::ModuleDSP::ChannelDataProxy;
-
-    struct MakeChannelStateHolder
-    {
-        template <class Effect>
-        struct ChannelStates
-        {
-            using ChannelState      = typename Effect::ChannelState;
-            using ChannelStateRange = boost::iterator_range<ChannelState * LE_RESTRICT>;
-
-            void LE_FORCEINLINE LE_HOT callProcess
-            (
-                Effect           const &       effect,
-                std::uint8_t             const channel,
-                ChannelDataProxy const &       data,
-                Engine::Setup    const &       setup
-            ) const
-            {
-                effect.process( channelStates_[ channel ], data, setup );
-            }
-
-            LE_OPTIMIZE_FOR_SIZE_BEGIN()
-
-            LE_FORCEINLINE void LE_COLD callReset()
-            {
-            #ifndef _MSC_VER
-                LE_DISABLE_LOOP_UNROLLING()
-                LE_DISABLE_LOOP_VECTORIZATION()
-            #endif // _MSC_VER
-                for ( auto & channelState : channelStates_ )
-                    channelState.reset();
-            }
-
-            static std::uint16_t const sizeOfChannelState = sizeof( ChannelState );
-            static std::uint32_t channelStateRequiredStorage( Engine::StorageFactors const & factors ) { return ChannelState::requiredStorage( factors ); }
-
-            LE_FORCEINLINE LE_NOTHROWNOALIAS LE_COLD
-            void LE_FASTCALL resize( Engine::Storage storage, Engine::StorageFactors const & factors )
-            {
-                LE_ASSUME( factors.numberOfChannels <= 16 );
-                char * const pChannelStatesBegin( storage                                                                   .begin() );
-                char * const pChannelStatesEnd  ( storage.advance_begin( sizeof( ChannelState ) * factors.numberOfChannels ).begin() );
-                channelStates_ = ChannelStateRange
-                (
-                    reinterpret_cast<ChannelState *>( pChannelStatesBegin ),
-                    reinterpret_cast<ChannelState *>( pChannelStatesEnd   )
-                );
-                BOOST_ASSERT( unsigned( channelStates_.size() ) == factors.numberOfChannels );
-            #ifndef _MSC_VER
-                LE_DISABLE_LOOP_UNROLLING()
-                LE_DISABLE_LOOP_VECTORIZATION()
-            #endif // _MSC_VER
-                for ( auto & channelState : channelStates_ )
-                {
-                    BOOST_ASSERT( reinterpret_cast<char *>( &channelState ) < storage.end() );
-                    ChannelState * LE_RESTRICT const pNewChannelState( new ( &channelState ) ChannelState );
-                    LE_ASSUME( pNewChannelState );
-                    pNewChannelState->resize( factors, storage );
-                }
-            }
-
-            LE_OPTIMIZE_FOR_SIZE_END()
-
-            ChannelStateRange channelStates_;
-        }; // struct ChannelStates
-    }; // struct MakeChannelStateHolder
-
-    struct MakeEmptyChannelStateHolder
-    {
-        template <class Effect>
-        struct ChannelStates
-        {
-            void LE_FORCEINLINE LE_HOT callProcess
-            (
-                Effect           const & effect,
-                std::uint8_t           /*channel*/,
-                ChannelDataProxy const & data,
-                Engine::Setup    const & setup
-            ) const
-            {
-                effect.process( data, setup ); ((void)effect);
-            }
-
-            static void callReset() {}
-
-            static std::uint8_t const sizeOfChannelState = 0;
-            static std::uint8_t channelStateRequiredStorage( Engine::StorageFactors const & ) { return 0; }
-
-            static void resize( Engine::Storage const &, Engine::StorageFactors const & ) {}
-        }; // struct ChannelStates
-    }; // struct MakeEmptyChannelStateHolder
-
 #if !LE_NO_PARAMETER_STRINGS
 #ifdef __clang__
     #pragma clang diagnostic push
@@ -386,6 +298,9 @@ namespace Detail ///< \internal
     {
         Effect::Parameters::static_size,
         TypeIndex::value,
+        EffectSideChannelDemand <Effect>::value,
+        EffectConversionAccuracy<Effect>::value,
+        EffectModifiesData      <Effect>::value,
         &ParametersInformation <typename Effect::Parameters>::data[ 0 ],
     #if !LE_NO_PARAMETER_STRINGS
         EffectParameterPrinter<typename Effect::Parameters>::print
@@ -423,6 +338,34 @@ namespace Detail ///< \internal
         offset_t,
         std::make_index_sequence<Effect::Parameters::static_size>
     >::data[ 0 ];
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \class PitchCurveFollower
+    ///
+    /// \brief Base of ModuleEffectImpl that, only for the TuneWorx(PVD)
+    /// effects, implements ModuleDSP::doFollowPitchCurve() (batch pitch
+    /// correction) by forwarding the curve to the effect.
+    ////////////////////////////////////////////////////////////////////////////
+
+    template <class Effect, class Base, bool followsPitchCurves = std::is_base_of<Effects::Detail::TuneWorxBaseImpl, Effect>::value>
+    class LE_NOVTABLE PitchCurveFollower : public Base
+    {
+    protected:
+        template <typename ... T>
+        LE_COLD PitchCurveFollower( T && ... args ) : Base( std::forward<T>( args )... ) {}
+    }; // class PitchCurveFollower
+
+    template <class Effect, class Base>
+    class LE_NOVTABLE PitchCurveFollower<Effect, Base, true> : public Base
+    {
+    protected:
+        template <typename ... T>
+        LE_COLD PitchCurveFollower( T && ... args ) : Base( std::forward<T>( args )... ) {}
+
+    private:
+        LE_NOTHROWNOALIAS LE_COLD
+        bool LE_FASTCALL doFollowPitchCurve( PitchCurve const * pPitchCurve ) LE_OVERRIDE;
+    }; // class PitchCurveFollower<..., true>
 } // namespace Detail
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -445,7 +388,7 @@ namespace Detail ///< \internal
 template <class EffectParam, class Base>
 class LE_NOVTABLE ModuleEffectImpl
     :
-    public Base
+    public Detail::PitchCurveFollower<EffectParam, Base>
 {
 public:
     using Effect = EffectParam;
@@ -468,7 +411,7 @@ public:
     LE_COLD
     ModuleEffectImpl( EffectTypeIndex, T && ... args )
         :
-        Base
+        ModuleEffectImpl::PitchCurveFollower
         (
             std::forward<T>( args )...,
             Engine::Detail::MakeEffectMetaData<Effect, EffectTypeIndex>::data,
@@ -514,6 +457,25 @@ protected: // Module process interface implementation.
         channelStatesHolder_.callProcess( effect(), channel, data, setup );
     }
 
+    // Implementation note:
+    //   The layer setups are plain copies of the effect (its parameters and
+    // the values derived from them and the engine setup) in the raw module
+    // storage (see ModuleDSP::allocateStorage()) which is simply overwritten
+    // or released.
+    static_assert( std::is_trivially_destructible<Effect>::value, "Effect layer setups are not destroyed." );
+
+    LE_NOTHROWNOALIAS LE_COLD
+    void LE_FASTCALL doSaveLayerSetup( std::uint8_t const layer ) LE_OVERRIDE
+    {
+        new ( this->layerSetupStorage( layer, sizeof( Effect ) ) ) Effect( effect() );
+    }
+
+    LE_NOTHROWNOALIAS LE_COLD
+    void LE_FASTCALL doRestoreLayerSetup( std::uint8_t const layer ) LE_OVERRIDE
+    {
+        effect() = *static_cast<Effect const *>( this->layerSetupStorage( layer, sizeof( Effect ) ) );
+    }
+
 LE_OPTIMIZE_FOR_SIZE_BEGIN()
 public: //...mrmlj...
     LE_NOINLINE LE_NOTHROWNOALIAS LE_COLD
@@ -525,7 +487,7 @@ private:
     {
         //...mrmlj...au uninitialise...BOOST_ASSERT( factors.complete() );
 
-        if ( ChannelStatesHolder::sizeOfChannelState == 0 )
+        if ( ( ChannelStatesHolder::sizeOfChannelState == 0 ) && ( factors.resolutionLayers <= 1 ) )
         {
             BOOST_ASSERT( channelStatesHolder_.channelStateRequiredStorage( factors ) == 0 );
             return true;
@@ -537,7 +499,8 @@ private:
             (
                 factors,
                 channelStatesHolder_.sizeOfChannelState,
-                channelStatesHolder_.channelStateRequiredStorage( factors )
+                channelStatesHolder_.channelStateRequiredStorage( factors ),
+                sizeof( Effect )
             ) )
         )
         {
@@ -575,6 +538,13 @@ private:
 
 #pragma warning( pop )
 
+template <class Effect, class Base>
+bool Detail::PitchCurveFollower<Effect, Base, true>::doFollowPitchCurve( PitchCurve const * const pPitchCurve )
+{
+    static_cast<ModuleEffectImpl<Effect, Base> &>( *this ).effect().followPitchCurve( pPitchCurve );
+    return true;
+}
+
 
 template <class Effect>
 class ModuleDSP::Impl LE_SEALED
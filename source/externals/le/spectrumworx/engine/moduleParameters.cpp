@@ -42,7 +42,9 @@ ModuleParameters::ModuleParameters
 )
     :
   //moduleSlotIndex_( moduleSlotIndex ),
-    metaData_( metadata )
+    metaData_            ( metadata ),
+    optional_            ( false    ),
+    parametersGeneration_( 0        )
 #ifdef LE_NO_LFOs
     {}
 #else
@@ -85,7 +87,7 @@ namespace
 {
     struct ValueSetter
     {
-        ValueSetter( float const value ) : value_( value ) {}
+        ValueSetter( float const value, bool & changed ) : value_( value ), changed_( changed ) {}
         typedef float result_type;
         template <class Parameter>
         result_type operator()( Parameter & parameter ) const
@@ -95,21 +97,31 @@ namespace
                 !std::is_same<typename Parameter::Tag, LE::Parameters::PowerOfTwoParameterTag>::value,
                 "Automation-to-parameter-value conversion using Plugins::AutomatedParameter::Info is correct only for linear parameters." //...mrmlj...
             );
+            auto const previousValue( parameter.getValue() );
             parameter.setValue( Math::convert<typename Parameter::value_type>( value_ ) );
+            changed_ = ( parameter.getValue() != previousValue );
             return Math::convert<float>( parameter.getValue() );
         }
-        float const value_;
+        float const   value_  ;
+        bool        & changed_;
     }; // struct ValueSetter
 } // anonymous namespace
 LE_COLD LE_NOTHROW
 float ModuleParameters::setBaseParameter( std::uint8_t const baseParameterIndex, float const parameterValue )
 {
-    return LE::Parameters::invokeFunctorOnIndexedParameter
+    bool changed;
+    float const newValue
     (
-        baseParameters(),
-        baseParameterIndex,
-        ValueSetter( parameterValue )
+        LE::Parameters::invokeFunctorOnIndexedParameter
+        (
+            baseParameters(),
+            baseParameterIndex,
+            ValueSetter( parameterValue, changed )
+        )
     );
+    if ( changed )
+        parametersChanged();
+    return newValue;
 }
 
 #ifdef __clang__
@@ -172,26 +184,6 @@ ModuleParameters::LFOs ModuleParameters::lfos() const
     return LFOs( pLFOs_, pLFOs_ + numberOfLFOControledParameters() );
 }
 
-LE_COLD LE_NOTHROW
-void ModuleParameters::updateBaseParametersFromLFOs( LFO::Timer const & timer )
-{
-    LE_DISABLE_LOOP_UNROLLING()
-    for
-    (
-        std::uint8_t baseParameter( numberOfNonLFOBaseParameters );
-        baseParameter < numberOfBaseParameters;
-        ++baseParameter
-    )
-    {
-        LFO const & parameterLFO( baseLFO( baseParameter - numberOfNonLFOBaseParameters ) );
-        if ( parameterLFO.enabled() )
-        {
-            auto const lfoValue( parameterLFO.getValue( timer ) );
-            setBaseParameterFromLFO( baseParameter, lfoValue );
-        }
-    }
-}
-
 /// \note Up to SVN revision 8952 many more parameter related operations were
 /// lowered to the individual/specific ModuleImpl<> instantiations. This, for
 /// example, enabled both the parameters and their corresponding widgets to be
@@ -214,18 +206,13 @@ void ModuleParameters::updateBaseParametersFromLFOs( LFO::Timer const & timer )
 ///    information, many more virtual function calls...).
 ///                                           (07.02.2014.) (Domagoj Saric)
 LE_COLD LE_NOTHROW
-void ModuleParameters::updateEffectParametersFromLFOs( LFO::Timer const & timer )
+void ModuleParameters::setParameterFromLFO( std::uint8_t const lfoableParameterIndex, LFO::value_type const lfoValue )
 {
-    auto const numberOfEffectSpecificParameters( this->numberOfEffectSpecificParameters() );
-    for ( std::uint8_t effectParameter( 0 ); effectParameter < numberOfEffectSpecificParameters; ++effectParameter )
-    {
-        LFO const & parameterLFO( effectLFO( effectParameter ) );
-        if ( parameterLFO.enabled() )
-        {
-            auto const lfoValue( parameterLFO.getValue( timer ) );
-            setEffectParameterFromLFO( effectParameter, lfoValue );
-        }
-    }
+    BOOST_ASSERT( lfoableParameterIndex < numberOfLFOControledParameters() );
+    if ( lfoableParameterIndex < numberOfLFOBaseParameters )
+        setBaseParameterFromLFO  ( lfoableParameterIndex + numberOfNonLFOBaseParameters, lfoValue );
+    else
+        setEffectParameterFromLFO( lfoableParameterIndex - numberOfLFOBaseParameters   , lfoValue );
 }
 
 LE_COLD LE_NOTHROW
@@ -306,6 +293,8 @@ void ModuleParameters::loadPresetParameters( ParametersLoader const & parameterL
             setBaseParameter( 0, *bypassValue ); //...mrmlj...assumes bypass is the first parameter/@ index 0
     }
 
+    setOptional( parameterLoader.getSimpleParameterValue<bool>( "Optional" ).get_value_or( false ) );
+
     for ( std::uint8_t i( 1 ); i < numberOfBaseParameters; ++i )
     {
         auto const parameterValueWithoutLFO
@@ -335,6 +324,8 @@ void ModuleParameters::savePresetParameters( ParametersSaver const & parameterSa
     ParametersSaver & saver( const_cast<ParametersSaver &>( parameterSaver ) ); //...mrmlj...
 
     saver.saveParameter<bool>( LE::Parameters::Name<Effects::BaseParameters::Bypass>::string_, bypass() );
+    if ( optional() )
+        saver.saveParameter<bool>( "Optional", true );
 
     for ( std::uint8_t i( 1 ); i < numberOfBaseParameters; ++i )
     {
@@ -11,6 +11,7 @@
 #define moduleParameters_hpp__F444F629_3EBC_4840_BFA4_817E1218B10D
 #pragma once
 //------------------------------------------------------------------------------
+#include "channelData_fwd.hpp"
 #include "moduleNode.hpp"
 
 #include "le/parameters/lfoImpl.hpp"
@@ -73,6 +74,15 @@ public:
 public:
     bool bypass() const;
 
+    /// \brief Modules flagged as optional get bypassed by the core engine
+    /// while it is shedding load (see Setup::shedOptionalModules()).
+    bool optional   (                    ) const { return optional_; }
+    void setOptional( bool const optional )       { optional_ = optional; }
+
+    /// \brief Incremented by every parameter write that actually changes a
+    /// value (including LFO driven ones), see ModuleDSP::preProcess().
+    std::uint32_t parametersGeneration() const { return parametersGeneration_; }
+
     BaseParameters       & baseParameters()       { return baseParameters_; }
     BaseParameters const & baseParameters() const { return baseParameters_; }
 
@@ -119,6 +129,12 @@ public: // LFO section
     LFO       & effectLFO( std::uint8_t index )       { return lfos()[ numberOfLFOBaseParameters + index ]; }
     LFO const & effectLFO( std::uint8_t index ) const { return const_cast<ModuleParameters &>( *this ).effectLFO( index ); }
 
+#ifndef LE_NO_LFOs
+    /// Sets the (base or effect specific) parameter controlled by the given LFO
+    /// from its value (see ModuleChainImpl::preProcessAll()).
+    void LE_FASTCALL setParameterFromLFO( std::uint8_t lfoableParameterIndex, LFO::value_type );
+#endif // LE_NO_LFOs
+
     static LFO::value_type   LE_FASTCALL normalisedToParameterValue( parameter_value_t normalisedValue, ParameterInfo const & );
     static parameter_value_t LE_FASTCALL parameterToNormalisedValue( LFO::value_type   parameterValue , ParameterInfo const & );
 
@@ -154,6 +170,9 @@ public:
 
         std::uint8_t                      const numberOfExtraParameters;
         std::uint8_t                      const typeIndex_             ;
+        SideChannelDemand                 const sideChannelDemand      ;
+        Math::ConversionAccuracy          const conversionAccuracy     ;
+        bool                              const modifiesData           ;
         ParameterInfo const * LE_RESTRICT const pParameterInfos        ;
     #if !LE_NO_PARAMETER_STRINGS
         GetParameterValueString &               getParameterValueString;
@@ -179,6 +198,8 @@ protected:
     #endif
     );
 
+    void parametersChanged() { ++parametersGeneration_; }
+
 #ifndef LE_NO_PRESETS
 public: // Presets
     void LE_FASTCALL loadPresetParameters( ParametersLoader const & )      ;
@@ -189,11 +210,6 @@ public: // Presets
 
 #ifndef LE_NO_LFOs
 protected:
-    void LE_FASTCALL updateBaseParametersFromLFOs  ( LFO::Timer const & );
-    void LE_FASTCALL updateEffectParametersFromLFOs( LFO::Timer const & );
-
-    //...mrmlj...make ModuleDSP::preProcess() call SW::Module::set*ParameterFromLFO()...
-    //...mrmlj...and make ModuleChainImpl::preProcessAll() non template...
     parameter_value_t LE_FASTCALL setBaseParameterFromLFOAux  ( std::uint8_t parameterIndex, LFO::value_type );
     parameter_value_t LE_FASTCALL setEffectParameterFromLFOAux( std::uint8_t parameterIndex, LFO::value_type );
 
@@ -224,6 +240,8 @@ private:
   //std::uint8_t                             moduleSlotIndex_;
     EffectMetaData const &                   metaData_;
     BaseParameters                           baseParameters_;
+    bool                                     optional_;
+    std::uint32_t                            parametersGeneration_;
 #ifndef LE_NO_LFOs
     LFO                  * LE_RESTRICT const pLFOs_;
 #endif
@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// parameterEvents.cpp
+/// -------------------
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#include "parameterEvents.hpp"
+
+#include "module.hpp"
+#include "moduleChainImpl.hpp"
+
+#include "le/utility/binaryTrace.hpp"
+
+#include "boost/assert.hpp"
+
+#include <algorithm>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_BEGIN( Engine )
+//------------------------------------------------------------------------------
+
+namespace
+{
+    float getParameter( ModuleDSP const & module, std::uint8_t const parameterIndex )
+    {
+        return ( parameterIndex < ModuleParameters::numberOfBaseParameters )
+            ? module.getBaseParameter  (                                                 parameterIndex   )
+            : module.getEffectParameter( ModuleParameters::effectSpecificParameterIndex( parameterIndex ) );
+    }
+
+    void setParameter( ModuleDSP & module, std::uint8_t const parameterIndex, float const value )
+    {
+        if ( parameterIndex < ModuleParameters::numberOfBaseParameters )
+            module.setBaseParameter  (                                                 parameterIndex  , value );
+        else
+            module.setEffectParameter( ModuleParameters::effectSpecificParameterIndex( parameterIndex ), value );
+    }
+} // anonymous namespace
+
+
+bool ParameterEvents::stale( ModuleChainImpl const & modules ) const
+{
+    return ( pChain_ != &modules ) || ( chainGeneration_ != modules.structureGeneration() );
+}
+
+
+bool ParameterEvents::push( Event const & event, ModuleChainImpl const & modules )
+{
+    if ( stale( modules ) )
+    {
+        // Events queued for a different chain structure address the wrong
+        // modules.
+        size_            = 0;
+        pChain_          = &modules;
+        chainGeneration_ = modules.structureGeneration();
+    }
+    if ( BOOST_UNLIKELY( size_ == capacity ) )
+    {
+        LE_TRACE_RT( Engine, "parameter event queue full." );
+        return false;
+    }
+    events_[ size_++ ] = event;
+    return true;
+}
+
+
+bool ParameterEvents::schedule
+(
+    ModuleChainImpl const & modules,
+    std::uint8_t    const   moduleIndex,
+    std::uint8_t    const   parameterIndex,
+    float           const   value,
+    bool            const   continuous,
+    std::uint32_t   const   sampleOffset
+)
+{
+    auto const position( static_cast<std::int32_t>( sampleOffset ) );
+    Event event = { position, position, value, value, moduleIndex, parameterIndex, true };
+    if ( continuous )
+    {
+        // Ramp from the previous point of the same parameter.
+        event.begin      = 0;
+        event.startKnown = false;
+        for ( std::uint16_t index( stale( modules ) ? 0 : size_ ); index--; )
+        {
+            Event const & previous( events_[ index ] );
+            if ( ( previous.moduleIndex == moduleIndex ) && ( previous.parameterIndex == parameterIndex ) )
+            {
+                event.begin = std::min( previous.end, position );
+                break;
+            }
+        }
+    }
+    return push( event, modules );
+}
+
+
+bool ParameterEvents::scheduleRamp
+(
+    ModuleChainImpl const & modules,
+    std::uint8_t    const   moduleIndex,
+    std::uint8_t    const   parameterIndex,
+    float           const   startValue,
+    float           const   endValue,
+    std::uint32_t   const   sampleOffset,
+    std::uint32_t   const   duration
+)
+{
+    auto const begin( static_cast<std::int32_t>( sampleOffset ) );
+    Event const event = { begin, begin + static_cast<std::int32_t>( duration ), startValue, endValue, moduleIndex, parameterIndex, true };
+    return push( event, modules );
+}
+
+
+LE_NOTHROW
+void ParameterEvents::apply( std::uint32_t const hopPosition, ModuleChainImpl & modules )
+{
+    if ( BOOST_UNLIKELY( stale( modules ) ) )
+    {
+        LE_TRACE_RT( Engine, "module chain changed, dropping pending parameter events." );
+        clear();
+        return;
+    }
+
+    auto const position( static_cast<std::int32_t>( hopPosition ) );
+    std::uint16_t pending( 0 );
+    for ( std::uint16_t index( 0 ); index < size_; ++index )
+    {
+        Event event( events_[ index ] );
+        if ( event.begin > position )
+        {
+            events_[ pending++ ] = event;
+            continue;
+        }
+
+        auto const pModule( modules.module( event.moduleIndex ) );
+        if ( modules.isEnd( pModule ) )
+            continue;
+        auto & module( actualModule<ModuleDSP>( *pModule ) );
+        if ( event.parameterIndex >= module.numberOfParameters() )
+            continue;
+
+        bool const finished( position >= event.end );
+        float value;
+        if ( finished )
+        {
+            value = event.endValue;
+        }
+        else
+        {
+            if ( !event.startKnown )
+            {
+                event.startValue = getParameter( module, event.parameterIndex );
+                event.startKnown = true;
+            }
+            float const progress( static_cast<float>( position - event.begin ) / static_cast<float>( event.end - event.begin ) );
+            value = event.startValue + ( event.endValue - event.startValue ) * progress;
+            events_[ pending++ ] = event;
+        }
+        setParameter( module, event.parameterIndex, value );
+    }
+    size_ = pending;
+}
+
+
+void ParameterEvents::advance( std::uint32_t const blockSize )
+{
+    auto const shift( static_cast<std::int32_t>( blockSize ) );
+    for ( std::uint16_t index( 0 ); index < size_; ++index )
+    {
+        events_[ index ].begin -= shift;
+        events_[ index ].end   -= shift;
+    }
+}
+
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_END( Engine )
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
@@ -0,0 +1,114 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file parameterEvents.hpp
+/// -------------------------
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef parameterEvents_hpp__5E2A7C91_0B3D_4F84_8C61_D94A2E7B13F0
+#define parameterEvents_hpp__5E2A7C91_0B3D_4F84_8C61_D94A2E7B13F0
+#pragma once
+//------------------------------------------------------------------------------
+#include "configuration.hpp"
+
+#include "le/utility/platformSpecifics.hpp"
+
+#include <array>
+#include <cstdint>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_BEGIN( Engine )
+//------------------------------------------------------------------------------
+
+class ModuleChainImpl;
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class ParameterEvents
+///
+/// \brief Preallocated queue of timestamped module parameter changes.
+///
+///   Events are positioned in samples relative to the start of the next
+/// process() call and the Processor applies them at the STFT hop they fall in
+/// (i.e. each hop sees the parameter values for its own position in the
+/// block). Changes of continuous parameters are ramped linearly from the
+/// previous point scheduled for the same parameter (or the start of the block)
+/// so hops in between get interpolated values instead of a single jump.
+///
+///   Modules are addressed by their position in the module chain (the same
+/// way the host addresses them) so the queue is tied to the structure of the
+/// chain it was filled for: any change of the chain (module insertion,
+/// removal, replacement or reordering, preset or program loads) discards all
+/// the pending events (see ModuleChainBase::structureGeneration()).
+/// Parameters are indexed as in
+/// ModuleBase::setParameter() (base parameters first) and carry internal
+/// (not automation) values.
+///
+///   Not thread safe: scheduling and processing must be serialised by the
+/// process lock.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class ParameterEvents
+{
+public:
+    static std::uint16_t BOOST_CONSTEXPR_OR_CONST capacity = 256;
+
+    ParameterEvents() : pChain_( nullptr ), chainGeneration_( 0 ), size_( 0 ) {}
+
+    /// Returns false if the queue is full (the caller should then apply the
+    /// change immediately).
+    bool LE_FASTCALL schedule    ( ModuleChainImpl const &, std::uint8_t moduleIndex, std::uint8_t parameterIndex, float value, bool continuous, std::uint32_t sampleOffset );
+    bool LE_FASTCALL scheduleRamp( ModuleChainImpl const &, std::uint8_t moduleIndex, std::uint8_t parameterIndex, float startValue, float endValue, std::uint32_t sampleOffset, std::uint32_t duration );
+
+    bool empty() const { return size_ == 0; }
+
+    void clear() { size_ = 0; }
+
+    /// Applies (and removes the completed) events for the hop at the given
+    /// position (or drops all of them if the chain changed since they were
+    /// scheduled).
+    void LE_FASTCALL apply( std::uint32_t hopPosition, ModuleChainImpl & );
+
+    /// Rebases the pending events (ramps still in progress and events
+    /// positioned after the last hop) to the start of the next block.
+    void LE_FASTCALL advance( std::uint32_t blockSize );
+
+private:
+    struct Event
+    {
+        std::int32_t begin         ;
+        std::int32_t end           ;
+        float        startValue    ;
+        float        endValue      ;
+        std::uint8_t moduleIndex   ;
+        std::uint8_t parameterIndex;
+        bool         startKnown    ; // otherwise captured when the ramp starts
+    }; // struct Event
+
+    bool LE_FASTCALL push( Event const &, ModuleChainImpl const & );
+
+    bool LE_FASTCALL stale( ModuleChainImpl const & ) const;
+
+private:
+    std::array<Event, capacity> events_         ;
+    ModuleChainImpl const *     pChain_         ;
+    std::uint32_t               chainGeneration_;
+    std::uint16_t               size_           ;
+}; // class ParameterEvents
+
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_END( Engine )
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // parameterEvents_hpp
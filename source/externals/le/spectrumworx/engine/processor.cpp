@@ -11,6 +11,7 @@
 
 #include "module.hpp"
 #include "moduleChainImpl.hpp"
+#include "staticChain.hpp"
 
 #include "le/math/conversion.hpp"
 #include "le/math/math.hpp"
@@ -28,6 +29,7 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <cstddef>
 //------------------------------------------------------------------------------
 namespace LE
 {
@@ -38,10 +40,50 @@ namespace SW
 LE_IMPL_NAMESPACE_BEGIN( Engine )
 //------------------------------------------------------------------------------
 
+LE_COLD
+Processor::Processor()
+    :
+    pCurrentChannelData_( nullptr                                 ),
+    pCurrentModule_     ( nullptr                                 ),
+    pFixedChain_        ( nullptr                                 ),
+    callSamples_        ( 0                                       ),
+    hopPosition_        ( 0                                       ),
+    preProcessPending_  ( false                                   ),
+    hopRequirements_    ( { NoSideChannel, Math::FullConversion } )
+#ifndef LE_NO_LFOs
+   ,lfoHopTimeInBars_   ( 0                                       )
+#endif // LE_NO_LFOs
+{}
+
+
 LE_NOTHROW
 void Processor::preProcess()
 {
-    modules().preProcessAll( lfoTimer(), engineSetup() );
+    if ( pFixedChain_ )
+    {
+        hopRequirements_ = pFixedChain_->preProcess( engineSetup() );
+        return;
+    }
+
+    if ( !parameterEvents_.empty() )
+        parameterEvents_.apply( hopPosition_, modules() );
+
+#ifdef LE_NO_LFOs
+    hopRequirements_ = modules().preProcessAll( lfoTimer(), engineSetup() );
+#else
+    // Implementation note:
+    //   The LFOs are evaluated at the hop's position between the two most
+    // recent timer updates. The evaluated interval starts at the previous hop
+    // (so that period boundaries are detected exactly once) unless the
+    // position jumped in the meantime.
+    auto const & timer  ( lfoTimer() );
+    auto const   hopTime( timer.timeInBars( Math::convert<float>( hopPosition_ ) / Math::convert<float>( callSamples_ ) ) );
+    auto const   span   ( timer.currentTimeInBars() - timer.previousTimeInBars() );
+    bool const   continuous( ( lfoHopTimeInBars_ <= hopTime ) && ( lfoHopTimeInBars_ >= timer.previousTimeInBars() - span ) );
+    LFO::Timer const hopTimer( timer.between( continuous ? lfoHopTimeInBars_ : timer.previousTimeInBars(), hopTime ) );
+    lfoHopTimeInBars_ = hopTime;
+    hopRequirements_  = modules().preProcessAll( hopTimer, engineSetup() );
+#endif // LE_NO_LFOs
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -58,6 +100,7 @@ public:
         InputData  inputs,
         InputData  sideChannel,
         OutputData outputs,
+        std::uint8_t  stride,
         Channels const & channels,
         std::uint32_t numberOfSamples,
         float         outputGain,
@@ -66,19 +109,21 @@ public:
     ProcessParameters( ProcessParameters const & ) = delete;
 
     std::uint8_t  currentChannel () const { return currentChannel_ ; }
-    std::uint32_t numberOfSamples() const { return numberOfSamples_; }
+    std::uint32_t numberOfSamples() const { return numberOfSamples_; } ///< of the current chunk
+    std::uint8_t  stride         () const { return stride_         ; } ///< distance between consecutive samples of a channel (the number of channels for interleaved data)
+    std::uint32_t chunkEnd       () const { return offset_ + numberOfSamples_; }
 
     float const & mixPercentage() const { return mixPercentage_; }
     float const & outputScaling() const { return outputScaling_; } ///< Combined postAmp and mixPercentage
 
     bool doMix() const { return doMix_; }
 
-    float const * mainChannel   () const { LE_ASSUME( *ppMainChannels_ ); return *ppMainChannels_; }
-    float const * sideChannel   () const {                                return *ppSideChannels_; }
+    float const * mainChannel   () const { LE_ASSUME( *ppMainChannels_ ); return *ppMainChannels_ + offset_ * stride_; }
+    float const * sideChannel   () const { return *ppSideChannels_ ? *ppSideChannels_ + offset_ * stride_ : nullptr; }
 #ifdef LE_SW_PURE_ANALYSIS
     float       * output        () const { return nullptr; }
 #else
-    float       * output        () const { BOOST_ASSERT( pOutput_ ); return *pOutput_; }
+    float       * output        () const { BOOST_ASSERT( pOutput_ ); return *pOutput_ + offset_ * stride_; }
 #endif // LE_SW_PURE_ANALYSIS
     ChannelBuffers & channelBuffers() const { return channelBuffers_.front(); }
 
@@ -97,6 +142,29 @@ public:
         else                                       return false;
     }
 
+    /// Moves back to the first channel (of the current chunk).
+    void setFirstChannel()
+    {
+        ppMainChannels_ -= currentChannel_;
+        pOutput_        -= currentChannel_;
+        channelBuffers_.advance_begin( -static_cast<std::ptrdiff_t>( currentChannel_ ) );
+        if ( sideChannels_ )
+            ppSideChannels_ -= currentChannel_;
+        currentChannel_ = 0;
+    }
+
+    /// Moves on to the next chunk of the block (of at most maximumSize
+    /// samples) and back to the first channel. Returns false at the end of
+    /// the block.
+    bool setNextChunk( std::uint32_t const maximumSize )
+    {
+        setFirstChannel();
+
+        offset_         += numberOfSamples_;
+        numberOfSamples_ = std::min( blockSize_ - offset_, maximumSize );
+        return numberOfSamples_ != 0;
+    }
+
 private:
     InputData  ppMainChannels_;
     InputData  ppSideChannels_;
@@ -104,9 +172,13 @@ private:
 
     boost::iterator_range<ChannelBuffers * LE_RESTRICT> channelBuffers_;
 
-    std::uint8_t currentChannel_;
+    std::uint8_t       currentChannel_;
+    std::uint8_t const stride_        ;
+    bool         const sideChannels_  ;
 
-    std::uint32_t const numberOfSamples_;
+    std::uint32_t const blockSize_      ;
+    std::uint32_t       offset_         ;
+    std::uint32_t       numberOfSamples_;
 
     float const mixPercentage_;
     float const outputScaling_;
@@ -144,24 +216,23 @@ void Processor::process /// \throws nothing
     Math::FPUDisableDenormalsGuard const disableDenormals;
 #endif // LE_SW_SDK_BUILD
 
-    preProcess();
+    callSamples_ = samples;
 
     ProcessParameters processParameters
     (
         mainInputs,
         sideInputs,
         outputs   ,
+        1         ,
         channels_ ,
         samples   ,
         outputGain,
         mixAmount
     );
 
-    do
-    {
-        processSingleChannel( processParameters );
-    }
-    while ( processParameters.setNextChannel( engineSetup().numberOfChannels() ) );
+    processBlock( processParameters, 0 );
+
+    parameterEvents_.advance( samples );
 }
 
 
@@ -212,6 +283,26 @@ namespace
         BOOST_SIMD_ALIGNED_STACK_BUFFER( resultPointer##DeinterLeavedDataStorage , float  , size * numberOfChannels );                                       \
         BOOST_SIMD_ALIGNED_STACK_BUFFER( resultPointer##DeinterLeavedDataPointers, float *,        numberOfChannels );                                       \
         resultPointer = makeDeinterLeaveBuffers( resultPointer##DeinterLeavedDataStorage, resultPointer##DeinterLeavedDataPointers, size, numberOfChannels )
+
+    float * * LE_FASTCALL makeInterleavedChannelPointers
+    (
+        boost::iterator_range<float * *> const channelPointers,
+        float const *                    const pInterleavedData,
+        std::uint8_t                     const numberOfChannels
+    )
+    {
+        LE_ASSUME( channelPointers.begin() );
+        LE_DISABLE_LOOP_VECTORIZATION()
+        for ( std::uint8_t channel( 0 ); channel < numberOfChannels; ++channel )
+            channelPointers[ channel ] = const_cast<float *>( pInterleavedData ) + channel;
+        return channelPointers.begin();
+    }
+
+    /// Points the channels directly into the interleaved data (to be accessed
+    /// with a stride equal to the number of channels).
+    #define LE_MAKE_INTERLEAVED_CHANNEL_POINTERS( resultPointer, pInterleavedData, numberOfChannels )                                                        \
+        BOOST_SIMD_ALIGNED_STACK_BUFFER( resultPointer##ChannelPointers, float *, numberOfChannels );                                                        \
+        resultPointer = makeInterleavedChannelPointers( resultPointer##ChannelPointers, pInterleavedData, numberOfChannels )
 } // anonymous namespace
 
 LE_NOTHROWNOALIAS
@@ -249,12 +340,48 @@ void Processor::process /// \throws nothing
     Math::FPUDisableDenormalsGuard const disableDenormals;
 #endif // LE_SW_SDK_BUILD
 
-    preProcess();
+    callSamples_ = samples;
 
     float const * LE_RESTRICT const * LE_RESTRICT mainInputs;
     float const * LE_RESTRICT const * LE_RESTRICT sideInputs;
     float       * LE_RESTRICT const * LE_RESTRICT outputs   ;
 
+    // Implementation note:
+    //   The input FIFOs and the output OLA read-out work directly with the
+    // interleaved (strided) data so that no deinterleaving/interleaving
+    // copies (and stack buffers) are needed. Only the multi-resolution mode
+    // (whose decimation and layer delay lines work with contiguous channel
+    // data) still goes through the deinterleaved, block-wise, path below.
+    if ( BOOST_LIKELY( resolutionLayers_.numberOfLayers() == 1 ) )
+    {
+        LE_MAKE_INTERLEAVED_CHANNEL_POINTERS( mainInputs, interleavedMainInputs, numberOfChannels );
+        if ( interleavedSideInputs ) { LE_MAKE_INTERLEAVED_CHANNEL_POINTERS( sideInputs, interleavedSideInputs, numberOfChannels ); }
+        else                         { sideInputs = nullptr; }
+    #ifdef LE_SW_PURE_ANALYSIS
+        outputs = nullptr;
+    #else
+        LE_MAKE_INTERLEAVED_CHANNEL_POINTERS( outputs, interleavedOutputs, numberOfChannels );
+    #endif // LE_SW_PURE_ANALYSIS
+
+        ProcessParameters processParameters
+        (
+            mainInputs,
+            sideInputs,
+            outputs   ,
+            numberOfChannels,
+            channels_ ,
+            samples   ,
+            outputGain,
+            mixAmount
+        );
+
+        processBlock( processParameters, 0 );
+
+        parameterEvents_.advance( samples );
+        return;
+    }
+
+    std::uint32_t blockPosition( 0 );
     std::uint32_t processBlockSize;
 
 #ifdef LE_MELODIFY_SDK_BUILD
@@ -301,17 +428,14 @@ void Processor::process /// \throws nothing
             mainInputs,
             sideInputs,
             outputs   ,
+            1         ,
             channels_ ,
             processBlockSize,
             outputGain,
             mixAmount
         );
 
-        do
-        {
-            processSingleChannel( processParameters );
-        }
-        while ( processParameters.setNextChannel( numberOfChannels ) );
+        processBlock( processParameters, blockPosition );
 
         if ( numberOfChannels != 1 )
         {
@@ -324,10 +448,129 @@ void Processor::process /// \throws nothing
         #ifndef LE_SW_PURE_ANALYSIS
                                          interleavedOutputs    += processBlockSize * numberOfChannels;
         #endif // LE_SW_PURE_ANALYSIS
+        }
+
+        blockPosition += processBlockSize;
+        samples       -= processBlockSize;
+    }
+
+    parameterEvents_.advance( callSamples_ );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Processor::processBlock()
+// -------------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Processes the block in chunks that end exactly where the next hop
+/// happens so that every hop can be given the parameter values (events, LFOs)
+/// for its own position within the process() call.
+///
+/// In the multi-resolution mode each chunk is, after the first layer,
+/// processed by the deeper layers (whose hops coincide with the first
+/// layer's, see ResolutionLayers).
+///
+////////////////////////////////////////////////////////////////////////////////
+
+LE_NOTHROW
+void Processor::processBlock( ProcessParameters & processParameters, std::uint32_t const blockPosition ) /// \throws nothing
+{
+    auto const numberOfChannels( engineSetup().numberOfChannels() );
+    bool const layered         ( resolutionLayers_.numberOfLayers() > 1 );
+    while ( processParameters.setNextChunk( samplesUntilNextHop() ) )
+    {
+        hopPosition_       = blockPosition + processParameters.chunkEnd();
+        preProcessPending_ = true;
+        do
+        {
+            // (before the first layer overwrites in-place processed input)
+            if ( BOOST_UNLIKELY( layered ) )
+                resolutionLayers_.decimate( processParameters.currentChannel(), processParameters.mainChannel(), processParameters.sideChannel(), static_cast<std::uint16_t>( processParameters.numberOfSamples() ) );
 
-            samples -= processBlockSize;
+            processSingleChannel
+            (
+                processParameters,
+                processParameters.channelBuffers (),
+                processParameters.currentChannel (),
+                processParameters.mainChannel    (),
+                processParameters.sideChannel    (),
+                processParameters.numberOfSamples(),
+                processParameters.output         (),
+                processParameters.stride         ()
+            );
+
+        #ifndef LE_SW_PURE_ANALYSIS
+            if ( BOOST_UNLIKELY( layered ) )
+                resolutionLayers_.delayFirstLayerOutput( processParameters.currentChannel(), processParameters.output(), static_cast<std::uint16_t>( processParameters.numberOfSamples() ) );
+        #endif // LE_SW_PURE_ANALYSIS
+        }
+        while ( processParameters.setNextChannel( numberOfChannels ) );
+
+        if ( BOOST_UNLIKELY( layered ) )
+            processDeeperLayers( processParameters, numberOfChannels );
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Processor::processDeeperLayers()
+// --------------------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+///
+/// Processes the current chunk with the deeper resolution layers (with the
+/// engine setup switched to each of them in turn) and adds their outputs to
+/// the (already delayed) output of the first layer.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+LE_NOTHROW
+void Processor::processDeeperLayers( ProcessParameters & processParameters, std::uint8_t const numberOfChannels ) /// \throws nothing
+{
+    for ( std::uint8_t layer( 1 ); layer < resolutionLayers_.numberOfLayers(); ++layer )
+    {
+        engineSetup().selectResolutionLayer( layer );
+        preProcessPending_ = true;
+        processParameters.setFirstChannel();
+        do
+        {
+            auto const channel     ( processParameters.currentChannel()                            );
+            auto const layerChannel( static_cast<std::uint8_t>( layer * numberOfChannels + channel ) );
+            processSingleChannel
+            (
+                processParameters,
+                channels_[ layerChannel ],
+                layerChannel,
+                resolutionLayers_.decimatedMainInput( channel, layer ),
+                processParameters.haveSideChannel() ? resolutionLayers_.decimatedSideInput( channel, layer ) : nullptr,
+                resolutionLayers_.decimatedSamples( channel, layer ),
+            #ifdef LE_SW_PURE_ANALYSIS
+                nullptr,
+            #else
+                resolutionLayers_.layerOutput( channel, layer ),
+            #endif // LE_SW_PURE_ANALYSIS
+                1
+            );
+        #ifndef LE_SW_PURE_ANALYSIS
+            resolutionLayers_.addLayerOutput( channel, layer, processParameters.output(), static_cast<std::uint16_t>( processParameters.numberOfSamples() ) );
+        #endif // LE_SW_PURE_ANALYSIS
         }
+        while ( processParameters.setNextChannel( numberOfChannels ) );
     }
+    engineSetup().selectResolutionLayer( 0 );
+}
+
+
+std::uint16_t Processor::samplesUntilNextHop() const
+{
+    auto const inputDataSize( channels_[ 0 ].inputDataSize() );
+    auto const windowSize   ( engineSetup().windowSize<std::uint16_t>() );
+    BOOST_ASSERT_MSG( inputDataSize < windowSize, "Unprocessed hop." );
+    return windowSize - inputDataSize;
 }
 
 
@@ -339,7 +582,17 @@ void Processor::process /// \throws nothing
 ////////////////////////////////////////////////////////////////////////////////
 
 LE_NOTHROW
-void Processor::processSingleChannel( ProcessParameters const & processParameters ) /// \throws nothing
+void Processor::processSingleChannel /// \throws nothing
+(
+    ProcessParameters const &                    processParameters,
+    ChannelBuffers          &                    channelBuffers,
+    std::uint8_t                           const moduleChannel,
+    float const             * LE_RESTRICT        pCompleteNewInput,
+    float const             * LE_RESTRICT        pCompleteNewSideChannel,
+    std::uint32_t                                inputSamples,
+    float                   * LE_RESTRICT        pOutput,
+    std::uint8_t                           const stride
+)
 {
     auto const stepSize        ( engineSetup().stepSize  <std::uint16_t>() );
     auto const windowSizeFactor( engineSetup().windowSizeFactor         () );
@@ -360,12 +613,9 @@ void Processor::processSingleChannel( ProcessParameters const & processParameter
     std::uint16_t const incompleteOutputDataSizeFromPreviousSteps( windowSize - stepSize );
 #endif // !LE_SW_PURE_ANALYSIS
 
-    float const    * LE_RESTRICT        pCompleteNewInput      ( processParameters.mainChannel    () );
-    float const    * LE_RESTRICT        pCompleteNewSideChannel( processParameters.sideChannel    () );
-    std::uint32_t                       inputSamples           ( processParameters.numberOfSamples() );
-    bool                          const useSideChannel         ( processParameters.haveSideChannel() );
-    ChannelBuffers &                    channelBuffers         ( processParameters.channelBuffers () );
-    float          * LE_RESTRICT        pOutput                ( processParameters.output         () );
+    bool          const useSideChannel( pCompleteNewSideChannel != nullptr              );
+    std::uint8_t  const layer         ( engineSetup().resolutionLayer()                 );
+    bool          const layered       ( resolutionLayers_.numberOfLayers() > 1          );
 
 #ifdef LE_SW_PURE_ANALYSIS
     LE_ASSUME( useSideChannel          == false   );
@@ -375,8 +625,10 @@ void Processor::processSingleChannel( ProcessParameters const & processParameter
 
     using namespace Math;
 
-    LE_MATH_VERIFY_VALUES( Math::InvalidOrSlow, ReadOnlyDataRange( pCompleteNewInput      , pCompleteNewInput       +                             inputSamples       ), "main input" );
-    LE_MATH_VERIFY_VALUES( Math::InvalidOrSlow, ReadOnlyDataRange( pCompleteNewSideChannel, pCompleteNewSideChannel + ( pCompleteNewSideChannel ? inputSamples : 0 ) ), "side input" );
+    // (strided input is verified by the interleaved process() overload)
+    std::uint32_t const samplesToVerify( stride == 1 ? inputSamples : 0 );
+    LE_MATH_VERIFY_VALUES( Math::InvalidOrSlow, ReadOnlyDataRange( pCompleteNewInput      , pCompleteNewInput       +                             samplesToVerify       ), "main input" );
+    LE_MATH_VERIFY_VALUES( Math::InvalidOrSlow, ReadOnlyDataRange( pCompleteNewSideChannel, pCompleteNewSideChannel + ( pCompleteNewSideChannel ? samplesToVerify : 0 ) ), "side input" );
 
     while ( inputSamples )
     {
@@ -386,7 +638,7 @@ void Processor::processSingleChannel( ProcessParameters const & processParameter
         std::uint16_t const neededData   ( windowSize - previousData      );
         std::uint16_t const sizeToConsume( static_cast<std::uint16_t>( std::min<std::uint32_t>( neededData, inputSamples ) ) );
 
-        channelBuffers.addNewData( pCompleteNewInput, pCompleteNewSideChannel, sizeToConsume, useSideChannel );
+        channelBuffers.addNewData( pCompleteNewInput, pCompleteNewSideChannel, sizeToConsume, stride, useSideChannel );
         BOOST_ASSERT_MSG( channelBuffers.inputDataSize() <= windowSize, "Too much data consumed." );
         inputSamples -= sizeToConsume;
 
@@ -400,6 +652,17 @@ void Processor::processSingleChannel( ProcessParameters const & processParameter
             ( channelBuffers.readyOutputDataSize() <= channelBuffers.outputBufferSize() - windowSize )    // - we have space for output data
         )
         {
+            // The modules are preprocessed ahead of the analysis as it
+            // depends on what they will read from the side channel:
+            // (the deeper resolution layers only redo the setup of the
+            // modules for their own sample rate).
+            if ( BOOST_UNLIKELY( preProcessPending_ ) )
+            {
+                preProcessPending_ = false;
+                if ( layer == 0 ) preProcess();
+                else              hopRequirements_ = pFixedChain_ ? pFixedChain_->preProcess( engineSetup() ) : modules().setupResolutionLayerAll( engineSetup() );
+            }
+
             // The Window+FFT phase:
             // Implementation note:
             //   As we cannot window the input data directly (because we
@@ -413,20 +676,46 @@ void Processor::processSingleChannel( ProcessParameters const & processParameter
             // merged into one: input data is copied into the destination
             // buffer, windowed and then the FFT is performed.
             //                                (11.02.2010.) (Domagoj Saric)
-            channelBuffers.setCurrentDataToChannelData( useSideChannel, fft_, analysisWindow(), windowSizeFactor );
+            //   The side channel input FIFO is always kept up to date (so that
+            // it is ready as soon as a module starts consuming it) but it is
+            // transformed only as far as the current modules require.
+            HopRequirements const hopRequirements = { useSideChannel ? hopRequirements_.sideChannelDemand : NoSideChannel, hopRequirements_.conversionAccuracy };
+            channelBuffers.setCurrentDataToChannelData( hopRequirements, fft_, analysisWindow(), windowSizeFactor );
 
             // The processing phase:
             {
-                auto   const channel    ( processParameters.currentChannel() );
+                auto   const channel    ( moduleChannel                      );
                 auto &       data       ( channelBuffers   .channelData   () );
                 auto &       engineSetup( this->engineSetup()                );
-                modules().forEach<ModuleDSP>
-                (
-                    [&, channel]( ModuleDSP const & module )
-                    {
-                        module.process( channel, data, engineSetup );
-                    }
-                );
+                // Each resolution layer keeps only its own band (the mask is
+                // applied both after the analysis and before the synthesis):
+                if ( BOOST_UNLIKELY( layered ) )
+                    data.applyBandMask( resolutionLayers_.bandMask( layer ) );
+                pCurrentChannelData_ = &data;
+                if ( pFixedChain_ )
+                {
+                    pFixedChain_->process( channel, data, engineSetup );
+                }
+                else
+                {
+                    modules().forEach<ModuleDSP>
+                    (
+                        [&, channel]( ModuleDSP const & module )
+                        {
+                            pCurrentModule_ = &node( module );
+                            module.process( channel, data, engineSetup );
+                        }
+                    );
+                    pCurrentModule_ = nullptr;
+                }
+
+                // Modules are done with the hop: return the lent frame (if
+                // any) and let go of its owner.
+                data.restoreFrame();
+                frameLender_.reset();
+
+                if ( BOOST_UNLIKELY( layered ) )
+                    data.applyBandMask( resolutionLayers_.bandMask( layer ) );
             }
 
         #ifndef LE_SW_PURE_ANALYSIS
@@ -440,7 +729,7 @@ void Processor::processSingleChannel( ProcessParameters const & processParameter
             // - compensate for the WOLA gain.
             multiply( pOutput, processParameters.outputScaling() / engineSetup().wolaGain(), stepSize );
 
-            if ( processParameters.doMix() )
+            if ( processParameters.doMix() && ( layer == 0 ) ) // (the first layer carries the whole dry signal)
             {
                 // Implementation note:
                 //   To avoid redundant buffers and data copying we scale
@@ -465,8 +754,16 @@ void Processor::processSingleChannel( ProcessParameters const & processParameter
             // passed so we do not have enough data and therefore simply zero
             // the part of the output that we have no data for.
             std::uint16_t const amountToZero( sizeToProduce - availableOutputData );
-            Math::clear( pOutput, amountToZero );
-            pOutput += amountToZero;
+            if ( stride == 1 )
+            {
+                Math::clear( pOutput, amountToZero );
+            }
+            else
+            {
+                for ( std::uint16_t sample( 0 ); sample < amountToZero; ++sample )
+                    pOutput[ sample * stride ] = 0;
+            }
+            pOutput += amountToZero * stride;
         }
         BOOST_ASSERT_MSG
         (
@@ -478,12 +775,13 @@ void Processor::processSingleChannel( ProcessParameters const & processParameter
         (
             pOutput,
             amountToExtract,
+            stride,
             incompleteOutputDataSizeFromPreviousSteps
         );
 
-        LE_MATH_VERIFY_VALUES( Math::InvalidOrSlow, ReadOnlyDataRange( pOutput, pOutput + amountToExtract ), "output" );
+        LE_MATH_VERIFY_VALUES( Math::InvalidOrSlow, ReadOnlyDataRange( pOutput, pOutput + ( stride == 1 ? amountToExtract : 0 ) ), "output" );
 
-        pOutput += amountToExtract;
+        pOutput += amountToExtract * stride;
     #endif // LE_SW_PURE_ANALYSIS
     } // while ( inputSamples )
 }
@@ -703,7 +1001,8 @@ void LE_COLD Processor::calculateWindowAndWOLAGain()
     // Fill a temporary buffer with overlap-added copies of the window(s) to
     // determine the total gain and whether the COLA condition is (sufficiently)
     // satisfied (the gain variation is sufficiently small).
-    BOOST_SIMD_ALIGNED_SCOPED_STACK_BUFFER( wolaBuffer, real_t, windowSize );
+    ScratchArena::Scope scratch( scratch_ );
+    DataRange const wolaBuffer( scratch.allocate<real_t>( windowSize ) );
     Math::clear( wolaBuffer );
     for ( DataRange::iterator pBufferPosition( wolaBuffer.begin() ); ;pBufferPosition += stepSize )
     {
@@ -769,6 +1068,7 @@ bool LE_FASTCALL Processor::setSampleRate( float const sampleRate, StorageFactor
     #endif // LE_SW_ENGINE_WINDOW_PRESUM
         currentStorageFactors.overlapFactor,
         currentStorageFactors.numberOfChannels,
+        currentStorageFactors.resolutionLayers,
         engineSetup().sampleRate<std::uint32_t>()
     };
 
@@ -785,7 +1085,7 @@ bool LE_FASTCALL Processor::setSampleRate( float const sampleRate, StorageFactor
         "Processor storage assumed not to depend on the sampling rate."
     );
 
-    if ( modules().resizeAll( storageFactors, currentStorageFactors ) )
+    if ( resizeModules( storageFactors, currentStorageFactors ) )
     {
         currentStorageFactors = storageFactors;
         return true;
@@ -842,7 +1142,7 @@ bool Processor::resize
     bool allocationSucceeded( sharedStorage.resize( requiredStorage ) );
     if ( allocationSucceeded )
     {
-        if ( modules().resizeAll( newStorageFactors, currentStorageFactors ) )
+        if ( resizeModules( newStorageFactors, currentStorageFactors ) )
         {
             currentStorageFactors = newStorageFactors;
         }
@@ -868,6 +1168,45 @@ bool Processor::resize
     return allocationSucceeded;
 }
 
+LE_COLD
+bool Processor::setFixedChain( FixedChain * const pChain, StorageFactors const & currentStorageFactors )
+{
+    // See the related note in resize() (about incomplete storage factors).
+    if ( pChain && currentStorageFactors.complete() )
+    {
+        if ( pChain->scratchStorage( currentStorageFactors ) > scratch_.size() )
+            return false;
+        if ( !pChain->resize( currentStorageFactors ) )
+            return false;
+    }
+    pFixedChain_ = pChain;
+    return true;
+}
+
+LE_COLD
+bool Processor::resizeModules( StorageFactors const & newStorageFactors, StorageFactors const & currentStorageFactors )
+{
+    // The scratch arena is sized only for the project's effects (see
+    // effectsScratchStorage()).
+    if ( pFixedChain_ && pFixedChain_->scratchStorage( newStorageFactors ) > scratchStorage( newStorageFactors ) )
+        return false;
+    return
+        modules().resizeAll( newStorageFactors, currentStorageFactors ) &&
+        ( !pFixedChain_ || pFixedChain_->resize( newStorageFactors ) );
+}
+
+LE_COLD LE_CONST_FUNCTION
+std::uint32_t Processor::scratchStorage( StorageFactors const & factors )
+{
+    // The WOLA gain calculation buffer (see calculateWindowAndWOLAGain()):
+#if LE_SW_ENGINE_WINDOW_PRESUM
+    std::uint16_t const windowSize( factors.fftSize * factors.windowSizeFactor );
+#else
+    std::uint16_t const windowSize( factors.fftSize                            );
+#endif // LE_SW_ENGINE_WINDOW_PRESUM
+    return std::max( ScratchArena::requiredStorage<real_t>( windowSize ), effectsScratchStorage( factors ) );
+}
+
 LE_COLD
 StorageFactors Processor::makeFactors
 (
@@ -877,6 +1216,7 @@ StorageFactors Processor::makeFactors
 #endif // LE_SW_ENGINE_WINDOW_PRESUM
     std::uint8_t  const overlapFactor   ,
     std::uint8_t  const numberOfChannels,
+    std::uint8_t  const resolutionLayers,
     std::uint32_t const sampleRate
 )
 {
@@ -888,6 +1228,7 @@ StorageFactors Processor::makeFactors
     #endif // LE_SW_ENGINE_WINDOW_PRESUM
         overlapFactor,
         numberOfChannels,
+        resolutionLayers,
         sampleRate
     };
     return storageFactors;
@@ -900,10 +1241,11 @@ void LE_COLD Processor::changeWOLAParameters( StorageFactors const & storageFact
     this->resize( storageFactors, storage );
     BOOST_ASSERT_MSG
     (
-        unsigned( storage.size() ) <= storageFactors.numberOfChannels * Utility::Constants::vectorAlignment, //...mrmlj...
+        unsigned( storage.size() ) <= ( storageFactors.numberOfLayerChannels() + 1 ) * Utility::Constants::vectorAlignment, //...mrmlj...
         "Requested storage space not consumed."
     );
 
+    engineSetup().setResolutionLayers ( storageFactors.resolutionLayers );
     engineSetup().setFFTSize          ( storageFactors.fftSize          );
     engineSetup().setOverlappingFactor( storageFactors.overlapFactor    );
 #if LE_SW_ENGINE_WINDOW_PRESUM
@@ -929,13 +1271,31 @@ void LE_COLD Processor::clearSideChannelData()
 
 void LE_COLD Processor::resetChannelBuffers()
 {
-    std::uint16_t const initialSilenceSamples
-    (
-        engineSetup().windowSize<std::uint16_t>() -
-        engineSetup().stepSize  <std::uint16_t>()
-    );
-    for ( auto & channel : channels_ )
-        channel.reset( initialSilenceSamples );
+    auto const windowSize      ( engineSetup().windowSize<std::uint16_t>()            );
+    auto const stepSize        ( engineSetup().stepSize  <std::uint16_t>()            );
+    auto const channelsPerLayer( channels_.size() / resolutionLayers_.numberOfLayers() );
+    std::uint32_t channel( 0 );
+    for ( auto & channelBuffers : channels_ )
+    {
+        // (the deeper resolution layers have proportionally shorter hops)
+        auto const layer( channel++ / channelsPerLayer );
+        channelBuffers.reset( windowSize - ( stepSize >> layer ) );
+    }
+    resolutionLayers_.reset();
+}
+
+
+LE_NOTHROW
+void Processor::lendFrame( ChannelData_AmPh & data, float * const pFrame ) const
+{
+    BOOST_ASSERT( pCurrentChannelData_ );
+    BOOST_ASSERT( pCurrentModule_ || pFixedChain_ );
+    pCurrentChannelData_->lendFrame( data, pFrame );
+    // A fixed chain owns its effects and can only be replaced with the process
+    // lock held (i.e. not before the frame is returned at the end of the hop)
+    // so only chain modules have to be kept alive.
+    if ( pCurrentModule_ )
+        frameLender_ = pCurrentModule_;
 }
 
 
@@ -947,18 +1307,24 @@ std::uint32_t Processor::requiredStorage( StorageFactors const & factors )
 {
     return
         Math::FFT_float_real_1D::requiredStorage( factors ) +
+        SpectralEnvelope       ::requiredStorage( factors ) +
         FFTWindow              ::requiredStorage( factors ) + // analysis
         FFTWindow              ::requiredStorage( factors ) + // synthesis
-        Channels               ::requiredStorage( factors );
+        Channels               ::requiredStorage( factors ) +
+        ResolutionLayers       ::requiredStorage( factors ) +
+        Utility::align( scratchStorage( factors ) );
 }
 
 LE_COLD
 void Processor::resize( StorageFactors const & factors, Storage & storage )
 {
     fft_            .resize( factors, storage );
+    spectralEnvelope_.resize( factors, storage );
     analysisWindow_ .resize( factors, storage );
     synthesisWindow_.resize( factors, storage );
     channels_       .resize( factors, storage );
+    resolutionLayers_.resize( factors, storage );
+    scratch_        .resize( scratchStorage( factors ), storage );
 
     synthesisWindowBackup_.alias( synthesisWindow_ );
 }
@@ -967,17 +1333,22 @@ LE_COLD LE_CONST_FUNCTION
 std::uint32_t Processor::Channels::requiredStorage( StorageFactors const & factors )
 {
     using Utility::align;
-    std::uint16_t const channelBuffersBaseSize   ( sizeof( value_type ) );
-    std::uint32_t const channelBuffersStorageSize( value_type::requiredStorage( factors ) );
-    BOOST_ASSERT( align( channelBuffersStorageSize ) == channelBuffersStorageSize );
-    std::uint32_t const totalSizePerChannel( align( channelBuffersBaseSize ) + channelBuffersStorageSize );
-    return factors.numberOfChannels * totalSizePerChannel;
+    std::uint16_t const channelBuffersBaseSize( sizeof( value_type ) );
+    std::uint32_t       totalSize             ( 0                    );
+    for ( std::uint8_t layer( 0 ); layer < factors.resolutionLayers; ++layer )
+    {
+        std::uint32_t const channelBuffersStorageSize( value_type::requiredStorage( ResolutionLayers::layerFactors( factors, layer ) ) );
+        BOOST_ASSERT( align( channelBuffersStorageSize ) == channelBuffersStorageSize );
+        std::uint32_t const totalSizePerChannel( align( channelBuffersBaseSize ) + channelBuffersStorageSize );
+        totalSize += factors.numberOfChannels * totalSizePerChannel;
+    }
+    return totalSize;
 }
 
 LE_COLD
 void Processor::Channels::resize( StorageFactors const & factors, Storage & storage )
 {
-    Utility::SharedStorageBuffer<ChannelBuffers>::resize( factors.numberOfChannels * sizeof( value_type ), storage );
+    Utility::SharedStorageBuffer<ChannelBuffers>::resize( factors.numberOfLayerChannels() * sizeof( value_type ), storage );
 
 #if LE_SW_ENGINE_WINDOW_PRESUM
     std::uint8_t const windowSizeFactor      ( factors.windowSizeFactor                );
@@ -985,15 +1356,21 @@ void Processor::Channels::resize( StorageFactors const & factors, Storage & stor
     std::uint8_t const windowSizeFactor      ( 1                                       );
 #endif // LE_SW_ENGINE_WINDOW_PRESUM
     std::uint16_t const windowSize           ( factors.fftSize * windowSizeFactor      );
-    std::uint16_t const stepSize             ( factors.fftSize / factors.overlapFactor );
-    std::uint16_t const initialSilenceSamples( windowSize - stepSize                   );
-    for ( auto  & channelBuffers : *this )
+    ChannelBuffers * LE_RESTRICT pChannelBuffers( begin() );
+    for ( std::uint8_t layer( 0 ); layer < factors.resolutionLayers; ++layer )
     {
-        ChannelBuffers * LE_RESTRICT const pNewChannelBuffers( new ( &channelBuffers ) ChannelBuffers() );
-        LE_ASSUME( pNewChannelBuffers );
-        pNewChannelBuffers->resize( factors, storage      );
-        pNewChannelBuffers->reset ( initialSilenceSamples );
+        StorageFactors const layerFactors         ( ResolutionLayers::layerFactors( factors, layer ) );
+        std::uint16_t  const stepSize             ( factors.fftSize / layerFactors.overlapFactor     );
+        std::uint16_t  const initialSilenceSamples( windowSize - stepSize                            );
+        for ( std::uint8_t channel( 0 ); channel < factors.numberOfChannels; ++channel )
+        {
+            ChannelBuffers * LE_RESTRICT const pNewChannelBuffers( new ( pChannelBuffers++ ) ChannelBuffers() );
+            LE_ASSUME( pNewChannelBuffers );
+            pNewChannelBuffers->resize( layerFactors, storage );
+            pNewChannelBuffers->reset ( initialSilenceSamples );
+        }
     }
+    BOOST_ASSERT( pChannelBuffers == end() );
 }
 
 LE_OPTIMIZE_FOR_SIZE_END()
@@ -1009,6 +1386,7 @@ Processor::ProcessParameters::ProcessParameters
     InputData             const inputs,
     InputData             const sideChannels,
     OutputData            const outputs,
+    std::uint8_t          const stride,
     Channels      const &       channels,
     std::uint32_t         const numberOfSamples,
     float                 const outputGain,
@@ -1025,8 +1403,13 @@ Processor::ProcessParameters::ProcessParameters
 
     channelBuffers_( channels ),
 
-    currentChannel_ ( 0               ),
-    numberOfSamples_( numberOfSamples ),
+    currentChannel_( 0                       ),
+    stride_        ( stride                  ),
+    sideChannels_  ( sideChannels != nullptr ),
+
+    blockSize_      ( numberOfSamples ),
+    offset_         ( 0               ),
+    numberOfSamples_( 0               ),
 
     mixPercentage_( mixAmount              ),
     outputScaling_( outputGain * mixAmount ),
@@ -15,12 +15,19 @@
 //------------------------------------------------------------------------------
 #include "buffers.hpp"
 #include "channelBuffers.hpp"
+#include "moduleNode.hpp"
+#include "parameterEvents.hpp"
+#include "resolutionLayers.hpp"
+#include "scratchArena.hpp"
 #include "setup.hpp"
+#include "spectralEnvelope.hpp"
 
 #include "le/math/dft/fft.hpp"
 #include "le/parameters/lfoImpl.hpp"
 #include "le/utility/platformSpecifics.hpp"
 
+#include "boost/assert.hpp"
+
 #include <cstdint>
 //------------------------------------------------------------------------------
 namespace boost
@@ -44,6 +51,7 @@ LE_IMPL_NAMESPACE_BEGIN( Engine )
 ///
 ////////////////////////////////////////////////////////////////////////////////
 
+class FixedChain;
 class ModuleChainImpl;
 
 class Processor
@@ -54,6 +62,8 @@ public:
     using InterleavedInputData  = float const * LE_RESTRICT                    ;
     using InterleavedOutputData = float       * LE_RESTRICT                    ;
 
+    Processor();
+
     LE_NOTHROWNOALIAS
     void LE_FASTCALL process // separated channel data
     (
@@ -75,7 +85,7 @@ public:
         float                 mixAmount
     );
 
-    void reset() { lfoTimer().reset(); }
+    void reset() { lfoTimer().reset(); parameterEvents_.clear(); }
 
     void setNumberOfChannels( std::uint8_t numberOfMainChannels, std::uint8_t numberOfSideChannels );
 
@@ -89,12 +99,36 @@ public:
 
     Setup                   const & engineSetup    () const { return engineSetup_    ; }
     Math::FFT_float_real_1D const & fft            () const { return fft_            ; }
+    SpectralEnvelope        const & spectralEnvelope() const { return spectralEnvelope_; }
     ReadOnlyDataRange       const & analysisWindow () const { return analysisWindow_ ; }
     ReadOnlyDataRange       const & synthesisWindow() const { return synthesisWindow_; }
 
     FullChannelData_AmPh const & currentAmPhData( std::uint8_t const channel ) const { return static_cast<ChannelData const &>( channels_[ channel ].channelData() ).currentAmPhData(); }
     FullChannelData_ReIm const & currentReImData( std::uint8_t const channel ) const { return static_cast<ChannelData const &>( channels_[ channel ].channelData() ).currentReImData(); }
 
+    /// Feature cache of the channel whose hop is currently being processed
+    /// (for use by modules from within their process() member functions).
+    SpectralFeatures & features() const { BOOST_ASSERT( pCurrentChannelData_ ); return pCurrentChannelData_->features(); }
+    SpectralFeatures::Statistics const & featureStatistics( std::uint8_t const channel ) const { return static_cast<ChannelData const &>( channels_[ channel ].channelData() ).features().statistics(); }
+
+    /// Per-hop temporaries (for use by modules from within their process()
+    /// member functions instead of stack buffers). The arena holds at least
+    /// scratchStorage() bytes.
+    ScratchArena & scratch() const { return scratch_; }
+
+    /// Makes the main channel AmPh data of the hop being processed (and the
+    /// passed view of it) use the given frame instead of the engine's own
+    /// storage, without copying, until all the modules have processed the hop.
+    /// Intended for modules that would otherwise copy a frame from their
+    /// channel state to the output (e.g. a consumed history frame). The frame
+    /// has to be laid out like the engine's data (see
+    /// FullChannelData_AmPh::phasesOffset()), hold the complete spectrum (also
+    /// outside the module's working range) and must not be used by the module
+    /// before its next hop (the following modules are free to modify it). The
+    /// calling module is kept alive for as long as its frame is in use (effects
+    /// of a fixed chain, see setFixedChain(), live as long as the chain).
+    LE_NOTHROW void LE_FASTCALL lendFrame( ChannelData_AmPh &, float * pFrame ) const;
+
     static Processor       & fromEngineSetup( Setup       & );
     static Processor const & fromEngineSetup( Setup const & );
 
@@ -108,6 +142,13 @@ public: //...mrmlj...SDK and plugin shared functionality (cleanup and extract)..
         Engine::HeapSharedStorage       & sharedStorage
     );
 
+    /// Makes the hops be processed by the given compile-time specialised
+    /// chain (see StaticChain) instead of the module chain (a null pointer
+    /// switches back to the latter). The chain is resized for (and then
+    /// follows) the current storage factors.
+    /// \note Has to be called with the process lock held.
+    bool LE_COLD setFixedChain( FixedChain *, StorageFactors const & currentStorageFactors );
+
     static StorageFactors makeFactors
     (
         std::uint16_t fftSize         ,
@@ -116,9 +157,19 @@ public: //...mrmlj...SDK and plugin shared functionality (cleanup and extract)..
     #endif // LE_SW_ENGINE_WINDOW_PRESUM
         std::uint8_t  overlapFactor   ,
         std::uint8_t  numberOfChannels,
+        std::uint8_t  resolutionLayers,
         std::uint32_t sampleRate
     );
 
+protected: // Sample accurate automation
+    /// \note Scheduled events are applied at the STFT hops of the following
+    /// process() call (see ParameterEvents) and have to be scheduled with the
+    /// process lock held.
+    ParameterEvents & parameterEvents() { return parameterEvents_; }
+
+protected: // Load shedding
+    void setLoadShedding( bool const optionalModules, bool const expensiveModes ) { engineSetup_.setLoadShedding( optionalModules, expensiveModes ); }
+
 protected: // LFO & timing
 #ifdef LE_NO_LFOs
     private: using lfoTimer = Parameters::LFOImpl::Timer; public:
@@ -145,9 +196,34 @@ private:
 
     Setup & engineSetup() { return engineSetup_; }
 
-    void LE_FASTCALL processSingleChannel( ProcessParameters const & );
+    void LE_FASTCALL processBlock        ( ProcessParameters &, std::uint32_t blockPosition );
+    void LE_FASTCALL processDeeperLayers ( ProcessParameters &, std::uint8_t numberOfChannels );
+    void LE_FASTCALL processSingleChannel
+    (
+        ProcessParameters const &,
+        ChannelBuffers          &,
+        std::uint8_t              moduleChannel,
+        float const             * pInput,
+        float const             * pSideChannel,
+        std::uint32_t             samples,
+        float                   * pOutput,
+        std::uint8_t              stride
+    );
     void LE_FASTCALL preProcess          ();
 
+    bool resizeModules( StorageFactors const & newStorageFactors, StorageFactors const & currentStorageFactors );
+
+    /// The scratch arena size: the largest of the Processor's own and the
+    /// effects' (effectsScratchStorage()) requirements.
+    static std::uint32_t LE_FASTCALL scratchStorage( StorageFactors const & );
+    /// The largest scratchStorage() declared by an effect available in the
+    /// project (defined by the project, like modules()).
+    /// \note Like the rest of the Processor's storage it must not depend on
+    /// the sampling rate.
+    static std::uint32_t LE_FASTCALL effectsScratchStorage( StorageFactors const & );
+
+    std::uint16_t samplesUntilNextHop() const;
+
     ModuleChainImpl       & modules()      ;
     ModuleChainImpl const & modules() const;
 
@@ -169,15 +245,34 @@ private:
     LFO::Timer              lfoTimer_       ;
 #endif // LE_NO_LFOs
     Math::FFT_float_real_1D fft_            ;
+    SpectralEnvelope        spectralEnvelope_;
     FFTWindow               analysisWindow_ ;
     FFTWindow               synthesisWindow_;
-    Channels                channels_       ;
+    Channels                channels_       ; // of all the resolution layers (layer major)
+    ResolutionLayers        resolutionLayers_;
+    ChannelData           * pCurrentChannelData_; // of the hop being processed
+    ModuleNode      const * pCurrentModule_     ; // being processed
+    FixedChain            * pFixedChain_        ; // replacing the module chain (if set)
+    mutable ModuleNode::NodeCPtr frameLender_   ; // see lendFrame()
+    mutable ScratchArena    scratch_        ; // see scratch()
 
     /// \note See the related note in the calculateWindowAndWOLAGain() member
     /// function.
     ///                                       (04.03.2015.) (Domagoj Saric)
     FFTWindow synthesisWindowBackup_;
 
+    /// \note Blocks are processed in hop aligned chunks and the modules are
+    /// preprocessed (parameter events, LFOs and setup) only for chunks that
+    /// end with a hop, with the parameter values for the hop's position.
+    ParameterEvents   parameterEvents_  ;
+    std::uint32_t     callSamples_      ;
+    std::uint32_t     hopPosition_      ; // within the current process() call
+    bool              preProcessPending_;
+    HopRequirements   hopRequirements_  ; // of the preprocessed modules
+#ifndef LE_NO_LFOs
+    LFO::value_type   lfoHopTimeInBars_ ; // of the most recently processed hop
+#endif // LE_NO_LFOs
+
 public:
     static LE_CONST_FUNCTION std::uint32_t LE_FASTCALL requiredStorage( StorageFactors const & );
 
@@ -0,0 +1,435 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// resolutionLayers.cpp
+/// --------------------
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#include "resolutionLayers.hpp"
+
+#include "le/math/constants.hpp"
+#include "le/math/vector.hpp"
+
+#include "boost/assert.hpp"
+
+#include <algorithm>
+#include <cmath>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_BEGIN( Engine )
+//------------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// ResolutionLayers::Layout
+// ------------------------
+//
+//   Sizes (in samples) of the per channel buffers and the delays (in full rate
+// samples) that align the shallower layers with the deepest one.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+struct ResolutionLayers::Layout
+{
+    explicit Layout( StorageFactors const & factors )
+    {
+    #if LE_SW_ENGINE_WINDOW_PRESUM
+        std::uint8_t const windowSizeFactor( factors.windowSizeFactor );
+    #else
+        std::uint8_t const windowSizeFactor( 1                        );
+    #endif // LE_SW_ENGINE_WINDOW_PRESUM
+        layers       = factors.resolutionLayers;
+        windowSize   = static_cast<std::uint16_t>( factors.fftSize * windowSizeFactor );
+        numberOfBins = static_cast<std::uint16_t>( factors.fftSize / 2 + 1 );
+        maskStride   = static_cast<std::uint16_t>( Math::alignIndex( numberOfBins ) );
+
+        BOOST_ASSERT( layers >= 2 && layers <= Constants::maximumResolutionLayers );
+        std::uint8_t const deepest( layers - 1 );
+
+        lineSize       = Math::alignIndex( ( 2 * halfLength << deepest ) + windowSize );
+        channelSamples = 2 * lineSize;
+        for ( std::uint8_t layer( 1 ); layer < layers; ++layer )
+        {
+            std::uint16_t const maximumChunk( ( windowSize >> layer ) + 1 );
+            decimatedSize    [ layer ] = Math::alignIndex(                   maximumChunk );
+            interpolationSize[ layer ] = Math::alignIndex( polyphaseLength + maximumChunk );
+            channelSamples += 2 * decimatedSize[ layer ] + interpolationSize[ layer ];
+        }
+        for ( std::uint8_t layer( 0 ); layer < deepest; ++layer )
+        {
+            delays   [ layer ] = latency( deepest ) - latency( layer );
+            delaySize[ layer ] = Math::alignIndex( delays[ layer ] );
+            channelSamples += delaySize[ layer ];
+        }
+        delays   [ deepest ] = 0;
+        delaySize[ deepest ] = 0;
+    }
+
+    /// The layer's STFT latency (its window, in samples of its own rate) plus
+    /// the group delays of its decimator and interpolator.
+    std::uint32_t latency( std::uint8_t const layer ) const
+    {
+        return
+            ( std::uint32_t( windowSize ) << layer ) +
+            ( layer ? std::uint32_t( 2 * halfLength ) << layer : 0 );
+    }
+
+    std::uint8_t  layers        ;
+    std::uint16_t windowSize    ;
+    std::uint16_t numberOfBins  ;
+    std::uint16_t maskStride    ;
+    std::uint32_t lineSize      ;
+    std::uint32_t channelSamples;
+    std::uint32_t decimatedSize    [ Constants::maximumResolutionLayers ];
+    std::uint32_t interpolationSize[ Constants::maximumResolutionLayers ];
+    std::uint32_t delays           [ Constants::maximumResolutionLayers ];
+    std::uint32_t delaySize        [ Constants::maximumResolutionLayers ];
+}; // struct ResolutionLayers::Layout
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// ResolutionLayers::ResolutionLayers()
+// ------------------------------------
+//
+//   Blackman windowed sinc lowpass filters with the cutoff at the decimated
+// Nyquist frequency and halfLength zero crossings on each side (in samples of
+// the decimated signal). The same prototype, scaled by the decimation factor,
+// is used for interpolation (split into its polyphase components, stored in
+// reverse so that the convolutions run forward through the history).
+//
+////////////////////////////////////////////////////////////////////////////////
+
+LE_COLD
+ResolutionLayers::ResolutionLayers()
+    :
+    numberOfLayers_( 1 ),
+    windowSize_    ( 0 ),
+    maskStride_    ( 0 ),
+    numberOfBins_  ( 0 )
+{
+    using Math::Constants::pi_d;
+    for ( std::uint8_t deeper( 0 ); deeper < maximumDeeperLayers; ++deeper )
+    {
+        std::uint8_t const decimation( 2 << deeper                    );
+        std::uint8_t const length    ( 2 * halfLength * decimation + 1 );
+        std::uint8_t const centre    ( halfLength * decimation         );
+
+        double taps[ maximumFilterLength ];
+        double sum( 0 );
+        for ( std::uint8_t tap( 0 ); tap < length; ++tap )
+        {
+            double const x     ( double( int( tap ) - centre ) / decimation );
+            double const sinc  ( x ? std::sin( pi_d * x ) / ( pi_d * x ) : 1 );
+            double const window( 0.42 - 0.5 * std::cos( 2 * pi_d * tap / ( length - 1 ) ) + 0.08 * std::cos( 4 * pi_d * tap / ( length - 1 ) ) );
+            taps[ tap ] = sinc * window;
+            sum        += taps[ tap ];
+        }
+
+        for ( std::uint8_t tap( 0 ); tap < maximumFilterLength; ++tap )
+            decimators_[ deeper ][ tap ] = ( tap < length ) ? static_cast<float>( taps[ tap ] / sum ) : 0;
+
+        for ( std::uint8_t phase( 0 ); phase < maximumDecimation; ++phase )
+        {
+            for ( std::uint8_t tap( 0 ); tap < polyphaseLength; ++tap )
+            {
+                unsigned int const prototypeTap( phase + ( polyphaseLength - 1 - tap ) * decimation );
+                interpolators_[ deeper ][ phase ][ tap ] =
+                    ( ( phase < decimation ) && ( prototypeTap < length ) )
+                        ? static_cast<float>( taps[ prototypeTap ] * decimation / sum )
+                        : 0;
+            }
+        }
+    }
+    std::fill( &delays_[ 0 ], &delays_[ Constants::maximumResolutionLayers ], 0 );
+}
+
+
+StorageFactors ResolutionLayers::layerFactors( StorageFactors const & factors, std::uint8_t const layer )
+{
+    StorageFactors layerFactors( factors );
+    layerFactors.overlapFactor = static_cast<std::uint8_t >( factors.overlapFactor << layer );
+    layerFactors.samplerate    = static_cast<std::uint32_t>( factors.samplerate    >> layer );
+    return layerFactors;
+}
+
+
+ReadOnlyDataRange ResolutionLayers::bandMask( std::uint8_t const layer ) const
+{
+    BOOST_ASSERT( layer < numberOfLayers_ );
+    float const * const pMask( &bandMasks_[ layer * maskStride_ ] );
+    return ReadOnlyDataRange( pMask, pMask + numberOfBins_ );
+}
+
+
+std::uint16_t ResolutionLayers::decimatedSamples( std::uint8_t const channel, std::uint8_t const layer ) const
+{
+    BOOST_ASSERT( layer > 0 && layer < numberOfLayers_ );
+    ChannelState const & state( channels_[ channel ] );
+    std::uint8_t const decimation( 1 << layer );
+    return static_cast<std::uint16_t>( ( state.chunkPhase % decimation + state.chunkSamples ) >> layer );
+}
+
+float const * ResolutionLayers::decimatedMainInput( std::uint8_t const channel, std::uint8_t const layer ) const { BOOST_ASSERT( layer > 0 ); return channels_[ channel ].pDecimatedMain    [ layer ]; }
+float const * ResolutionLayers::decimatedSideInput( std::uint8_t const channel, std::uint8_t const layer ) const { BOOST_ASSERT( layer > 0 ); return channels_[ channel ].pDecimatedSide    [ layer ]; }
+float       * ResolutionLayers::layerOutput       ( std::uint8_t const channel, std::uint8_t const layer )       { BOOST_ASSERT( layer > 0 ); return channels_[ channel ].pInterpolationLine[ layer ] + polyphaseLength; }
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// ResolutionLayers::decimate()
+// ----------------------------
+//
+//   The decimated samples are produced at the full rate samples whose global
+// position (modulo the decimation factor) is decimation - 1, i.e. as soon as
+// all of their inputs are available.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+LE_NOTHROWNOALIAS LE_HOT
+void ResolutionLayers::decimate( std::uint8_t const channel, float const * const pMainInput, float const * const pSideInput, std::uint16_t const samples )
+{
+    BOOST_ASSERT( numberOfLayers_ > 1 );
+    BOOST_ASSERT( samples && samples <= windowSize_ );
+    ChannelState & state( channels_[ channel ] );
+    state.chunkPhase   = state.phase;
+    state.chunkSamples = samples;
+    state.phase        = static_cast<std::uint8_t>( ( state.phase + samples ) % maximumDecimation );
+
+                      decimate( state.pMainLine, pMainInput, state.pDecimatedMain, state.chunkPhase, samples );
+    if ( pSideInput ) decimate( state.pSideLine, pSideInput, state.pDecimatedSide, state.chunkPhase, samples );
+}
+
+
+LE_NOTHROWNOALIAS LE_HOT
+void ResolutionLayers::decimate
+(
+    float       * LE_RESTRICT const pLine,
+    float const * LE_RESTRICT const pInput,
+    float       *       const *     ppDecimated,
+    std::uint8_t                const phase,
+    std::uint16_t               const samples
+) const
+{
+    std::uint8_t const history( decimationHistory() );
+    std::copy( pInput, pInput + samples, &pLine[ history ] );
+
+    for ( std::uint8_t layer( 1 ); layer < numberOfLayers_; ++layer )
+    {
+        std::uint8_t const decimation( 1 << layer                      );
+        std::uint8_t const length    ( 2 * halfLength * decimation + 1 );
+        float const * LE_RESTRICT const pTaps  ( decimators_[ layer - 1 ] );
+        float       * LE_RESTRICT       pOutput( ppDecimated[ layer ]     );
+        // (the filters are symmetric so they need not be reversed)
+        for ( std::uint16_t sample( decimation - 1 - phase % decimation ); sample < samples; sample += decimation )
+        {
+            float const * LE_RESTRICT const pHistory( &pLine[ history + sample + 1 - length ] );
+            float sum( 0 );
+            for ( std::uint8_t tap( 0 ); tap < length; ++tap )
+                sum += pTaps[ tap ] * pHistory[ tap ];
+            *pOutput++ = sum;
+        }
+    }
+
+    std::copy( &pLine[ samples ], &pLine[ samples + history ], &pLine[ 0 ] );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// ResolutionLayers::addLayerOutput()
+// ----------------------------------
+//
+//   Zero-stuffing interpolation with the decimated samples placed at the
+// positions they were produced at (see decimate()), i.e. full rate sample n
+// uses the polyphase component ( n + 1 ) % decimation and the most recent
+// decimated samples up to (and including) n.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+LE_NOTHROWNOALIAS LE_HOT
+void ResolutionLayers::addLayerOutput( std::uint8_t const channel, std::uint8_t const layer, float * LE_RESTRICT const pOutput, std::uint16_t const samples )
+{
+    BOOST_ASSERT( layer > 0 && layer < numberOfLayers_ );
+    ChannelState & state( channels_[ channel ] );
+    BOOST_ASSERT( samples == state.chunkSamples );
+
+    std::uint8_t const decimation( 1 << layer );
+    float * LE_RESTRICT const pLine  ( state.pInterpolationLine[ layer ] );
+    float * LE_RESTRICT const pResult( interpolated_.begin()             );
+
+    std::uint8_t  phase   ( state.chunkPhase % decimation );
+    std::uint16_t produced( 0                             );
+    for ( std::uint16_t sample( 0 ); sample < samples; ++sample )
+    {
+        phase = ( phase + 1 ) % decimation;
+        produced += ( phase == 0 );
+        float const * LE_RESTRICT const pTaps   ( interpolators_[ layer - 1 ][ phase ] );
+        float const * LE_RESTRICT const pHistory( &pLine[ produced ]                   );
+        float sum( 0 );
+        for ( std::uint8_t tap( 0 ); tap < polyphaseLength; ++tap )
+            sum += pTaps[ tap ] * pHistory[ tap ];
+        pResult[ sample ] = sum;
+    }
+    BOOST_ASSERT( produced == decimatedSamples( channel, layer ) );
+    if ( produced )
+        std::copy( &pLine[ produced ], &pLine[ produced + polyphaseLength ], &pLine[ 0 ] );
+
+    if ( layer != numberOfLayers_ - 1 )
+        delay( state, layer, pResult, samples );
+
+    Math::add( pResult, pOutput, samples );
+}
+
+
+LE_NOTHROWNOALIAS
+void ResolutionLayers::delayFirstLayerOutput( std::uint8_t const channel, float * const pOutput, std::uint16_t const samples )
+{
+    BOOST_ASSERT( numberOfLayers_ > 1 );
+    delay( channels_[ channel ], 0, pOutput, samples );
+}
+
+
+/// \note A ring buffer exchanged chunk-wise with the samples: each swapped
+/// segment takes out the samples that went in delay samples ago.
+LE_NOTHROWNOALIAS
+void ResolutionLayers::delay( ChannelState & state, std::uint8_t const layer, float * LE_RESTRICT pSamples, std::uint16_t samples ) const
+{
+    std::uint32_t   const length  ( delays_[ layer ]            );
+    float         * const pLine   ( state.pDelayLine[ layer ]   );
+    std::uint32_t &       position( state.delayPosition[ layer ] );
+    BOOST_ASSERT( length );
+    while ( samples )
+    {
+        std::uint16_t const segment( static_cast<std::uint16_t>( std::min<std::uint32_t>( samples, length - position ) ) );
+        std::swap_ranges( pSamples, pSamples + segment, &pLine[ position ] );
+        pSamples += segment;
+        samples  -= segment;
+        position += segment;
+        if ( position == length )
+            position = 0;
+    }
+}
+
+
+LE_COLD
+void ResolutionLayers::reset()
+{
+    if ( numberOfLayers_ == 1 )
+        return;
+    samples_.clear();
+    for ( auto & state : channels_ )
+    {
+        std::fill( &state.delayPosition[ 0 ], &state.delayPosition[ Constants::maximumResolutionLayers ], 0 );
+        state.chunkSamples = 0;
+        state.chunkPhase   = 0;
+        state.phase        = 0;
+    }
+}
+
+
+LE_COLD LE_CONST_FUNCTION
+std::uint32_t ResolutionLayers::requiredStorage( StorageFactors const & factors )
+{
+    if ( factors.resolutionLayers <= 1 )
+        return 0;
+    Layout const layout( factors );
+    return
+        Utility::Constants::vectorAlignment + // the preceding storage is not necessarily aligned
+        Utility::align( factors.numberOfChannels * sizeof( ChannelState ) ) +
+        (
+            factors.numberOfChannels * layout.channelSamples     +
+            Math::alignIndex( layout.windowSize )                +
+            layout.layers            * layout.maskStride
+        ) * sizeof( float );
+}
+
+
+LE_COLD
+void ResolutionLayers::resize( StorageFactors const & factors, Storage & storage )
+{
+    numberOfLayers_ = factors.resolutionLayers;
+    if ( numberOfLayers_ <= 1 )
+    {
+        channels_    .alias( Utility::SharedStorageBuffer<ChannelState>() );
+        samples_     .alias( Utility::SharedStorageBuffer<float       >() );
+        bandMasks_   .alias( Utility::SharedStorageBuffer<float       >() );
+        interpolated_.alias( Utility::SharedStorageBuffer<float       >() );
+        windowSize_ = maskStride_ = numberOfBins_ = 0;
+        return;
+    }
+
+    Layout const layout( factors );
+    windowSize_   = layout.windowSize  ;
+    maskStride_   = layout.maskStride  ;
+    numberOfBins_ = layout.numberOfBins;
+    std::copy( &layout.delays[ 0 ], &layout.delays[ Constants::maximumResolutionLayers ], &delays_[ 0 ] );
+
+    channels_    .resize( factors.numberOfChannels * sizeof( ChannelState )                  , storage );
+    samples_     .resize( factors.numberOfChannels * layout.channelSamples * sizeof( float ), storage );
+    interpolated_.resize( Math::alignIndex( layout.windowSize )            * sizeof( float ), storage );
+    bandMasks_   .resize( layout.layers * layout.maskStride                * sizeof( float ), storage );
+
+    float * pSamples( samples_.begin() );
+    for ( auto & state : channels_ )
+    {
+        state.pMainLine = pSamples; pSamples += layout.lineSize;
+        state.pSideLine = pSamples; pSamples += layout.lineSize;
+        for ( std::uint8_t layer( 0 ); layer < Constants::maximumResolutionLayers; ++layer )
+        {
+            bool const deeper( layer > 0 && layer < layout.layers );
+            state.pDecimatedMain    [ layer ] = deeper ? pSamples : nullptr; if ( deeper ) pSamples += layout.decimatedSize    [ layer ];
+            state.pDecimatedSide    [ layer ] = deeper ? pSamples : nullptr; if ( deeper ) pSamples += layout.decimatedSize    [ layer ];
+            state.pInterpolationLine[ layer ] = deeper ? pSamples : nullptr; if ( deeper ) pSamples += layout.interpolationSize[ layer ];
+            bool const delayed( layer < layout.layers - 1 );
+            state.pDelayLine        [ layer ] = delayed ? pSamples : nullptr; if ( delayed ) pSamples += layout.delaySize  [ layer ];
+        }
+    }
+    BOOST_ASSERT( pSamples == samples_.end() );
+
+    // Power complementary (telescoping) band split: with below( f, j ) being
+    // the (cos^2 shaped) share of the spectrum that goes below the crossover of
+    // layer j the layer k keeps below( f, k ) - below( f, k + 1 ).
+    auto const below
+    (
+        []( double const frequency, std::uint8_t const layer ) -> double
+        {
+            if ( layer == 0 )
+                return 1;
+            double const lower( 0.25 / ( 1 << layer ) );
+            if ( frequency <= lower     ) return 1;
+            if ( frequency >= lower * 2 ) return 0;
+            double const weight( std::cos( Math::Constants::pi_d / 2 * ( frequency - lower ) / lower ) );
+            return weight * weight;
+        }
+    );
+    for ( std::uint8_t layer( 0 ); layer < layout.layers; ++layer )
+    {
+        float * LE_RESTRICT const pMask( &bandMasks_[ layer * layout.maskStride ] );
+        for ( std::uint16_t bin( 0 ); bin < layout.numberOfBins; ++bin )
+        {
+            // Relative to the full rate Nyquist frequency:
+            double const frequency( double( bin ) / ( layout.numberOfBins - 1 ) / ( 1 << layer ) );
+            double const share    ( below( frequency, layer ) - ( ( layer + 1 < layout.layers ) ? below( frequency, layer + 1 ) : 0 ) );
+            pMask[ bin ] = static_cast<float>( std::sqrt( std::max( share, 0.0 ) ) );
+        }
+        std::fill( &pMask[ layout.numberOfBins ], &pMask[ layout.maskStride ], 0.f );
+    }
+
+    reset();
+}
+
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_END( Engine )
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
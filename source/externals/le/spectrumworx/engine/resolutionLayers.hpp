@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file resolutionLayers.hpp
+/// --------------------------
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef resolutionLayers_hpp__7626A668_A470_4D3B_B090_3817E24679C4
+#define resolutionLayers_hpp__7626A668_A470_4D3B_B090_3817E24679C4
+#pragma once
+//------------------------------------------------------------------------------
+#include "buffers.hpp"
+#include "configuration.hpp"
+
+#include "le/utility/buffers.hpp"
+#include "le/utility/platformSpecifics.hpp"
+
+#include <cstdint>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_BEGIN( Engine )
+//------------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class ResolutionLayers
+///
+/// \brief Multi-resolution (band split) STFT support for the Processor.
+///
+///   A single FFT size forces a choice between time resolution (transients)
+/// and frequency resolution (low notes). In the multi-resolution mode the
+/// signal is additionally processed by deeper layers: layer k processes the
+/// input decimated by 2^k with the same FFT size, so it has 2^k times finer
+/// frequency resolution (and a 2^k times longer window) while its hop (the
+/// overlap factor is multiplied by 2^k) stays matched in time to the first
+/// layer's.
+///
+///   Each layer keeps only its band of the spectrum: power complementary band
+/// masks (bandMask()) are applied after the analysis and before the synthesis
+/// of every hop. The crossovers lie in the lower half of the deeper layer's
+/// band where its resampling filters (windowed sinc decimators and matching
+/// polyphase interpolators) are flat. The outputs of the shallower layers are
+/// delayed to match the latency of the deepest one (see
+/// Setup::latencyInSamples()).
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class ResolutionLayers
+{
+public:
+    ResolutionLayers();
+
+    std::uint8_t numberOfLayers() const { return numberOfLayers_; }
+
+    /// Storage factors of the channel buffers (and module channel states) of
+    /// the given layer.
+    static StorageFactors LE_FASTCALL layerFactors( StorageFactors const &, std::uint8_t layer );
+
+    /// Square root of the layer's (power) share of the spectrum, per bin of
+    /// the layer.
+    ReadOnlyDataRange bandMask( std::uint8_t layer ) const;
+
+    /// Feeds the next (at most windowSize long) chunk of the channel's full
+    /// rate input to the deeper layers. Has to be called before the first
+    /// layer processes the chunk (which, with in-place processing, overwrites
+    /// the input).
+    LE_NOTHROWNOALIAS void LE_FASTCALL decimate( std::uint8_t channel, float const * pMainInput, float const * pSideInput, std::uint16_t samples );
+
+    /// The current chunk of the given (deeper) layer.
+    std::uint16_t LE_FASTCALL decimatedSamples  ( std::uint8_t channel, std::uint8_t layer ) const;
+    float const * LE_FASTCALL decimatedMainInput( std::uint8_t channel, std::uint8_t layer ) const;
+    float const * LE_FASTCALL decimatedSideInput( std::uint8_t channel, std::uint8_t layer ) const;
+
+    /// Where the given (deeper) layer's output of the current chunk
+    /// (decimatedSamples() long) has to be stored.
+    float * LE_FASTCALL layerOutput( std::uint8_t channel, std::uint8_t layer );
+
+    /// Interpolates the layer's output (see layerOutput()) back to the full
+    /// rate, delays it as required and adds it to the given output chunk.
+    LE_NOTHROWNOALIAS void LE_FASTCALL addLayerOutput( std::uint8_t channel, std::uint8_t layer, float * pOutput, std::uint16_t samples );
+
+    /// Delays the first layer's output chunk (in place).
+    LE_NOTHROWNOALIAS void LE_FASTCALL delayFirstLayerOutput( std::uint8_t channel, float * pOutput, std::uint16_t samples );
+
+    void reset();
+
+private:
+    static std::uint8_t BOOST_CONSTEXPR_OR_CONST maximumDeeperLayers = Constants::maximumResolutionLayers - 1;
+    static std::uint8_t BOOST_CONSTEXPR_OR_CONST maximumDecimation   = 1 << maximumDeeperLayers;
+    static std::uint8_t BOOST_CONSTEXPR_OR_CONST halfLength          = Constants::resamplingFilterHalfLength;
+    static std::uint8_t BOOST_CONSTEXPR_OR_CONST maximumFilterLength = 2 * halfLength * maximumDecimation + 1;
+    static std::uint8_t BOOST_CONSTEXPR_OR_CONST polyphaseLength     = 2 * halfLength + 1;
+
+    /// \note Plain data, placement constructed in the shared storage.
+    struct ChannelState
+    {
+        float       * pMainLine;                // decimator history followed by the current chunk
+        float       * pSideLine;
+        float       * pDecimatedMain    [ Constants::maximumResolutionLayers ];
+        float       * pDecimatedSide    [ Constants::maximumResolutionLayers ];
+        float       * pInterpolationLine[ Constants::maximumResolutionLayers ]; // interpolator history followed by the layer output
+        float       * pDelayLine        [ Constants::maximumResolutionLayers ];
+        std::uint32_t delayPosition     [ Constants::maximumResolutionLayers ];
+        std::uint16_t chunkSamples;
+        std::uint8_t  chunkPhase  ;             // of the current chunk's first sample (modulo the deepest decimation)
+        std::uint8_t  phase       ;             // of the next chunk
+    }; // struct ChannelState
+
+    struct Layout;
+
+    LE_NOTHROWNOALIAS void LE_FASTCALL decimate( float * pLine, float const * pInput, float * const * ppDecimated, std::uint8_t phase, std::uint16_t samples ) const;
+    LE_NOTHROWNOALIAS void LE_FASTCALL delay   ( ChannelState &, std::uint8_t layer, float * pSamples, std::uint16_t samples ) const;
+
+    std::uint8_t decimationHistory() const { return static_cast<std::uint8_t>( 2 * halfLength << ( numberOfLayers_ - 1 ) ); }
+
+private:
+    std::uint8_t  numberOfLayers_;
+    std::uint16_t windowSize_    ;
+    std::uint16_t maskStride_    ;
+    std::uint16_t numberOfBins_  ;
+    std::uint32_t delays_[ Constants::maximumResolutionLayers ]; // of the shallower layers
+
+    // Symmetric windowed sinc decimators and their polyphase (reversed)
+    // interpolator counterparts, per deeper layer:
+    float decimators_   [ maximumDeeperLayers ][ maximumFilterLength ];
+    float interpolators_[ maximumDeeperLayers ][ maximumDecimation   ][ polyphaseLength ];
+
+    Utility::SharedStorageBuffer<ChannelState> channels_    ;
+    Utility::SharedStorageBuffer<float       > samples_     ;
+    Utility::SharedStorageBuffer<float       > bandMasks_   ;
+    Utility::SharedStorageBuffer<float       > interpolated_; // scratch
+
+public:
+    static LE_CONST_FUNCTION std::uint32_t LE_FASTCALL requiredStorage( StorageFactors const & );
+
+    void LE_FASTCALL resize( StorageFactors const &, Storage & );
+}; // class ResolutionLayers
+
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_END( Engine )
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // resolutionLayers_hpp
@@ -0,0 +1,120 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file scratchArena.hpp
+/// ----------------------
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef scratchArena_hpp__0B7E9E4C_51D2_4A8F_9C36_3F2D6A1E8B57
+#define scratchArena_hpp__0B7E9E4C_51D2_4A8F_9C36_3F2D6A1E8B57
+#pragma once
+//------------------------------------------------------------------------------
+#include "buffers.hpp"
+
+#include "le/utility/buffers.hpp"
+#include "le/utility/platformSpecifics.hpp"
+
+#include "boost/assert.hpp"
+#include "boost/range/iterator_range_core.hpp"
+
+#include <cstdint>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_BEGIN( Engine )
+//------------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class ScratchArena
+///
+/// \brief Stack-like allocator of (vector aligned) per-hop temporaries.
+///
+///   Replaces stack buffers (which, with large FFT sizes, can overflow the
+/// small stacks of some hosts' audio threads) with a region of the
+/// Processor's shared storage (see Processor::scratch()). The region is sized
+/// at resize() time for the largest scratchStorage() requirement declared by
+/// an effect (effects process sequentially so they all share it).
+///
+///   Allocations are made through a Scope and are released, in LIFO order,
+/// when the Scope is destroyed:
+/// <CODE>
+///     Engine::ScratchArena::Scope scratch( Engine::Processor::fromEngineSetup( engineSetup ).scratch() );
+///     DataRange const workBuffer( scratch.allocate<Engine::real_t>( numberOfBins ) );
+/// </CODE>
+///
+/// \note A Processor processes its channels serially (with the process lock
+/// held) so a single arena per Processor suffices.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class ScratchArena
+{
+public:
+    ScratchArena() : pTop_( nullptr ) {}
+
+    class Scope
+    {
+    public:
+        explicit Scope( ScratchArena & arena ) : arena_( arena ), pSavedTop_( arena.pTop_ ) {}
+        ~Scope() { arena_.pTop_ = pSavedTop_; }
+
+        template <typename T>
+        boost::iterator_range<T * LE_RESTRICT> LE_FASTCALL allocate( std::uint32_t const numberOfElements ) { return arena_.allocate<T>( numberOfElements ); }
+
+    private:
+        Scope( Scope const & );
+        void operator=( Scope const & );
+
+    private:
+        ScratchArena &       arena_    ;
+        char         * const pSavedTop_;
+    }; // class Scope
+
+    std::uint32_t size     () const { return buffer_.size(); }
+    std::uint32_t available() const { return static_cast<std::uint32_t>( buffer_.end() - pTop_ ); }
+
+    /// Scratch storage (in bytes) taken by an allocation of the given number of
+    /// Ts (for effects' scratchStorage() declarations).
+    template <typename T>
+    static std::uint32_t requiredStorage( std::uint32_t const numberOfElements ) { return Utility::align( numberOfElements * sizeof( T ) ); }
+
+    LE_COLD
+    void LE_FASTCALL resize( std::uint32_t const scratchStorage, Storage & storage )
+    {
+        buffer_.resize( Utility::align( scratchStorage ), storage );
+        pTop_ = buffer_.begin();
+    }
+
+private:
+    template <typename T>
+    LE_NOTHROWNOALIAS
+    boost::iterator_range<T * LE_RESTRICT> LE_FASTCALL allocate( std::uint32_t const numberOfElements )
+    {
+        auto const bytes( requiredStorage<T>( numberOfElements ) );
+        BOOST_ASSERT_MSG( bytes <= available(), "Scratch arena exhausted (missing or insufficient scratchStorage() declaration)." );
+        BOOST_ASSERT_MSG( reinterpret_cast<std::size_t>( pTop_ ) % Utility::Constants::vectorAlignment == 0, "Misaligned scratch allocation." );
+        T * LE_RESTRICT const pBegin( reinterpret_cast<T *>( pTop_ ) );
+        pTop_ += bytes;
+        return boost::iterator_range<T * LE_RESTRICT>( pBegin, pBegin + numberOfElements );
+    }
+
+private:
+    Utility::SharedStorageBuffer<char> buffer_;
+    char *                             pTop_  ;
+}; // class ScratchArena
+
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_END( Engine )
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // scratchArena_hpp
@@ -16,6 +16,8 @@
 #include "le/math/dft/domainConversion.hpp"
 #include "le/math/dft/fft.hpp"
 #include "le/math/math.hpp"
+
+#include <algorithm>
 //------------------------------------------------------------------------------
 namespace LE
 {
@@ -53,7 +55,12 @@ Setup::Setup()
     windowSizeFactor_      ( 0                            ),
 #endif // LE_SW_ENGINE_WINDOW_PRESUM
     wolaGain_              ( 0                            ),
-    maximumAmplitude_      ( 0                            )
+    maximumAmplitude_      ( 0                            ),
+    shedOptionalModules_   ( false                        ),
+    reducedQuality_        ( false                        ),
+    resolutionLayers_      ( 1                            ),
+    resolutionLayer_       ( 0                            ),
+    generation_            ( 0                            )
 {
 }
 
@@ -95,13 +102,17 @@ std::uint16_t Setup::numberOfBins() const
 /// are actually ((FFT-size / 2) + 1), not (FFT-size / 2), valid frequencies or
 /// bins.
 ///
+/// Frequencies above the Nyquist frequency of the selected resolution layer
+/// map to its last bin.
+///
 ////////////////////////////////////////////////////////////////////////////////
 
 std::uint16_t Setup::normalisedFrequencyToBin( float const normalisedFrequency ) const
 {
     BOOST_ASSERT_MSG( Math::isNormalisedValue( normalisedFrequency ), "Frequency out of range." );
-    auto const result( Math::convert<std::uint16_t>( normalisedFrequency * fftSize<float>() / 2 ) );
-    BOOST_ASSERT_MSG( result == Math::convert<std::uint16_t>( normalisedFrequency * ( numberOfBins() - 1 ) ), "Frequency-bin calculation bug." );
+    float const layerFrequency( std::min<float>( normalisedFrequency * resolutionDecimation(), 1 ) );
+    auto const result( Math::convert<std::uint16_t>( layerFrequency * fftSize<float>() / 2 ) );
+    BOOST_ASSERT_MSG( result == Math::convert<std::uint16_t>( layerFrequency * ( numberOfBins() - 1 ) ), "Frequency-bin calculation bug." );
     return result;
 }
 
@@ -137,8 +148,8 @@ std::uint16_t Setup::frequencyPercentageToBin( float const percentage ) const
 std::uint16_t Setup::frequencyPercentageToBin( std::uint8_t const percentage ) const
 {
     BOOST_ASSERT_MSG( percentage >= 0 && percentage <= 100, "Percentage value out of range." );
-    auto const result( fftSize<unsigned int>() * percentage / 100 / 2 );
-    BOOST_ASSERT_MSG( result == unsigned( percentage * ( numberOfBins() - 1 ) / 100 ), "Percentage-bin calculation bug." );
+    auto const result( std::min( fftSize<unsigned int>() * percentage * resolutionDecimation() / 100 / 2, fftSize<unsigned int>() / 2 ) );
+    BOOST_ASSERT_MSG( ( resolutionDecimation() != 1 ) || ( result == unsigned( percentage * ( numberOfBins() - 1 ) / 100 ) ), "Percentage-bin calculation bug." );
     return static_cast<std::uint16_t>( result );
 }
 
@@ -146,15 +157,15 @@ std::uint16_t Setup::frequencyPercentageToBin( std::uint8_t const percentage ) c
 std::uint16_t Setup::frequencyInHzToBin( std::uint32_t const frequency ) const
 {
     auto const maximumFrequency( sampleRate<unsigned int>() / 2 );
-    BOOST_ASSERT_MSG( frequency <= maximumFrequency, "Frequency out of range." );
-    return static_cast<std::uint16_t>( ( numberOfBins() - 1 ) * frequency / maximumFrequency );
+    BOOST_ASSERT_MSG( frequency <= maximumFrequency * resolutionDecimation(), "Frequency out of range." );
+    return static_cast<std::uint16_t>( ( numberOfBins() - 1 ) * std::min( frequency, maximumFrequency ) / maximumFrequency );
 }
 
 
 float Setup::normalisedFrequencyToHz( float const normalisedFrequency ) const
 {
     BOOST_ASSERT_MSG( Math::isNormalisedValue( normalisedFrequency ), "Frequency out of range." );
-    return normalisedFrequency * sampleRate<float>() / 2;
+    return normalisedFrequency * sampleRate<float>() * resolutionDecimation() / 2;
 }
 
 
@@ -198,20 +209,27 @@ float Setup::stepTime      (                     ) const { return stepSize <floa
 /// each sample has to "pass through" the entire FFT buffer before appearing at 
 /// the output regardless of window overlapping.
 ///
+/// In the multi-resolution mode all the layers are delayed to match the
+/// deepest one: its (decimated) window plus the delays of its decimation and
+/// interpolation filters.
+///
 /// http://www.mathworks.com/help/dsp/ref/overlapaddfftfilter.html
 /// http://dsp.stackexchange.com/questions/2537/do-fft-based-filtering-methods-add-intrinsic-latency-to-a-real-time-algorithm
 ///
 ////////////////////////////////////////////////////////////////////////////////
 
-std::uint16_t Setup::latencyInSamples() const
+std::uint32_t Setup::latencyInSamples() const
 {
-    return static_cast<std::uint16_t>( frameSize<unsigned int>() * windowSizeFactor() );
+    std::uint32_t const deepestDecimation( 1U << ( resolutionLayers_ - 1 )                                                          );
+    std::uint32_t const filterLatency    ( ( deepestDecimation > 1 ) ? 2 * Constants::resamplingFilterHalfLength * deepestDecimation : 0 );
+    return frameSize<unsigned int>() * windowSizeFactor() * deepestDecimation + filterLatency;
 }
 
 
 float Setup::latencyInMilliseconds() const
 {
-    return frameTime() * Math::convert<float>( windowSizeFactor() ) * 1000;
+    // The latency is expressed in samples of the full rate layer:
+    return Math::convert<float>( latencyInSamples() ) / ( sampleRate<float>() * resolutionDecimation() ) * 1000;
 }
 
 
@@ -220,6 +238,7 @@ void Setup::setWindowFunction( Window const window )
     BOOST_ASSERT_MSG( window >= 0                         , "Unknown window." );
     BOOST_ASSERT_MSG( window <  Constants::NumberOfWindows, "Unknown window." );
     windowFunction_ = window;
+    ++generation_;
 }
 
 
@@ -228,6 +247,63 @@ void Setup::setNumberOfChannels( std::uint8_t const numberOfMainChannels, std::u
     BOOST_ASSERT_MSG( numberOfSideChannels <= numberOfMainChannels, "Too many side channel inputs." );
     numberOfChannels_     = numberOfMainChannels;
     numberOfSideChannels_ = numberOfSideChannels;
+    ++generation_;
+}
+
+
+/// \note Called for every process() call so the generation is bumped only
+/// for actual changes.
+void Setup::setLoadShedding( bool const optionalModules, bool const expensiveModes )
+{
+    if ( ( optionalModules == shedOptionalModules_ ) && ( expensiveModes == reducedQuality_ ) )
+        return;
+    shedOptionalModules_ = optionalModules;
+    reducedQuality_      = expensiveModes;
+    ++generation_;
+}
+
+
+void Setup::setResolutionLayers( std::uint8_t const numberOfLayers )
+{
+    BOOST_ASSERT_MSG( numberOfLayers >= 1 && numberOfLayers <= Constants::maximumResolutionLayers, "Invalid number of resolution layers." );
+    BOOST_ASSERT_MSG( resolutionLayer_ == 0                                                      , "Deeper resolution layer selected."    );
+    resolutionLayers_ = numberOfLayers;
+    ++generation_;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Setup::selectResolutionLayer()
+// ------------------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \brief Switches the sample rate dependent values to those of the given
+/// resolution layer: each layer halves the sample rate and the hop size (in
+/// samples of its own rate) of the previous one so it doubles the overlap
+/// factor (and the WOLA gain, as the same windows are used by all the layers).
+///
+/// Only used by the Processor for the duration of the layer's processing, all
+/// the other setters expect the first (full rate) layer to be selected.
+///   Does not change the generation(): the setups of the layers are kept (and
+/// checked for staleness) per layer (see ModuleDSP::setupUpToDate()).
+///
+////////////////////////////////////////////////////////////////////////////////
+
+void Setup::selectResolutionLayer( std::uint8_t const layer )
+{
+    BOOST_ASSERT_MSG( layer < resolutionLayers_, "Invalid resolution layer." );
+    if ( layer == resolutionLayer_ )
+        return;
+
+    // Power of two scaling keeps the floating point values exact (so that they
+    // are restored exactly when returning to the first layer).
+    float const scale( Math::convert<float>( 1U << resolutionLayer_ ) / Math::convert<float>( 1U << layer ) );
+    sampleRate_        = sampleRate<float>() * scale;
+    overlappingFactor_ = ( overlappingFactor_.integer << layer ) >> resolutionLayer_;
+    wolaGain_         /= scale;
+    resolutionLayer_   = layer;
 }
 
 
@@ -71,6 +71,27 @@ public: // Read only interface for effects.
     float        const & maximumAmplitude    () const { return maximumAmplitude_    ; }
     float        const & wolaRippleFactor    () const { return wolaRippleFactor_    ; }
 
+    /// \brief Set by the core engine while it is shedding load (see the
+    /// SpectrumWorxCore quality of service controller). While set the
+    /// polar <-> rectangular conversions are capped to the FineConversion tier
+    /// (see effectiveConversionAccuracy()) and effects with optional expensive
+    /// processing modes should fall back to their cheapest variant.
+    bool                 reducedQuality      () const { return reducedQuality_      ; }
+    bool                 shedOptionalModules () const { return shedOptionalModules_ ; }
+
+    /// \brief Incremented by every setter (except selectResolutionLayer()) so
+    /// that modules can cheaply detect that their cached (per resolution layer)
+    /// setup (see ModuleDSP::preProcess()) went stale.
+    std::uint32_t        generation          () const { return generation_          ; }
+
+    /// \brief Multi-resolution mode (see ResolutionLayers): while a deeper
+    /// layer is selected the sample rate, the overlap factor and the WOLA gain
+    /// are those of the layer (the FFT size is shared by all the layers) while
+    /// normalised frequencies stay relative to the full rate Nyquist frequency.
+    std::uint8_t         resolutionLayers    () const { return resolutionLayers_    ; }
+    std::uint8_t         resolutionLayer     () const { return resolutionLayer_     ; }
+    std::uint8_t         resolutionDecimation() const { return static_cast<std::uint8_t>( 1 << resolutionLayer_ ); }
+
 public: // Utility interface.
     template <typename T> T frameSize           () const { return fftSize   <T>()                               ; }
     template <typename T> T stepSize            () const { return frameSize <T>() / windowOverlappingFactor<T>(); }
@@ -81,7 +102,7 @@ public: // Utility interface.
     float         frameTime   () const;
     float         stepTime    () const;
 
-    std::uint16_t latencyInSamples     () const;
+    std::uint32_t latencyInSamples     () const;
     float         latencyInMilliseconds() const;
 
     std::uint16_t frequencyInHzToBin      ( std::uint32_t frequency           ) const;
@@ -101,15 +122,20 @@ public: // Non-const interface for the core engine.
 
     template <typename T> void setFFTSize          ( T const & newValue );
     template <typename T> void setOverlappingFactor( T const & newValue );
-    template <typename T> void setSampleRate       ( T const & newValue ) { sampleRate_ = newValue; }
+    template <typename T> void setSampleRate       ( T const & newValue ) { sampleRate_ = newValue; ++generation_; }
 
 #if LE_SW_ENGINE_WINDOW_PRESUM
-    void setWindowSizeFactor( std::uint8_t const value                                             ) { windowSizeFactor_ = value; }
+    void setWindowSizeFactor( std::uint8_t const value                                             ) { windowSizeFactor_ = value; ++generation_; }
 #endif // LE_SW_ENGINE_WINDOW_PRESUM
     void setWindowFunction  ( Window                                                               );
     void setNumberOfChannels( std::uint8_t numberOfMainChannels, std::uint8_t numberOfSideChannels );
 
-    void setWOLAGainAndRipple( float const gain, float const ripple ) { wolaGain_ = gain; wolaRippleFactor_ = ripple; }
+    void setWOLAGainAndRipple( float const gain, float const ripple ) { wolaGain_ = gain; wolaRippleFactor_ = ripple; ++generation_; }
+
+    void setLoadShedding( bool optionalModules, bool expensiveModes );
+
+    void setResolutionLayers  ( std::uint8_t numberOfLayers );
+    void selectResolutionLayer( std::uint8_t layer          );
 
 private:
     void updateMaximumAmplitude();
@@ -158,6 +184,11 @@ private:
     float          wolaGain_            ;
     float          maximumAmplitude_    ;
     float          wolaRippleFactor_    ;
+    bool           shedOptionalModules_ ;
+    bool           reducedQuality_      ;
+    std::uint8_t   resolutionLayers_    ;
+    std::uint8_t   resolutionLayer_     ;
+    std::uint32_t  generation_          ;
 }; // class Setup
 
 
@@ -177,6 +208,7 @@ void Setup::setFFTSize( T const & newValue )
 {
     fftSize_ = newValue;
     updateMaximumAmplitude();
+    ++generation_;
 }
 
 
@@ -196,6 +228,7 @@ void Setup::setOverlappingFactor( T const & newValue )
 {
     overlappingFactor_ = newValue;
     verifyOverlapFactor();
+    ++generation_;
 }
 
 //------------------------------------------------------------------------------
@@ -0,0 +1,315 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// spectralEnvelope.cpp
+/// --------------------
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#include "spectralEnvelope.hpp"
+
+#include "processor.hpp"
+#include "setup.hpp"
+#include "spectralFeatures.hpp"
+
+#include "le/math/constants.hpp"
+#include "le/math/dft/fft.hpp"
+#include "le/math/math.hpp"
+#include "le/math/vector.hpp"
+
+#include "boost/assert.hpp"
+
+#include <cmath>
+#include <limits>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_BEGIN( Engine )
+//------------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// SpectralEnvelope::cosineTransform()
+// -----------------------------------
+//
+//   Real-even DFT of the numberOfBins unique values of an even spectrum (i.e.
+// the unnormalised inverse DFT of the full, mirrored spectrum) computed for
+// only the first numberOfOutputs (quefrency/lag) indices.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+LE_NOTHROW LE_HOT
+void SpectralEnvelope::cosineTransform( float const * LE_RESTRICT const pInput, float * LE_RESTRICT const pOutput, std::uint16_t const numberOfOutputs ) const
+{
+    float const * LE_RESTRICT const pCosines  ( cosines_.begin()                            );
+    std::uint32_t             const fftSize   ( cosines_.size()                             );
+    std::uint16_t             const nyquistBin( static_cast<std::uint16_t>( fftSize / 2 ) );
+
+    for ( std::uint16_t n( 0 ); n < numberOfOutputs; ++n )
+    {
+        float sum( 0 );
+        std::uint32_t cosineIndex( n );
+        for ( std::uint16_t k( 1 ); k < nyquistBin; ++k )
+        {
+            sum += pInput[ k ] * pCosines[ cosineIndex ];
+            cosineIndex += n;
+            if ( cosineIndex >= fftSize )
+                cosineIndex -= fftSize;
+        }
+        float const nyquist( ( n % 2 ) ? -pInput[ nyquistBin ] : pInput[ nyquistBin ] );
+        pOutput[ n ] = pInput[ 0 ] + nyquist + 2 * sum;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// SpectralEnvelope::cepstral()
+// ----------------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+
+LE_NOTHROW LE_HOT
+void SpectralEnvelope::cepstral
+(
+    ReadOnlyDataRange const & amplitudes,
+    ReadOnlyDataRange const & lifter,
+    DataRange         const & workBuffer,
+    Setup             const & engineSetup
+) const
+{
+    BOOST_ASSERT( amplitudes.size() == engineSetup.numberOfBins() );
+
+    if ( directlyCheaper( static_cast<std::uint16_t>( lifter.size() ) ) )
+    {
+        cepstralDirect( amplitudes, lifter, workBuffer );
+    }
+    else
+    {
+        Processor const & processor( Processor::fromEngineSetup( engineSetup ) );
+        processor.features().cepstrum( amplitudes, workBuffer, engineSetup );
+        lifterCepstrum( lifter, workBuffer, processor.fft() );
+    }
+}
+
+
+LE_NOTHROW LE_HOT
+void SpectralEnvelope::lifterCepstrum
+(
+    ReadOnlyDataRange       const & lifter,
+    DataRange               const & workBuffer,
+    Math::FFT_float_real_1D const & fft
+) const
+{
+    using namespace Math;
+
+    std::uint32_t const fftSize             ( cosines_.size()                             );
+    auto          const numberOfCoefficients( static_cast<std::uint16_t>( lifter.size() ) );
+    BOOST_ASSERT( fft.size() == fftSize                     );
+    BOOST_ASSERT( numberOfCoefficients <= workBuffer.size() );
+
+    float * LE_RESTRICT const pEnvelope  ( workBuffer.begin()                                                         );
+    float * LE_RESTRICT const pSecondHalf( static_cast<float *>( align( workBuffer.begin() + fftSize / 2 + 1 ) ) );
+
+    for ( std::uint16_t n( 0 ); n < numberOfCoefficients; ++n )
+        pEnvelope[ n ] *= lifter[ n ];
+    clear( pEnvelope + numberOfCoefficients, workBuffer.end() );
+    // Transform back into the frequency domain (low passed spectrum/envelope)
+    // and discard the imaginary components:
+    fft.transform( pEnvelope, pSecondHalf, static_cast<std::uint16_t>( fftSize ) );
+}
+
+
+LE_NOTHROW LE_HOT
+void SpectralEnvelope::cepstralDirect
+(
+    ReadOnlyDataRange const & amplitudes,
+    ReadOnlyDataRange const & lifter,
+    DataRange         const & workBuffer
+) const
+{
+    using namespace Math;
+
+    std::uint32_t const fftSize             ( cosines_.size()                                 );
+    auto          const numberOfBins        ( static_cast<std::uint16_t>( amplitudes.size() ) );
+    auto          const numberOfCoefficients( static_cast<std::uint16_t>( lifter.size()     ) );
+    BOOST_ASSERT( numberOfBins == fftSize / 2 + 1                 );
+    BOOST_ASSERT( numberOfCoefficients <= numberOfBins            );
+    BOOST_ASSERT( workBuffer.size() >= alignIndex( numberOfBins ) * 2 );
+
+    float * LE_RESTRICT const pEnvelope  ( workBuffer.begin()                                                  );
+    float * LE_RESTRICT const pSecondHalf( static_cast<float *>( align( workBuffer.begin() + numberOfBins ) ) );
+
+    // Log spectrum in the second half:
+    DataRange const logSpectrum( pSecondHalf, pSecondHalf + numberOfBins );
+    add( amplitudes, std::numeric_limits<float>::epsilon(), logSpectrum );
+    ln ( logSpectrum );
+
+    // Liftered cepstral coefficients (the engine's FFT is unitary so the
+    // analysis and synthesis together scale by 1 / fftSize):
+    cosineTransform( logSpectrum.begin(), pEnvelope, numberOfCoefficients );
+    float const scale( 1 / convert<float>( fftSize ) );
+    for ( std::uint16_t n( 0 ); n < numberOfCoefficients; ++n )
+        pSecondHalf[ n ] = pEnvelope[ n ] * lifter[ n ] * scale;
+
+    // Synthesis:
+    float const * LE_RESTRICT const pCoefficients( pSecondHalf      );
+    float const * LE_RESTRICT const pCosines     ( cosines_.begin() );
+    for ( std::uint16_t k( 0 ); k < numberOfBins; ++k )
+    {
+        float sum( 0 );
+        std::uint32_t cosineIndex( 0 );
+        for ( std::uint16_t n( 0 ); n < numberOfCoefficients; ++n )
+        {
+            sum += pCoefficients[ n ] * pCosines[ cosineIndex ];
+            cosineIndex += k;
+            if ( cosineIndex >= fftSize )
+                cosineIndex -= fftSize;
+        }
+        pEnvelope[ k ] = sum;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// SpectralEnvelope::lpc()
+// -----------------------
+//
+// http://ccrma.stanford.edu/~jos/SpecEnv/LPC_Envelope_Example_Speech.html
+// http://en.wikipedia.org/wiki/Levinson_recursion
+//
+////////////////////////////////////////////////////////////////////////////////
+
+LE_NOTHROW LE_HOT
+void SpectralEnvelope::lpc( ReadOnlyDataRange const & amplitudes, std::uint8_t const order, DataRange const & envelope ) const
+{
+    using namespace Math;
+
+    std::uint32_t const fftSize     ( cosines_.size()                                 );
+    auto          const numberOfBins( static_cast<std::uint16_t>( amplitudes.size() ) );
+    BOOST_ASSERT( numberOfBins == fftSize / 2 + 1                 );
+    BOOST_ASSERT( envelope.size() == numberOfBins                 );
+    BOOST_ASSERT( ( order > 0 ) && ( order <= maximumLPCOrder ) );
+    BOOST_ASSERT( order < numberOfBins                            );
+
+    // Autocorrelation (fftSize times the actual one) from the power spectrum
+    // (using the envelope as scratch space):
+    copy  ( amplitudes, envelope );
+    square( envelope             );
+    float autocorrelation[ maximumLPCOrder + 1 ];
+    cosineTransform( envelope.begin(), autocorrelation, order + 1 );
+
+    // Levinson-Durbin recursion (in double precision, with a slight white noise
+    // floor for numerical robustness):
+    double predictor[ maximumLPCOrder + 1 ];
+    double error( autocorrelation[ 0 ] * ( 1 + 1e-9 ) );
+    if ( !( error > 0 ) )
+    {
+        clear( envelope );
+        return;
+    }
+    predictor[ 0 ] = 1;
+    for ( std::uint8_t i( 1 ); i <= order; ++i )
+    {
+        double accumulator( autocorrelation[ i ] );
+        for ( std::uint8_t j( 1 ); j < i; ++j )
+            accumulator += predictor[ j ] * autocorrelation[ i - j ];
+        double const reflection( -accumulator / error );
+        for ( std::uint8_t j( 1 ); j <= i / 2; ++j )
+        {
+            double const lower( predictor[ j     ] );
+            double const upper( predictor[ i - j ] );
+            predictor[ j     ] = lower + reflection * upper;
+            predictor[ i - j ] = upper + reflection * lower;
+        }
+        predictor[ i ] = reflection;
+        error *= 1 - reflection * reflection;
+    }
+
+    // Envelope = gain / |A( e^jw )|, sin( x ) = cos( x + 3 * pi / 2 ):
+    float coefficients[ maximumLPCOrder + 1 ];
+    for ( std::uint8_t n( 0 ); n <= order; ++n )
+        coefficients[ n ] = static_cast<float>( predictor[ n ] );
+    float const gain( static_cast<float>( std::sqrt( error / fftSize ) ) );
+
+    float const * LE_RESTRICT const pCosines  ( cosines_.begin() );
+    std::uint32_t             const sineOffset( fftSize / 4 * 3  );
+    for ( std::uint16_t k( 0 ); k < numberOfBins; ++k )
+    {
+        float real( 0 );
+        float imag( 0 );
+        std::uint32_t cosineIndex( 0 );
+        for ( std::uint8_t n( 0 ); n <= order; ++n )
+        {
+            std::uint32_t sineIndex( cosineIndex + sineOffset );
+            if ( sineIndex >= fftSize )
+                sineIndex -= fftSize;
+            real += coefficients[ n ] * pCosines[ cosineIndex ];
+            imag += coefficients[ n ] * pCosines[ sineIndex   ];
+            cosineIndex += k;
+            if ( cosineIndex >= fftSize )
+                cosineIndex -= fftSize;
+        }
+        envelope[ k ] = gain / std::sqrt( real * real + imag * imag + std::numeric_limits<float>::min() );
+    }
+}
+
+
+void SpectralEnvelope::udoBrickLifter( std::uint16_t const cutoff, float const gain, DataRange const & lifter )
+{
+    BOOST_ASSERT( lifter.size() == cutoff + 2u );
+    float * LE_RESTRICT const pLifter( lifter.begin() );
+    Math::fill( pLifter, 1.0f, cutoff );
+    if ( cutoff > 2 )
+    {
+        Math::fill( &pLifter[ 1 ], gain, cutoff - 2 );
+        // an attempt to make the LP less of a brick...
+        pLifter[ 0          ] = 0.50f * gain;
+        pLifter[ cutoff - 1 ] = 0.75f * gain;
+    }
+        pLifter[ cutoff     ] = 0.50f * gain;
+        pLifter[ cutoff + 1 ] = 0.25f * gain;
+}
+
+
+bool SpectralEnvelope::directlyCheaper( std::uint16_t const numberOfCoefficients ) const
+{
+    /// \note The direct path costs two scalar (table lookup bound)
+    /// numberOfCoefficients x numberOfBins passes against two real FFTs so the
+    /// crossover grows with log2( fftSize ). Timed against a scalar radix-2
+    /// real FFT it lies at 1.25 - 1.5 coefficients per FFT stage for all sizes
+    /// from 128 to 8192, the constant is rounded down for the vectorised
+    /// engine FFT (the spectralEnvelopeBenchmark tool reports the crossover
+    /// of an actual build).
+    return numberOfCoefficients <= directCoefficientsPerFFTStage * Math::log2( cosines_.size() );
+}
+
+
+std::uint32_t SpectralEnvelope::requiredStorage( StorageFactors const & factors )
+{
+    return FFTBuffer<real_t>::requiredStorage( factors );
+}
+
+
+LE_COLD
+void SpectralEnvelope::resize( StorageFactors const & factors, Storage & storage )
+{
+    cosines_.resize( factors, storage );
+    double const step( Math::Constants::twoPi_d / cosines_.size() );
+    for ( std::uint32_t n( 0 ); n < cosines_.size(); ++n )
+        cosines_[ n ] = static_cast<float>( std::cos( n * step ) );
+}
+
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_END( Engine )
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file spectralEnvelope.hpp
+/// --------------------------
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef spectralEnvelope_hpp__6B1E93D2_4F7A_4C05_8E3B_A1C5D0729F48
+#define spectralEnvelope_hpp__6B1E93D2_4F7A_4C05_8E3B_A1C5D0729F48
+#pragma once
+//------------------------------------------------------------------------------
+#include "buffers.hpp"
+
+#include "le/math/dft/fft.hpp"
+#include "le/utility/platformSpecifics.hpp"
+
+#include <cstdint>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_BEGIN( Engine )
+//------------------------------------------------------------------------------
+
+class Setup;
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class SpectralEnvelope
+///
+/// \brief Spectral envelope estimation shared by the envelope based effects.
+///
+///   The (log) amplitude spectrum of a real signal is real and even so its
+/// cepstrum can be computed with a real-even (DCT-like) transform of the
+/// numberOfBins unique values instead of a full size inverse FFT. When only a
+/// few low quefrency coefficients survive the lifter (short lifters, smaller
+/// FFT sizes) it is cheaper to compute just those coefficients and their
+/// synthesis directly (two K x numberOfBins cosine matrix products, with the
+/// cosines looked up in a single period table) than to do two full size FFTs
+/// so the cheaper of the two is chosen per call (see directlyCheaper() and
+/// the spectralEnvelopeBenchmark tool). Both paths produce the same result as
+/// the engine's (unitary) FFT based cepstral smoothing.
+///
+///   The same cosine table also provides a cheap LPC (all-pole) envelope as
+/// an alternative to cepstral smoothing.
+///
+///   Available through Processor::fromEngineSetup( engineSetup ).spectralEnvelope().
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class SpectralEnvelope
+{
+public:
+    static std::uint8_t BOOST_CONSTEXPR_OR_CONST maximumLPCOrder = 48;
+
+    /// Up to how many cepstral coefficients per log2( fftSize ) the direct
+    /// path is used (see directlyCheaper()).
+    static std::uint8_t BOOST_CONSTEXPR_OR_CONST directCoefficientsPerFFTStage = 1;
+
+    /// Stores the cepstrally smoothed natural logarithm of the given full range
+    /// amplitudes at the beginning of the workBuffer (which must hold at least
+    /// two aligned numberOfBins sized halves).
+    ///   The lifter holds the weights of the (one sided) low quefrency
+    /// cepstral coefficients, the remaining coefficients are discarded, i.e.
+    /// symmetric lifters have to be given with doubled weights (except for
+    /// the zeroth coefficient).
+    LE_NOTHROW void LE_FASTCALL cepstral( ReadOnlyDataRange const & fullAmplitudes, ReadOnlyDataRange const & lifter, DataRange const & workBuffer, Setup const & ) const;
+
+    /// Stores the LPC envelope (of the given order, in linear amplitudes) of
+    /// the given full range amplitudes into the numberOfBins sized envelope.
+    LE_NOTHROW void LE_FASTCALL lpc( ReadOnlyDataRange const & fullAmplitudes, std::uint8_t order, DataRange const & envelope ) const;
+
+    /// Fills the cutoff + 2 sized lifter with the DAFX (Udo Zolzer, 9.3.1)
+    /// brickwall lifter with slightly softened edges.
+    static void LE_FASTCALL udoBrickLifter( std::uint16_t cutoff, float gain, DataRange const & lifter );
+
+    /// Whether the given number of cepstral coefficients is computed directly
+    /// (or through the FFT).
+    bool LE_FASTCALL directlyCheaper( std::uint16_t numberOfCoefficients ) const;
+
+    /// The two cepstral() paths (for benchmarking): the FFT one expects the
+    /// real cepstrum of the amplitudes at the beginning of the workBuffer (see
+    /// SpectralFeatures::cepstrum()).
+    LE_NOTHROW void LE_FASTCALL cepstralDirect( ReadOnlyDataRange const & fullAmplitudes, ReadOnlyDataRange const & lifter, DataRange const & workBuffer                                  ) const;
+    LE_NOTHROW void LE_FASTCALL lifterCepstrum(                                           ReadOnlyDataRange const & lifter, DataRange const & workBuffer, Math::FFT_float_real_1D const & ) const;
+
+private:
+    LE_NOTHROW void LE_FASTCALL cosineTransform( float const * pInput, float * pOutput, std::uint16_t numberOfOutputs ) const;
+
+private:
+    FFTBuffer<real_t> cosines_; // cos( 2 * pi * n / fftSize ), n in [ 0, fftSize )
+
+public:
+    static std::uint32_t requiredStorage( StorageFactors const & );
+
+    void resize( StorageFactors const &, Storage & );
+}; // class SpectralEnvelope
+
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_END( Engine )
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // spectralEnvelope_hpp
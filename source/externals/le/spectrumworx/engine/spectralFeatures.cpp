@@ -0,0 +1,227 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// spectralFeatures.cpp
+/// --------------------
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#include "spectralFeatures.hpp"
+
+#include "channelData.hpp"
+#include "processor.hpp"
+#include "setup.hpp"
+
+#include "le/math/dft/fft.hpp"
+#include "le/math/vector.hpp"
+#include "le/utility/clear.hpp"
+#include "le/utility/parentFromMember.hpp"
+
+#include "boost/assert.hpp"
+
+#include <limits>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_BEGIN( Engine )
+//------------------------------------------------------------------------------
+
+SpectralFeatures::SpectralFeatures()
+    :
+    hop_           ( 1 ),
+    sideGeneration_( 0 )
+{
+    Utility::clear( statistics_ );
+    Version const invalid = { 0, 0 };
+    for ( auto & features : channels_ )
+    {
+        features.cepstrum = invalid;
+        features.centroid = invalid;
+        features.pitch    = invalid;
+    }
+}
+
+
+LE_NOTHROW
+SpectralFeatures::Features * SpectralFeatures::lookup( ReadOnlyDataRange const & amplitudes, Version & version )
+{
+    ChannelData & channelData( Utility::ParentFromMember<ChannelData, SpectralFeatures, &ChannelData::features_>()( *this ) );
+    FullMainSideChannelData_AmPh const & data( channelData.amphData() );
+
+    version.hop = hop_;
+    if ( ( amplitudes.begin() == data.main().amps().begin() ) && ( amplitudes.end() == data.main().amps().end() ) )
+    {
+        version.generation = channelData.contentGeneration();
+        return &channels_[ DataPair::Main ];
+    }
+    if ( ( amplitudes.begin() == data.side().amps().begin() ) && ( amplitudes.end() == data.side().amps().end() ) )
+    {
+        version.generation = sideGeneration_;
+        return &channels_[ DataPair::Side ];
+    }
+    return nullptr;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// SpectralFeatures::cepstrum()
+// ----------------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+
+LE_NOTHROW
+void SpectralFeatures::cepstrum( ReadOnlyDataRange const & amplitudes, DataRange const & workBuffer, Setup const & engineSetup )
+{
+    using namespace Math;
+
+    FFT_float_real_1D const & fft( Processor::fromEngineSetup( engineSetup ).fft() );
+    auto const fftSize( fft.size() );
+    BOOST_ASSERT( amplitudes.size() == engineSetup.numberOfBins() );
+
+    Version version;
+    Features * const pFeatures( lookup( amplitudes, version ) );
+    ++statistics_.cepstrum.requests;
+    if ( pFeatures && ( pFeatures->cepstrum == version ) )
+    {
+        ++statistics_.cepstrum.hits;
+        copy( pFeatures->cepstrumValue.begin(), pFeatures->cepstrumValue.end(), workBuffer.begin() );
+        return;
+    }
+
+    computeCepstrum( amplitudes, workBuffer, fft );
+
+    if ( pFeatures )
+    {
+        BOOST_ASSERT( pFeatures->cepstrumValue.size() == fftSize );
+        copy( workBuffer.begin(), workBuffer.begin() + fftSize, pFeatures->cepstrumValue.begin() );
+        pFeatures->cepstrum = version;
+    }
+}
+
+
+LE_NOTHROW
+void SpectralFeatures::computeCepstrum( ReadOnlyDataRange const & amplitudes, DataRange const & workBuffer, Math::FFT_float_real_1D const & fft )
+{
+    using namespace Math;
+
+    auto const numberOfBins( static_cast<std::uint16_t>( amplitudes.size() ) );
+    BOOST_ASSERT( numberOfBins == fft.size() / 2 + 1                  );
+    BOOST_ASSERT( workBuffer.size() >= alignIndex( numberOfBins ) * 2 );
+
+    DataRange const logSpectrum( workBuffer.begin(), workBuffer.begin() + numberOfBins );
+    add( amplitudes, std::numeric_limits<float>::epsilon(), logSpectrum );
+    ln ( logSpectrum );
+
+    // Dummy/null imaginary components (the log spectrum is real):
+    float * LE_RESTRICT const pImags( static_cast<float *>( align( logSpectrum.end() ) ) );
+    clear( pImags, numberOfBins );
+
+    // Inplace FFT: the work buffer now starts with the real cepstrum.
+    fft.inverseTransform( logSpectrum.begin(), pImags, fft.size() );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// SpectralFeatures::centroid()
+// ----------------------------
+//
+// http://en.wikipedia.org/wiki/Spectral_centroid
+//
+////////////////////////////////////////////////////////////////////////////////
+
+LE_NOTHROW
+float SpectralFeatures::centroid( ReadOnlyDataRange const & amplitudes )
+{
+    Version version;
+    Features * const pFeatures( lookup( amplitudes, version ) );
+    ++statistics_.centroid.requests;
+    if ( pFeatures && ( pFeatures->centroid == version ) )
+    {
+        ++statistics_.centroid.hits;
+        return pFeatures->centroidValue;
+    }
+
+    float binmag( 0 );
+    float mag   ( std::numeric_limits<float>::epsilon() );
+
+    float binCounter( 0 );
+    for ( float const amp : amplitudes )
+    {
+        binmag += binCounter++ * amp;
+        mag    +=                amp;
+    }
+
+    float const centroid( binmag / mag );
+
+    if ( pFeatures )
+    {
+        pFeatures->centroidValue = centroid;
+        pFeatures->centroid      = version;
+    }
+    return centroid;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// SpectralFeatures::pitch()
+// -------------------------
+//
+////////////////////////////////////////////////////////////////////////////////
+
+LE_NOTHROW
+float SpectralFeatures::pitch
+(
+    ReadOnlyDataRange           const &       amplitudes,
+    PitchDetector::ChannelState       &       cs,
+    float                             const lfb,
+    float                             const hfb,
+    Setup                       const &       engineSetup
+)
+{
+    Version version;
+    Features * const pFeatures( lookup( amplitudes, version ) );
+    ++statistics_.pitch.requests;
+    if ( !pFeatures )
+        return PitchDetector::findPitch( amplitudes, cs, lfb, hfb, engineSetup );
+
+    if ( pFeatures->pitch == version )
+    {
+        ++statistics_.pitch.hits;
+    }
+    else
+    {
+        PitchDetector::analyse( amplitudes, pFeatures->pitchCandidates, engineSetup );
+        pFeatures->pitch = version;
+    }
+    return PitchDetector::estimate( pFeatures->pitchCandidates, cs, lfb, hfb );
+}
+
+
+std::uint32_t SpectralFeatures::requiredStorage( StorageFactors const & factors )
+{
+    return Cepstrum::requiredStorage( factors ) * 2;
+}
+
+
+void SpectralFeatures::resize( StorageFactors const & factors, Storage & storage )
+{
+    for ( auto & features : channels_ )
+        features.cepstrumValue.resize( factors, storage );
+    invalidate();
+}
+
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_END( Engine )
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file spectralFeatures.hpp
+/// --------------------------
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef spectralFeatures_hpp__4A7E2B90_1C3D_4E58_9F06_B2D81C6E7A35
+#define spectralFeatures_hpp__4A7E2B90_1C3D_4E58_9F06_B2D81C6E7A35
+#pragma once
+//------------------------------------------------------------------------------
+#include "buffers.hpp"
+
+#include "le/analysis/pitch_detector/pitchDetector.hpp"
+#include "le/math/dft/fft.hpp"
+#include "le/utility/platformSpecifics.hpp"
+
+#include <array>
+#include <cstdint>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_BEGIN( Engine )
+//------------------------------------------------------------------------------
+
+class ChannelData;
+class Setup;
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class SpectralFeatures
+///
+/// \brief Per channel, per hop memoised spectral features shared by the
+/// modules in a chain.
+///
+///   Features are computed on request from the full range amplitudes of the
+/// main or the side channel of the owning ChannelData and are reused for as
+/// long as the data they were computed from remains unmodified: main channel
+/// features are keyed on the ChannelData content generation (which the data
+/// request of a module following one that can write to the data advances,
+/// see ChannelData::mainDataModified(), i.e. they describe a module's input
+/// and have to be requested before the module writes to the data) while side
+/// channel features remain valid until the next hop unless a module reports
+/// writing to the side channel through sideChannelModified(). Amplitudes that
+/// do not belong to the owning ChannelData are simply passed through to the
+/// uncached computation.
+///
+///   Available through Processor::fromEngineSetup( engineSetup ).features()
+/// for the channel currently being processed.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class SpectralFeatures
+{
+public:
+    SpectralFeatures();
+
+    /// Stores the real cepstrum of the natural logarithm of the given
+    /// amplitudes (fftSize values, ready for liftering and a forward FFT) at
+    /// the beginning of the workBuffer (which must hold at least two aligned
+    /// numberOfBins sized halves).
+    LE_NOTHROW void  LE_FASTCALL cepstrum( ReadOnlyDataRange const & fullAmplitudes, DataRange const & workBuffer, Setup const & );
+    /// The uncached cepstrum() computation.
+    static LE_NOTHROW void LE_FASTCALL computeCepstrum( ReadOnlyDataRange const & fullAmplitudes, DataRange const & workBuffer, Math::FFT_float_real_1D const & );
+
+    /// Spectral centroid, in bins.
+    LE_NOTHROW float LE_FASTCALL centroid( ReadOnlyDataRange const & fullAmplitudes );
+
+    /// Only the (detector state and bounds independent) PitchDetector::analyse()
+    /// part is cached, PitchDetector::estimate() is always done with the
+    /// caller's state and bounds, so that modules tracking the same signal
+    /// share the detection while the results remain identical to those of
+    /// PitchDetector::findPitch().
+    LE_NOTHROW float LE_FASTCALL pitch( ReadOnlyDataRange const & fullAmplitudes, PitchDetector::ChannelState &, float lfb, float hfb, Setup const & );
+
+    /// Has to be called by modules that (contrary to convention) write to the
+    /// side channel.
+    void sideChannelModified() { ++sideGeneration_; }
+
+    /// Cache effectiveness (since construction), for measurements.
+    struct Statistics
+    {
+        struct Counters
+        {
+            std::uint32_t requests;
+            std::uint32_t hits    ;
+        }; // struct Counters
+
+        Counters cepstrum;
+        Counters centroid;
+        Counters pitch   ;
+    }; // struct Statistics
+
+    Statistics const & statistics() const { return statistics_; }
+
+private: friend class ChannelData;
+    void invalidate() { ++hop_; sideGeneration_ = 0; }
+
+    using Cepstrum = SharedStorageFFTBasedBuffer<real_t>;
+
+    static std::uint32_t requiredStorage( StorageFactors const & );
+
+    void resize( StorageFactors const &, Storage & );
+
+private:
+    struct Version
+    {
+        bool operator==( Version const & other ) const { return ( hop == other.hop ) && ( generation == other.generation ); }
+
+        std::uint32_t hop       ;
+        std::uint32_t generation;
+    }; // struct Version
+
+    struct Features
+    {
+        Version cepstrum;
+
+        Version centroid     ;
+        float   centroidValue;
+
+        Version                   pitch          ;
+        PitchDetector::Candidates pitchCandidates;
+
+        Cepstrum cepstrumValue;
+    }; // struct Features
+
+    LE_NOTHROW Features * LE_FASTCALL lookup( ReadOnlyDataRange const & fullAmplitudes, Version & );
+
+private:
+    std::array<Features, 2> channels_; // main and side
+
+    std::uint32_t hop_           ;
+    std::uint32_t sideGeneration_;
+
+    Statistics statistics_;
+}; // class SpectralFeatures
+
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_END( Engine )
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // spectralFeatures_hpp
@@ -0,0 +1,447 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file staticChain.hpp
+/// ---------------------
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef staticChain_hpp__763EF220_7268_49AF_966D_7530C2AC6837
+#define staticChain_hpp__763EF220_7268_49AF_966D_7530C2AC6837
+#pragma once
+//------------------------------------------------------------------------------
+#include "buffers.hpp"
+#include "channelData.hpp"
+#include "effectTraits.hpp"
+#include "setup.hpp"
+
+#include "le/math/conversion.hpp"
+#include "le/math/math.hpp"
+#include "le/parameters/trigger/tag.hpp"
+#include "le/spectrumworx/effects/baseParameters.hpp"
+#include "le/spectrumworx/effects/indexRange.hpp"
+#include "le/utility/buffers.hpp"
+#include "le/utility/platformSpecifics.hpp"
+
+#include <boost/mpl/if.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility> // std::(make_)index_sequence
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+namespace Engine
+{
+//------------------------------------------------------------------------------
+
+namespace Detail ///< \internal
+{
+    ////////////////////////////////////////////////////////////////////////////
+    // StaticChain compile-time helpers
+    ////////////////////////////////////////////////////////////////////////////
+
+    template <typename T, T... values> struct Maximum;
+    template <typename T, T value>
+    struct Maximum<T, value> : std::integral_constant<T, value> {};
+    template <typename T, T first, T second, T... rest>
+    struct Maximum<T, first, second, rest...> : Maximum<T, ( first > second ) ? first : second, rest...> {};
+
+    /// Whether an effect has trigger parameters (the one-shot state its setup()
+    /// derives from them has to be released by one more setup, see
+    /// ModuleDSP::preProcess()).
+    template <class Parameters, class Indices> struct HasTriggerParameters;
+    template <class Parameters, std::size_t... index>
+    struct HasTriggerParameters<Parameters, std::index_sequence<index...>>
+        : Maximum<bool, false, std::is_same<typename Parameters:: template ParameterAt<index>::type::Tag, LE::Parameters::TriggerParameterTag>::value...> {};
+
+    template <class Effect>
+    struct EffectHasTriggers : HasTriggerParameters<typename Effect::Parameters, std::make_index_sequence<Effect::Parameters::static_size>> {};
+
+    /// The domain an effect's data is read in (Input) and left fresh in
+    /// (Output).
+    enum Domain : std::uint8_t { AmPhDomain, ReImDomain };
+
+    template <class Data> struct DataDomains;
+    template <> struct DataDomains<ChannelData_AmPh        > { static Domain const input = AmPhDomain; static Domain const output = AmPhDomain; };
+    template <> struct DataDomains<ChannelData_ReIm        > { static Domain const input = ReImDomain; static Domain const output = ReImDomain; };
+    template <> struct DataDomains<MainSideChannelData_AmPh> { static Domain const input = AmPhDomain; static Domain const output = AmPhDomain; };
+    template <> struct DataDomains<MainSideChannelData_ReIm> { static Domain const input = ReImDomain; static Domain const output = ReImDomain; };
+    template <> struct DataDomains<ChannelData_AmPh2ReIm   > { static Domain const input = AmPhDomain; static Domain const output = ReImDomain; };
+    template <> struct DataDomains<ChannelData_ReIm2AmPh   > { static Domain const input = ReImDomain; static Domain const output = AmPhDomain; };
+
+    /// Number of domain conversions a hop of a chain of effects taking the
+    /// given data types requires (the analysis leaves ReIm data and the
+    /// synthesis requires it).
+    template <Domain fresh, class ... Data>
+    struct DomainConversions : std::integral_constant<std::uint8_t, fresh != ReImDomain> {};
+    template <Domain fresh, class FirstData, class ... Data>
+    struct DomainConversions<fresh, FirstData, Data...>
+        : std::integral_constant
+        <
+            std::uint8_t,
+            ( DataDomains<FirstData>::input != fresh ) + DomainConversions<DataDomains<FirstData>::output, Data...>::value
+        > {};
+
+    /// Static counterparts of the ModuleDSP::ChannelDataProxy conversions.
+    template <class Data> Data channelData( ChannelData &, Effects::IndexRange const &, bool saveForBlending );
+
+    template <> inline MainSideChannelData_AmPh channelData<MainSideChannelData_AmPh>( ChannelData & data, Effects::IndexRange const & range, bool const blend ) { return MainSideChannelData_AmPh( data.freshAmPhData( blend )       , range ); }
+    template <> inline MainSideChannelData_ReIm channelData<MainSideChannelData_ReIm>( ChannelData & data, Effects::IndexRange const & range, bool const blend ) { return MainSideChannelData_ReIm( data.freshReImData( blend )       , range ); }
+    template <> inline ChannelData_AmPh         channelData<ChannelData_AmPh        >( ChannelData & data, Effects::IndexRange const & range, bool const blend ) { return ChannelData_AmPh        ( data.freshAmPhData( blend ).main(), range ); }
+    template <> inline ChannelData_ReIm         channelData<ChannelData_ReIm        >( ChannelData & data, Effects::IndexRange const & range, bool const blend ) { return ChannelData_ReIm        ( data.freshReImData( blend ).main(), range ); }
+
+    template <> inline
+    ChannelData_AmPh2ReIm channelData<ChannelData_AmPh2ReIm>( ChannelData & data, Effects::IndexRange const & range, bool const blend )
+    {
+        ChannelData::AmPhReImData const bothDomainData( data.freshAmPh2ReImData( blend ) );
+        ChannelData_AmPh2ReIm const result =
+        {
+            MainSideChannelData_AmPh( bothDomainData.first        , range ),
+                    ChannelData_ReIm( bothDomainData.second.main(), range )
+        };
+        return result;
+    }
+
+    template <> inline
+    ChannelData_ReIm2AmPh channelData<ChannelData_ReIm2AmPh>( ChannelData & data, Effects::IndexRange const & range, bool const blend )
+    {
+        ChannelData::AmPhReImData const bothDomainData( data.freshReIm2AmPhData( blend ) );
+        ChannelData_ReIm2AmPh const result =
+        {
+            MainSideChannelData_ReIm( bothDomainData.second, range ),
+            MainSideChannelData_AmPh( bothDomainData.first , range )
+        };
+        return result;
+    }
+} // namespace Detail
+
+//------------------------------------------------------------------------------
+} // namespace Engine
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_BEGIN( Engine )
+//------------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class FixedChain
+///
+/// \brief Interface through which the Processor drives an effect chain fixed
+/// at compile time (see StaticChain and Processor::setFixedChain()) instead of
+/// its (dynamic) module chain.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class LE_NOVTABLE FixedChain
+{
+public:
+    /// Sets the effects up (if their parameters or the engine setup changed
+    /// since the last setup) and returns what they require from the hop's
+    /// channel data.
+    virtual LE_NOTHROW HopRequirements LE_FASTCALL preProcess( Setup const & ) = 0;
+
+    virtual LE_NOTHROW void LE_FASTCALL process( std::uint8_t channel, ChannelData &, Setup const & ) const = 0;
+
+    virtual LE_NOTHROW void LE_FASTCALL reset (                        ) = 0;
+    virtual LE_NOTHROW bool LE_FASTCALL resize( StorageFactors const & ) = 0;
+
+    /// The largest scratch storage requirement of the chain's effects (see
+    /// ScratchArena).
+    virtual LE_NOTHROW std::uint32_t LE_FASTCALL scratchStorage( StorageFactors const & ) const = 0;
+
+protected:
+    ~FixedChain() {}
+}; // class FixedChain
+
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class StaticChain
+///
+/// \brief An effect chain fixed at compile time.
+///
+///   Intended for SDK and middleware builds where the chain is known at design
+/// time, e.g.:
+/// <CODE>Engine::StaticChain<Effects::PitchShifterImpl, Effects::FreqverbImpl, Effects::GainImpl></CODE>.
+/// The effects (their implementation classes) are held by value and called
+/// directly (no virtual call, channel data proxy or channel state holder
+/// dispatch per effect): the data type each effect processes, and with it the
+/// domain conversions between them, are resolved at compile time (see
+/// domainConversions). The whole chain costs the Processor a single virtual
+/// call per hop (see FixedChain).
+///
+///   Each effect gets the base Gain, Wet and Start/StopFrequency parameters
+/// (baseParameters()) with the same semantics as in a module. Bypass is
+/// ignored and there are no LFOs or parameter events. Effects that lend their
+/// frames to the engine (see Processor::lendFrame(), e.g. ReverserImpl) are
+/// supported, the chain (owning them) has to outlive its use as with
+/// Processor::setFixedChain().
+///
+/// \note Parameters are changed through the non-const accessors (effect() and
+/// baseParameters()), which mark the chain for a new setup, and only with the
+/// process lock held.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+template <class ... Effects>
+class StaticChain LE_SEALED : public FixedChain
+{
+private:
+    using BaseParameters = SW::Effects::BaseParameters::Parameters;
+
+    template <class Effect>
+    struct Element
+    {
+        using ChannelStates =
+            typename boost::mpl::if_
+            <
+                Detail::has_ChannelState<Effect>,
+                Detail::MakeChannelStateHolder,
+                Detail::MakeEmptyChannelStateHolder
+            >::type:: template ChannelStates<Effect>;
+
+        using Data = typename Detail::EffectData<Effect>::type;
+
+        Effect                      effect        ;
+        ChannelStates               channelStates ;
+        BaseParameters              baseParameters;
+        SW::Effects::IndexRange     workingRange  ;
+    }; // struct Element
+
+    using Elements = std::tuple<Element<Effects>...>;
+
+    // Multi-resolution mode: the setup results of each resolution layer (see
+    // the related note for ModuleDSP::preProcess()).
+    template <class Effect>
+    struct LayerSetup
+    {
+        Effect                  effect      ;
+        SW::Effects::IndexRange workingRange;
+    }; // struct LayerSetup
+
+    using LayerSetups = std::tuple<LayerSetup<Effects>...>;
+
+    struct LayerGenerations
+    {
+        std::uint32_t parameters      ;
+        std::uint32_t engine          ;
+        bool          triggersConsumed;
+    }; // struct LayerGenerations
+    using Indices  = std::make_index_sequence<sizeof...( Effects )>;
+
+public:
+    static std::uint8_t const length = sizeof...( Effects );
+
+    template <std::uint8_t index>
+    using EffectAt = typename std::tuple_element<index, std::tuple<Effects...>>::type;
+
+    /// The chain has to be set up once more after a change (see
+    /// Detail::EffectHasTriggers).
+    static bool const hasTriggers = Detail::Maximum<bool, false, Detail::EffectHasTriggers<Effects>::value...>::value;
+
+    /// Domain conversions a hop requires (with all the effects fully wet).
+    static std::uint8_t const domainConversions = Detail::DomainConversions<Detail::ReImDomain, typename Element<Effects>::Data...>::value;
+
+    static HopRequirements hopRequirements( Setup const & engineSetup )
+    {
+        HopRequirements const requirements =
+        {
+            Detail::Maximum<SideChannelDemand, Detail::EffectSideChannelDemand<Effects>::value...>::value,
+            effectiveConversionAccuracy
+            (
+                Detail::Maximum<Math::ConversionAccuracy, Detail::EffectConversionAccuracy<Effects>::value...>::value,
+                engineSetup.reducedQuality()
+            )
+        };
+        return requirements;
+    }
+
+public:
+    StaticChain()
+        :
+        parametersGeneration_( 0 )
+    {
+        for ( auto & generations : setupGenerations_ )
+        {
+            generations.parameters       = 0;
+            generations.engine           = 0;
+            generations.triggersConsumed = true;
+        }
+    }
+
+    template <std::uint8_t index> EffectAt<index>       & effect()       { ++parametersGeneration_; return std::get<index>( elements_ ).effect; }
+    template <std::uint8_t index> EffectAt<index> const & effect() const {                          return std::get<index>( elements_ ).effect; }
+
+    template <std::uint8_t index> BaseParameters       & baseParameters()       { ++parametersGeneration_; return std::get<index>( elements_ ).baseParameters; }
+    template <std::uint8_t index> BaseParameters const & baseParameters() const {                          return std::get<index>( elements_ ).baseParameters; }
+
+public: // FixedChain interface.
+    LE_NOTHROW
+    HopRequirements LE_FASTCALL preProcess( Setup const & engineSetup ) LE_OVERRIDE
+    {
+        auto const         layer      ( engineSetup.resolutionLayer()      );
+        bool const         layered    ( engineSetup.resolutionLayers() > 1 );
+        LayerGenerations & generations( setupGenerations_[ layer ]         );
+        bool const changed
+        (
+            ( generations.parameters != parametersGeneration_    ) ||
+            ( generations.engine     != engineSetup.generation() )
+        );
+        // See the related note for ModuleDSP::preProcess().
+        if ( changed || generations.triggersConsumed )
+        {
+            generations.triggersConsumed = changed && hasTriggers;
+            generations.parameters       = parametersGeneration_;
+            generations.engine           = engineSetup.generation();
+            setup( engineSetup, Indices() );
+            if ( layered )
+                saveLayerSetup( layerSetups_[ layer ], Indices() );
+        }
+        else
+        if ( layered )
+            restoreLayerSetup( layerSetups_[ layer ], Indices() );
+        return hopRequirements( engineSetup );
+    }
+
+    LE_NOTHROW LE_HOT
+    void LE_FASTCALL process( std::uint8_t const channel, ChannelData & data, Setup const & engineSetup ) const LE_OVERRIDE
+    {
+        process( channel, data, engineSetup, Indices() );
+    }
+
+    LE_NOTHROW LE_COLD
+    void LE_FASTCALL reset() LE_OVERRIDE { reset( Indices() ); }
+
+    LE_NOTHROW LE_COLD
+    bool LE_FASTCALL resize( StorageFactors const & factors ) LE_OVERRIDE
+    {
+        if ( !storage_.resize( requiredStorage( factors, Indices() ) ) )
+            return false;
+        Storage storage( storage_.begin(), storage_.end() );
+        resize( factors, storage, Indices() );
+        reset();
+        return true;
+    }
+
+    LE_NOTHROW LE_COLD
+    std::uint32_t LE_FASTCALL scratchStorage( StorageFactors const & factors ) const LE_OVERRIDE
+    {
+        std::uint32_t const sizes[] = { 0, Detail::effectScratchStorage<Effects>( factors )... };
+        return *std::max_element( std::begin( sizes ), std::end( sizes ) );
+    }
+
+private:
+    template <class Effect>
+    static LE_FORCEINLINE
+    void setup( Element<Effect> & element, Setup const & engineSetup )
+    {
+        using namespace SW::Effects::BaseParameters;
+        float const  leftFrequency( element.baseParameters.template get<StartFrequency>() );
+        float const rightFrequency( element.baseParameters.template get<StopFrequency >() );
+        element.workingRange.setNewRange
+        (
+            engineSetup.normalisedFrequencyToBin( std::min( leftFrequency, rightFrequency ) ),
+            engineSetup.normalisedFrequencyToBin(                          rightFrequency   )
+        );
+        element.effect.setup( element.workingRange, engineSetup );
+    }
+
+    template <class Effect>
+    static LE_FORCEINLINE
+    void process( Element<Effect> const & element, std::uint8_t const channel, ChannelData & data, Setup const & engineSetup )
+    {
+        using namespace SW::Effects::BaseParameters;
+        using Data = typename Element<Effect>::Data;
+
+        float const & wet ( element.baseParameters.template get<Wet >() );
+        float const & gain( element.baseParameters.template get<Gain>() );
+
+        bool const blend  ( !Math::is<100>( wet  ) );
+        bool const amplify( !Math::isZero ( gain ) );
+
+        element.channelStates.callProcess( element.effect, channel, Detail::channelData<Data>( data, element.workingRange, blend ), engineSetup );
+        if ( Detail::EffectModifiesData<Effect>::value ) { data.mainDataModified(); }
+
+        if ( blend   ) { data.blendWithPreviousData( wet / 100, std::is_same<Data, ChannelData_AmPh2ReIm>::value ); }
+        if ( amplify ) { data.amplifyCurrentData   ( Math::dB2NormalisedLinear( gain )                             ); }
+    }
+
+    template <class Element>
+    static std::uint32_t elementStorage( StorageFactors const & factors )
+    {
+        // Same layout as ModuleDSP::allocateStorage():
+        using Utility::align;
+        using ChannelStates = typename Element::ChannelStates;
+        auto const numberOfChannels( factors.numberOfLayerChannels() );
+        return
+            align( numberOfChannels * ChannelStates::sizeOfChannelState ) +
+            numberOfChannels * align( ChannelStates::channelStateRequiredStorage( factors ) );
+    }
+
+    template <std::size_t... index> void setup  ( Setup const & engineSetup, std::index_sequence<index...> ) { using expander = int[]; (void)expander{ 0, ( setup( std::get<index>( elements_ ), engineSetup ), 0 )... }; }
+    template <std::size_t... index> void reset  (                            std::index_sequence<index...> ) { using expander = int[]; (void)expander{ 0, ( std::get<index>( elements_ ).channelStates.callReset(), 0 )... }; }
+
+    template <class Effect> static void saveLayerSetup   ( Element<Effect> const & element, LayerSetup<Effect>       & layerSetup ) { layerSetup.effect = element.effect; layerSetup.workingRange = element.workingRange; }
+    template <class Effect> static void restoreLayerSetup( Element<Effect>       & element, LayerSetup<Effect> const & layerSetup ) { element.effect = layerSetup.effect; element.workingRange = layerSetup.workingRange; }
+
+    template <std::size_t... index> void saveLayerSetup   ( LayerSetups       & layerSetups, std::index_sequence<index...> ) { using expander = int[]; (void)expander{ 0, ( saveLayerSetup   ( std::get<index>( elements_ ), std::get<index>( layerSetups ) ), 0 )... }; }
+    template <std::size_t... index> void restoreLayerSetup( LayerSetups const & layerSetups, std::index_sequence<index...> ) { using expander = int[]; (void)expander{ 0, ( restoreLayerSetup( std::get<index>( elements_ ), std::get<index>( layerSetups ) ), 0 )... }; }
+
+    template <std::size_t... index>
+    void process( std::uint8_t const channel, ChannelData & data, Setup const & engineSetup, std::index_sequence<index...> ) const
+    {
+        using expander = int[]; (void)expander{ 0, ( process( std::get<index>( elements_ ), channel, data, engineSetup ), 0 )... };
+    }
+
+    template <std::size_t... index>
+    static std::uint32_t requiredStorage( StorageFactors const & factors, std::index_sequence<index...> )
+    {
+        std::uint32_t const sizes[] = { 0, elementStorage<typename std::tuple_element<index, Elements>::type>( factors )... };
+        std::uint32_t total( 0 );
+        for ( auto const size : sizes )
+            total += size;
+        return total;
+    }
+
+    template <std::size_t... index>
+    void resize( StorageFactors const & factors, Storage & storage, std::index_sequence<index...> )
+    {
+        using expander = int[];
+        (void)expander
+        {
+            0,
+            (
+                std::get<index>( elements_ ).channelStates.resize( Storage( storage.begin(), storage.begin() + elementStorage<typename std::tuple_element<index, Elements>::type>( factors ) ), factors ),
+                storage.advance_begin( elementStorage<typename std::tuple_element<index, Elements>::type>( factors ) ),
+                0
+            )...
+        };
+        BOOST_ASSERT( storage.empty() );
+    }
+
+private:
+    Elements          elements_;
+
+    std::uint32_t     parametersGeneration_;
+    LayerGenerations  setupGenerations_[ Constants::maximumResolutionLayers ];
+    LayerSetups       layerSetups_     [ Constants::maximumResolutionLayers ];
+
+    HeapSharedStorage storage_; // of the channel states
+}; // class StaticChain
+
+//------------------------------------------------------------------------------
+LE_IMPL_NAMESPACE_END( Engine )
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // staticChain_hpp
@@ -0,0 +1,343 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// binaryTrace.cpp
+/// ---------------
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#include "binaryTrace.hpp"
+
+#include "conditionVariable.hpp"
+#include "countof.hpp"
+
+#include "boost/assert.hpp"
+#include "boost/lockfree/spsc_queue.hpp"
+
+#ifdef _WIN32
+    #include "windowsLite.hpp"
+#else
+    #include "pthread.h"
+#endif // _WIN32
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace Utility
+{
+//------------------------------------------------------------------------------
+
+std::atomic<BinaryTracer::CategoryMask> BinaryTracer::enabledCategories_( BinaryTracer::allCategories );
+
+namespace
+{
+    std::uint16_t const pollMilliseconds = 50;
+
+    // A fixed pool of rings (claimed by threads on their first record()) so
+    // that producers never allocate.
+    std::uint8_t  const numberOfRings = 8  ;
+    std::uint16_t const ringCapacity  = 256;
+
+    struct Slot
+    {
+        using Ring = boost::lockfree::spsc_queue<BinaryTracer::Record, boost::lockfree::capacity<ringCapacity>>;
+
+        std::atomic<bool> claimed;
+        Ring              ring   ;
+    }; // struct Slot
+
+    struct Pipeline
+    {
+        Slot slots[ numberOfRings ];
+
+        std::atomic<std::uint32_t> overflows[ BinaryTracer::NumberOfCategories ];
+
+        ConditionVariable       wakeUp;
+        ConditionVariable::Lock lock  ;
+
+        std::atomic<bool> running;
+        std::atomic<bool> stop   ;
+
+        std::FILE * pFile;
+        std::chrono::steady_clock::time_point startTime;
+
+    #ifdef _WIN32
+        ::HANDLE    thread;
+    #else
+        ::pthread_t thread;
+    #endif // _WIN32
+    }; // struct Pipeline
+
+    Pipeline pipeline;
+
+    char const * const categoryNames[] = { "General", "Host", "Engine", "Numerics", "AudioIO" };
+    static_assert( _countof( categoryNames ) == BinaryTracer::NumberOfCategories, "Category name missing." );
+
+    /// Releases the calling thread's ring when the thread exits.
+    struct ThreadRing
+    {
+        LE_NOTHROW
+        ~ThreadRing()
+        {
+            if ( pSlot )
+                pSlot->claimed.store( false, std::memory_order_release );
+        }
+
+        LE_NOTHROWNOALIAS
+        Slot * get()
+        {
+            if ( BOOST_LIKELY( pSlot != nullptr ) )
+                return pSlot;
+            for ( auto & slot : pipeline.slots )
+            {
+                bool expected( false );
+                if ( slot.claimed.compare_exchange_strong( expected, true, std::memory_order_acquire, std::memory_order_relaxed ) )
+                    return pSlot = &slot;
+            }
+            return nullptr;
+        }
+
+        Slot * pSlot;
+    }; // struct ThreadRing
+
+    thread_local ThreadRing threadRing = { nullptr };
+
+    LE_NOTHROW
+    void format( BinaryTracer::Record const & record, std::FILE & file )
+    {
+        char message[ 512 ];
+        char       *       pOut    ( message                    );
+        char const * const pOutEnd ( message + sizeof( message ) - 1 );
+        std::uint8_t       argument( 0 );
+
+        char const * pIn( record.pFormatString );
+        while ( *pIn && pOut < pOutEnd )
+        {
+            if ( *pIn != '%' )
+            {
+                *pOut++ = *pIn++;
+                continue;
+            }
+            if ( pIn[ 1 ] == '%' )
+            {
+                *pOut++ = '%';
+                pIn += 2;
+                continue;
+            }
+
+            // Rebuild the conversion specification with the length modifier
+            // matching the stored argument (so that every argument can be
+            // passed as stored).
+            char specification[ 32 ];
+            char * pSpecification( specification );
+            char const * const pSpecificationStart( pIn );
+            *pSpecification++ = *pIn++;
+            while ( *pIn && std::strchr( "-+ #0123456789.", *pIn ) && pSpecification < &specification[ sizeof( specification ) - 4 ] )
+                *pSpecification++ = *pIn++;
+            while ( *pIn && std::strchr( "hljztL", *pIn ) )
+                ++pIn;
+            char const conversion( *pIn );
+            if ( !conversion || argument == record.numberOfArguments )
+            {
+                // Malformed or missing argument: output verbatim.
+                pIn = pSpecificationStart;
+                *pOut++ = *pIn++;
+                continue;
+            }
+            ++pIn;
+
+            auto const & value( record.arguments[ argument++ ] );
+            auto const available( static_cast<std::size_t>( pOutEnd - pOut ) + 1 );
+            int written( 0 );
+            if ( std::strchr( "diouxX", conversion ) )
+            {
+                *pSpecification++ = 'l';
+                *pSpecification++ = 'l';
+                *pSpecification++ = conversion;
+                *pSpecification   = '\0';
+                written = std::snprintf( pOut, available, specification, static_cast<long long>( value.integer ) );
+            }
+            else
+            if ( std::strchr( "fFeEgGaA", conversion ) )
+            {
+                *pSpecification++ = conversion;
+                *pSpecification   = '\0';
+                written = std::snprintf( pOut, available, specification, value.real );
+            }
+            else
+            if ( conversion == 'c' )
+            {
+                *pSpecification++ = conversion;
+                *pSpecification   = '\0';
+                written = std::snprintf( pOut, available, specification, static_cast<int>( value.integer ) );
+            }
+            else
+            if ( conversion == 's' )
+            {
+                *pSpecification++ = conversion;
+                *pSpecification   = '\0';
+                written = std::snprintf( pOut, available, specification, static_cast<char const *>( value.pointer ) );
+            }
+            else
+            if ( conversion == 'p' )
+            {
+                *pSpecification++ = conversion;
+                *pSpecification   = '\0';
+                written = std::snprintf( pOut, available, specification, value.pointer );
+            }
+            else
+            {
+                pIn = pSpecificationStart;
+                *pOut++ = *pIn++;
+                --argument;
+                continue;
+            }
+            if ( written > 0 )
+                pOut += std::min<std::size_t>( written, available - 1 );
+        }
+        *pOut = '\0';
+
+        auto const seconds( std::chrono::duration<double>( std::chrono::nanoseconds( record.timestamp ) - pipeline.startTime.time_since_epoch() ).count() );
+        std::fprintf( &file, "%12.6f %-8s %s\n", seconds, categoryNames[ record.category ], message );
+    }
+
+    LE_NOTHROW
+    void drain( std::uint32_t (&reportedOverflows)[ BinaryTracer::NumberOfCategories ] )
+    {
+        auto & file( *pipeline.pFile );
+        BinaryTracer::Record record;
+        for ( auto & slot : pipeline.slots )
+        {
+            while ( slot.ring.pop( record ) )
+                format( record, file );
+        }
+        for ( std::uint8_t category( 0 ); category < BinaryTracer::NumberOfCategories; ++category )
+        {
+            auto const overflows( pipeline.overflows[ category ].load( std::memory_order_relaxed ) );
+            if ( overflows != reportedOverflows[ category ] )
+            {
+                std::fprintf( &file, "%12s %-8s %u record(s) dropped\n", "", categoryNames[ category ], overflows - reportedOverflows[ category ] );
+                reportedOverflows[ category ] = overflows;
+            }
+        }
+        std::fflush( &file );
+    }
+
+    LE_NOTHROW
+    void worker()
+    {
+        std::uint32_t reportedOverflows[ BinaryTracer::NumberOfCategories ];
+        for ( std::uint8_t category( 0 ); category < BinaryTracer::NumberOfCategories; ++category )
+            reportedOverflows[ category ] = pipeline.overflows[ category ].load( std::memory_order_relaxed );
+
+        for ( ; ; )
+        {
+            bool const stopping( pipeline.stop.load( std::memory_order_acquire ) );
+            drain( reportedOverflows );
+            if ( stopping )
+                break;
+
+            using Lock = std::lock_guard<ConditionVariable::Lock>;
+            Lock const lock( pipeline.lock );
+            if ( !pipeline.stop.load( std::memory_order_relaxed ) )
+                pipeline.wakeUp.wait( pipeline.lock, pollMilliseconds );
+        }
+    }
+} // anonymous namespace
+
+
+LE_COLD LE_NOTHROW
+bool LE_FASTCALL BinaryTracer::start( char const * const logFilePath )
+{
+    if ( pipeline.running.load( std::memory_order_relaxed ) )
+        return false;
+
+    pipeline.pFile = std::fopen( logFilePath, "a" );
+    if ( !pipeline.pFile )
+        return false;
+
+    // Discard whatever was left in the rings by producers that raced with a
+    // previous stop().
+    Record record;
+    for ( auto & slot : pipeline.slots )
+        while ( slot.ring.pop( record ) ) {}
+
+    pipeline.startTime = std::chrono::steady_clock::now();
+    pipeline.stop   .store( false, std::memory_order_relaxed );
+    pipeline.running.store( true , std::memory_order_release );
+#ifdef _WIN32
+    pipeline.thread = ::CreateThread
+    (
+        nullptr, 0,
+        []( void * ) -> DWORD { worker(); return 0; },
+        nullptr, 0, nullptr
+    );
+    bool const started( pipeline.thread != nullptr );
+#else
+    bool const started( ::pthread_create( &pipeline.thread, nullptr, []( void * ) -> void * { worker(); return nullptr; }, nullptr ) == 0 );
+#endif // _WIN32
+    if ( !started )
+    {
+        pipeline.running.store( false, std::memory_order_relaxed );
+        BOOST_VERIFY( std::fclose( pipeline.pFile ) == 0 );
+        pipeline.pFile = nullptr;
+    }
+    return started;
+}
+
+
+LE_COLD LE_NOTHROW
+void LE_FASTCALL BinaryTracer::stop()
+{
+    if ( !pipeline.running.load( std::memory_order_relaxed ) )
+        return;
+    pipeline.running.store( false, std::memory_order_relaxed );
+    {
+        using Lock = std::lock_guard<ConditionVariable::Lock>;
+        Lock const lock( pipeline.lock );
+        pipeline.stop.store( true, std::memory_order_release );
+        pipeline.wakeUp.signal();
+    }
+#ifdef _WIN32
+    BOOST_VERIFY( ::WaitForSingleObject( pipeline.thread, INFINITE ) == WAIT_OBJECT_0 );
+    BOOST_VERIFY( ::CloseHandle        ( pipeline.thread           )                  );
+    pipeline.thread = nullptr;
+#else
+    BOOST_VERIFY( ::pthread_join( pipeline.thread, nullptr ) == 0 );
+#endif // _WIN32
+    BOOST_VERIFY( std::fclose( pipeline.pFile ) == 0 );
+    pipeline.pFile = nullptr;
+}
+
+
+LE_NOTHROW
+std::uint32_t LE_FASTCALL BinaryTracer::overflows( Category const category )
+{
+    BOOST_ASSERT( category < NumberOfCategories );
+    return pipeline.overflows[ category ].load( std::memory_order_relaxed );
+}
+
+
+LE_NOTHROWNOALIAS
+void LE_FASTCALL BinaryTracer::push( Record & record )
+{
+    if ( !pipeline.running.load( std::memory_order_relaxed ) )
+        return;
+    record.timestamp = static_cast<std::uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count() );
+    auto * const pSlot( threadRing.get() );
+    if ( BOOST_UNLIKELY( !pSlot || !pSlot->ring.push( record ) ) )
+        pipeline.overflows[ record.category ].fetch_add( 1, std::memory_order_relaxed );
+}
+
+//------------------------------------------------------------------------------
+} // namespace Utility
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file binaryTrace.hpp
+/// ---------------------
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef binaryTrace_hpp__5C1F7B0E_8E2D_4F66_A3B9_2D41C7E09A64
+#define binaryTrace_hpp__5C1F7B0E_8E2D_4F66_A3B9_2D41C7E09A64
+#pragma once
+//------------------------------------------------------------------------------
+#include "platformSpecifics.hpp"
+
+#include "boost/config.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace Utility
+{
+//------------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class BinaryTracer
+///
+/// \brief Wait-free tracing for real time (audio) threads.
+///
+///   Unlike Tracer (which formats and emits messages synchronously)
+/// record() only stores a fixed size Record (the format string, the raw
+/// arguments and a timestamp) into a single producer ring buffer owned by the
+/// calling thread. A background thread (see start()) formats the records and
+/// appends them to a log file.
+///
+///   Records are filtered by Category with a runtime enable mask (a disabled
+/// category costs a relaxed load and a branch). Records dropped because the
+/// calling thread's ring was full (or no ring was available) are counted per
+/// category (see overflows()) and the drops are also reported in the log.
+///
+/// \note Format strings (and %s arguments) are stored as pointers so they
+/// must have static storage duration (e.g. string literals). Supported
+/// conversions are the printf integer (with any length modifier), floating
+/// point, character, string and pointer ones (without '*' widths).
+/// \note The first record() on a thread claims a ring for it (released when
+/// the thread exits), every following one is wait-free.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+struct BinaryTracer
+{
+    enum Category : std::uint8_t
+    {
+        General ,
+        Host    , ///< host interop (e.g. parameter automation)
+        Engine  ,
+        Numerics, ///< unexpected values (see LE_MATH_VERIFY_VALUES)
+        AudioIO ,
+
+        NumberOfCategories
+    };
+
+    using CategoryMask = std::uint32_t;
+
+    static CategoryMask BOOST_CONSTEXPR_OR_CONST allCategories = ( 1U << NumberOfCategories ) - 1;
+
+    static std::uint8_t BOOST_CONSTEXPR_OR_CONST maximumArguments = 4;
+
+    union Argument
+    {
+        std::int64_t integer;
+        double       real   ;
+        void const * pointer;
+    };
+
+    struct Record
+    {
+        std::uint64_t timestamp        ; ///< steady clock, in nanoseconds
+        char const *  pFormatString    ;
+        Argument      arguments[ maximumArguments ];
+        Category      category         ;
+        std::uint8_t  numberOfArguments;
+    }; // struct Record
+
+    /// Starts the background thread which appends the recorded messages to the
+    /// given file (records are discarded while it is not running).
+    static LE_NOTHROW bool LE_FASTCALL start( char const * logFilePath );
+    /// Flushes the remaining records and stops the background thread.
+    static LE_NOTHROW void LE_FASTCALL stop ();
+
+    static void         setEnabledCategories( CategoryMask const mask ) { enabledCategories_.store( mask, std::memory_order_relaxed ); }
+    static CategoryMask enabledCategories   (                         ) { return enabledCategories_.load( std::memory_order_relaxed ); }
+
+    static bool enabled( Category const category ) { return ( enabledCategories() & ( 1U << category ) ) != 0; }
+
+    static LE_NOTHROW std::uint32_t LE_FASTCALL overflows( Category );
+
+    template <typename ... Arguments>
+    static LE_NOTHROWNOALIAS void record( Category const category, char const * const pFormatString, Arguments const ... arguments )
+    {
+        static_assert( sizeof...( Arguments ) <= maximumArguments, "Too many trace arguments." );
+        if ( BOOST_LIKELY( !enabled( category ) ) )
+            return;
+        Argument const packedArguments[] = { Argument(), argument( arguments )... };
+        Record record;
+        record.pFormatString     = pFormatString;
+        record.category          = category;
+        record.numberOfArguments = sizeof...( Arguments );
+        for ( std::uint8_t index( 0 ); index < sizeof...( Arguments ); ++index )
+            record.arguments[ index ] = packedArguments[ index + 1 ];
+        push( record );
+    }
+
+private:
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, Argument>::type
+    argument( T            const value   ) { Argument result; result.integer = static_cast<std::int64_t>( value ); return result; }
+    static Argument argument( double       const value   ) { Argument result; result.real    = value            ; return result; }
+    static Argument argument( void const * const pointer ) { Argument result; result.pointer = pointer          ; return result; }
+
+    static LE_NOTHROWNOALIAS void LE_FASTCALL push( Record & );
+
+private:
+    static std::atomic<CategoryMask> enabledCategories_;
+}; // struct BinaryTracer
+
+#ifndef LE_NO_BINARY_TRACE
+
+    #define LE_TRACE_RT(               category, formatString, ... ) LE::Utility::BinaryTracer::record( LE::Utility::BinaryTracer::category, formatString, ##__VA_ARGS__ )
+    #define LE_TRACE_RT_IF( condition, category, formatString, ... ) do { if ( (condition) ) LE_TRACE_RT( category, formatString, ##__VA_ARGS__ ); } while ( false )
+
+#else
+
+    #define LE_TRACE_RT(               category, formatString, ... )
+    #define LE_TRACE_RT_IF( condition, category, formatString, ... ) do {} while ( false )
+
+#endif // LE_NO_BINARY_TRACE
+
+//------------------------------------------------------------------------------
+} // namespace Utility
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // binaryTrace_hpp
@@ -304,6 +304,16 @@ public:
 
     void alias( SharedStorageBuffer const & other ) { static_cast<Range &>( *this ) = static_cast<Range const &>( other ); }
 
+    /// Repositions the buffer (keeping its size) to the given storage.
+    void rebind( T * const pNewBegin ) { static_cast<Range &>( *this ) = Range( pNewBegin, pNewBegin + size() ); }
+
+    /// Exchanges the storage of two equally sized buffers (in O(1)).
+    void swap( SharedStorageBuffer & other )
+    {
+        BOOST_ASSERT_MSG( size() == other.size(), "Buffer size mismatch." );
+        std::swap( static_cast<Range &>( *this ), static_cast<Range &>( other ) );
+    }
+
     operator boost::iterator_range<T const * LE_RESTRICT> const & () const { return reinterpret_cast<boost::iterator_range<T const * LE_RESTRICT> const &>( *this ); }
 
 private:
@@ -1219,6 +1219,15 @@ void SpectrumWorxEditor::updateForEngineSetupChanges()
 }
 
 
+void SpectrumWorxEditor::updateForQualityOfServiceChange()
+{
+    // The overlap factor might have been changed (the engine page shows the
+    // current load shedding level).
+    updateSettings             ();
+    updateForEngineSetupChanges();
+}
+
+
 void SpectrumWorxEditor::updateForNewTimingInfo()
 {
     // This gets called from a non GUI thread.
@@ -1915,7 +1924,7 @@ double SpectrumWorxEditor::LFODisplay::Period::milliseconds() const
 #ifdef LE_SW_FMOD
     return 1000;
 #else
-    float  const basePeriod          ( parent().editor().effect().lfoTimer().basePeriod() );
+    float  const basePeriod          ( parent().editor().effect().lfoTimer().barDuration() );
     double const periodInMilliseconds( this->getValue() * basePeriod * 1000               );
     return periodInMilliseconds;
 #endif // LE_SW_FMOD
@@ -2000,6 +2009,10 @@ SpectrumWorxEditor::Settings::Settings() /// \throws std::bad_alloc Out of memor
     inputMode_       ( enginePage_, xMargin, yMargin + yStep * 3, (GlobalParameters::InputMode        *)( 0 ) ),
     #endif
 #endif // LE_SW_ENGINE_WINDOW_PRESUM
+#if !LE_SW_SEPARATED_DSP_GUI
+    adaptiveQuality_ ( enginePage_, xMargin - 4, yMargin + yStep * 5 + 100, "Adaptive quality (load shedding)" ),
+    multiResolution_ ( enginePage_, xMargin - 4, yMargin + yStep * 5 + 125, "Multi-resolution (band split layers)" ),
+#endif // LE_SW_SEPARATED_DSP_GUI
 
     pRegistrationData_( 0 )
 {
@@ -2017,6 +2030,11 @@ SpectrumWorxEditor::Settings::Settings() /// \throws std::bad_alloc Out of memor
     windowSizeFactor_->setEnabled( false );
 #endif // LE_SW_ENGINE_WINDOW_PRESUM
 
+#if !LE_SW_SEPARATED_DSP_GUI
+    adaptiveQuality_.addListener( this );
+    multiResolution_.addListener( this );
+#endif // LE_SW_SEPARATED_DSP_GUI
+
     updateEnginePage              ();
     updateLoadLastSessionOnStartup();
 
@@ -2198,6 +2216,11 @@ void SpectrumWorxEditor::Settings::updateEnginePage()
     inputMode_->setValue( inputModeValue );
 #endif // LE_SW_ENGINE_INPUT_MODE
     enginePage_.setNewQualityFactor( engineSetup.wolaRippleFactor() );
+#if !LE_SW_SEPARATED_DSP_GUI
+    adaptiveQuality_.setToggleState( editor().effect().qualityOfService().enabled(), juce::dontSendNotification );
+    multiResolution_.setToggleState( editor().effect().currentStorageFactors().resolutionLayers > 1, juce::dontSendNotification );
+#endif // LE_SW_SEPARATED_DSP_GUI
+    enginePage_.repaint();
 }
 
 
@@ -2272,6 +2295,16 @@ void SpectrumWorxEditor::Settings::EnginePage::paint( juce::Graphics & g )
     printEngineDiagnostics( tmp, "Time resolution"     , engineSetup.stepTime() * 1000            , "ms", yMargin + yStep * 5 + 40, g );
     printEngineDiagnostics( tmp, "Latency"             , engineSetup.latencyInMilliseconds()      , "ms", yMargin + yStep * 5 + 60, g );
 
+#if !LE_SW_SEPARATED_DSP_GUI
+    auto const & qualityOfService( settings.editor().effect().qualityOfService() );
+    if ( qualityOfService.enabled() )
+    {
+        tmp  = "Load shedding: ";
+        tmp += QualityOfService::levelName( qualityOfService.targetLevel() );
+        g.drawFittedText( tmp, xMargin + 4, yMargin + yStep * 5 + 80, 142, 12, juce::Justification::centred, 1 );
+    }
+#endif // LE_SW_SEPARATED_DSP_GUI
+
     //...mrmlj...for testing...
     //g.drawSingleLineText( engineQuality_, xMargin - 5, yMargin + yStep * 6 + 12 );
 }
@@ -2493,6 +2526,25 @@ void SpectrumWorxEditor::Settings::buttonClicked( juce::Button * const pButton )
     {
         Theme::settings().hideCursorOnKnobDrag = interfacePage_.hideCursorOnKnobDrag_.getToggleState();
     }
+#if !LE_SW_SEPARATED_DSP_GUI
+    else
+    if ( pButton == &adaptiveQuality_ )
+    {
+        effect.enableQualityOfService( adaptiveQuality_.getToggleState() );
+        enginePage_.repaint();
+    }
+    else
+    if ( pButton == &multiResolution_ )
+    {
+        std::uint8_t const numberOfLayers( multiResolution_.getToggleState() ? Engine::Constants::maximumResolutionLayers : 1 );
+        if ( !effect.setResolutionLayers( numberOfLayers ) )
+        {
+            multiResolution_.setToggleState( !multiResolution_.getToggleState(), juce::dontSendNotification );
+            GUI::warningMessageBox( MB_WARNING, "Out of memory.", false );
+        }
+        enginePage_.repaint();
+    }
+#endif // LE_SW_SEPARATED_DSP_GUI
 #if LE_SW_AUTHORISATION_REQUIRED
     else
     if ( pButton == &registrationPage_.authorize_ )
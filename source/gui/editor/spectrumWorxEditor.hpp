@@ -291,6 +291,8 @@ public:
 
     void updateForEngineSetupChanges();
 
+    void updateForQualityOfServiceChange();
+
     void updateForNewTimingInfo();
     void updateLFO( ModuleUI const &, std::uint8_t parameterIndex, std::uint8_t lfoParameterIndex, /*LFO::AutomatedParameterValue*/float value );
 
@@ -675,6 +677,10 @@ public:
     #if LE_SW_ENGINE_INPUT_MODE >= 1
         DiscreteParameterComboBox inputMode_       ;
     #endif // LE_SW_ENGINE_INPUT_MODE
+    #if !LE_SW_SEPARATED_DSP_GUI
+        LEDTextButton             adaptiveQuality_ ;
+        LEDTextButton             multiResolution_ ;
+    #endif // LE_SW_SEPARATED_DSP_GUI
 
         AuthorisationData const * pRegistrationData_;
 
@@ -504,6 +504,19 @@ void ModuleUI::mouseDrag( juce::MouseEvent const & event )
 void ModuleUI::mouseUp( juce::MouseEvent const & event ) noexcept
 {
     editor().moduleDragEnd( *this, event );
+
+#if !LE_SW_SEPARATED_DSP_GUI
+    // The context menu toggles the module's "optional" flag (optional modules
+    // get bypassed while the quality of service controller sheds load).
+    if ( event.mods.isPopupMenu() && !event.mouseWasDraggedSinceMouseDown() )
+    {
+        bool const optional( module().optional() );
+        PopupMenu menu;
+        menu.addItem( 0, optional ? "Required under heavy load" : "Optional under heavy load (bypassed)" );
+        if ( menu.showCenteredBelow( *this ).is_initialized() )
+            module().setOptional( !optional );
+    }
+#endif // LE_SW_SEPARATED_DSP_GUI
 }
 
 
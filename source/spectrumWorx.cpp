@@ -9,6 +9,7 @@
 //------------------------------------------------------------------------------
 #include "spectrumWorx.hpp"
 
+#include "core/modules/factory.hpp"
 #include "core/modules/moduleDSPAndGUI.hpp"
 #include "gui/gui.hpp"
 
@@ -61,6 +62,19 @@ namespace SW
 {
 //------------------------------------------------------------------------------
 
+namespace
+{
+    void sleepMilliseconds( unsigned int const milliseconds )
+    {
+    #ifdef _WIN32
+        ::Sleep ( milliseconds        );
+    #else
+        ::usleep( milliseconds * 1000 );
+    #endif // _WIN32
+    }
+} // anonymous namespace
+
+
 LE_NOTHROW
 SpectrumWorx::SpectrumWorx( bool const runningAsAU )
     :
@@ -112,6 +126,14 @@ SpectrumWorx::~SpectrumWorx()
     authorizationThread_.kill();
 #endif // LE_SW_AUTHORISATION_REQUIRED
 
+    enableQualityOfService( false );
+
+    // Release the modules here (rather than along with the programs) so that
+    // the memory they leave in the shared module pool can be trimmed.
+    for ( auto & program : programs() )
+        program.moduleChain().clear();
+    ModuleFactory::trimPools();
+
 #ifndef LE_SW_DISABLE_SIDE_CHANNEL
     BOOST_ASSERT( !pListenerToNotifyWhenSampleLoaded_ );
 #endif // LE_SW_DISABLE_SIDE_CHANNEL
@@ -125,47 +147,6 @@ SpectrumWorx::~SpectrumWorx()
 //
 ////////////////////////////////////////////////////////////////////////////////
 
-namespace
-{
-    LE_NOTHROWNOALIAS
-    float const * LE_RESTRICT getChannelDataChunk
-    (
-        Sample::ChannelData const &                   channelData,
-        std::uint32_t             &                   startingPosition,
-        std::uint16_t                                 chunkSize,
-        float                     * LE_RESTRICT const workBuffer
-    )
-    {
-        auto const dataSize( static_cast<std::uint32_t>( channelData.size() ) );
-        BOOST_ASSERT( startingPosition <= dataSize );
-        if ( dataSize > ( startingPosition + chunkSize ) )
-        {
-            float const * const pChunk( &channelData[ startingPosition ] );
-            startingPosition += chunkSize;
-            return pChunk;
-        }
-        else
-        {
-            float * workBufferPosition( workBuffer );
-            while ( chunkSize )
-            {
-                if ( startingPosition == dataSize )
-                    startingPosition = 0;
-                auto const channelDataPosition( &channelData[ startingPosition ] );
-                auto const amountToCopy       ( static_cast<std::uint16_t>( std::min<std::uint32_t>( dataSize - startingPosition, chunkSize ) ) );
-                Math::copy( channelDataPosition, workBufferPosition, amountToCopy );
-                workBufferPosition += amountToCopy;
-                startingPosition   += amountToCopy;
-                chunkSize          -= amountToCopy;
-            }
-            return workBuffer;
-        }
-    }
-} // anonymous namespace
-
-#pragma warning( push )
-#pragma warning( disable : 4701 ) // Potentially uninitialized local variable 'samplePosition' used.
-
 LE_NOTHROWNOALIAS
 void SpectrumWorx::process /// \throws nothing
 (
@@ -200,25 +181,15 @@ void SpectrumWorx::process /// \throws nothing
         /// numberOfExternalAudioChannels (stereo > mono).
         ///                                   (20.03.2013.) (Domagoj Saric)
         BOOST_ASSERT( numberOfExternalAudioChannels <= buffers().numberOfSideChannels() );
-        BOOST_SIMD_STACK_BUFFER( sideChannels, float const *, numberOfExternalAudioChannels );
-        std::uint32_t samplePosition;
+        BOOST_SIMD_STACK_BUFFER( sideChannels, float *, numberOfExternalAudioChannels );
         for ( std::uint8_t channel( 0 ); channel < numberOfExternalAudioChannels; ++channel )
-        {
-            samplePosition = sample_.samplePosition();
-            sideChannels[ channel ] =
-                getChannelDataChunk
-                (
-                    sample_.channel( channel ),
-                    samplePosition,
-                    samples,
-                    buffers().sideChannel( channel ).begin()
-                );
-        }
+            sideChannels[ channel ] = buffers().sideChannel( channel ).begin();
+        // Implementation note:
+        //   Sample::read() takes no locks: it only pops already converted and
+        // resampled data from the stream's ring buffer (filled by the sample
+        // prefetch thread) and outputs silence on an underrun.
+        sample_.read( &sideChannels[ 0 ], numberOfExternalAudioChannels, static_cast<std::uint16_t>( samples ) );
         pSideChannels = &sideChannels[ 0 ];
-        /// \todo Think of a smarter solution.
-        ///                                   (08.02.2010.) (Domagoj Saric)
-        BOOST_ASSERT( samplePosition != sample_.samplePosition() );
-        sample_.samplePosition() = samplePosition;
     }
     else
     if ( engineSetup().hasSideChannel() )
@@ -237,8 +208,6 @@ void SpectrumWorx::process /// \throws nothing
     SpectrumWorxCore::process( inputs, pSideChannels, outputs, outputGainScale_, samples );
 }
 
-#pragma warning( pop )
-
 #if LE_SW_AUTHORISATION_REQUIRED
 ////////////////////////////////////////////////////////////////////////////////
 // Authorization
@@ -319,15 +288,6 @@ bool SpectrumWorx::isCurrentlyCrippled() const
 
 namespace
 {
-    void sleepMilliseconds( unsigned int const milliseconds )
-    {
-    #ifdef _WIN32
-        ::Sleep ( milliseconds        );
-    #else
-        ::usleep( milliseconds * 1000 );
-    #endif // _WIN32
-    }
-
 /*
     // http://stackoverflow.com/questions/11763786/timercallback-function-based-on-standard-template-library-without-boost
 #ifdef _WIN32
@@ -1721,7 +1681,7 @@ bool LE_NOTHROWNOALIAS SpectrumWorx::setNewSampleWorker( juce::File const & newS
 
         if ( bufferAllocationSucceeded )
         {
-            char const * const pErrorMessage( sample_.load( newSampleFile, engineSetup().sampleRate<unsigned int>(), processCriticalSection_ ) );
+            char const * const pErrorMessage( sample_.load( newSampleFile, engineSetup().sampleRate<unsigned int>() ) );
             if ( pErrorMessage )
             {
                 GUI::warningMessageBox( "SpectrumWorx: error loading selected sample file.", pErrorMessage, true );
@@ -1837,6 +1797,77 @@ void SpectrumWorx::sampleLoadingLoop()
 #endif // LE_SW_DISABLE_SIDE_CHANNEL
 
 
+////////////////////////////////////////////////////////////////////////////////
+// Quality of service
+////////////////////////////////////////////////////////////////////////////////
+
+void SpectrumWorx::enableQualityOfService( bool const enable )
+{
+    if ( !enable )
+    {
+        // The poller exits on its own (after reporting the return to full
+        // quality) once it sees the controller disabled.
+        qualityOfService().enable( false );
+        qualityOfServiceThread_.join();
+        return;
+    }
+
+    if ( qualityOfServiceThread_.isRunning() )
+        return;
+    qualityOfService().enable( true );
+    BOOST_VERIFY(( qualityOfServiceThread_.startJoinable<SpectrumWorx, &SpectrumWorx::qualityOfServiceLoop>( *this ) ));
+                   qualityOfServiceThread_.setDebugName( "QoS thread" );
+}
+
+
+LE_NOTHROW
+void SpectrumWorx::qualityOfServiceLoop()
+{
+    // Implementation note:
+    //   The audio thread only publishes the wanted quality level so this
+    // (idle priority) thread polls it, performs the possibly required engine
+    // reallocation and forwards the change to the GUI. The final iteration
+    // (after the controller gets disabled) reports the return to full quality.
+    bool keepRunning;
+    do
+    {
+        keepRunning = qualityOfService().enabled();
+        if ( keepRunning )
+            sleepMilliseconds( 100 );
+        if ( updateQualityOfService() )
+        {
+            GUI::postMessage
+            (
+                *this,
+                []( GUI::SpectrumWorxEditor & gui )
+                {
+                    gui.updateForQualityOfServiceChange();
+                    return true;
+                }
+            );
+        }
+    } while ( keepRunning );
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Multi-resolution mode
+////////////////////////////////////////////////////////////////////////////////
+
+bool SpectrumWorx::setResolutionLayers( std::uint8_t const numberOfLayers )
+{
+    {
+        Utility::CriticalSectionLock const processLock( getProcessingLock() );
+        if ( !SpectrumWorxCore::setResolutionLayers( numberOfLayers ) )
+            return false;
+    }
+    // The deeper layers delay the output (see Engine::Setup::latencyInSamples()).
+    /*BOOST_VERIFY*/( latencyChanged() );
+    updateGUIForEngineSetupChanges();
+    return true;
+}
+
+
 bool LE_NOTHROW SpectrumWorx::updateEngineSetup()
 {
     if ( SpectrumWorxCore::updateEngineSetup() )
@@ -1916,14 +1947,16 @@ namespace
 {
     struct Settings : GUI::Theme::Settings
     {
-        Settings() : loadLastSessionOnStartup( false ) {}
-        Settings( GUI::Theme::Settings const & guiSettings, bool const loadLastSessionOnStartupParam )
+        Settings() : loadLastSessionOnStartup( false ), adaptiveQuality( false ) {}
+        Settings( GUI::Theme::Settings const & guiSettings, bool const loadLastSessionOnStartupParam, bool const adaptiveQualityParam )
             :
             GUI::Theme::Settings    ( guiSettings                   ),
-            loadLastSessionOnStartup( loadLastSessionOnStartupParam )
+            loadLastSessionOnStartup( loadLastSessionOnStartupParam ),
+            adaptiveQuality         ( adaptiveQualityParam          )
         {}
 
         bool loadLastSessionOnStartup;
+        bool adaptiveQuality         ; ///< the quality of service controller enabled
     }; // struct Settings
 } // anoynmous namepsace
 
@@ -1945,6 +1978,7 @@ void LE_NOTHROW SpectrumWorx::loadSettings()
         Settings const & settings( *reinterpret_cast<Settings const *>( mappedSettingsFile.begin() ) );
         GUI::Theme::settings() = settings;
         shouldLoadLastSessionOnStartup( settings.loadLastSessionOnStartup );
+        enableQualityOfService        ( settings.adaptiveQuality          );
         if ( shouldLoadLastSessionOnStartup() )
         {
             juce::File const lastSessionFile( lastSessionPresetFile() );
@@ -1981,7 +2015,7 @@ void LE_NOTHROW SpectrumWorx::saveSettings()
     }
 
     Settings &       onDiskSettings ( *reinterpret_cast<Settings *>( mappedSettingsFile.begin() ) );
-    Settings   const currentSettings( GUI::Theme::settings(), loadLastSessionOnStartup_           );
+    Settings   const currentSettings( GUI::Theme::settings(), loadLastSessionOnStartup_, qualityOfService().enabled() );
     onDiskSettings = currentSettings;
 
 #ifndef LE_SW_FMOD
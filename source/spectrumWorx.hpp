@@ -95,27 +95,50 @@ public:
         thread_ = _beginthread( &callbackWrapper<Runner, callback>, 0, &runner );
         if ( thread_ == invalidHandle )
             return false;
-        BOOST_VERIFY( ::SetThreadPriority( reinterpret_cast<HANDLE>( thread_ ), THREAD_PRIORITY_IDLE ) );
-        return true;
+        setIdlePriority();
     #else
-        if ( ::pthread_create( &thread_, nullptr, &callbackWrapper<Runner, callback>, &runner ) != 0 )
+        if ( !create<Runner, callback>( runner ) )
+            return false;
+        setIdlePriority();
+        BOOST_VERIFY( ::pthread_detach( thread_ ) == 0 );
+    #endif // _WIN32
+        return true;
+    }
+
+    /// Same as start() except that the thread has to be waited for with
+    /// join() (instead of being stopped or killed).
+    template <class Runner, void (Runner::*callback)()>
+    bool startJoinable( Runner & runner )
+    {
+        BOOST_ASSERT_MSG( !isRunning(), "Background thread already running" );
+    #ifdef _WIN32
+        // _beginthread() handles are closed by the exiting thread.
+        thread_ = _beginthreadex( nullptr, 0, &joinableCallbackWrapper<Runner, callback>, &runner, 0, nullptr );
+        if ( !thread_ )
         {
-            BOOST_ASSERT( thread_ == invalidHandle );
+            thread_ = invalidHandle;
             return false;
         }
-        sched_param schedulingParameters;
-        int         schedulingPolicy    ;
-        BOOST_VERIFY( ::pthread_getschedparam( thread_, &schedulingPolicy, &schedulingParameters ) == 0 );
-    #ifdef SCHED_IDLE
-        schedulingPolicy = SCHED_IDLE;
     #else
-        schedulingPolicy = SCHED_OTHER;
-    #endif // SCHED_OTHER
-        schedulingParameters.sched_priority = ::sched_get_priority_min( schedulingPolicy );
-        BOOST_VERIFY( ::pthread_setschedparam( thread_, schedulingPolicy, &schedulingParameters ) == 0 );
-        BOOST_VERIFY( ::pthread_detach       ( thread_                                          ) == 0 );
+        if ( !create<Runner, callback>( runner ) )
+            return false;
+    #endif // _WIN32
+        setIdlePriority();
         return true;
+    }
+
+    /// Waits for a thread started with startJoinable() to exit.
+    void join()
+    {
+        if ( !isRunning() )
+            return;
+    #ifdef _WIN32
+        BOOST_VERIFY( ::WaitForSingleObject( reinterpret_cast<HANDLE>( thread_ ), INFINITE ) == WAIT_OBJECT_0 );
+        BOOST_VERIFY( ::CloseHandle        ( reinterpret_cast<HANDLE>( thread_ )           )                  );
+    #else
+        BOOST_VERIFY( ::pthread_join( thread_, nullptr ) == 0 );
     #endif // _WIN32
+        thread_ = invalidHandle;
     }
 
     void setDebugName( char const * const threadName )
@@ -189,6 +212,37 @@ public:
     void markAsDone() /*...mrmlj...ugh...*/ { thread_ = invalidHandle; }
 
 private:
+#ifndef _WIN32
+    template <class Runner, void (Runner::*callback)()>
+    bool create( Runner & runner )
+    {
+        if ( ::pthread_create( &thread_, nullptr, &callbackWrapper<Runner, callback>, &runner ) != 0 )
+        {
+            BOOST_ASSERT( thread_ == invalidHandle );
+            return false;
+        }
+        return true;
+    }
+#endif // POSIX
+
+    void setIdlePriority()
+    {
+    #ifdef _WIN32
+        BOOST_VERIFY( ::SetThreadPriority( reinterpret_cast<HANDLE>( thread_ ), THREAD_PRIORITY_IDLE ) );
+    #else
+        sched_param schedulingParameters;
+        int         schedulingPolicy    ;
+        BOOST_VERIFY( ::pthread_getschedparam( thread_, &schedulingPolicy, &schedulingParameters ) == 0 );
+    #ifdef SCHED_IDLE
+        schedulingPolicy = SCHED_IDLE;
+    #else
+        schedulingPolicy = SCHED_OTHER;
+    #endif // SCHED_OTHER
+        schedulingParameters.sched_priority = ::sched_get_priority_min( schedulingPolicy );
+        BOOST_VERIFY( ::pthread_setschedparam( thread_, schedulingPolicy, &schedulingParameters ) == 0 );
+    #endif // _WIN32
+    }
+
     template <class Runner, void (Runner::*callback)()>
     static void
     #ifndef _WIN32
@@ -202,6 +256,15 @@ private:
     #endif // _WIN32
     }
 
+#ifdef _WIN32
+    template <class Runner, void (Runner::*callback)()>
+    static unsigned __stdcall joinableCallbackWrapper( void * const pHandler )
+    {
+        (static_cast<Runner *>( pHandler )->*callback)();
+        return 0;
+    }
+#endif // _WIN32
+
 private:
 #ifdef _WIN32
     typedef uintptr_t handle_t;
@@ -305,6 +368,34 @@ public:
 #endif // LE_SW_AUTHORISATION_REQUIRED
 
 
+    ////////////////////////////////////////////////////////////////////////////
+    // Quality of service
+    ////////////////////////////////////////////////////////////////////////////
+
+    public:
+        void enableQualityOfService( bool );
+
+    private:
+        void qualityOfServiceLoop();
+
+    private:
+        BackgroundThread qualityOfServiceThread_;
+
+    /* </Quality of service> */
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Multi-resolution mode
+    ////////////////////////////////////////////////////////////////////////////
+
+    public:
+        /// Changes the number of resolution layers (see
+        /// Engine::ResolutionLayers) and reports the resulting latency change.
+        bool setResolutionLayers( std::uint8_t numberOfLayers );
+
+    /* </Multi-resolution mode> */
+
+
 #ifndef LE_SW_DISABLE_SIDE_CHANNEL
     ////////////////////////////////////////////////////////////////////////////
     // External samples
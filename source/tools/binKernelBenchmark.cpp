@@ -0,0 +1,437 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// binKernelBenchmark.cpp
+/// ----------------------
+///
+///   Compares, for each effect ported to Engine::BinKernels, the per bin cost
+/// of its previous (iterator/pointer indirection based) process() loop with
+/// the current pack kernel one, on the same random main and side spectra with
+/// default parameters. The previous loops are reproduced below (with the
+/// values their setup() calculated passed in) and the maximum difference
+/// between the outputs of the two versions is reported as a sanity check.
+///
+///   Usage: binKernelBenchmark [FFT size] [hops]
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#include "headlessEngine.hpp"
+
+#include "le/spectrumworx/effects/burrito/burritoImpl.hpp"
+#include "le/spectrumworx/effects/denoiser/denoiserImpl.hpp"
+#include "le/spectrumworx/effects/ethereal/etherealImpl.hpp"
+#include "le/spectrumworx/effects/merger/mergerImpl.hpp"
+#include "le/spectrumworx/effects/shapeless/shapelessImpl.hpp"
+#include "le/spectrumworx/effects/vaxateer/vaxateerImpl.hpp"
+#include "le/spectrumworx/engine/channelDataAmPh.hpp"
+#include "le/spectrumworx/engine/setup.hpp"
+#include "le/math/constants.hpp"
+#include "le/math/conversion.hpp"
+#include "le/math/math.hpp"
+#include "le/math/vector.hpp"
+#include "le/utility/buffers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+#include <random>
+//------------------------------------------------------------------------------
+namespace
+{
+    using namespace LE;
+    using namespace LE::SW;
+
+    using Engine::MainSideChannelData_AmPh;
+    using Effects::IndexRange;
+
+    // Carves consecutive (aligned) parts out of a single allocation.
+    Engine::Storage take( Engine::Storage & storage, std::uint32_t const bytes )
+    {
+        Engine::Storage const part( storage.begin(), storage.begin() + bytes );
+        storage.advance_begin( Utility::align( bytes ) );
+        return part;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    // The previous process() loops
+    ////////////////////////////////////////////////////////////////////////////
+
+    namespace Previous
+    {
+        void denoiser( MainSideChannelData_AmPh data, Effects::DenoiserImpl::Mode::value_type const mode, float const factor )
+        {
+            using Mode = Effects::DenoiserImpl::Mode;
+            while ( data )
+            {
+                float       & mainAmp( data.main().amps().front() );
+                float const   sideAmp( data.side().amps().front() );
+                ++data;
+
+                float c;
+                switch ( mode )
+                {
+                    case Mode::Main: c =   mainAmp                   ;                                      break;
+                    case Mode::Side: c =             sideAmp         ; c = std::max( c, mainAmp - factor ); break;
+                    case Mode::Sum : c = ( mainAmp + sideAmp ) / 2.0f;                                      break;
+                    LE_DEFAULT_CASE_UNREACHABLE();
+                }
+
+                float const correctionFactor( mainAmp / ( c + factor ) );
+                mainAmp *= correctionFactor;
+            }
+        }
+
+        void merger( MainSideChannelData_AmPh data, Effects::MergerImpl::Operation::value_type const operation, float const threshold_ )
+        {
+            using Operation = Effects::MergerImpl::Operation;
+
+            Engine::ReadOnlyDataRange const &       mainAmps ( static_cast<Engine::ChannelData_AmPh const &>( data.main() ).amps() );
+            Engine::ReadOnlyDataRange const &       sideAmps (                                                data.side()  .amps() );
+            Engine::ReadOnlyDataRange         const threshold( &threshold_, &threshold_ + 1                                        );
+
+            Engine::ReadOnlyDataRange const * pLargerValue ;
+            Engine::ReadOnlyDataRange const * pSmallerValue;
+            switch ( operation )
+            {
+                case Operation::MainLargerThanSide: pLargerValue = &mainAmps ; pSmallerValue = &sideAmps ; break;
+                case Operation::SideLargerThanMain: pLargerValue = &sideAmps ; pSmallerValue = &mainAmps ; break;
+                case Operation::MainAboveThreshold: pLargerValue = &mainAmps ; pSmallerValue = &threshold; break;
+                case Operation::MainBelowThreshold: pLargerValue = &threshold; pSmallerValue = &mainAmps ; break;
+                case Operation::SideAboveThreshold: pLargerValue = &sideAmps ; pSmallerValue = &threshold; break;
+                case Operation::SideBelowThreshold: pLargerValue = &threshold; pSmallerValue = &sideAmps ; break;
+                LE_DEFAULT_CASE_UNREACHABLE();
+            }
+
+            while ( data )
+            {
+                if ( *pLargerValue->begin() > *pSmallerValue->begin() )
+                {
+                    data.main().amps  ().front() = data.side().amps  ().front();
+                    data.main().phases().front() = data.side().phases().front();
+                }
+                ++data;
+            }
+        }
+
+        void ethereal( MainSideChannelData_AmPh data, bool const replaceWhenWeaker, float const threshold, Effects::UnpackedMagPhaseMode const & mode )
+        {
+            MainSideChannelData_AmPh const & constData( data );
+            Engine::ReadOnlyDataRange const & ampSource  ( mode.magnitudes() ? constData.side().amps  () : constData.main().amps  () );
+            Engine::ReadOnlyDataRange const & phaseSource( mode.phases    () ? constData.side().phases() : constData.main().phases() );
+
+            while ( data )
+            {
+                bool const sideIsWeaker ( data.side().amps().front() < ( data.main().amps().front() * threshold ) );
+                bool const shouldReplace( sideIsWeaker == replaceWhenWeaker                                       );
+
+                if ( shouldReplace )
+                {
+                    data.main().amps  ().front() = ampSource  .front();
+                    data.main().phases().front() = phaseSource.front();
+                }
+
+                ++data;
+            }
+        }
+
+        void vaxateer( MainSideChannelData_AmPh data, Effects::VaxateerImpl::RMSTarget::value_type const rmsTarget, Effects::VaxateerImpl::Mode::value_type const mode, float const rmsGain )
+        {
+            using RMSTarget = Effects::VaxateerImpl::RMSTarget;
+            using Mode      = Effects::VaxateerImpl::Mode;
+
+            float const thr( rmsGain * Math::rms( ( rmsTarget == RMSTarget::MainRMS ) ? data.main().amps() : data.side().amps() ) );
+
+            Engine::ReadOnlyDataRange const &       mainAmps ( static_cast<Engine::ChannelData_AmPh const &>( data.main() ).amps() );
+            Engine::ReadOnlyDataRange const &       sideAmps (                                                data.side()  .amps() );
+            Engine::ReadOnlyDataRange         const threshold( &thr, &thr + 1                                                      );
+
+            Engine::ReadOnlyDataRange const * pThresholdHigher;
+            Engine::ReadOnlyDataRange const * pThresholdLower ;
+            Engine::ReadOnlyDataRange const * pAmpSideHigher  ;
+            Engine::ReadOnlyDataRange const * pAmpSideLower   ;
+            switch ( mode )
+            {
+                case Mode::M1: pThresholdHigher = &mainAmps ; pThresholdLower = &threshold; pAmpSideHigher = &mainAmps; pAmpSideLower = &sideAmps; break;
+                case Mode::M2: pThresholdHigher = &mainAmps ; pThresholdLower = &threshold; pAmpSideHigher = &sideAmps; pAmpSideLower = &mainAmps; break;
+                case Mode::M3: pThresholdHigher = &threshold; pThresholdLower = &mainAmps ; pAmpSideHigher = &mainAmps; pAmpSideLower = &sideAmps; break;
+                case Mode::M4: pThresholdHigher = &threshold; pThresholdLower = &mainAmps ; pAmpSideHigher = &sideAmps; pAmpSideLower = &mainAmps; break;
+                case Mode::M5: pThresholdHigher = &sideAmps ; pThresholdLower = &threshold; pAmpSideHigher = &mainAmps; pAmpSideLower = &sideAmps; break;
+                case Mode::M6: pThresholdHigher = &sideAmps ; pThresholdLower = &threshold; pAmpSideHigher = &sideAmps; pAmpSideLower = &mainAmps; break;
+                case Mode::M7: pThresholdHigher = &threshold; pThresholdLower = &sideAmps ; pAmpSideHigher = &mainAmps; pAmpSideLower = &sideAmps; break;
+                case Mode::M8: pThresholdHigher = &threshold; pThresholdLower = &sideAmps ; pAmpSideHigher = &sideAmps; pAmpSideLower = &mainAmps; break;
+                LE_DEFAULT_CASE_UNREACHABLE();
+            }
+
+            while ( data )
+            {
+                if
+                (
+                    ( *pThresholdHigher->begin() > *pThresholdLower->begin() ) &&
+                    ( *pAmpSideHigher  ->begin() > *pAmpSideLower  ->begin() )
+                )
+                {
+                    data.main().amps().front() = data.side().amps().front();
+                }
+                ++data;
+            }
+        }
+
+        void burrito( MainSideChannelData_AmPh data, Effects::BurritoImpl::Mode::value_type const mode, float const sideGain, bool const * LE_RESTRICT pPosition )
+        {
+            using Mode = Effects::BurritoImpl::Mode;
+            while ( data )
+            {
+                if ( *pPosition++ )
+                {
+                    float       & mainAmp( data.main().amps().front() );
+                    float const   sideAmp( data.side().amps().front() );
+
+                    float newMainAmp( sideAmp * sideGain );
+
+                    switch ( mode )
+                    {
+                        case Mode::Replace: data.main().phases().front() = data.side().phases().front(); break;
+                        case Mode::Sum    : newMainAmp += mainAmp;                                       break;
+                        LE_DEFAULT_CASE_UNREACHABLE();
+                    }
+
+                    mainAmp = newMainAmp;
+                }
+                ++data;
+            }
+        }
+
+        void shapeless( MainSideChannelData_AmPh data, std::uint16_t const width )
+        {
+            if ( !width )
+                return;
+
+            while ( data )
+            {
+                auto const currentWidth( std::min<std::uint16_t>( static_cast<std::uint16_t>( data.size() ), width ) );
+                auto *       LE_RESTRICT pMagnOut     ( data.main().amps().begin() );
+                auto *       LE_RESTRICT pMagnShape   ( data.side().amps().begin() );
+                data.advance_begin( currentWidth );
+                auto * const LE_RESTRICT pMagnOutEnd  ( data.main().amps().begin() );
+                auto * const LE_RESTRICT pMagnShapeEnd( data.side().amps().begin() );
+
+                float const inOut  ( std::accumulate( pMagnOut  , pMagnOutEnd  , std::numeric_limits<float>::epsilon() ) );
+                float const inShape( std::accumulate( pMagnShape, pMagnShapeEnd, std::numeric_limits<float>::epsilon() ) );
+
+                float const amplt( inOut / inShape );
+
+                while ( pMagnOut != pMagnOutEnd )
+                    *pMagnOut++ = amplt * *pMagnShape++;
+            }
+        }
+    } // namespace Previous
+
+
+    ////////////////////////////////////////////////////////////////////////////
+    // Benchmark
+    ////////////////////////////////////////////////////////////////////////////
+
+    class Benchmark
+    {
+    public:
+        Benchmark( Engine::FullMainSideChannelData_AmPh & data, Engine::FullMainSideChannelData_AmPh const & input, std::uint32_t const hops )
+            : data_( data ), input_( input ), hops_( hops ), restoreNanoseconds_( 0 )
+        {
+            restoreNanoseconds_ = time( []( MainSideChannelData_AmPh ) {} );
+        }
+
+        /// Prints the per bin cost of both versions (net of restoring the
+        /// input before each hop) and the maximum difference of their outputs.
+        template <class PreviousLoop, class KernelLoop>
+        void compare( char const * const effectName, PreviousLoop const & previous, KernelLoop const & kernel )
+        {
+            restore(); kernel  ( view() );
+            Utility::AlignedHeapBuffer<float> kernelOutput;
+            BOOST_VERIFY( kernelOutput.resize( 2 * bins() ) );
+            std::copy( data_.main().amps  ().begin(), data_.main().amps  ().end(), &kernelOutput[ 0      ] );
+            std::copy( data_.main().phases().begin(), data_.main().phases().end(), &kernelOutput[ bins() ] );
+            restore(); previous( view() );
+            float maximumDifference( 0 );
+            for ( std::uint16_t bin( 0 ); bin < bins(); ++bin )
+            {
+                maximumDifference = std::max( maximumDifference, std::abs( data_.main().amps  ()[ bin ] - kernelOutput[          bin ] ) );
+                maximumDifference = std::max( maximumDifference, std::abs( data_.main().phases()[ bin ] - kernelOutput[ bins() + bin ] ) );
+            }
+
+            double const previousNanoseconds( time( previous ) - restoreNanoseconds_ );
+            double const kernelNanoseconds  ( time( kernel   ) - restoreNanoseconds_ );
+            std::printf( "%-9s | %11.3f | %9.3f | %7.2f | %14.3g\n", effectName, previousNanoseconds, kernelNanoseconds, previousNanoseconds / kernelNanoseconds, maximumDifference );
+        }
+
+    private:
+        std::uint16_t bins() const { return static_cast<std::uint16_t>( input_.main().amps().size() ); }
+
+        MainSideChannelData_AmPh view() { return MainSideChannelData_AmPh( data_, IndexRange( 0, bins() ) ); }
+
+        void restore()
+        {
+            Math::copy( input_.main().amps  (), data_.main().amps  () );
+            Math::copy( input_.main().phases(), data_.main().phases() );
+        }
+
+        template <class Loop>
+        double time( Loop const & loop )
+        {
+            SW::Stopwatch const stopwatch;
+            for ( std::uint32_t hop( 0 ); hop < hops_; ++hop )
+            {
+                restore();
+                loop( view() );
+            }
+            return stopwatch.seconds() * 1e9 / ( double( hops_ ) * bins() );
+        }
+
+    private:
+        Engine::FullMainSideChannelData_AmPh       & data_ ;
+        Engine::FullMainSideChannelData_AmPh const & input_;
+        std::uint32_t                          const hops_ ;
+        double                                       restoreNanoseconds_;
+    }; // class Benchmark
+} // anonymous namespace
+
+int main( int const argc, char const * const argv[] )
+{
+    std::uint16_t const fftSize( static_cast<std::uint16_t>( ( argc > 1 ) ? std::atoi( argv[ 1 ] ) : 2048   ) );
+    std::uint32_t const hops   ( static_cast<std::uint32_t>( ( argc > 2 ) ? std::atoi( argv[ 2 ] ) : 100000 ) );
+
+    // Only used for its (valid) engine setup and storage factors.
+    HeadlessEngine engine;
+    if ( !hops || !engine.setup( 1, 44100, fftSize, 4 ) )
+    {
+        std::fprintf( stderr, "Usage: %s [FFT size] [hops]\n", argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+    Engine::Setup          const & engineSetup( engine.engineSetup   () );
+    Engine::StorageFactors const & factors    ( engine.storageFactors() );
+    std::uint16_t          const   bins       ( engineSetup.numberOfBins() );
+    IndexRange             const   fullRange  ( 0, bins );
+
+    using Utility::align;
+    using BurritoState = Effects::BurritoImpl::ChannelState;
+    std::uint32_t const dataBytes ( Engine::FullMainSideChannelData_AmPh::requiredStorage( factors ) );
+    std::uint32_t const stateBytes( BurritoState                        ::requiredStorage( factors ) );
+    Utility::AlignedHeapBuffer<char> buffer;
+    if ( !buffer.resize( 2 * align( dataBytes ) + align( stateBytes ) ) )
+    {
+        std::fprintf( stderr, "Out of memory.\n" );
+        return EXIT_FAILURE;
+    }
+    Engine::Storage storage( buffer.begin(), buffer.end() );
+
+    Engine::FullMainSideChannelData_AmPh input;
+    Engine::FullMainSideChannelData_AmPh data ;
+    BurritoState                         burritoState;
+    {
+        Engine::Storage inputStorage( take( storage, dataBytes  ) ); input       .resize( factors, inputStorage );
+        Engine::Storage dataStorage ( take( storage, dataBytes  ) ); data        .resize( factors, dataStorage  );
+        Engine::Storage stateStorage( take( storage, stateBytes ) ); burritoState.resize( factors, stateStorage );
+        burritoState.reset();
+    }
+
+    std::mt19937 generator;
+    std::uniform_real_distribution<float> sample( 0, 1 );
+    for ( auto const pChannel : { &input.main(), const_cast<Engine::FullChannelData_AmPh *>( &input.side() ) } )
+    {
+        for ( auto & amplitude : pChannel->amps  () ) amplitude = sample( generator ) * engineSetup.maximumAmplitude();
+        for ( auto & phase     : pChannel->phases() ) phase     = ( 2 * sample( generator ) - 1 ) * Math::Constants::pi;
+    }
+    Math::copy( input.side().amps  (), const_cast<Engine::FullChannelData_AmPh &>( data.side() ).amps  () );
+    Math::copy( input.side().phases(), const_cast<Engine::FullChannelData_AmPh &>( data.side() ).phases() );
+
+    Math::FPUDisableDenormalsGuard const disableDenormals;
+
+    std::printf( "FFT size %u, %u hops, default parameters\n", fftSize, hops );
+    std::printf( "effect    | previous ns | kernel ns | speedup | max difference\n" );
+
+    Benchmark benchmark( data, input, hops );
+
+    {
+        Effects::DenoiserImpl effect; effect.setup( fullRange, engineSetup );
+        using Effect = Effects::DenoiserImpl;
+        float const maxAmp( engineSetup.maximumAmplitude() );
+        float const minAmp( maxAmp * Math::dB2NormalisedLinear( -1 ) );
+        float const factor( Math::percentage2NormalisedLinear( effect.parameters().get<Effect::Intensity>() ) * ( maxAmp - minAmp ) );
+        Effect::Mode::value_type const mode( effect.parameters().get<Effect::Mode>() );
+        benchmark.compare
+        (
+            "Denoiser",
+            [&]( MainSideChannelData_AmPh const view ) { Previous::denoiser( view, mode, factor ); },
+            [&]( MainSideChannelData_AmPh const view ) { effect.process( view, engineSetup ); }
+        );
+    }
+    {
+        Effects::MergerImpl effect; effect.setup( fullRange, engineSetup );
+        using Effect = Effects::MergerImpl;
+        float const threshold( engineSetup.maximumAmplitude() * Math::dB2NormalisedLinear( effect.parameters().get<Effect::Threshold>() ) );
+        Effect::Operation::value_type const operation( effect.parameters().get<Effect::Operation>() );
+        benchmark.compare
+        (
+            "Merger",
+            [&]( MainSideChannelData_AmPh const view ) { Previous::merger( view, operation, threshold ); },
+            [&]( MainSideChannelData_AmPh const view ) { effect.process( view, engineSetup ); }
+        );
+    }
+    {
+        Effects::EtherealImpl effect; effect.setup( fullRange, engineSetup );
+        using Effect = Effects::EtherealImpl;
+        float const threshold( Math::dB2NormalisedLinear( effect.parameters().get<Effect::Threshold>() ) );
+        bool  const replaceWhenWeaker( effect.parameters().get<Effect::Condition>() == Effect::Condition::DiffLower );
+        Effects::UnpackedMagPhaseMode mode; mode.unpack( effect.parameters().get<Effect::Mode>() );
+        benchmark.compare
+        (
+            "Ethereal",
+            [&]( MainSideChannelData_AmPh const view ) { Previous::ethereal( view, replaceWhenWeaker, threshold, mode ); },
+            [&]( MainSideChannelData_AmPh const view ) { effect.process( view, engineSetup ); }
+        );
+    }
+    {
+        Effects::VaxateerImpl effect; effect.setup( fullRange, engineSetup );
+        using Effect = Effects::VaxateerImpl;
+        float const rmsGain( Math::dB2NormalisedLinear( effect.parameters().get<Effect::RMSGain>() ) );
+        Effect::RMSTarget::value_type const rmsTarget( effect.parameters().get<Effect::RMSTarget>() );
+        Effect::Mode     ::value_type const mode     ( effect.parameters().get<Effect::Mode     >() );
+        benchmark.compare
+        (
+            "Vaxateer",
+            [&]( MainSideChannelData_AmPh const view ) { Previous::vaxateer( view, rmsTarget, mode, rmsGain ); },
+            [&]( MainSideChannelData_AmPh const view ) { effect.process( view, engineSetup ); }
+        );
+    }
+    {
+        // (both versions use the replacement positions last generated by the
+        // current one)
+        Effects::BurritoImpl effect; effect.setup( fullRange, engineSetup );
+        using Effect = Effects::BurritoImpl;
+        float const sideGain( Math::dB2NormalisedLinear( effect.parameters().get<Effect::SideGain>() ) );
+        Effect::Mode::value_type const mode( effect.parameters().get<Effect::Mode>() );
+        benchmark.compare
+        (
+            "Burrito",
+            [&]( MainSideChannelData_AmPh const view ) { Previous::burrito( view, mode, sideGain, burritoState.positions.begin() ); },
+            [&]( MainSideChannelData_AmPh const view ) { effect.process( burritoState, view, engineSetup ); }
+        );
+    }
+    {
+        Effects::ShapelessImpl effect; effect.setup( fullRange, engineSetup );
+        using Effect = Effects::ShapelessImpl;
+        std::uint16_t const width( engineSetup.frequencyInHzToBin( effect.parameters().get<Effect::Width>() ) );
+        benchmark.compare
+        (
+            "Shapeless",
+            [&]( MainSideChannelData_AmPh const view ) { Previous::shapeless( view, width ); },
+            [&]( MainSideChannelData_AmPh const view ) { effect.process( view, engineSetup ); }
+        );
+    }
+
+    return EXIT_SUCCESS;
+}
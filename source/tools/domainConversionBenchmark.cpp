@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// domainConversionBenchmark.cpp
+/// -----------------------------
+///
+///   Measures the maximum errors and the throughput of each accuracy tier of
+/// the polar <-> rectangular conversions (see Math::ConversionAccuracy) against
+/// the standard library (std::atan2(), std::sin() and std::cos()).
+///
+///   Usage: domainConversionBenchmark [bins] [iterations]
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#include "headlessEngine.hpp"
+
+#include "le/math/constants.hpp"
+#include "le/math/dft/domainConversion.hpp"
+#include "le/utility/buffers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+//------------------------------------------------------------------------------
+namespace
+{
+    using namespace LE;
+
+    char const * const tierNames[] = { "Coarse", "Fine", "Full" };
+
+    // Phase difference wrapped to [-pi, pi].
+    float phaseError( float const phase, float const reference )
+    {
+        return std::abs( std::remainder( phase - reference, 2 * Math::Constants::pi ) );
+    }
+} // anonymous namespace
+
+int main( int const argc, char const * const argv[] )
+{
+    using namespace LE;
+
+    // A multiple of the SIMD width so that all the sub-buffers stay aligned.
+    std::uint16_t const bins      ( static_cast<std::uint16_t>( ( ( argc > 1 ) ? std::atoi( argv[ 1 ] ) : 4096 ) & ~15 ) );
+    std::uint32_t const iterations( static_cast<std::uint32_t>(   ( argc > 2 ) ? std::atoi( argv[ 2 ] ) : 10000       ) );
+    if ( !bins || !iterations )
+    {
+        std::fprintf( stderr, "Usage: %s [bins (a multiple of 16)] [iterations]\n", argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+
+    Utility::AlignedHeapBuffer<float> storage;
+    if ( !storage.resize( 8 * bins ) )
+    {
+        std::fprintf( stderr, "Out of memory.\n" );
+        return EXIT_FAILURE;
+    }
+    float * const reals         ( storage.begin() + 0 * bins );
+    float * const imags         ( storage.begin() + 1 * bins );
+    float * const amplitudes    ( storage.begin() + 2 * bins );
+    float * const phases        ( storage.begin() + 3 * bins );
+    float * const outputReals   ( storage.begin() + 4 * bins );
+    float * const outputImags   ( storage.begin() + 5 * bins );
+    float * const outputAmps    ( storage.begin() + 6 * bins );
+    float * const outputPhases  ( storage.begin() + 7 * bins );
+
+    std::mt19937 generator;
+    std::uniform_real_distribution<float> sample( -1, 1 );
+    for ( std::uint16_t bin( 0 ); bin < bins; ++bin )
+    {
+        reals     [ bin ] = sample( generator );
+        imags     [ bin ] = sample( generator );
+        amplitudes[ bin ] = std::abs( sample( generator ) );
+        phases    [ bin ] = sample( generator ) * Math::Constants::pi;
+    }
+
+    std::printf( "%u bins, %u iterations\n", bins, iterations );
+    std::printf( "tier    | reim2AmPh max phase error | amph2ReIm max error | reim2AmPh ns/bin | amph2ReIm ns/bin\n" );
+
+    for ( auto const accuracy : { Math::CoarseConversion, Math::FineConversion, Math::FullConversion } )
+    {
+        // Errors:
+        Math::reim2AmPh( reals, imags, outputAmps, outputPhases, bins, accuracy );
+        Math::amph2ReIm( amplitudes, phases, outputReals, outputImags, bins, accuracy );
+        float maximumPhaseError    ( 0 );
+        float maximumRectangleError( 0 );
+        for ( std::uint16_t bin( 0 ); bin < bins; ++bin )
+        {
+            maximumPhaseError     = std::max( maximumPhaseError    , phaseError( outputPhases[ bin ], std::atan2( imags[ bin ], reals[ bin ] ) ) );
+            maximumRectangleError = std::max( maximumRectangleError, std::abs( outputReals[ bin ] - amplitudes[ bin ] * std::cos( phases[ bin ] ) ) );
+            maximumRectangleError = std::max( maximumRectangleError, std::abs( outputImags[ bin ] - amplitudes[ bin ] * std::sin( phases[ bin ] ) ) );
+        }
+
+        // Throughput:
+        double const totalBins( double( bins ) * iterations );
+        SW::Stopwatch const polar;
+        for ( std::uint32_t iteration( 0 ); iteration < iterations; ++iteration )
+            Math::reim2AmPh( reals, imags, outputAmps, outputPhases, bins, accuracy );
+        double const polarNanoseconds( polar.seconds() * 1e9 / totalBins );
+        SW::Stopwatch const rectangular;
+        for ( std::uint32_t iteration( 0 ); iteration < iterations; ++iteration )
+            Math::amph2ReIm( amplitudes, phases, outputReals, outputImags, bins, accuracy );
+        double const rectangularNanoseconds( rectangular.seconds() * 1e9 / totalBins );
+
+        std::printf
+        (
+            "%-7s | %25.3g | %19.3g | %16.2f | %16.2f\n",
+            tierNames[ accuracy ], maximumPhaseError, maximumRectangleError, polarNanoseconds, rectangularNanoseconds
+        );
+    }
+
+    // The reference (with a sink so that the repeated loops are not folded):
+    {
+        float volatile sink;
+        double const totalBins( double( bins ) * iterations );
+        SW::Stopwatch const polar;
+        for ( std::uint32_t iteration( 0 ); iteration < iterations; ++iteration )
+        {
+            for ( std::uint16_t bin( 0 ); bin < bins; ++bin )
+            {
+                outputAmps  [ bin ] = std::sqrt ( reals[ bin ] * reals[ bin ] + imags[ bin ] * imags[ bin ] );
+                outputPhases[ bin ] = std::atan2( imags[ bin ], reals[ bin ] );
+            }
+            sink = outputPhases[ iteration % bins ];
+        }
+        double const polarNanoseconds( polar.seconds() * 1e9 / totalBins );
+        SW::Stopwatch const rectangular;
+        for ( std::uint32_t iteration( 0 ); iteration < iterations; ++iteration )
+        {
+            for ( std::uint16_t bin( 0 ); bin < bins; ++bin )
+            {
+                outputReals[ bin ] = amplitudes[ bin ] * std::cos( phases[ bin ] );
+                outputImags[ bin ] = amplitudes[ bin ] * std::sin( phases[ bin ] );
+            }
+            sink = outputImags[ iteration % bins ];
+        }
+        double const rectangularNanoseconds( rectangular.seconds() * 1e9 / totalBins );
+        std::printf( "%-7s | %25s | %19s | %16.2f | %16.2f\n", "std", "-", "-", polarNanoseconds, rectangularNanoseconds );
+    }
+
+    return EXIT_SUCCESS;
+}
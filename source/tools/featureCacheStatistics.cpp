@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// featureCacheStatistics.cpp
+/// --------------------------
+///
+///   Runs a module chain (by default the Pitch Follower -> Sumo Pitch pair,
+/// both of which detect the pitch of the main and the side channel) over a
+/// synthetic voice-like main and side channel signal and reports how many of
+/// the Engine::SpectralFeatures requests of the chain were served from the
+/// cache.
+///
+///   Usage: featureCacheStatistics [seconds] [effect...]
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#include "headlessEngine.hpp"
+
+#include "le/spectrumworx/engine/spectralFeatures.hpp"
+#include "le/math/constants.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+//------------------------------------------------------------------------------
+namespace
+{
+    using namespace LE;
+    using namespace LE::SW;
+
+    std::uint32_t const sampleRate( 44100 );
+    std::uint16_t const blockSize ( 512   );
+
+    // Five harmonics of a fundamental slowly gliding around the given one.
+    void synthesise( float * const pSamples, std::uint32_t const frames, float const fundamental )
+    {
+        float const twoPi( 2 * Math::Constants::pi );
+        double phase( 0 );
+        for ( std::uint32_t frame( 0 ); frame < frames; ++frame )
+        {
+            float const glide( 1 + 0.05f * std::sin( twoPi * 0.5f * frame / sampleRate ) );
+            phase += double( fundamental * glide ) / sampleRate;
+            float sample( 0 );
+            for ( std::uint8_t harmonic( 1 ); harmonic <= 5; ++harmonic )
+                sample += std::sin( float( twoPi * harmonic * phase ) ) / ( 2 * harmonic );
+            pSamples[ frame ] = sample;
+        }
+    }
+
+    void print( char const * const feature, Engine::SpectralFeatures::Statistics::Counters const & counters )
+    {
+        std::printf
+        (
+            "%-8s | %8u | %8u | %6.1f%%\n",
+            feature, counters.requests, counters.hits,
+            counters.requests ? 100.0 * counters.hits / counters.requests : 0.0
+        );
+    }
+} // anonymous namespace
+
+int main( int const argc, char const * const argv[] )
+{
+    std::uint32_t const seconds( static_cast<std::uint32_t>( ( argc > 1 ) ? std::atoi( argv[ 1 ] ) : 10 ) );
+    std::uint32_t const frames ( seconds * sampleRate                                                  );
+
+    char const * const defaultChain[] = { "Pitch Follower", "Sumo Pitch" };
+    char const * const * const pTitlesBegin( ( argc > 2 ) ? &argv[ 2    ] : std::begin( defaultChain ) );
+    char const * const * const pTitlesEnd  ( ( argc > 2 ) ? &argv[ argc ] : std::end  ( defaultChain ) );
+
+    HeadlessEngine engine;
+    if ( !frames || !engine.setup( 1, sampleRate, 2048, 4, 1 ) )
+    {
+        std::fprintf( stderr, "Usage: %s [seconds] [effect...]\n", argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+    for ( auto pTitle( pTitlesBegin ); pTitle != pTitlesEnd; ++pTitle )
+    {
+        if ( !engine.append( *pTitle ) )
+        {
+            std::fprintf( stderr, "%s: not available.\n", *pTitle );
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::unique_ptr<float[]> const pMain  ( new ( std::nothrow ) float[ frames ] );
+    std::unique_ptr<float[]> const pSide  ( new ( std::nothrow ) float[ frames ] );
+    std::unique_ptr<float[]> const pOutput( new ( std::nothrow ) float[ frames ] );
+    if ( !pMain || !pSide || !pOutput )
+    {
+        std::fprintf( stderr, "Out of memory.\n" );
+        return EXIT_FAILURE;
+    }
+    synthesise( pMain.get(), frames, 220 );
+    synthesise( pSide.get(), frames, 330 );
+
+    SW::Stopwatch const stopwatch;
+    for ( std::uint32_t frame( 0 ); frame < frames; frame += blockSize )
+    {
+        std::uint32_t const samples( std::min<std::uint32_t>( blockSize, frames - frame ) );
+        engine.process( &pMain[ frame ], &pSide[ frame ], &pOutput[ frame ], samples, 1, 1 );
+    }
+    double const speed( stopwatch.xRealTime( frames, sampleRate ) );
+
+    std::printf( "%u modules, %u s, %.1f x real time\n", unsigned( pTitlesEnd - pTitlesBegin ), seconds, speed );
+    std::printf( "feature  | requests |     hits | hit rate\n" );
+    Engine::SpectralFeatures::Statistics const & statistics( engine.featureStatistics( 0 ) );
+    print( "cepstrum", statistics.cepstrum );
+    print( "centroid", statistics.centroid );
+    print( "pitch"   , statistics.pitch    );
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// headlessEngine.cpp
+/// ------------------
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#include "headlessEngine.hpp"
+
+#include "core/modules/factory.hpp"
+#include "core/modules/moduleDSP.hpp"
+
+#include "le/spectrumworx/effects/configuration/effectNames.hpp"
+#include "le/spectrumworx/engine/configuration.hpp"
+#include "le/utility/clear.hpp"
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+
+namespace Engine
+{
+    ModuleChainImpl & Processor::modules() { return static_cast<HeadlessEngine &>( *this ).modules_; }
+    std::uint32_t Processor::effectsScratchStorage( StorageFactors const & factors ) { return ModuleFactory::maximumScratchStorage( factors ); }
+} // namespace Engine
+
+
+HeadlessEngine::HeadlessEngine()
+{
+    Utility::clear( storageFactors_ );
+}
+
+
+LE_COLD
+bool HeadlessEngine::setup( std::uint8_t const numberOfChannels, std::uint32_t const sampleRate, std::uint16_t const fftSize, std::uint8_t const overlapFactor, std::uint8_t const numberOfSideChannels )
+{
+    setNumberOfChannels( numberOfChannels, numberOfSideChannels );
+    return resize
+    (
+        storageFactors_,
+        makeFactors
+        (
+            fftSize,
+        #if LE_SW_ENGINE_WINDOW_PRESUM
+            1,
+        #endif // LE_SW_ENGINE_WINDOW_PRESUM
+            overlapFactor,
+            numberOfChannels,
+            1,
+            sampleRate
+        ),
+        Engine::Constants::Hann,
+        sharedStorage_
+    );
+}
+
+
+LE_COLD
+ModuleDSP * HeadlessEngine::append( char const * const effectTitle )
+{
+    BOOST_ASSERT( storageFactors_.complete() );
+    auto const pModule( ModuleFactory::create<ModuleDSP>( Effects::effectIndex( effectTitle ) ) );
+    if ( !pModule || !pModule->resize( storageFactors_ ) )
+        return nullptr;
+    pModule->initialise( engineSetup() );
+    modules_.push_back( Engine::node( *pModule ) );
+    return pModule.get();
+}
+
+
+LE_COLD
+void HeadlessEngine::reset()
+{
+    Processor::reset();
+    resetChannelBuffers();
+    modules_.resetAll();
+}
+
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \file headlessEngine.hpp
+/// ------------------------
+///
+///   The SpectrumWorx engine without the plugin core (and GUI) for the command
+/// line tools and benchmarks.
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#ifndef headlessEngine_hpp__3B7E2D51_96C4_4F0A_8E1D_5C0A4B27F963
+#define headlessEngine_hpp__3B7E2D51_96C4_4F0A_8E1D_5C0A4B27F963
+#pragma once
+//------------------------------------------------------------------------------
+#include "le/spectrumworx/engine/buffers.hpp"
+#include "le/spectrumworx/engine/moduleChainImpl.hpp"
+#include "le/spectrumworx/engine/processor.hpp"
+#include "le/utility/platformSpecifics.hpp"
+
+#include <chrono>
+#include <cstdint>
+//------------------------------------------------------------------------------
+namespace LE
+{
+//------------------------------------------------------------------------------
+namespace SW
+{
+//------------------------------------------------------------------------------
+
+class ModuleDSP;
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class HeadlessEngine
+///
+/// \brief An Engine::Processor with its own module chain and storage, set up
+/// directly (instead of through automated parameters).
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class HeadlessEngine : public Engine::Processor
+{
+public:
+    HeadlessEngine();
+
+    /// Allocates the engine (and resizes the chained modules) for the given
+    /// format and STFT parameters (Hann window, a single resolution layer, no
+    /// side channels unless requested).
+    LE_COLD bool setup( std::uint8_t numberOfChannels, std::uint32_t sampleRate, std::uint16_t fftSize, std::uint8_t overlapFactor, std::uint8_t numberOfSideChannels = 0 );
+
+    /// Creates a module for the effect with the given title (see
+    /// Effects::effectIndex()), sets it up for the current engine setup and
+    /// appends it to the chain. Returns nullptr if the effect is not available
+    /// or on allocation failure.
+    /// \note Requires a successful setup() call.
+    LE_COLD ModuleDSP * append( char const * effectTitle );
+
+    /// Resets the processor and all the chained modules (e.g. to process a
+    /// file again from its start).
+    LE_COLD void reset();
+
+    Engine::ModuleChainImpl       & moduleChain()       { return modules_; }
+    Engine::ModuleChainImpl const & moduleChain() const { return modules_; }
+
+    Engine::StorageFactors const & storageFactors() const { return storageFactors_; }
+    Engine::Setup          const & engineSetup   () const { return Processor::engineSetup(); }
+
+    using Processor::setFixedChain;
+
+private: friend class Engine::Processor;
+    Engine::ModuleChainImpl   modules_       ;
+    Engine::StorageFactors    storageFactors_;
+    Engine::HeapSharedStorage sharedStorage_ ;
+}; // class HeadlessEngine
+
+
+////////////////////////////////////////////////////////////////////////////////
+///
+/// \class Stopwatch
+///
+/// \brief Wall clock time of a (batch) processing pass and its x-realtime
+/// speed.
+///
+////////////////////////////////////////////////////////////////////////////////
+
+class Stopwatch
+{
+public:
+    Stopwatch() : start_( Clock::now() ) {}
+
+    double seconds() const { return std::chrono::duration<double>( Clock::now() - start_ ).count(); }
+
+    /// How many times faster than real time the given amount of audio was
+    /// processed.
+    double xRealTime( std::uint32_t const sampleFrames, std::uint32_t const sampleRate ) const { return ( double( sampleFrames ) / sampleRate ) / seconds(); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point const start_;
+}; // class Stopwatch
+
+//------------------------------------------------------------------------------
+} // namespace SW
+//------------------------------------------------------------------------------
+} // namespace LE
+//------------------------------------------------------------------------------
+#endif // headlessEngine_hpp
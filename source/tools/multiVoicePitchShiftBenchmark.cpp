@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// multiVoicePitchShiftBenchmark.cpp
+/// ---------------------------------
+///
+///   Measures the per hop cost of PhaseVocoderShared::MultiVoicePitchShifter
+/// with 1, 2, 4 and 8 voices (addVoice() called N times over one shared
+/// analyse()) and, for comparison, of the analysis alone.
+///
+///   Usage: multiVoicePitchShiftBenchmark [FFT size] [hops]
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#include "headlessEngine.hpp"
+
+#include "le/spectrumworx/effects/phase_vocoder/shared.hpp"
+#include "le/spectrumworx/engine/channelDataAmPh.hpp"
+#include "le/spectrumworx/engine/channelDataReIm.hpp"
+#include "le/spectrumworx/engine/setup.hpp"
+#include "le/math/constants.hpp"
+#include "le/math/vector.hpp"
+#include "le/utility/buffers.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+//------------------------------------------------------------------------------
+namespace
+{
+    using namespace LE;
+    using namespace LE::SW;
+
+    using MultiVoicePitchShifter = Effects::PhaseVocoderShared::MultiVoicePitchShifter;
+    using AnalysisChannelState   = Effects::PhaseVocoderShared::AnalysisChannelState;
+    using VoiceChannelState      = MultiVoicePitchShifter::VoiceChannelState;
+
+    std::uint8_t const maximumVoices( 8 );
+
+    // A (detuned) chord of up to an octave below and above the input:
+    float const pitchScales[ maximumVoices ] = { 0.5f, 2.0f, 0.75f, 1.5f, 0.8909f, 1.2599f, 0.6674f, 1.3348f };
+
+    // Carves consecutive (aligned) parts out of a single allocation.
+    Engine::Storage take( Engine::Storage & storage, std::uint32_t const bytes )
+    {
+        Engine::Storage const part( storage.begin(), storage.begin() + bytes );
+        storage.advance_begin( Utility::align( bytes ) );
+        return part;
+    }
+} // anonymous namespace
+
+int main( int const argc, char const * const argv[] )
+{
+    std::uint16_t const fftSize( static_cast<std::uint16_t>( ( argc > 1 ) ? std::atoi( argv[ 1 ] ) : 2048  ) );
+    std::uint32_t const hops   ( static_cast<std::uint32_t>( ( argc > 2 ) ? std::atoi( argv[ 2 ] ) : 20000 ) );
+
+    // Only used for its (valid) engine setup and storage factors.
+    HeadlessEngine engine;
+    if ( !hops || !engine.setup( 1, 44100, fftSize, 4 ) )
+    {
+        std::fprintf( stderr, "Usage: %s [FFT size] [hops]\n", argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+    Engine::Setup          const & engineSetup( engine.engineSetup   () );
+    Engine::StorageFactors const & factors    ( engine.storageFactors() );
+    std::uint16_t          const   bins       ( engineSetup.numberOfBins() );
+
+    using Utility::align;
+    std::uint32_t const amPhBytes    ( Engine::ChannelData_AmPhStorage::requiredStorage( fftSize ) );
+    std::uint32_t const reImBytes    ( Engine::FullChannelData_ReIm   ::requiredStorage( factors ) );
+    std::uint32_t const analysisBytes( AnalysisChannelState           ::requiredStorage( factors ) );
+    std::uint32_t const voiceBytes   ( VoiceChannelState              ::requiredStorage( factors ) );
+    Utility::AlignedHeapBuffer<char> buffer;
+    if ( !buffer.resize( 3 * align( amPhBytes ) + align( reImBytes ) + align( analysisBytes ) + maximumVoices * align( voiceBytes ) ) )
+    {
+        std::fprintf( stderr, "Out of memory.\n" );
+        return EXIT_FAILURE;
+    }
+    Engine::Storage storage( buffer.begin(), buffer.end() );
+
+    Engine::ChannelData_AmPhStorage input   ( fftSize, 0, bins, take( storage, amPhBytes ) );
+    Engine::ChannelData_AmPhStorage analysed( fftSize, 0, bins, take( storage, amPhBytes ) );
+    Engine::ChannelData_AmPhStorage voice   ( fftSize, 0, bins, take( storage, amPhBytes ) );
+
+    Engine::FullChannelData_ReIm fullOutput;
+    {
+        Engine::Storage outputStorage( take( storage, reImBytes ) );
+        fullOutput.resize( factors, outputStorage );
+    }
+    Engine::ChannelData_ReIm output( fullOutput, Effects::IndexRange( 0, bins ) );
+
+    AnalysisChannelState analysis;
+    {
+        Engine::Storage analysisStorage( take( storage, analysisBytes ) );
+        analysis.resize( factors, analysisStorage );
+    }
+    VoiceChannelState voices[ maximumVoices ];
+    for ( auto & voiceState : voices )
+    {
+        Engine::Storage voiceStorage( take( storage, voiceBytes ) );
+        voiceState.resize( factors, voiceStorage );
+    }
+
+    std::mt19937 generator;
+    std::uniform_real_distribution<float> sample( 0, 1 );
+    for ( auto & amplitude : input.amps  () ) amplitude = sample( generator );
+    for ( auto & phase     : input.phases() ) phase     = ( 2 * sample( generator ) - 1 ) * Math::Constants::pi;
+
+    MultiVoicePitchShifter pitchShifter;
+    pitchShifter.setup( engineSetup );
+
+    std::printf( "FFT size %u, %u hops\n", fftSize, hops );
+    std::printf( "voices | us/hop | us/voice\n" );
+
+    // The shared analysis alone:
+    double analysisMicroseconds;
+    {
+        analysis.reset();
+        SW::Stopwatch const stopwatch;
+        for ( std::uint32_t hop( 0 ); hop < hops; ++hop )
+            pitchShifter.analyse( analysis, input, analysed );
+        analysisMicroseconds = stopwatch.seconds() * 1e6 / hops;
+        std::printf( "%6s | %6.2f | %8s\n", "0", analysisMicroseconds, "-" );
+    }
+
+    for ( std::uint8_t const numberOfVoices : { 1, 2, 4, 8 } )
+    {
+        analysis.reset();
+        for ( auto & voiceState : voices )
+            voiceState.reset();
+        float const gain( 1.0f / numberOfVoices );
+
+        SW::Stopwatch const stopwatch;
+        for ( std::uint32_t hop( 0 ); hop < hops; ++hop )
+        {
+            Math::clear( output.reals().begin(), output.reals().end() );
+            Math::clear( output.imags().begin(), output.imags().end() );
+            pitchShifter.analyse( analysis, input, analysed );
+            for ( std::uint8_t voiceIndex( 0 ); voiceIndex < numberOfVoices; ++voiceIndex )
+                pitchShifter.addVoice( pitchScales[ voiceIndex ], gain, analysis, voices[ voiceIndex ], input, analysed, voice, output );
+        }
+        double const microseconds( stopwatch.seconds() * 1e6 / hops );
+        std::printf( "%6u | %6.2f | %8.2f\n", numberOfVoices, microseconds, ( microseconds - analysisMicroseconds ) / numberOfVoices );
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// pitchCorrection.cpp
+/// -------------------
+///
+///   Batch (offline) pitch correction of a WAVE file in two passes:
+///  1) the pitch curve of the whole file is analysed (in parallel) and
+///     smoothed with lookahead (see PitchCurve)
+///  2) the file is processed by a TuneWorx module that follows the curve
+///     (see Engine::ModuleDSP::followPitchCurve()).
+/// The x-realtime speed of each pass is reported.
+///
+///   Usage: pitchCorrection <input.wav> <output.wav> [FFT size] [overlap factor]
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#include "headlessEngine.hpp"
+
+#include "core/modules/moduleDSP.hpp"
+
+#include "le/analysis/pitch_detector/pitchCurve.hpp"
+#include "le/audioio/file/inputWaveFile.hpp"
+#include "le/audioio/file/outputWaveFile.hpp"
+#include "le/utility/filesystem.hpp"
+
+#include "boost/assert.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <thread>
+//------------------------------------------------------------------------------
+namespace
+{
+    int fail( char const * const what, char const * const error )
+    {
+        std::fprintf( stderr, "%s: %s\n", what, error );
+        return EXIT_FAILURE;
+    }
+
+    // The (fixed) TuneWorx pitch range of the plugin.
+    float const lowerBound( 70               );
+    float const upperBound( 70 * 2*2*2*2*2   ); // 5 octaves
+
+    std::uint8_t  const maximumGap( 4   );
+    std::uint16_t const blockSize ( 512 );
+} // anonymous namespace
+
+int main( int const argc, char const * const argv[] )
+{
+    using namespace LE;
+
+    if ( argc < 3 )
+    {
+        std::fprintf( stderr, "Usage: %s <input.wav> <output.wav> [FFT size] [overlap factor]\n", argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+
+    std::uint16_t const fftSize      ( static_cast<std::uint16_t>( ( argc > 3 ) ? std::atoi( argv[ 3 ] ) : 2048 ) );
+    std::uint8_t  const overlapFactor( static_cast<std::uint8_t >( ( argc > 4 ) ? std::atoi( argv[ 4 ] ) : 4    ) );
+
+    AudioIO::InputWaveFile input;
+    if ( auto const error = input.open<Utility::AbsolutePath>( argv[ 1 ] ) )
+        return fail( argv[ 1 ], error );
+
+    std::uint8_t  const channels  ( input.numberOfChannels    () );
+    std::uint32_t const sampleRate( input.sampleRate          () );
+    std::uint32_t const frames    ( input.lengthInSampleFrames() );
+
+    SW::HeadlessEngine engine;
+    if ( !engine.setup( channels, sampleRate, fftSize, overlapFactor ) )
+        return fail( "Engine setup", "out of memory or unsupported parameters." );
+    SW::ModuleDSP * const pTuneWorx( engine.append( "TuneWorx" ) );
+    if ( !pTuneWorx )
+        return fail( "TuneWorx", "not available." );
+
+    // The input is padded (and the output trimmed) by the engine latency.
+    std::uint32_t const latency    ( engine.engineSetup().latencyInSamples() );
+    std::uint32_t const totalFrames( frames + latency                        );
+
+    std::unique_ptr<float[]> const pInput ( new ( std::nothrow ) float[ totalFrames * channels ]() );
+    std::unique_ptr<float[]> const pOutput( new ( std::nothrow ) float[ totalFrames * channels ]   );
+    std::unique_ptr<float[]> const pMono  ( new ( std::nothrow ) float[ frames                 ]   );
+    if ( !pInput || !pOutput || !pMono )
+        return fail( argv[ 1 ], "out of memory." );
+    if ( input.read( pInput.get(), frames ) != frames )
+        return fail( argv[ 1 ], "read error." );
+
+    for ( std::uint32_t frame( 0 ); frame < frames; ++frame )
+    {
+        float sum( 0 );
+        for ( std::uint8_t channel( 0 ); channel < channels; ++channel )
+            sum += pInput[ frame * channels + channel ];
+        pMono[ frame ] = sum / channels;
+    }
+
+    // Pass 1: the pitch curve.
+    PitchCurve curve;
+    SW::Stopwatch const analysis;
+    auto const threads( static_cast<std::uint8_t>( std::max( 1U, std::min( 255U, std::thread::hardware_concurrency() ) ) ) );
+    if ( auto const error = curve.analyse( pMono.get(), frames, sampleRate, fftSize, overlapFactor, lowerBound, upperBound, threads ) )
+        return fail( "Analysis", error );
+    if ( auto const error = curve.smooth( PitchCurve::maximumLookahead, maximumGap ) )
+        return fail( "Smoothing", error );
+    double const analysisSpeed( analysis.xRealTime( frames, sampleRate ) );
+
+    // Pass 2: correction.
+    engine.reset();
+    BOOST_VERIFY( pTuneWorx->followPitchCurve( &curve ) );
+    SW::Stopwatch const correction;
+    for ( std::uint32_t frame( 0 ); frame < totalFrames; frame += blockSize )
+    {
+        std::uint32_t const samples( std::min<std::uint32_t>( blockSize, totalFrames - frame ) );
+        engine.process( &pInput[ frame * channels ], nullptr, &pOutput[ frame * channels ], samples, 1, 1 );
+    }
+    double const correctionSpeed( correction.xRealTime( frames, sampleRate ) );
+    BOOST_VERIFY( pTuneWorx->followPitchCurve( nullptr ) );
+
+    AudioIO::OutputWaveFile output;
+    if ( auto const error = output.create<Utility::AbsolutePath>( argv[ 2 ], channels, sampleRate ) )
+        return fail( argv[ 2 ], error );
+    if ( auto const error = output.write( &pOutput[ latency * channels ], frames ) )
+        return fail( argv[ 2 ], error );
+    output.close();
+
+    std::printf
+    (
+        "%u hops, %u threads\n"
+        "analysis  : %8.1f x realtime\n"
+        "correction: %8.1f x realtime\n",
+        curve.numberOfHops(), threads, analysisSpeed, correctionSpeed
+    );
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,140 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// simulatedDeviceDriver.cpp
+/// -------------------------
+///
+///   Runs the headless engine (optionally with one effect) from an
+/// AudioIO::SimulatedDevice callback, i.e. along the same (host-style) path as
+/// with a real audio device, and reports the callback processing times and
+/// deadline misses.
+///
+///   Usage: simulatedDeviceDriver <input.wav> [output.wav|-] [effect|-] [callback size] [jitter]
+///  A jitter argument (relative to the buffer period) paces the callbacks to
+/// real time, otherwise the simulation is free running.
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#include "headlessEngine.hpp"
+
+#include "le/audioio/device/simulatedDevice.hpp"
+#include "le/audioio/file/inputWaveFile.hpp"
+#include "le/audioio/file/outputWaveFile.hpp"
+#include "le/utility/filesystem.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+//------------------------------------------------------------------------------
+namespace
+{
+    int fail( char const * const what, char const * const error )
+    {
+        std::fprintf( stderr, "%s: %s\n", what, error );
+        return EXIT_FAILURE;
+    }
+
+    bool specified( int const argc, char const * const argv[], int const index )
+    {
+        return ( argc > index ) && std::strcmp( argv[ index ], "-" ) != 0;
+    }
+} // anonymous namespace
+
+int main( int const argc, char const * const argv[] )
+{
+    using namespace LE;
+
+    if ( argc < 2 )
+    {
+        std::fprintf( stderr, "Usage: %s <input.wav> [output.wav|-] [effect|-] [callback size] [jitter]\n", argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+
+    std::uint16_t const callbackSize( static_cast<std::uint16_t>( ( argc > 4 ) ? std::atoi( argv[ 4 ] ) : 512 ) );
+    bool          const realTime    ( argc > 5                                                                 );
+    float         const jitter      ( realTime ? static_cast<float>( std::atof( argv[ 5 ] ) ) : 0              );
+    if ( !callbackSize )
+        return fail( "Callback size", "must be positive." );
+
+    AudioIO::InputWaveFile input;
+    if ( auto const error = input.open<Utility::AbsolutePath>( argv[ 1 ] ) )
+        return fail( argv[ 1 ], error );
+
+    std::uint8_t  const channels  ( input.numberOfChannels() );
+    std::uint32_t const sampleRate( input.sampleRate      () );
+
+    AudioIO::OutputWaveFile output;
+    bool const hasOutput( specified( argc, argv, 2 ) );
+    if ( hasOutput )
+    {
+        if ( auto const error = output.create<Utility::AbsolutePath>( argv[ 2 ], channels, sampleRate ) )
+            return fail( argv[ 2 ], error );
+    }
+
+    SW::HeadlessEngine engine;
+    if ( !engine.setup( channels, sampleRate, 2048, 4 ) )
+        return fail( "Engine setup", "out of memory or unsupported parameters." );
+    if ( specified( argc, argv, 3 ) && !engine.append( argv[ 3 ] ) )
+        return fail( argv[ 3 ], "not available." );
+
+    // The engine does not process in place.
+    std::unique_ptr<float[]> const pOutput( new ( std::nothrow ) float[ callbackSize * channels ] );
+    if ( !pOutput )
+        return fail( "Output buffer", "out of memory." );
+
+    AudioIO::SimulatedDevice device;
+    if ( auto const error = device.setup( channels, sampleRate, callbackSize ) )
+        return fail( "Device setup", error );
+    if ( auto const error = device.setInput( &input ) )
+        return fail( argv[ 1 ], error );
+    device.setOutput( hasOutput ? &output : nullptr );
+
+    AudioIO::SimulatedDevice::Simulation const simulation =
+    {
+        realTime ? AudioIO::SimulatedDevice::RealTime : AudioIO::SimulatedDevice::FreeRunning,
+        jitter,
+        0, // until the input file is exhausted
+        nullptr,
+        0
+    };
+    device.setSimulation( simulation );
+
+    auto const callback
+    (
+        [&]( AudioIO::Device::InterleavedInputOutput const data )
+        {
+            std::uint32_t const samples( data.numberOfSampleFrames * channels );
+            engine.process( data.pInputOutput, nullptr, pOutput.get(), data.numberOfSampleFrames, 1, 1 );
+            std::copy( &pOutput[ 0 ], &pOutput[ samples ], data.pInputOutput );
+        }
+    );
+    if ( auto const error = device.setCallback<AudioIO::Device::InterleavedInputOutput>( callback ) )
+        return fail( "Device callback", error );
+
+    device.start();
+    device.wait ();
+    if ( hasOutput )
+        output.close();
+
+    AudioIO::SimulatedDevice::Statistics const & statistics( device.statistics() );
+    std::printf
+    (
+        "%s, %u frame callbacks, buffer period %u us\n"
+        "callbacks       : %u (%u sample frames)\n"
+        "deadline misses : %u\n"
+        "processing time : %u / %.1f / %u us (min / avg / max)\n",
+        realTime ? "real time" : "free running", callbackSize, statistics.bufferPeriod,
+        statistics.callbacks, statistics.processedSampleFrames,
+        statistics.deadlineMisses,
+        statistics.minimumProcessingTime,
+        statistics.callbacks ? double( statistics.totalProcessingTime ) / statistics.callbacks : 0.0,
+        statistics.maximumProcessingTime
+    );
+
+    return EXIT_SUCCESS;
+}
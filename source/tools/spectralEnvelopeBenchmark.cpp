@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// spectralEnvelopeBenchmark.cpp
+/// -----------------------------
+///
+///   Times, for FFT sizes from 128 to 8192, the Engine::SpectralEnvelope
+/// paths against the previous (VocoderImpl::lowPassSpectrum_cepstrum) full
+/// FFT cepstral smoothing:
+///  - the FFT path (uncached cepstrum, lifter and forward FFT)
+///  - the direct (cosine matrix) path for an increasing number of cepstral
+///    coefficients, up to where it becomes slower than the FFT path (the
+///    crossover that SpectralEnvelope::directCoefficientsPerFFTStage should
+///    be set from)
+///  - LPC envelopes of a few orders.
+/// The maximum differences of the cepstral envelopes to the previous one (for
+/// the same Udo brick lifter) are reported as a sanity check.
+///
+///   Usage: spectralEnvelopeBenchmark [iterations]
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#include "headlessEngine.hpp"
+
+#include "le/spectrumworx/engine/setup.hpp"
+#include "le/spectrumworx/engine/spectralEnvelope.hpp"
+#include "le/spectrumworx/engine/spectralFeatures.hpp"
+#include "le/math/dft/fft.hpp"
+#include "le/math/math.hpp"
+#include "le/math/vector.hpp"
+#include "le/utility/buffers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+//------------------------------------------------------------------------------
+namespace
+{
+    using namespace LE;
+    using namespace LE::SW;
+
+    using Engine::DataRange;
+    using Engine::ReadOnlyDataRange;
+
+    // The previous VocoderImpl::lowPassSpectrum_cepstrum() Udo brick path.
+    void previousLowPassSpectrum_cepstrum( ReadOnlyDataRange const & amplitudes, std::uint16_t const cutoff, DataRange const & workBuffer, Math::FFT_float_real_1D const & fft )
+    {
+        using namespace Math;
+
+        Engine::SpectralFeatures::computeCepstrum( amplitudes, workBuffer, fft );
+
+        float * LE_RESTRICT const pCepstrum( workBuffer.begin()                                                       );
+        float * LE_RESTRICT const pImags   ( static_cast<float *>( align( workBuffer.begin() + amplitudes.size() ) ) );
+
+        float const udoGain( 1 );
+        if ( cutoff > 2 )
+        {
+            multiply( &pCepstrum[ 1 ], udoGain, cutoff - 2 );
+            // an attempt to make the LP less of a brick...
+            pCepstrum[ 0          ] *= 0.50f * udoGain;
+            pCepstrum[ cutoff - 1 ] *= 0.75f * udoGain;
+        }
+            pCepstrum[ cutoff     ] *= 0.50f * udoGain;
+            pCepstrum[ cutoff + 1 ] *= 0.25f * udoGain;
+        clear( &pCepstrum[ cutoff + 2 ], workBuffer.end() );
+
+        fft.transform( pCepstrum, pImags, fft.size() );
+    }
+
+    // Microseconds per call.
+    template <class Envelope>
+    double time( std::uint32_t const iterations, Envelope const & envelope )
+    {
+        SW::Stopwatch const stopwatch;
+        for ( std::uint32_t iteration( 0 ); iteration < iterations; ++iteration )
+            envelope();
+        return stopwatch.seconds() * 1e6 / iterations;
+    }
+
+    float maximumDifference( ReadOnlyDataRange const & left, float const * const pRight )
+    {
+        float difference( 0 );
+        for ( std::uint16_t bin( 0 ); bin < left.size(); ++bin )
+            difference = std::max( difference, std::abs( left[ bin ] - pRight[ bin ] ) );
+        return difference;
+    }
+
+    bool benchmark( std::uint16_t const fftSize, std::uint32_t const iterations )
+    {
+        HeadlessEngine engine;
+        if ( !engine.setup( 1, 44100, fftSize, 4 ) )
+            return false;
+        Engine::SpectralEnvelope const & spectralEnvelope( engine.spectralEnvelope() );
+        Math::FFT_float_real_1D  const & fft             ( engine.fft()              );
+        std::uint16_t            const   numberOfBins    ( engine.engineSetup().numberOfBins() );
+        std::uint16_t            const   stages          ( static_cast<std::uint16_t>( Math::log2( fftSize ) ) );
+
+        // Work buffers (two aligned numberOfBins sized halves each), amplitudes
+        // and the previous/reference envelope:
+        std::uint32_t const halfSize( Math::alignIndex( numberOfBins ) );
+        Utility::AlignedHeapBuffer<float> storage;
+        if ( !storage.resize( 2 * 2 * halfSize + 2 * halfSize ) )
+            return false;
+        DataRange const workBuffer( &storage[ 0            ], &storage[ 2 * halfSize ] );
+        DataRange const reference ( &storage[ 2 * halfSize ], &storage[ 4 * halfSize ] );
+        DataRange const amplitudes( &storage[ 4 * halfSize ], &storage[ 4 * halfSize + numberOfBins ] );
+
+        std::mt19937 generator;
+        std::uniform_real_distribution<float> amplitude( 0, engine.engineSetup().maximumAmplitude() );
+        for ( auto & value : amplitudes )
+            value = amplitude( generator );
+
+        // The lifter of the previous path (for the same number of coefficients
+        // as the direct path uses at the current crossover):
+        std::uint16_t const cutoff( static_cast<std::uint16_t>( std::max( 2, Engine::SpectralEnvelope::directCoefficientsPerFFTStage * stages - 2 ) ) );
+        Utility::AlignedHeapBuffer<float> lifterStorage;
+        if ( !lifterStorage.resize( numberOfBins ) )
+            return false;
+        Math::fill( lifterStorage.begin(), 1.0f, numberOfBins );
+        DataRange const udoLifter( &lifterStorage[ 0 ], &lifterStorage[ cutoff + 2 ] );
+        Engine::SpectralEnvelope::udoBrickLifter( cutoff, 1, udoLifter );
+
+        double const previousTime( time( iterations, [&]{ previousLowPassSpectrum_cepstrum( amplitudes, cutoff, workBuffer, fft ); } ) );
+        Math::copy( workBuffer.begin(), workBuffer.begin() + numberOfBins, reference.begin() );
+
+        auto const fftPath
+        (
+            [&]( ReadOnlyDataRange const & lifter )
+            {
+                Engine::SpectralFeatures::computeCepstrum( amplitudes, workBuffer, fft );
+                spectralEnvelope.lifterCepstrum( lifter, workBuffer, fft );
+            }
+        );
+        double const fftTime( time( iterations, [&]{ fftPath( udoLifter ); } ) );
+        float  const fftDifference( maximumDifference( ReadOnlyDataRange( reference.begin(), reference.begin() + numberOfBins ), workBuffer.begin() ) );
+
+        double const directTime( time( iterations, [&]{ spectralEnvelope.cepstralDirect( amplitudes, udoLifter, workBuffer ); } ) );
+        float  const directDifference( maximumDifference( ReadOnlyDataRange( reference.begin(), reference.begin() + numberOfBins ), workBuffer.begin() ) );
+
+        // The crossover (the direct path cost does not depend on the lifter
+        // values):
+        std::uint16_t crossover( 1 );
+        while ( crossover < numberOfBins )
+        {
+            std::uint16_t const coefficients( std::min<std::uint16_t>( crossover + 1, numberOfBins ) );
+            ReadOnlyDataRange const lifter( lifterStorage.begin(), lifterStorage.begin() + coefficients );
+            if ( time( iterations, [&]{ spectralEnvelope.cepstralDirect( amplitudes, lifter, workBuffer ); } ) > fftTime )
+                break;
+            crossover = coefficients;
+        }
+
+        DataRange const envelope( workBuffer.begin(), workBuffer.begin() + numberOfBins );
+        double const lpc16Time( time( iterations, [&]{ spectralEnvelope.lpc( amplitudes, 16                                       , envelope ); } ) );
+        double const lpc48Time( time( iterations, [&]{ spectralEnvelope.lpc( amplitudes, Engine::SpectralEnvelope::maximumLPCOrder, envelope ); } ) );
+
+        std::printf
+        (
+            "%5u | %8.2f | %8.2f | %9.3g | %2u: %8.2f | %9.3g | %9u | %9.2f | %6.2f | %6.2f\n",
+            fftSize,
+            previousTime,
+            fftTime, fftDifference,
+            cutoff + 2, directTime, directDifference,
+            crossover, double( crossover ) / stages,
+            lpc16Time, lpc48Time
+        );
+        return true;
+    }
+} // anonymous namespace
+
+int main( int const argc, char const * const argv[] )
+{
+    std::uint32_t const iterations( static_cast<std::uint32_t>( ( argc > 1 ) ? std::atoi( argv[ 1 ] ) : 2000 ) );
+    if ( !iterations )
+    {
+        std::fprintf( stderr, "Usage: %s [iterations]\n", argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+
+    Math::FPUDisableDenormalsGuard const disableDenormals;
+
+    std::printf( "Microseconds per envelope, %u iterations\n", iterations );
+    std::printf( " FFT  | previous | FFT path | FFT diff  |   direct     | direct diff | crossover | per stage | LPC 16 | LPC 48\n" );
+    for ( std::uint16_t fftSize( 128 ); fftSize <= 8192; fftSize *= 2 )
+    {
+        if ( !benchmark( fftSize, iterations ) )
+        {
+            std::fprintf( stderr, "FFT size %u: out of memory or unsupported.\n", fftSize );
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////////////
+///
+/// staticChainBenchmark.cpp
+/// ------------------------
+///
+///   Compares the x-realtime speed of the same effect chains (of 3, 4 and 6
+/// effects, with default parameters) processed as a dynamic module chain and
+/// as a compile-time Engine::StaticChain (see Processor::setFixedChain()).
+///
+///   Usage: staticChainBenchmark [FFT size] [overlap factor] [seconds]
+///
+/// Copyright (c) 2016. Little Endian Ltd. All rights reserved.
+///
+////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
+#include "headlessEngine.hpp"
+
+#include "le/spectrumworx/effects/exaggerator/exaggeratorImpl.hpp"
+#include "le/spectrumworx/effects/gain/gainImpl.hpp"
+#include "le/spectrumworx/effects/robotizer/robotizerImpl.hpp"
+#include "le/spectrumworx/effects/shifter/shifterImpl.hpp"
+#include "le/spectrumworx/effects/smoother/smootherImpl.hpp"
+#include "le/spectrumworx/effects/whisperer/whispererImpl.hpp"
+#include "le/spectrumworx/engine/staticChain.hpp"
+
+#include "boost/assert.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <random>
+//------------------------------------------------------------------------------
+namespace
+{
+    using namespace LE;
+    using namespace LE::SW;
+
+    std::uint8_t  const channels  ( 2     );
+    std::uint32_t const sampleRate( 44100 );
+    std::uint16_t const blockSize ( 512   );
+
+    struct Settings
+    {
+        std::uint16_t fftSize      ;
+        std::uint8_t  overlapFactor;
+        std::uint32_t frames       ;
+        float const * pInput       ; // interleaved
+        float       * pOutput      ;
+    }; // struct Settings
+
+    double run( HeadlessEngine & engine, Settings const & settings )
+    {
+        engine.reset();
+        Stopwatch const stopwatch;
+        for ( std::uint32_t frame( 0 ); frame < settings.frames; frame += blockSize )
+        {
+            std::uint32_t const samples( std::min<std::uint32_t>( blockSize, settings.frames - frame ) );
+            engine.process( &settings.pInput[ frame * channels ], nullptr, &settings.pOutput[ frame * channels ], samples, 1, 1 );
+        }
+        return stopwatch.xRealTime( settings.frames, sampleRate );
+    }
+
+    template <class ... Effects>
+    bool compare( Settings const & settings )
+    {
+        // The dynamic chain:
+        HeadlessEngine dynamicEngine;
+        if ( !dynamicEngine.setup( channels, sampleRate, settings.fftSize, settings.overlapFactor ) )
+            return false;
+        char const * const titles[] = { Effects::title... };
+        for ( auto const title : titles )
+        {
+            if ( !dynamicEngine.append( title ) )
+            {
+                std::fprintf( stderr, "%s: not available.\n", title );
+                return false;
+            }
+        }
+
+        // The same chain fixed at compile time:
+        HeadlessEngine staticEngine;
+        if ( !staticEngine.setup( channels, sampleRate, settings.fftSize, settings.overlapFactor ) )
+            return false;
+        Engine::StaticChain<Effects...> chain;
+        if ( !staticEngine.setFixedChain( &chain, staticEngine.storageFactors() ) )
+            return false;
+
+        double const dynamicSpeed( run( dynamicEngine, settings ) );
+        double const staticSpeed ( run( staticEngine , settings ) );
+        BOOST_VERIFY( staticEngine.setFixedChain( nullptr, staticEngine.storageFactors() ) );
+
+        std::printf( "%7u | %13.1f | %12.1f | %7.2f\n", unsigned( sizeof...( Effects ) ), dynamicSpeed, staticSpeed, staticSpeed / dynamicSpeed );
+        return true;
+    }
+} // anonymous namespace
+
+int main( int const argc, char const * const argv[] )
+{
+    using namespace LE::SW::Effects;
+
+    std::uint16_t const fftSize      ( static_cast<std::uint16_t>( ( argc > 1 ) ? std::atoi( argv[ 1 ] ) : 2048 ) );
+    std::uint8_t  const overlapFactor( static_cast<std::uint8_t >( ( argc > 2 ) ? std::atoi( argv[ 2 ] ) : 4    ) );
+    std::uint32_t const seconds      ( static_cast<std::uint32_t>( ( argc > 3 ) ? std::atoi( argv[ 3 ] ) : 60   ) );
+    std::uint32_t const frames       ( seconds * sampleRate                                                       );
+    if ( !frames )
+    {
+        std::fprintf( stderr, "Usage: %s [FFT size] [overlap factor] [seconds]\n", argv[ 0 ] );
+        return EXIT_FAILURE;
+    }
+
+    std::unique_ptr<float[]> const pInput ( new ( std::nothrow ) float[ frames * channels ] );
+    std::unique_ptr<float[]> const pOutput( new ( std::nothrow ) float[ frames * channels ] );
+    if ( !pInput || !pOutput )
+    {
+        std::fprintf( stderr, "Out of memory.\n" );
+        return EXIT_FAILURE;
+    }
+    std::mt19937 generator;
+    std::uniform_real_distribution<float> sample( -0.5f, 0.5f );
+    std::generate( &pInput[ 0 ], &pInput[ frames * channels ], [&]{ return sample( generator ); } );
+
+    Settings const settings = { fftSize, overlapFactor, frames, pInput.get(), pOutput.get() };
+
+    std::printf( "%u s of stereo noise, FFT size %u, overlap factor %u\n", seconds, fftSize, overlapFactor );
+    std::printf( "effects | dynamic x RT  | static x RT  | speedup\n" );
+    bool const success
+    (
+        compare<GainImpl, RobotizerImpl, SmootherImpl                                              >( settings ) &&
+        compare<GainImpl, RobotizerImpl, SmootherImpl, ShifterImpl                                 >( settings ) &&
+        compare<GainImpl, RobotizerImpl, SmootherImpl, ShifterImpl, ExaggeratorImpl, WhispererImpl >( settings )
+    );
+    if ( !success )
+    {
+        std::fprintf( stderr, "Engine setup failed (out of memory or unsupported parameters).\n" );
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}